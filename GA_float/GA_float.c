@@ -0,0 +1,1288 @@
+/* This is the source file for 'GA_float.h'. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "GA_float.h"
+
+/* Pair used to rank the population by fo. */
+struct FloatRank
+{
+    float fo;
+    int index;
+};
+
+/* Increment of the counter based random numbers (see 'float_rng_at'). */
+#define FLOAT_GOLDEN 0x9E3779B97F4A7C15ULL
+
+/*==========================*/
+/* Local source functions prototypes. */
+int
+float_compare_ranks(const void *a, const void *b);
+
+void
+float_alloc_rows(struct FloatPopulation *pop);
+
+void
+float_init_rows(struct FloatPopulation *pop, int first, int last);
+
+int
+float_init_n_threads(void);
+
+void
+float_update_ranking(struct FloatPopulation *pop);
+
+long
+float_evaluate_batch(struct FloatPopulation *pop);
+
+int
+float_tournament_index(struct FloatPopulation *pop, int tournament_size);
+
+uint64_t
+float_block_stream(uint64_t seed, int block);
+
+int
+float_cross_code(struct FloatPopulation *pop, char *cross_mode,
+                 float *param);
+
+int
+float_mutate_code(struct FloatPopulation *pop, char *mutate_mode,
+                  float *param);
+
+int
+float_next_mutation(int j, float mutate_rate, double log_keep,
+                    uint64_t *rng);
+
+void
+float_cross_pair(struct FloatPopulation *pop, int cross_code, float param,
+                 const float *parent1, const float *parent2,
+                 float *child1, float *child2, uint64_t key);
+
+void
+float_mutate_block(int mutate_code, float param, float *row,
+                   const float *lower, const float *upper,
+                   int32_t threshold, int first, int last, uint64_t key);
+
+void
+float_mutate_row(struct FloatPopulation *pop, int mutate_code, float param,
+                 float *row, float mutate_rate, uint64_t key);
+
+/*==========================*/
+/* Per gene functions, inlined in the gene loops so they vectorize:
+   no branches (only selects) and no calls to libm. */
+static inline uint64_t
+float_rng_at(uint64_t key, int j)
+{
+/* Random 64 bits of gene 'j' of the stream 'key' (splitmix64 of the
+   j-th counter), so each gene draws it's numbers independently. */
+    uint64_t z = key + (uint64_t) (j + 1) * FLOAT_GOLDEN;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline float
+float_unit(uint64_t bits)
+{
+/* Uniform float in (0, 1) from the 23 lowest bits of 'bits'. */
+    return ((float) (int32_t) (bits & 0x7FFFFF) + 0.5f)
+           * (1.0f / 8388608.0f);
+}
+
+static inline float
+float_select(int condition, float a, float b)
+{
+/* 'condition' ? a : b through the bits, so both values are computed
+   before (a float select of computed values becomes a branch, and
+   the loop is not vectorized as float operations may trap). */
+    int32_t bits_a, bits_b, mask = -(int32_t) (condition != 0);
+
+    memcpy(&bits_a, &a, sizeof(float));
+    memcpy(&bits_b, &b, sizeof(float));
+    bits_a = (bits_a & mask) | (bits_b & ~mask);
+    memcpy(&a, &bits_a, sizeof(float));
+    return a;
+}
+
+static inline float
+float_log2(float x)
+{
+/* log2(x) for x > 0 (absolute error < 1e-6): the exponent from the
+   bits and an atanh series for the mantissa, in [sqrt(2) / 2,
+   sqrt(2)). 0 gives -127. */
+    int32_t bits, e;
+    float m, t, t2;
+
+    memcpy(&bits, &x, sizeof(float));
+    e = ((bits >> 23) & 0xFF) - 127;
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+    memcpy(&m, &bits, sizeof(float));
+    e += (m > 1.41421356f);
+    m = float_select(m > 1.41421356f, 0.5f * m, m);
+    t = (m - 1.0f) / (m + 1.0f);
+    t2 = t * t;
+    return (float) e + t * (2.88539008f + t2 * (0.961796694f
+                            + t2 * (0.577078016f + t2 * (0.412198583f
+                            + t2 * 0.320598898f))));
+}
+
+static inline float
+float_exp2(float x)
+{
+/* 2^x (relative error < 1e-6), 'x' clamped to [-126, 127]. The
+   integer part is rounded by adding 1.5 * 2^23 (a float to int
+   conversion may trap too) and the clamps are bit selects (branches
+   to constant results otherwise). */
+    int32_t i, bits;
+    float f, scale, shifted;
+
+    x = float_select(x < -126.0f, -126.0f, x);
+    x = float_select(x > 127.0f, 127.0f, x);
+    shifted = x + 12582912.0f;
+    memcpy(&bits, &shifted, sizeof(float));
+    i = bits - 0x4B400000;
+    /* f in [-0.5, 0.5]. */
+    f = x - (shifted - 12582912.0f);
+    bits = (i + 127) << 23;
+    memcpy(&scale, &bits, sizeof(float));
+    /* Least squares fit of 2^f over [-0.5, 0.5] (relative error
+       < 1e-7). */
+    return scale * (1.00000007f + f * (0.693146949f + f * (0.240221218f
+                    + f * (0.0555074262f + f * (0.00967545975f
+                    + f * 0.00132669703f)))));
+}
+
+static inline float
+float_pow(float x, float y)
+{
+/* x^y for x >= 0. */
+    return float_exp2(y * float_log2(x));
+}
+
+static inline float
+float_cos_2pi(float u)
+{
+/* cos(2 pi u) for u in [0, 1] (absolute error < 1e-6): folded to
+   [0, pi / 2] by symmetry and a Taylor polynomial. */
+    float a = 0.5f - fabsf(u - 0.5f);
+    float sign = (a > 0.25f) ? -1.0f : 1.0f;
+    float x, x2;
+
+    a = 0.25f - fabsf(a - 0.25f);
+    x = 6.28318531f * a;
+    x2 = x * x;
+    return sign * (1.0f + x2 * (-0.5f + x2 * (0.0416666667f
+                   + x2 * (-0.00138888889f + x2 * (0.0000248015873f
+                   - x2 * 0.000000275573192f)))));
+}
+
+static inline float
+float_reflect(float x, float lower, float upper)
+{
+/* 'x' reflected into [lower, upper] (once, then clamped). */
+    x = float_select(x < lower, 2.0f * lower - x, x);
+    x = float_select(x > upper, 2.0f * upper - x, x);
+    x = (x < lower) ? lower : x;
+    return (x > upper) ? upper : x;
+}
+
+static inline float
+float_sbx_spread(float beta, float u, float eta)
+{
+/* Spread factor of Deb's bounded SBX for one side, 'beta' being
+   1 + 2 * (distance of the parents to the bound) / (their distance). */
+    float root = 1.0f / (eta + 1.0f);
+    float alpha = 2.0f - float_exp2(-(eta + 1.0f) * float_log2(beta));
+    float v = u * alpha;
+    int low = (v <= 1.0f);
+    /* v <= 1: v^root, otherwise (1 / (2 - v))^root = 2^(-root *
+       log2(2 - v)), with 2 - v > 0 as u < 1 and alpha <= 2. */
+    float log_v = float_log2(float_select(low, v, 2.0f - v));
+
+    return float_exp2(root * float_select(low, log_v, -log_v));
+}
+
+static inline float
+float_gaussian_gene(float x, float lower, float upper, float sigma,
+                    uint64_t bits)
+{
+/* 'x' plus a normal deviate (Box-Muller) with standard deviation
+   'sigma' times the gene range, reflected into bounds. The radius
+   sqrt(-2 ln(u1)) is 2^(log2(-2 ln(u1)) / 2) (no libm call). */
+    float radius = float_exp2(0.5f * float_log2(
+                       -1.38629436f * float_log2(float_unit(bits))));
+    float normal = radius * float_cos_2pi(float_unit(bits >> 23));
+
+    return float_reflect(x + sigma * (upper - lower) * normal, lower, upper);
+}
+
+static inline float
+float_polynomial_gene(float x, float lower, float upper, float eta,
+                      uint64_t bits)
+{
+/* Deb's polynomial mutation of 'x' with distribution index 'eta'. */
+    float range = upper - lower;
+    float u = float_unit(bits);
+    int low = (u < 0.5f);
+    /* 1 - distance to the bound on the side of the perturbation, in
+       [0, 1] as 'x' is within bounds ('fabsf' only drops the sign of a
+       rounding error). */
+    float xy = float_select(low, 1.0f - (x - lower) / range,
+                            1.0f - (upper - x) / range);
+    float power = float_pow(fabsf(xy), eta + 1.0f);
+    float val = float_select(low, 2.0f * u + (1.0f - 2.0f * u) * power,
+                             2.0f * (1.0f - u) + 2.0f * (u - 0.5f) * power);
+    float root = float_pow(val, 1.0f / (eta + 1.0f));
+
+    x += float_select(low, root - 1.0f, 1.0f - root) * range;
+    x = (x < lower) ? lower : x;
+    return (x > upper) ? upper : x;
+}
+
+/*==========================*/
+/* Miscellanous functions. */
+int
+float_compare_ranks(const void *a, const void *b)
+{
+    /* To use in qsort: by fo (minor first) and then by index,
+       so tied individuals keep their population order. */
+    const struct FloatRank *ra = a, *rb = b;
+
+    if (ra->fo < rb->fo)
+        return -1;
+    if (ra->fo > rb->fo)
+        return 1;
+    return ra->index - rb->index;
+}
+
+uint64_t
+float_block_stream(uint64_t seed, int block)
+{
+/* Random stream of 'block' (a pair of childs or an individual) from
+   the per call 'seed'. */
+    return hash_mix64(seed ^ hash_mix64((uint64_t) block + 1));
+}
+
+int
+float_init_n_threads(void)
+{
+/* Threads for the initial random individuals: all the OpenMP ones
+   (OMP_NUM_THREADS), as no user function is called. */
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/*==========================*/
+/* Print functions. */
+void
+float_print_results(FILE *ptr, int print_mode,
+                    struct FloatPopulation *pop, int k)
+{
+/* Simple function to print results of the current population
+   'pop' to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - 'print_mode': - PRINT_INDV : Only the best individual and the best
+                                  fo of the current pop are printed.
+                   - PRINT_COMPLETE : The best individual and all the
+                                      population are printed.
+   - '*pop' : An already evaluated FloatPopulation struct.
+   - 'k' : The current iteration. */
+    int i, j;
+
+    fprintf(ptr, "\n===POPULATION GEN %d===\n", k);
+    if (print_mode == PRINT_COMPLETE)
+    {
+        for (i = 0; i < pop->n_population; i++)
+        {
+            fprintf(ptr, "[ ");
+            for (j = 0; j < pop->length; j++)
+            {
+                fprintf(ptr, "%g ", pop->individuals[i][j]);
+            }
+            fprintf(ptr, "]\n");
+        }
+    }
+    if (print_mode == PRINT_INDV || print_mode == PRINT_COMPLETE)
+    {
+        fprintf(ptr, "Best individual(s) found in the population:\n");
+        for (i = 0; i < pop->n_best_individuals; i++)
+        {
+            fprintf(ptr, "[ ");
+            for (j = 0; j < pop->length; j++)
+            {
+                fprintf(ptr, "%g ", pop->individuals[
+                                        pop->best_indexes[i]][j]);
+            }
+            fprintf(ptr, "]\n");
+        }
+        fprintf(ptr, "The best fo for this population is: %.8f\n",
+                pop->best_fo);
+    }
+}
+
+void
+float_print_end_results(FILE *ptr, struct FloatPopulation *pop, int k)
+{
+/* Simple function to print end results of the GA to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - '*pop' : An already evaluated FloatPopulation struct.
+   - 'k' : The last iteration. */
+    int j;
+
+    fprintf(ptr,
+        "\n\nAfter %d iterations this is the best fo found!!"
+        " Good for you!\n", k);
+    fprintf(ptr, "Best individual found through all iters:\n[ ");
+    for (j = 0; j < pop->length; j++)
+    {
+        fprintf(ptr, "%g ", pop->best_indv_alltime[j]);
+    }
+    fprintf(ptr, "]\nThe best fo value found through all iters: %.8f\n",
+            pop->best_fo_alltime);
+}
+
+/*==========================*/
+/* Population init, evaluation and free. */
+struct FloatPopulation
+*float_init_population(char *init_mode, int n_population, int length,
+                       float min_value, float max_value)
+{
+/* This function returns an initalized FloatPopulation struct. It's the
+   first call in your program, defining the initial population. After
+   this you MUST evaluate the population with 'float_evaluate_population'.
+   =ARGUMENTS=
+   - '*init_mode' : - 'random' : Each gene uniform within it's bounds,
+                                 in parallel with all the OpenMP threads
+                                 (each individual with it's own random
+                                 stream).
+                    - 'empty'  : Individuals of 0s, to be defined by the
+                                 user (e.g. by a heuristic).
+   - 'n_population' : The number of individuals inside population (>= 2).
+   - 'length' : Length of the solution (number of genes).
+   - 'min_value', 'max_value' : Boundaries of every gene
+                                (min_value < max_value).
+   =RETURNS=
+   - 'pop' : A pointer to a FloatPopulation struct. */
+    int j;
+    struct FloatPopulation *pop;
+
+    if (strcmp(init_mode, "random") != 0 && strcmp(init_mode, "empty") != 0)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'init_mode' ('%s') argument passed\nto "
+               "'float_init_population' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'random'  :    randomly initialize population according"
+               "\n\t\tto solution boundaries.\n"
+               "-'empty'   :    individuals inside population start as"
+               "\n\t\tarrays of 0s.\n"
+               "====================\n", init_mode);
+        exit(EXIT_FAILURE);
+    }
+    if (length < 1 || n_population < 2 || !(min_value < max_value))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'float_init_population' needs length >= 1,\n"
+               "n_population >= 2 and min_value < max_value.\n"
+               "====================\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pop = ec_malloc(sizeof(struct FloatPopulation), __LINE__, __FILE__);
+    pop->init_mode = init_mode;
+    pop->length = length;
+    pop->min_value = min_value;
+    pop->max_value = max_value;
+    pop->lower = ec_malloc(length * sizeof(float), __LINE__, __FILE__);
+    pop->upper = ec_malloc(length * sizeof(float), __LINE__, __FILE__);
+    for (j = 0; j < length; j++)
+    {
+        pop->lower[j] = min_value;
+        pop->upper[j] = max_value;
+    }
+    pop->n_population = n_population;
+    pop->n_population_alloc = n_population;
+    pop->stride = (length + FLOAT_LANES - 1) / FLOAT_LANES * FLOAT_LANES;
+    float_alloc_rows(pop);
+    pop->n_best_individuals = 0;
+    pop->best_indexes = NULL;
+    pop->fos = NULL;
+    pop->best_fo = 0.0;
+    pop->sorted_fos = NULL;
+    pop->sorted_fos_indexes = NULL;
+    pop->best_fo_alltime = 0.0;
+    pop->best_indv_alltime = NULL;
+    pop->first_population = POP_NOT_EVAL;
+    pop->generation = 0;
+    pop->n_evaluations = 0;
+    pop->objective_function = NULL;
+    pop->eval_skip = ec_calloc(n_population, sizeof(int),
+                               __LINE__, __FILE__);
+    pop->n_eval_skip = 0;
+    pop->batch_objective = NULL;
+    /* The pop random stream follows srand(). */
+    pop->rng_state = ((uint64_t) rand() << 32) ^ (uint64_t) rand();
+    pop->n_threads = 1;
+    if (strcmp(init_mode, "random") == 0)
+        float_init_rows(pop, 0, n_population);
+    return pop;
+}
+
+void
+float_alloc_rows(struct FloatPopulation *pop)
+{
+/* Allocs the current and next generation buffers, with
+   'n_population_alloc' + 1 rows (the last one is scratch) of 'stride'
+   floats each, 64 bytes aligned and filled with 0s. */
+    int i, n_rows = pop->n_population_alloc + 1;
+    size_t size = (size_t) n_rows * pop->stride * sizeof(float);
+    void *genes, *next_genes;
+
+    if (posix_memalign(&genes, 64, size) != 0)
+        genes = NULL;
+    check_null(genes, __LINE__, __FILE__);
+    if (posix_memalign(&next_genes, 64, size) != 0)
+        next_genes = NULL;
+    check_null(next_genes, __LINE__, __FILE__);
+    memset(genes, 0, size);
+    memset(next_genes, 0, size);
+    pop->genes = genes;
+    pop->next_genes = next_genes;
+    pop->individuals = ec_malloc(n_rows * sizeof(float*), __LINE__, __FILE__);
+    pop->next_individuals = ec_malloc(n_rows * sizeof(float*),
+                                      __LINE__, __FILE__);
+    for (i = 0; i < n_rows; i++)
+    {
+        pop->individuals[i] = pop->genes + (size_t) i * pop->stride;
+        pop->next_individuals[i] = pop->next_genes + (size_t) i * pop->stride;
+    }
+}
+
+void
+float_init_rows(struct FloatPopulation *pop, int first, int last)
+{
+/* Random individuals [first, last), each gene uniform within it's
+   bounds, in parallel (each individual with it's own stream). */
+    int i;
+    uint64_t seed = rng_next(&pop->rng_state);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(float_init_n_threads()) \
+    schedule(static)
+#endif
+    for (i = first; i < last; i++)
+    {
+        int j;
+        float *row = pop->individuals[i];
+        uint64_t key = float_block_stream(seed, i);
+
+        for (j = 0; j < pop->length; j++)
+        {
+            row[j] = pop->lower[j] + float_unit(float_rng_at(key, j))
+                                     * (pop->upper[j] - pop->lower[j]);
+        }
+    }
+}
+
+void
+float_set_bounds(struct FloatPopulation *pop, float *lower, float *upper)
+{
+/* This function defines different boundaries for each gene,
+   [lower[j], upper[j]] (lower[j] < upper[j]). It must be called before
+   the first evaluation: random individuals are drawn again within the
+   new boundaries.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized (not
+              evaluated).
+   - '*lower', '*upper' : Arrays of 'length' boundaries (copied). */
+    int j;
+
+    for (j = 0; j < pop->length; j++)
+    {
+        if (!(lower[j] < upper[j]))
+            break;
+    }
+    if (pop->first_population != POP_NOT_EVAL || j < pop->length)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'float_set_bounds' must be called before the first\n"
+               "evaluation, with lower[j] < upper[j] for every gene.\n"
+               "====================\n");
+        float_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(pop->lower, lower, pop->length * sizeof(float));
+    memcpy(pop->upper, upper, pop->length * sizeof(float));
+    if (strcmp(pop->init_mode, "random") == 0)
+        float_init_rows(pop, 0, pop->n_population);
+}
+
+void
+float_set_n_threads(struct FloatPopulation *pop, int n_threads)
+{
+/* Defines the number of threads used by the evaluation and the
+   operators (1 by default). It only has effect when compiled with
+   OpenMP ('-fopenmp'); with n_threads > 1 the objective function must
+   be thread safe. Childs are bred in pairs, each pair with it's own
+   random stream, so results don't depend on 'n_threads'. */
+    pop->n_threads = (n_threads < 1) ? 1 : n_threads;
+}
+
+void
+float_set_batch_objective(struct FloatPopulation *pop,
+                          void (*batch_function)())
+{
+/* This function makes 'float_evaluate_population' evaluate the
+   population by blocks of up to FLOAT_BATCH consecutive individuals,
+   read in place from the 'genes' buffer, so objective functions can
+   work on several individuals per call (e.g. vectorizing across them).
+   The objective function passed to 'float_evaluate_population' is
+   still kept as the last one used, and both must give the same fos.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '(*batch_function)()' : Batch objective with inputs
+                             (float *genes, int stride, int n,
+                             int length, float *fos): gene j of the
+                             individual k of the block is
+                             'genes[k * stride + j]' and it's fo goes
+                             to 'fos[k]', k in [0, n). 'genes' is 64
+                             bytes aligned and 'stride' is a multiple of
+                             FLOAT_LANES. NULL goes back to single
+                             evaluations. */
+    pop->batch_objective = batch_function;
+}
+
+void
+float_evaluate_population(struct FloatPopulation *pop,
+                          float (*objective_function)())
+{
+/* Evaluate a float population defining the struct variables:
+   - 'fos'
+   - 'best_fo'
+   - 'n_best_individuals'
+   - 'best_indexes'
+   - 'sorted_fos'
+   - 'sorted_fos_indexes'
+   - 'best_fo_alltime'
+   - 'best_indv_alltime'
+   It should be called after the generation of a population.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '(*objective_function)()' : A fo calculation with inputs:
+                                 - 'float *arr' : float solution array.
+                                 - 'int length' : length of 'arr'. */
+    int i;
+    long n_evaluations = 0;
+
+    if (pop->first_population == POP_NOT_EVAL)
+    {
+        /* After evaluation 'first_population' goes to POP_EVALUATED
+           to avoid multiple allocs. */
+        pop->best_indexes = ec_malloc(pop->n_population_alloc * sizeof(int),
+                                      __LINE__, __FILE__);
+        pop->fos = ec_malloc(pop->n_population_alloc * sizeof(float),
+                             __LINE__, __FILE__);
+        pop->sorted_fos_indexes = ec_malloc(
+                                      pop->n_population_alloc * sizeof(int),
+                                      __LINE__, __FILE__);
+        pop->sorted_fos = ec_malloc(pop->n_population_alloc * sizeof(float),
+                                    __LINE__, __FILE__);
+        pop->best_indv_alltime = ec_malloc(pop->length * sizeof(float),
+                                           __LINE__, __FILE__);
+        pop->generation = 0;
+    }
+    else
+        pop->generation++;
+    pop->objective_function = objective_function;
+
+    if (pop->batch_objective != NULL)
+        n_evaluations = float_evaluate_batch(pop);
+    else
+    {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 16) \
+    reduction(+:n_evaluations) if (pop->n_threads > 1)
+#endif
+        for (i = 0; i < pop->n_population; i++)
+        {
+            if (pop->n_eval_skip > 0 && pop->eval_skip[i])
+                continue;
+            pop->fos[i] = objective_function(pop->individuals[i],
+                                             pop->length);
+            n_evaluations++;
+        }
+    }
+    pop->n_evaluations += n_evaluations;
+    pop->n_eval_skip = 0;
+
+    /* Best fo, best individuals and sorted fos. */
+    float_update_ranking(pop);
+    /* All time best fo and individual. */
+    if (pop->first_population == POP_NOT_EVAL ||
+        pop->best_fo < pop->best_fo_alltime)
+    {
+        pop->best_fo_alltime = pop->best_fo;
+        memcpy(pop->best_indv_alltime,
+               pop->individuals[pop->best_indexes[0]],
+               pop->length * sizeof(float));
+    }
+    pop->first_population = POP_EVALUATED;
+}
+
+long
+float_evaluate_batch(struct FloatPopulation *pop)
+{
+/* Evaluates the population by blocks of up to FLOAT_BATCH consecutive
+   individuals, read in place, in parallel. Blocks with only known fos
+   are skipped.
+   =RETURNS=
+   - The number of evaluated individuals. */
+    int b, n_blocks = (pop->n_population + FLOAT_BATCH - 1) / FLOAT_BATCH;
+    long n_evaluations = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 1) \
+    reduction(+:n_evaluations) if (pop->n_threads > 1)
+#endif
+    for (b = 0; b < n_blocks; b++)
+    {
+        int i, n_eval = 0;
+        int first = b * FLOAT_BATCH;
+        int last = (first + FLOAT_BATCH < pop->n_population) ?
+                   first + FLOAT_BATCH : pop->n_population;
+        float fos[FLOAT_BATCH];
+
+        for (i = first; i < last; i++)
+        {
+            if (!(pop->n_eval_skip > 0 && pop->eval_skip[i]))
+                n_eval++;
+        }
+        if (n_eval == 0)
+            continue;
+        pop->batch_objective(pop->individuals[first], pop->stride,
+                             last - first, pop->length, fos);
+        for (i = first; i < last; i++)
+        {
+            if (!(pop->n_eval_skip > 0 && pop->eval_skip[i]))
+                pop->fos[i] = fos[i - first];
+        }
+        n_evaluations += n_eval;
+    }
+    return n_evaluations;
+}
+
+void
+float_update_ranking(struct FloatPopulation *pop)
+{
+/* Defines 'sorted_fos', 'sorted_fos_indexes', 'best_fo',
+   'n_best_individuals' and 'best_indexes' from 'fos'. */
+    int i;
+    struct FloatRank *ranks;
+
+    ranks = ec_malloc(pop->n_population * sizeof(struct FloatRank),
+                      __LINE__, __FILE__);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        ranks[i].fo = pop->fos[i];
+        ranks[i].index = i;
+    }
+    qsort(ranks, pop->n_population, sizeof(struct FloatRank),
+          float_compare_ranks);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        pop->sorted_fos[i] = ranks[i].fo;
+        pop->sorted_fos_indexes[i] = ranks[i].index;
+    }
+    free(ranks);
+    pop->best_fo = pop->sorted_fos[0];
+    pop->n_best_individuals = 0;
+    for (i = 0; i < pop->n_population && pop->sorted_fos[i] == pop->best_fo;
+         i++)
+    {
+        pop->best_indexes[pop->n_best_individuals++] =
+            pop->sorted_fos_indexes[i];
+    }
+}
+
+void
+float_free_population(struct FloatPopulation *pop)
+{
+/* This function frees a FloatPopulation struct and all it's members.
+   It MUST be called in the end of your program to free heap memory.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized. */
+    free(pop->lower);
+    free(pop->upper);
+    free(pop->genes);
+    free(pop->next_genes);
+    free(pop->individuals);
+    free(pop->next_individuals);
+    free(pop->best_indexes);
+    free(pop->fos);
+    free(pop->sorted_fos);
+    free(pop->sorted_fos_indexes);
+    free(pop->best_indv_alltime);
+    free(pop->eval_skip);
+    free(pop);
+}
+
+/*==========================*/
+/* GA operators. */
+int
+float_tournament_index(struct FloatPopulation *pop, int tournament_size)
+{
+/* Index of the winner of a tournament (with replacement). */
+    int i, index, winner = -1;
+
+    for (i = 0; i < tournament_size || winner < 0; i++)
+    {
+        index = (int) rng_bounded(&pop->rng_state,
+                                  (uint32_t) pop->n_population);
+        if (winner < 0 || pop->fos[index] < pop->fos[winner])
+            winner = index;
+    }
+    return winner;
+}
+
+float
+*float_tournament_selection(struct FloatPopulation *pop,
+                            int tournament_size)
+{
+/* This function return the winner (float solution array) pointer
+   after a tournament inside the population.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized AND
+              evaluated.
+   - 'tournament_size' : The number of competitors (with replacement).
+   =RETURNS=
+   - 'winner' : The individual with the minor fo of the tournament. */
+    return pop->individuals[float_tournament_index(pop, tournament_size)];
+}
+
+int
+float_cross_code(struct FloatPopulation *pop, char *cross_mode,
+                 float *param)
+{
+/* Code of a '*cross_mode' string ('sbx[:eta]', 'blx[:alpha]' or
+   'arithmetic'), defining it's '*param'. */
+    if (strncmp(cross_mode, "sbx", 3) == 0 &&
+        (cross_mode[3] == '\0' || cross_mode[3] == ':'))
+    {
+        *param = (cross_mode[3] == ':') ? (float) atof(cross_mode + 4)
+                                        : FLOAT_SBX_ETA;
+        if (*param >= 0.0f)
+            return FCROSS_SBX;
+    }
+    else if (strncmp(cross_mode, "blx", 3) == 0 &&
+             (cross_mode[3] == '\0' || cross_mode[3] == ':'))
+    {
+        *param = (cross_mode[3] == ':') ? (float) atof(cross_mode + 4)
+                                        : FLOAT_BLX_ALPHA;
+        if (*param >= 0.0f)
+            return FCROSS_BLX;
+    }
+    else if (strcmp(cross_mode, "arithmetic") == 0)
+    {
+        *param = 0.0f;
+        return FCROSS_ARITHMETIC;
+    }
+    fprintf(stderr, "===ARGUMENT ERROR===\n"
+           "Wrong 'cross_mode' ('%s') argument passed\n"
+           "to a GA_float crossover.\n"
+           "The supported arguments are (so far):\n"
+           "-'sbx[:eta]'     :    simulated binary crossover (eta >= 0).\n"
+           "-'blx[:alpha]'   :    blend crossover (alpha >= 0).\n"
+           "-'arithmetic'    :    whole arithmetic crossover.\n"
+           "====================\n", cross_mode);
+    float_free_population(pop);
+    exit(EXIT_FAILURE);
+}
+
+int
+float_mutate_code(struct FloatPopulation *pop, char *mutate_mode,
+                  float *param)
+{
+/* Code of a '*mutate_mode' string ('gaussian[:sigma]' or
+   'polynomial[:eta]'), defining it's '*param'. */
+    if (strncmp(mutate_mode, "gaussian", 8) == 0 &&
+        (mutate_mode[8] == '\0' || mutate_mode[8] == ':'))
+    {
+        *param = (mutate_mode[8] == ':') ? (float) atof(mutate_mode + 9)
+                                         : FLOAT_GAUSSIAN_SIGMA;
+        if (*param > 0.0f)
+            return FMUTATE_GAUSSIAN;
+    }
+    else if (strncmp(mutate_mode, "polynomial", 10) == 0 &&
+             (mutate_mode[10] == '\0' || mutate_mode[10] == ':'))
+    {
+        *param = (mutate_mode[10] == ':') ? (float) atof(mutate_mode + 11)
+                                          : FLOAT_POLYNOMIAL_ETA;
+        if (*param >= 0.0f)
+            return FMUTATE_POLYNOMIAL;
+    }
+    fprintf(stderr, "===ARGUMENT ERROR===\n"
+           "Wrong 'mutate_mode' ('%s') argument passed\n"
+           "to a GA_float mutation.\n"
+           "The supported arguments are (so far):\n"
+           "-'gaussian[:sigma]' :    normal deviate, sigma (> 0) times\n"
+           "\t\tthe gene range.\n"
+           "-'polynomial[:eta]' :    polynomial mutation (eta >= 0).\n"
+           "====================\n", mutate_mode);
+    float_free_population(pop);
+    exit(EXIT_FAILURE);
+}
+
+void
+float_cross_pair(struct FloatPopulation *pop, int cross_code, float param,
+                 const float *parent1, const float *parent2,
+                 float *child1, float *child2, uint64_t key)
+{
+/* Crossover of one pair of parents with the stream 'key', one loop
+   per operator over the genes (vectorized). */
+    int j, length = pop->length;
+    const float *lower = pop->lower, *upper = pop->upper;
+    float mix;
+
+    if (cross_code == FCROSS_SBX)
+    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = 0; j < length; j++)
+        {
+            uint64_t bits = float_rng_at(key, j);
+            float a = parent1[j], b = parent2[j];
+            float y1 = (a < b) ? a : b, y2 = (a < b) ? b : a;
+            float distance = y2 - y1;
+            float scale = 2.0f / ((distance > 1e-12f) ? distance : 1e-12f);
+            float u = float_unit(bits);
+            float q1 = float_sbx_spread(1.0f + (y1 - lower[j]) * scale, u,
+                                        param);
+            float q2 = float_sbx_spread(1.0f + (upper[j] - y2) * scale, u,
+                                        param);
+            float x1 = 0.5f * ((y1 + y2) - q1 * distance);
+            float x2 = 0.5f * ((y1 + y2) + q2 * distance);
+            int swap = (int) ((bits >> 23) & 1);
+
+            x1 = (x1 < lower[j]) ? lower[j] : ((x1 > upper[j]) ? upper[j] : x1);
+            x2 = (x2 < lower[j]) ? lower[j] : ((x2 > upper[j]) ? upper[j] : x2);
+            /* Equal parents are kept. */
+            x1 = (distance > 1e-12f) ? x1 : a;
+            x2 = (distance > 1e-12f) ? x2 : b;
+            child1[j] = swap ? x2 : x1;
+            child2[j] = swap ? x1 : x2;
+        }
+    }
+    else if (cross_code == FCROSS_BLX)
+    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = 0; j < length; j++)
+        {
+            uint64_t bits = float_rng_at(key, j);
+            float a = parent1[j], b = parent2[j];
+            float y1 = (a < b) ? a : b;
+            float distance = fabsf(a - b);
+            float start = y1 - param * distance;
+            float width = (1.0f + 2.0f * param) * distance;
+
+            child1[j] = float_reflect(start + float_unit(bits) * width,
+                                      lower[j], upper[j]);
+            child2[j] = float_reflect(start + float_unit(bits >> 23) * width,
+                                      lower[j], upper[j]);
+        }
+    }
+    else
+    {
+        /* One mixing factor for the whole pair. */
+        mix = float_unit(float_rng_at(key, -1));
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = 0; j < length; j++)
+        {
+            float a = parent1[j], b = parent2[j];
+            float x1 = mix * a + (1.0f - mix) * b;
+            float x2 = (1.0f - mix) * a + mix * b;
+
+            child1[j] = (x1 < lower[j]) ? lower[j] :
+                        ((x1 > upper[j]) ? upper[j] : x1);
+            child2[j] = (x2 < lower[j]) ? lower[j] :
+                        ((x2 > upper[j]) ? upper[j] : x2);
+        }
+    }
+}
+
+int
+float_next_mutation(int j, float mutate_rate, double log_keep,
+                    uint64_t *rng)
+{
+/* Index of the next mutated gene after gene 'j' (j = -1 for the
+   first one): the gaps between mutations are geometric, so only one
+   random number is drawn per mutation ('log_keep' is
+   log(1 - mutate_rate), see 'int_next_mutation' in GA_int.c).
+   =RETURNS=
+   - The index, which may be >= length (no more mutations). */
+    double gap;
+
+    if (mutate_rate <= 0.0f)
+        return INT_MAX;
+    /* 1 - rng_double is in (0, 1]. */
+    gap = floor(log(1.0 - rng_double(rng)) / log_keep);
+    if (gap >= (double) (INT_MAX - 1 - j))
+        return INT_MAX;
+    return j + 1 + (int) gap;
+}
+
+void
+float_mutate_block(int mutate_code, float param, float *row,
+                   const float *lower, const float *upper,
+                   int32_t threshold, int first, int last, uint64_t key)
+{
+/* Dense mutation of the genes [first, last) of 'row': every gene is
+   computed and those with the 18 highest random bits below
+   'threshold' are kept (vectorized loop without gathers). */
+    int j;
+
+    if (mutate_code == FMUTATE_GAUSSIAN)
+    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = first; j < last; j++)
+        {
+            uint64_t bits = float_rng_at(key, j);
+            float x = float_gaussian_gene(row[j], lower[j], upper[j], param,
+                                          bits);
+
+            row[j] = float_select((int32_t) (bits >> 46) < threshold, x,
+                                  row[j]);
+        }
+    }
+    else
+    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = first; j < last; j++)
+        {
+            uint64_t bits = float_rng_at(key, j);
+            float x = float_polynomial_gene(row[j], lower[j], upper[j], param,
+                                            bits);
+
+            row[j] = float_select((int32_t) (bits >> 46) < threshold, x,
+                                  row[j]);
+        }
+    }
+}
+
+void
+float_mutate_row(struct FloatPopulation *pop, int mutate_code, float param,
+                 float *row, float mutate_rate, uint64_t key)
+{
+/* Mutation of one individual with the stream 'key'. From
+   FLOAT_DENSE_RATE on, every gene draws it's random number (vectorized
+   loop), the mutated ones are gathered by blocks of FLOAT_MUTATE_BLOCK
+   and only those are computed (vectorized loop too). Rates from
+   1 / FLOAT_GATHER_RATIO on, and blocks where as many genes mutate,
+   compute all the genes ('float_mutate_block'). Lower rates only visit
+   the mutated genes. All apply the same per gene operator. */
+    int j, k, first, last, n_hits, length = pop->length;
+    int genes[FLOAT_MUTATE_BLOCK], hits[FLOAT_MUTATE_BLOCK];
+    float mutated[FLOAT_MUTATE_BLOCK];
+    const float *lower = pop->lower, *upper = pop->upper;
+    /* Genes with the 18 highest random bits below 'threshold' are
+       mutated. */
+    int32_t threshold = (int32_t) (mutate_rate * 262144.0f);
+    /* The gaps have their own stream (the genes use the counters of
+       'key'). */
+    uint64_t rng = hash_mix64(key);
+    double log_keep;
+
+    if (mutate_rate < FLOAT_DENSE_RATE)
+    {
+        log_keep = log(1.0 - (double) mutate_rate);
+        for (j = float_next_mutation(-1, mutate_rate, log_keep, &rng);
+             j < length;
+             j = float_next_mutation(j, mutate_rate, log_keep, &rng))
+        {
+            if (mutate_code == FMUTATE_GAUSSIAN)
+                row[j] = float_gaussian_gene(row[j], lower[j], upper[j],
+                                             param, float_rng_at(key, j));
+            else
+                row[j] = float_polynomial_gene(row[j], lower[j], upper[j],
+                                               param, float_rng_at(key, j));
+        }
+        return;
+    }
+    if (mutate_rate >= 1.0f)
+        threshold = 262144;
+    if (mutate_rate * FLOAT_GATHER_RATIO >= 1.0f)
+    {
+        float_mutate_block(mutate_code, param, row, lower, upper,
+                           threshold, 0, length, key);
+        return;
+    }
+    for (first = 0; first < length; first += FLOAT_MUTATE_BLOCK)
+    {
+        last = (length - first < FLOAT_MUTATE_BLOCK) ? length
+               : first + FLOAT_MUTATE_BLOCK;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (j = first; j < last; j++)
+        {
+            hits[j - first] = ((int32_t) (float_rng_at(key, j) >> 46)
+                               < threshold);
+        }
+        /* Branchless compaction of the mutated genes. */
+        n_hits = 0;
+        for (j = first; j < last; j++)
+        {
+            genes[n_hits] = j;
+            n_hits += hits[j - first];
+        }
+        if (n_hits * FLOAT_GATHER_RATIO > last - first)
+        {
+            /* Most genes mutate: all of them are computed and the
+               mutated ones selected (no gathers). */
+            float_mutate_block(mutate_code, param, row, lower, upper,
+                               threshold, first, last, key);
+            continue;
+        }
+        if (mutate_code == FMUTATE_GAUSSIAN)
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (k = 0; k < n_hits; k++)
+            {
+                int gene = genes[k];
+
+                mutated[k] = float_gaussian_gene(row[gene], lower[gene],
+                                                 upper[gene], param,
+                                                 float_rng_at(key, gene));
+            }
+        }
+        else
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (k = 0; k < n_hits; k++)
+            {
+                int gene = genes[k];
+
+                mutated[k] = float_polynomial_gene(row[gene], lower[gene],
+                                                   upper[gene], param,
+                                                   float_rng_at(key, gene));
+            }
+        }
+        for (k = 0; k < n_hits; k++)
+        {
+            row[genes[k]] = mutated[k];
+        }
+    }
+}
+
+void
+float_crossover(char *cross_mode, struct FloatPopulation *pop,
+                float **parents, float **childs, int n_parents)
+{
+/* This function applies crossover to each pair of consecutive
+   '**parents' (an odd last parent is copied), writing as many
+   '**childs'. Childs are kept within the gene boundaries.
+   =ARGUMENTS=
+   - '*cross_mode' : - 'sbx[:eta]' : Simulated binary crossover (Deb's
+                                     bounded version) with distribution
+                                     index eta (FLOAT_SBX_ETA by
+                                     default), applied to every gene.
+                     - 'blx[:alpha]' : Blend crossover, each gene uniform
+                                       in the parents interval extended
+                                       by alpha times it's length on
+                                       both sides (FLOAT_BLX_ALPHA by
+                                       default), reflected into bounds.
+                     - 'arithmetic' : Whole arithmetic crossover, childs
+                                      l * p1 + (1 - l) * p2 and
+                                      (1 - l) * p1 + l * p2 with one
+                                      uniform l per pair.
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '**parents' : Pointer of 'n_parents' individuals.
+   - '**childs' : Pointer of 'n_parents' rows of 'length' floats.
+   - 'n_parents' : Number of parents. */
+    int i, cross_code;
+    float param;
+    uint64_t seed;
+
+    cross_code = float_cross_code(pop, cross_mode, &param);
+    seed = rng_next(&pop->rng_state);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_parents - 1; i += 2)
+    {
+        float_cross_pair(pop, cross_code, param, parents[i], parents[i + 1],
+                         childs[i], childs[i + 1],
+                         float_block_stream(seed, i / 2));
+    }
+    if (n_parents % 2 == 1)
+        memcpy(childs[n_parents - 1], parents[n_parents - 1],
+               pop->length * sizeof(float));
+}
+
+void
+float_mutation(char *mutate_mode, struct FloatPopulation *pop,
+               float **new_individuals, int n_new_individuals,
+               float mutate_rate)
+{
+/* This function mutates each gene of the '**new_individuals' with
+   probability 'mutate_rate'. Mutated genes are kept within the gene
+   boundaries.
+   =ARGUMENTS=
+   - '*mutate_mode' : - 'gaussian[:sigma]' : Adds a normal deviate with
+                                             standard deviation sigma
+                                             times the gene range
+                                             (FLOAT_GAUSSIAN_SIGMA by
+                                             default), reflected into
+                                             bounds.
+                      - 'polynomial[:eta]' : Deb's polynomial mutation
+                                             with distribution index eta
+                                             (FLOAT_POLYNOMIAL_ETA by
+                                             default).
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '**new_individuals' : The individuals to be mutated.
+   - 'n_new_individuals' : Number of individuals.
+   - 'mutate_rate' : Probability of each gene to be mutated. */
+    int i, mutate_code;
+    float param;
+    uint64_t seed;
+
+    mutate_code = float_mutate_code(pop, mutate_mode, &param);
+    seed = rng_next(&pop->rng_state);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_new_individuals; i++)
+    {
+        float_mutate_row(pop, mutate_code, param, new_individuals[i],
+                         mutate_rate, float_block_stream(seed, i));
+    }
+}
+
+void
+float_ga_one_iter(struct FloatPopulation *pop,
+                  float (*objective_function)(), int tournament_size,
+                  char *cross_mode, int n_parents, int n_childs,
+                  char *mutate_mode, float mutate_rate)
+/* The purpose of this function is to apply a complete iteration of the
+   GA, as 'int_ga_one_iter': 'n_parents' tournaments, crossover and
+   mutation of each pair straight into the next generation (in
+   parallel, see 'float_set_n_threads'), elitism for the remaining
+   'n_population' - 'n_childs' individuals (not evaluated again) and
+   the evaluation of the new population.
+   =ARGUMENTS=
+   - '*pop' : pointer to an already evaluated FloatPopulation struct.
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'tournament_size' : How many competitors within each tournament.
+   - 'cross_mode' : See 'float_crossover'.
+   - 'n_parents' : Number of parents to be combined.
+   - 'n_childs' : Number of childs (<= n_parents and <= n_population).
+   - 'mutate_mode' : See 'float_mutation'.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+{
+    int i, cross_code, mutate_code, n_elites;
+    int *selected;
+    float cross_param, mutate_param, *elite_fos, *genes;
+    float **individuals;
+    uint64_t seed;
+
+    if (pop->first_population == POP_NOT_EVAL || n_childs < 0 ||
+        n_childs > n_parents || n_childs > pop->n_population)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'float_ga_one_iter' needs an evaluated population and\n"
+               "0 <= n_childs <= n_parents, n_childs <= n_population.\n"
+               "====================\n");
+        float_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    cross_code = float_cross_code(pop, cross_mode, &cross_param);
+    mutate_code = float_mutate_code(pop, mutate_mode, &mutate_param);
+
+    /* Parents by tournaments. */
+    selected = ec_malloc((n_parents + 1) * sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n_parents; i++)
+    {
+        selected[i] = float_tournament_index(pop, tournament_size);
+    }
+    /* An odd last child has it's sibling in the scratch row. */
+    selected[n_parents] = selected[0];
+    seed = rng_next(&pop->rng_state);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_childs; i += 2)
+    {
+        int last = (i + 1 == n_childs);
+        float *child2 = pop->next_individuals[last ? pop->n_population_alloc
+                                                   : i + 1];
+
+        float_cross_pair(pop, cross_code, cross_param,
+                         pop->individuals[selected[i]],
+                         pop->individuals[selected[i + 1]],
+                         pop->next_individuals[i], child2,
+                         float_block_stream(seed, i / 2));
+        float_mutate_row(pop, mutate_code, mutate_param,
+                         pop->next_individuals[i], mutate_rate,
+                         float_block_stream(seed, n_childs + i));
+        if (!last)
+            float_mutate_row(pop, mutate_code, mutate_param, child2,
+                             mutate_rate,
+                             float_block_stream(seed, n_childs + i + 1));
+    }
+    free(selected);
+
+    /* Elitism: the best individuals complete the next generation. */
+    n_elites = pop->n_population - n_childs;
+    elite_fos = ec_malloc((n_elites + 1) * sizeof(float), __LINE__, __FILE__);
+    for (i = 0; i < n_elites; i++)
+    {
+        memcpy(pop->next_individuals[n_childs + i],
+               pop->individuals[pop->sorted_fos_indexes[i]],
+               pop->length * sizeof(float));
+        elite_fos[i] = pop->fos[pop->sorted_fos_indexes[i]];
+    }
+    /* Swapping the generations. */
+    genes = pop->genes;
+    pop->genes = pop->next_genes;
+    pop->next_genes = genes;
+    individuals = pop->individuals;
+    pop->individuals = pop->next_individuals;
+    pop->next_individuals = individuals;
+    for (i = 0; i < pop->n_population; i++)
+    {
+        pop->eval_skip[i] = (i >= n_childs);
+        if (i >= n_childs)
+            pop->fos[i] = elite_fos[i - n_childs];
+    }
+    pop->n_eval_skip = n_elites;
+    free(elite_fos);
+
+    /* Evaluating the new individuals. */
+    float_evaluate_population(pop, objective_function);
+}
@@ -0,0 +1,314 @@
+/* This header defines a struct and functions to make easy
+   work with real valued (float) genetic algorithms, analogous to
+   GA_int: it declares the struct 'FloatPopulation' with the main
+   variables related to the algorithm and the same steps (init,
+   evaluation, selection, crossover, mutation and 'float_ga_one_iter').
+
+   The individuals of a population are the rows of one contiguous,
+   64 bytes aligned buffer, each row padded to FLOAT_LANES floats, and
+   the operators (SBX, BLX-alpha and arithmetic crossovers, gaussian and
+   polynomial mutations) are branch free loops over the genes, with one
+   counter based random number per gene, so the compiler vectorizes
+   them (compile GA_float.c with -O3, plus -march=native to use the
+   widest registers of the machine). */
+
+#ifndef GA_FLOAT_H
+#define GA_FLOAT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "../generals/generals.h"
+
+/* Same codes as GA_int.h (so both headers can be included). */
+#ifndef POP_NOT_EVAL
+#define POP_NOT_EVAL 1
+#define POP_EVALUATED 0
+#endif
+#ifndef PRINT_COMPLETE
+#define PRINT_COMPLETE 2
+#define PRINT_INDV 1
+#endif
+/* Rows of the individuals are padded to FLOAT_LANES floats (one
+   AVX-512 register) and batch objectives get up to FLOAT_BATCH
+   individuals per call (see 'float_set_batch_objective'). */
+#define FLOAT_LANES 16
+#define FLOAT_BATCH 64
+/* Crossover and mutation codes (see 'float_crossover' and
+   'float_mutation') and the default parameter of each operator. */
+#define FCROSS_SBX 0
+#define FCROSS_BLX 1
+#define FCROSS_ARITHMETIC 2
+#define FMUTATE_GAUSSIAN 0
+#define FMUTATE_POLYNOMIAL 1
+#define FLOAT_SBX_ETA 20.0f
+#define FLOAT_BLX_ALPHA 0.5f
+#define FLOAT_GAUSSIAN_SIGMA 0.1f
+#define FLOAT_POLYNOMIAL_ETA 20.0f
+/* Mutation rates from FLOAT_DENSE_RATE on are applied with one random
+   number per gene (vectorized), lower ones only visit the mutated
+   genes (geometric gaps, as GA_int). */
+#define FLOAT_DENSE_RATE 0.05f
+/* Dense mutations select the mutated genes by blocks of
+   FLOAT_MUTATE_BLOCK and only compute those, unless the rate or the
+   mutated part of a block is above 1 / FLOAT_GATHER_RATIO (see
+   'float_mutate_row'). */
+#define FLOAT_MUTATE_BLOCK 256
+#define FLOAT_GATHER_RATIO 2
+
+/*==========================*/
+/* The main struct for solving real valued GA. */
+struct FloatPopulation
+{
+/* FloatPopulation compose of 'n_population' individuals (solutions),
+   each one being an array of 'length' floats within the boundaries
+   of each gene. As IntPopulation, it's defined by
+   'float_init_population' and the evaluation related and 'all time
+   best' variables are computed by 'float_evaluate_population'. */
+
+    /* Solution boundaries: gene j is in [lower[j], upper[j]], which
+       are 'min_value' and 'max_value' unless defined otherwise with
+       'float_set_bounds'. */
+    int length;
+    float min_value, max_value;
+    float *lower, *upper;
+    /* Population data. Individual i is 'individuals[i]', the row i of
+       the 'genes' buffer ([n_population_alloc + 1][stride] floats,
+       64 bytes aligned, 'stride' being 'length' rounded up to
+       FLOAT_LANES). The pointers must not be changed: generations are
+       bred into 'next_genes' ('next_individuals') and swapped.
+       The last row of each buffer is scratch. */
+    char *init_mode;
+    int n_population, n_population_alloc, stride;
+    float *genes, *next_genes;
+    float **individuals, **next_individuals;
+    /* Evaluation related.
+       - 'best_fo' : best of all fo from this pop (minor).
+       - 'n_best_individuals' : Number of individuals with 'best_fo'.
+       - 'best_indexes' : The index (inside pop) of the best individuals.
+       - 'fos' : fo value for each individual.
+       - 'sorted_fos' : fo value sorted from best (minor) to worst.
+       - 'sorted_fos_indexes' : indexes for the fos in 'sorted_fos'. */
+    int n_best_individuals, *best_indexes;
+    float *fos, best_fo;
+    float *sorted_fos;
+    int *sorted_fos_indexes;
+    /* All time best fo and one individual with it. */
+    float best_fo_alltime;
+    float *best_indv_alltime;
+    /* To make sure a few variables are alloc'd only on 1st eval call. */
+    int first_population;
+    /* Iteration bookkeeping (updated by 'float_evaluate_population').
+       - 'generation' : Number of evaluations of this pop (0 = first one).
+       - 'n_evaluations' : Number of objective function calls.
+       - 'objective_function' : Last fo used.
+       - 'eval_skip' : Individuals with 'fos' already defined (elites),
+                       not evaluated by the next evaluation. */
+    int generation;
+    long n_evaluations;
+    float (*objective_function)();
+    int *eval_skip, n_eval_skip;
+    /* Batch evaluation (see 'float_set_batch_objective') or NULL. */
+    void (*batch_objective)();
+    /* Random stream of the pop (seeded with rand()) and number of
+       threads (see 'float_set_n_threads'). */
+    uint64_t rng_state;
+    int n_threads;
+};
+
+/*==========================*/
+/* Print functions. */
+void
+float_print_results(FILE *ptr, int print_mode,
+                    struct FloatPopulation *pop, int k);
+/* Simple function to print results of the current population
+   'pop' to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - 'print_mode': - PRINT_INDV : Only the best individual and the best
+                                  fo of the current pop are printed.
+                   - PRINT_COMPLETE : The best individual and all the
+                                      population are printed.
+   - '*pop' : An already evaluated FloatPopulation struct.
+   - 'k' : The current iteration. */
+
+void
+float_print_end_results(FILE *ptr, struct FloatPopulation *pop, int k);
+/* Simple function to print end results of the GA to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - '*pop' : An already evaluated FloatPopulation struct.
+   - 'k' : The last iteration. */
+
+/*==========================*/
+/* Population init, evaluation and free. */
+struct FloatPopulation
+*float_init_population(char *init_mode, int n_population, int length,
+                       float min_value, float max_value);
+/* This function returns an initalized FloatPopulation struct. It's the
+   first call in your program, defining the initial population. After
+   this you MUST evaluate the population with 'float_evaluate_population'.
+   =ARGUMENTS=
+   - '*init_mode' : - 'random' : Each gene uniform within it's bounds,
+                                 in parallel with all the OpenMP threads
+                                 (each individual with it's own random
+                                 stream).
+                    - 'empty'  : Individuals of 0s, to be defined by the
+                                 user (e.g. by a heuristic).
+   - 'n_population' : The number of individuals inside population (>= 2).
+   - 'length' : Length of the solution (number of genes).
+   - 'min_value', 'max_value' : Boundaries of every gene
+                                (min_value < max_value).
+   =RETURNS=
+   - 'pop' : A pointer to a FloatPopulation struct. */
+
+void
+float_set_bounds(struct FloatPopulation *pop, float *lower, float *upper);
+/* This function defines different boundaries for each gene,
+   [lower[j], upper[j]] (lower[j] < upper[j]). It must be called before
+   the first evaluation: random individuals are drawn again within the
+   new boundaries.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized (not
+              evaluated).
+   - '*lower', '*upper' : Arrays of 'length' boundaries (copied). */
+
+void
+float_set_n_threads(struct FloatPopulation *pop, int n_threads);
+/* Defines the number of threads used by the evaluation and the
+   operators (1 by default). It only has effect when compiled with
+   OpenMP ('-fopenmp'); with n_threads > 1 the objective function must
+   be thread safe. Childs are bred in pairs, each pair with it's own
+   random stream, so results don't depend on 'n_threads'. */
+
+void
+float_set_batch_objective(struct FloatPopulation *pop,
+                          void (*batch_function)());
+/* This function makes 'float_evaluate_population' evaluate the
+   population by blocks of up to FLOAT_BATCH consecutive individuals,
+   read in place from the 'genes' buffer, so objective functions can
+   work on several individuals per call (e.g. vectorizing across them).
+   The objective function passed to 'float_evaluate_population' is
+   still kept as the last one used, and both must give the same fos.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '(*batch_function)()' : Batch objective with inputs
+                             (float *genes, int stride, int n,
+                             int length, float *fos): gene j of the
+                             individual k of the block is
+                             'genes[k * stride + j]' and it's fo goes
+                             to 'fos[k]', k in [0, n). 'genes' is 64
+                             bytes aligned and 'stride' is a multiple of
+                             FLOAT_LANES. NULL goes back to single
+                             evaluations. */
+
+void
+float_evaluate_population(struct FloatPopulation *pop,
+                          float (*objective_function)());
+/* Evaluate a float population defining the struct variables:
+   - 'fos'
+   - 'best_fo'
+   - 'n_best_individuals'
+   - 'best_indexes'
+   - 'sorted_fos'
+   - 'sorted_fos_indexes'
+   - 'best_fo_alltime'
+   - 'best_indv_alltime'
+   It should be called after the generation of a population.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '(*objective_function)()' : A fo calculation with inputs:
+                                 - 'float *arr' : float solution array.
+                                 - 'int length' : length of 'arr'. */
+
+void
+float_free_population(struct FloatPopulation *pop);
+/* This function frees a FloatPopulation struct and all it's members.
+   It MUST be called in the end of your program to free heap memory.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized. */
+
+/*==========================*/
+/* GA operators. */
+float
+*float_tournament_selection(struct FloatPopulation *pop,
+                            int tournament_size);
+/* This function return the winner (float solution array) pointer
+   after a tournament inside the population.
+   =ARGUMENTS=
+   - '*pop' : A FloatPopulation struct already initialized AND
+              evaluated.
+   - 'tournament_size' : The number of competitors (with replacement).
+   =RETURNS=
+   - 'winner' : The individual with the minor fo of the tournament. */
+
+void
+float_crossover(char *cross_mode, struct FloatPopulation *pop,
+                float **parents, float **childs, int n_parents);
+/* This function applies crossover to each pair of consecutive
+   '**parents' (an odd last parent is copied), writing as many
+   '**childs'. Childs are kept within the gene boundaries.
+   =ARGUMENTS=
+   - '*cross_mode' : - 'sbx[:eta]' : Simulated binary crossover (Deb's
+                                     bounded version) with distribution
+                                     index eta (FLOAT_SBX_ETA by
+                                     default), applied to every gene.
+                     - 'blx[:alpha]' : Blend crossover, each gene uniform
+                                       in the parents interval extended
+                                       by alpha times it's length on
+                                       both sides (FLOAT_BLX_ALPHA by
+                                       default), reflected into bounds.
+                     - 'arithmetic' : Whole arithmetic crossover, childs
+                                      l * p1 + (1 - l) * p2 and
+                                      (1 - l) * p1 + l * p2 with one
+                                      uniform l per pair.
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '**parents' : Pointer of 'n_parents' individuals.
+   - '**childs' : Pointer of 'n_parents' rows of 'length' floats.
+   - 'n_parents' : Number of parents. */
+
+void
+float_mutation(char *mutate_mode, struct FloatPopulation *pop,
+               float **new_individuals, int n_new_individuals,
+               float mutate_rate);
+/* This function mutates each gene of the '**new_individuals' with
+   probability 'mutate_rate'. Mutated genes are kept within the gene
+   boundaries.
+   =ARGUMENTS=
+   - '*mutate_mode' : - 'gaussian[:sigma]' : Adds a normal deviate with
+                                             standard deviation sigma
+                                             times the gene range
+                                             (FLOAT_GAUSSIAN_SIGMA by
+                                             default), reflected into
+                                             bounds.
+                      - 'polynomial[:eta]' : Deb's polynomial mutation
+                                             with distribution index eta
+                                             (FLOAT_POLYNOMIAL_ETA by
+                                             default).
+   - '*pop' : A FloatPopulation struct already initialized.
+   - '**new_individuals' : The individuals to be mutated.
+   - 'n_new_individuals' : Number of individuals.
+   - 'mutate_rate' : Probability of each gene to be mutated. */
+
+void
+float_ga_one_iter(struct FloatPopulation *pop,
+                  float (*objective_function)(), int tournament_size,
+                  char *cross_mode, int n_parents, int n_childs,
+                  char *mutate_mode, float mutate_rate);
+/* The purpose of this function is to apply a complete iteration of the
+   GA, as 'int_ga_one_iter': 'n_parents' tournaments, crossover and
+   mutation of each pair straight into the next generation (in
+   parallel, see 'float_set_n_threads'), elitism for the remaining
+   'n_population' - 'n_childs' individuals (not evaluated again) and
+   the evaluation of the new population.
+   =ARGUMENTS=
+   - '*pop' : pointer to an already evaluated FloatPopulation struct.
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'tournament_size' : How many competitors within each tournament.
+   - 'cross_mode' : See 'float_crossover'.
+   - 'n_parents' : Number of parents to be combined.
+   - 'n_childs' : Number of childs (<= n_parents and <= n_population).
+   - 'mutate_mode' : See 'float_mutation'.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+
+#endif /* GA_FLOAT_H */
@@ -5,1021 +5,9226 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <float.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "GA_int.h"
 
 /*==========================*/
-/* externals from GA_int.h and globals. */
-extern int **ext_parents, **ext_childs, **ext_new_individuals, ext_ptrs_state;
-int **competitors, *winner, glb_compet_win_state;
+/* externals from GA_int.h (defined here) and globals. */
+int **ext_parents, **ext_childs, **ext_new_individuals, ext_ptrs_state;
+
+/* Header (first page) of the memory mapped storage file. */
+struct IntMmapHeader
+{
+    char magic[8];
+    int length, n_rows, min_value, max_value, non_repeatable;
+    int n_population, current, generation;
+    int hof_size; /* Entries of the hall of fame (region MMAP_REGION_BEST). */
+    float best_fo_alltime;
+};
+#define MMAP_MAGIC "GACINT01"
+
+/* Start of the shared region of the fork evaluator pool (see
+   'int_set_fork_evaluator'): the queue is 'fork_tasks[next, n_tasks)'
+   and 'n_done' counts the individuals with their fo. */
+struct IntForkControl
+{
+    float (*objective_function)();
+    int n_tasks, next, n_done;
+};
+
+/* Pair used to rank the population by fo. */
+struct IntRank
+{
+    float fo;
+    int index;
+};
+
+/* Point sorted by 'int_nondominated_sort'. */
+struct IntMoPoint
+{
+    float *objs; /* 'n_objectives' contiguous objectives. */
+    int n_objectives;
+    int index;
+};
 
 /*==========================*/
 /* Local source functions prototypes. */
 int
 compare (const void *a, const void *b);
 
+int
+compare_ranks(const void *a, const void *b);
+
+int
+compare_mo_points(const void *a, const void *b);
+
+void
+int_update_ranking(struct IntPopulation *pop);
+
+int
+**int_realloc_rows(int **rows, int old_n_rows, int new_n_rows, int length);
+
+void
+int_resize_ext_ptrs(struct IntPopulation *pop, int new_n_rows);
+
+void
+int_set_population_alloc(struct IntPopulation *pop, int new_n_alloc);
+
+int
+int_scale_to_pop(struct IntPopulation *pop, int n);
+
+int
+int_update_alltime(struct IntPopulation *pop);
+
+int
+compare_hashes(const void *a, const void *b);
+
+uint64_t
+int_gene_hash(int locus, int value);
+
+void
+int_locus_count(struct IntPopulation *pop, int locus, int value,
+                int delta);
+
+void
+int_diversity_replace(struct IntPopulation *pop, int index,
+                      int *new_individual, int copy);
+
+void
+int_diversity_stats(struct IntPopulation *pop);
+
+int
+int_apply_stagnation(struct IntPopulation *pop, char *mutate_mode);
+
+int
+int_tracks_hashes(struct IntPopulation *pop);
+
+void
+int_init_dedup_buffers(struct IntPopulation *pop);
+
+struct IntGenomeEntry
+*int_genome_lookup(struct IntPopulation *pop, uint64_t hash, int *genome);
+
+int
+int_dedup_change(struct IntPopulation *pop, int *child, uint64_t *hash,
+                 char *mutate_mode);
+
+void
+int_dedup_childs(struct IntPopulation *pop, char *mutate_mode,
+                 int **childs, int n_childs, int hashes_known);
+
+int
+*int_mmap_row(struct IntPopulation *pop, int region, int row);
+
+void
+int_mmap_advise(struct IntPopulation *pop, int *row, int n_rows,
+                int advice);
+
+void
+int_mmap_set_current(struct IntPopulation *pop, int region);
+
+void
+int_mmap_write_header(struct IntPopulation *pop);
+
+void
+int_map_population(struct IntPopulation *pop, char *path, int remap);
+
+void
+int_unmap_population(struct IntPopulation *pop);
+
+void
+int_fork_spawn(struct IntPopulation *pop, int w);
+
+void
+int_fork_worker(struct IntPopulation *pop, int w, int wake_fd);
+
+int
+int_fork_claim(struct IntPopulation *pop, int w);
+
+void
+int_fork_wake(struct IntPopulation *pop, int w);
+
+void
+int_fork_restart(struct IntPopulation *pop, int w);
+
+long
+int_fork_evaluate(struct IntPopulation *pop, int start, int end,
+                  float (*objective_function)());
+
+void
+int_fork_stop(struct IntPopulation *pop);
+
+double
+int_process_clock(void);
+
+void
+int_process_spawn(struct IntPopulation *pop, int k);
+
+void
+int_process_kill(struct IntPopulation *pop, int k);
+
+int
+int_process_next(struct IntPopulation *pop, int *next, int end);
+
+size_t
+int_process_encode(struct IntPopulation *pop, int *arr, char *out);
+
+int
+int_process_send(struct IntPopulation *pop, int k, int *next, int end);
+
+int
+int_process_receive(struct IntPopulation *pop, int k, int *n_done);
+
+int
+int_process_fail(struct IntPopulation *pop, int k);
+
+long
+int_process_evaluate(struct IntPopulation *pop, int start, int end);
+
+void
+int_process_stop(struct IntPopulation *pop);
+
+void
+int_surrogate_free(struct IntPopulation *pop);
+
+void
+int_surrogate_fit(struct IntPopulation *pop);
+
+float
+int_surrogate_predict(struct IntPopulation *pop, int *arr);
+
+void
+int_surrogate_screen(struct IntPopulation *pop, char *cross_mode,
+                     char *mutate_mode, float mutate_rate,
+                     float select_param, int *selected, int n_parents,
+                     int n_childs);
+
+void
+int_surrogate_ranks(struct IntRank *items, int n, float *ranks);
+
+void
+int_surrogate_collect(struct IntPopulation *pop);
+
+int
+compare_longs(const void *a, const void *b);
+
+void
+int_copy_parents(struct IntPopulation *pop, int *indexes, int n_parents);
+
+int
+int_ls_apply(struct IntPopulation *pop, int *work, int a, int b);
+
+float
+int_ls_delta(struct IntPopulation *pop, float (*objective_function)(),
+             int *work, float fo, int a, int b);
+
+float
+int_ls_climb(struct IntPopulation *pop, float (*objective_function)(),
+             int *work, float fo, uint64_t *rng, long *n_evals);
+
+void
+int_local_search(struct IntPopulation *pop, float (*objective_function)());
+
+void
+int_gm_alloc(struct IntPopulation *pop);
+
+void
+int_gm_transpose(struct IntPopulation *pop, int first, int last,
+                 int padded_last);
+
+long
+int_evaluate_batch(struct IntPopulation *pop, int start, int end);
+
+void
+int_hof_alloc(struct IntPopulation *pop, int capacity);
+
+void
+int_hof_free(struct IntPopulation *pop);
+
+uint64_t
+int_hof_hash(struct IntPopulation *pop, int *arr);
+
+int
+int_hof_table_find(struct IntPopulation *pop, int *arr, uint64_t hash);
+
+void
+int_hof_table_remove(struct IntPopulation *pop, int slot);
+
+void
+int_hof_sift(struct IntPopulation *pop, int pos);
+
+void
+int_hof_index(struct IntPopulation *pop, int slot, float fo, uint64_t hash);
+
+int
+int_hof_offer(struct IntPopulation *pop, int *arr, float fo,
+              uint64_t hash);
+
+void
+int_hof_restore(struct IntPopulation *pop, int n_restored,
+                float (*objective_function)());
+
+void
+int_hof_update_best(struct IntPopulation *pop);
+
+int
+int_cell_neighbors(struct IntPopulation *pop, int cell, int *neighbors);
+
+int
+int_cell_update(struct IntPopulation *pop, int cell, int cross_code,
+                int mutate_code, float mutate_rate, int tournament_size,
+                float (*objective_function)(), uint64_t *rng);
+
+void
+int_accept_child(struct IntPopulation *pop, int i);
+
+void
+int_adopt_known_fos(struct IntPopulation *pop,
+                    float (*objective_function)(), char *mutate_mode,
+                    long n_evaluated);
+
+int
+compare_niche_pairs(const void *a, const void *b);
+
+void
+int_init_niche_buffers(struct IntPopulation *pop);
+
+void
+int_niche_push(struct IntNichePair **pairs, long *n_pairs, long *cap,
+               int i, int j, int distance, float weight);
+
+long
+int_niche_exact_pairs(struct IntPopulation *pop);
+
+long
+int_niche_lsh_pairs(struct IntPopulation *pop);
+
+void
+int_niche_clearing(struct IntPopulation *pop, long *first, int *adjacency);
+
+float
+*int_select_fos(struct IntPopulation *pop);
+
+int
+*int_select_order(struct IntPopulation *pop);
+
+double
+int_run_clock(void);
+
+int
+int_run_check(struct IntPopulation *pop, long n_evaluations,
+              double last_seconds, long last_evaluations);
+
+void
+int_cow_alloc(struct IntPopulation *pop);
+
+struct IntRowRef
+*int_cow_find(struct IntPopulation *pop, int *row, int insert);
+
+void
+int_cow_add_ref(struct IntPopulation *pop, int *row);
+
+int
+int_cow_release(struct IntPopulation *pop, int *row);
+
+int
+*int_cow_new_row(struct IntPopulation *pop);
+
+void
+int_cow_spare_row(struct IntPopulation *pop, int *row);
+
+void
+int_cow_private(struct IntPopulation *pop, int **row);
+
+void
+int_unshare_rows(struct IntPopulation *pop);
+
+void
+int_share_rows(struct IntPopulation *pop);
+
+void
+int_cow_plan_childs(struct IntPopulation *pop, int *selected,
+                    int n_childs, float mutate_rate, uint64_t seed);
+
+void
+int_cow_fill_rows(struct IntPopulation *pop);
+
+void
+int_cow_free_spare(struct IntPopulation *pop);
+
+void
+int_cow_breed_twin(struct IntPopulation *pop, int mutate_code,
+                   float mutate_rate, int *parent, int *child,
+                   uint64_t *hash, uint64_t *rng);
+
+void
+int_block_alloc(struct IntPopulation *pop);
+
+void
+int_block_compare(struct IntPopulation *pop, unsigned char *codes,
+                  int *parent, int *child);
+
+void
+int_block_resolve(struct IntPopulation *pop, int k, int own, int other);
+
+void
+int_block_swap(struct IntPopulation *pop);
+
+long
+int_evaluate_blocks(struct IntPopulation *pop, int start, int end);
+
+void
+int_mo_alloc(struct IntPopulation *pop);
+
+void
+int_mo_free(struct IntPopulation *pop);
+
+long
+int_mo_evaluate(struct IntPopulation *pop, int **rows, int first, int n);
+
+int
+*int_mo_fronts(int *rank, int n, int n_fronts, int *start);
+
+int
+int_mo_rank(struct IntPopulation *pop, int n);
+
+int
+int_mo_tournament(struct IntPopulation *pop, int tournament_size,
+                  uint64_t *rng);
+
+void
+int_mo_select(struct IntPopulation *pop);
+
+int
+int_mo_update_archive(struct IntPopulation *pop);
+
+void
+int_mo_finish(struct IntPopulation *pop);
+
+int
+int_select_mode_code(char *select_mode);
+
+int
+int_tournament_draw(struct IntPopulation *pop, int tournament_size,
+                    uint64_t *rng);
+
+void
+int_init_select_buffers(struct IntPopulation *pop);
+
+void
+int_build_alias(struct IntPopulation *pop);
+
+int
+int_alias_draw(struct IntPopulation *pop, uint64_t *rng);
+
+void
+int_selection_weights(struct IntPopulation *pop, int select_mode,
+                      float select_param);
+
+void
+int_select_indexes(struct IntPopulation *pop, int select_mode,
+                   float select_param, int *indexes, int n_select);
+
+uint64_t
+int_block_stream(uint64_t seed, int block);
+
+void
+int_init_breed_buffers(struct IntPopulation *pop);
+
+int
+*int_thread_scratch(struct IntPopulation *pop);
+
+unsigned char
+*int_scratch_marks(struct IntPopulation *pop, int *scratch, int child);
+
+int
+int_next_mutation(int j, float mutate_rate, double log_keep,
+                  uint64_t *rng);
+
+void
+int_repair_marked(struct IntPopulation *pop, int *child, int *repeated,
+                  int n_repeated, unsigned char *marks, int *missing,
+                  uint64_t *hash, uint64_t *rng);
+
+void
+int_repair_child(struct IntPopulation *pop, int *child, int *scratch,
+                 uint64_t *rng);
+
+int
+int_subset_table_size(int length);
+
+int
+int_subset_insert(struct IntPopulation *pop, int *table, int mask,
+                  int value);
+
+int
+int_subset_contains(int *arr, int n, int value);
+
+void
+int_subset_cross(struct IntPopulation *pop, int *parent1, int *parent2,
+                 int *child1, int *child2, uint64_t *rng);
+
+int
+int_subset_replace(struct IntPopulation *pop, int *child, int *positions,
+                   int n_positions, int *scratch, uint64_t *rng);
+
+void
+int_subset_mutate(struct IntPopulation *pop, int *child, float mutate_rate,
+                  int *scratch, uint64_t *rng);
+
+void
+int_cross_pair(struct IntPopulation *pop, int cross_code,
+               int *parent1, int *parent2, int *child1, int *child2,
+               uint64_t *rng);
+
+void
+int_mutate_child(struct IntPopulation *pop, int mutate_code, int *child,
+                 float mutate_rate, uint64_t *rng);
+
+int
+int_cross_mode_code(struct IntPopulation *pop, char *cross_mode,
+                    int n_parents);
+
+int
+int_mutate_mode_code(struct IntPopulation *pop, char *mutate_mode);
+
+void
+int_cross_points(struct IntPopulation *pop, int cross_code, int *k1,
+                 int *k2, uint64_t *rng);
+
+void
+int_breed_pair(struct IntPopulation *pop, int cross_code, int mutate_code,
+               float mutate_rate, int *parent1, int *parent2,
+               int *child1, int *child2, uint64_t *hash1, uint64_t *hash2,
+               unsigned char *blocks1, unsigned char *blocks2,
+               int *scratch, uint64_t *rng);
+
+void
+int_breed(struct IntPopulation *pop, char *cross_mode, char *mutate_mode,
+          float mutate_rate, int *selected, int n_parents, int n_childs);
+
+int
+int_adopt_childs(struct IntPopulation *pop, int n_childs);
+
+void
+int_init_competitors_winner(struct IntPopulation *pop);
+
+void
+int_init_solution_rng(struct IntPopulation *pop, int *arr, uint64_t *rng);
+
+void
+int_init_individuals(struct IntPopulation *pop, int **rows, int n_rows,
+                     int n_threads);
+
+int
+int_read_individuals(struct IntPopulation *pop, char *path, int **rows,
+                     int max_rows);
+
+int
+int_init_n_threads(void);
+
+void
+int_free_competitors_winner(struct IntPopulation *pop);
+
+/*==========================*/
+/* Miscellanous functions. */
+int
+compare (const void *a, const void *b)
+{
+    /* To use in qsort (no overflow for distant values). */
+    int ia = *(const int*)a, ib = *(const int*)b;
+
+    return (ia > ib) - (ia < ib);
+}
+
+int
+compare_longs(const void *a, const void *b)
+{
+    /* To use in qsort with long long values. */
+    long long la = *(const long long*)a, lb = *(const long long*)b;
+
+    return (la > lb) - (la < lb);
+}
+
+int
+compare_ranks(const void *a, const void *b)
+{
+    /* To use in qsort: by fo (minor first) and then by index,
+       so tied individuals keep their population order. */
+    const struct IntRank *ra = a, *rb = b;
+
+    if (ra->fo < rb->fo)
+        return -1;
+    if (ra->fo > rb->fo)
+        return 1;
+    return ra->index - rb->index;
+}
+
+int
+compare_mo_points(const void *a, const void *b)
+{
+    /* To use in qsort: lexicographic order of the objectives and then
+       by index. */
+    const struct IntMoPoint *pa = a, *pb = b;
+    int m;
+
+    for (m = 0; m < pa->n_objectives; m++)
+    {
+        if (pa->objs[m] < pb->objs[m])
+            return -1;
+        if (pa->objs[m] > pb->objs[m])
+            return 1;
+    }
+    return pa->index - pb->index;
+}
+
+int
+compare_niche_pairs(const void *a, const void *b)
+{
+    /* To use in qsort: by the first and then by the second individual
+       of the pairs. */
+    const struct IntNichePair *pa = a, *pb = b;
+
+    if (pa->i != pb->i)
+        return (pa->i > pb->i) - (pa->i < pb->i);
+    return (pa->j > pb->j) - (pa->j < pb->j);
+}
+
+int
+compare_hashes(const void *a, const void *b)
+{
+    /* To use in qsort with uint64_t hashes. */
+    uint64_t ha = *(const uint64_t*)a, hb = *(const uint64_t*)b;
+
+    return (ha > hb) - (ha < hb);
+}
+
+uint64_t
+int_gene_hash(int locus, int value)
+{
+/* Hash of one gene. The hash of an individual is the XOR of the hashes
+   of all it's genes (Zobrist like), so changing one gene only needs
+   two XORs to update it. */
+    return hash_mix64(((uint64_t) (unsigned int) locus << 32)
+                      | (uint64_t) (unsigned int) value);
+}
+
+int
+**int_realloc_rows(int **rows, int old_n_rows, int new_n_rows, int length)
+{
+/* Resizes a pointer of int pointers with shape [old_n_rows][length]
+   to [new_n_rows][length]. Removed rows are free'd and new rows
+   are calloc'd. */
+    int i;
+
+    for (i = new_n_rows; i < old_n_rows; i++)
+    {
+        free(rows[i]);
+    }
+    rows = realloc(rows, new_n_rows * sizeof(int*));
+    check_null(rows, __LINE__, __FILE__);
+    for (i = old_n_rows; i < new_n_rows; i++)
+    {
+        rows[i] = ec_calloc(length, sizeof(int), __LINE__, __FILE__);
+    }
+    return rows;
+}
+
+/*==========================*/
+/* Print functions. */
+void
+print_results(FILE *ptr, int print_mode,
+                struct IntPopulation *pop, int k)
+{
+/* Simple function to print results of the current population
+   'pop' to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - 'print_mode': An integer that says how the results should be printed:
+                   - '1' : Only the best individual and the best fo
+                           of the current pop should be printed.
+                   - '2' : The best individual and all the population
+                           is printed.
+   - '*pop' : An already evaluated IntPopulation struct.
+   - 'k' : The current iteration. */
+    int i, j;
+
+    /* Basic function to print results to ptr file. */
+    fprintf(ptr, "\n===POPULATION GEN %d===\n", k);
+    if (print_mode == PRINT_COMPLETE)
+    {
+        for (i = 0; i < pop->n_population; i++)
+        {
+            fprintf(ptr, "[ ");
+            for (j = 0; j < pop->length; j++)
+            {
+                fprintf(ptr, "%d ", pop->individuals[i][j]);
+            }
+            fprintf(ptr, "]\n");
+        }
+    }
+    if (print_mode == PRINT_INDV || print_mode == PRINT_COMPLETE)
+    {
+        fprintf(ptr, "Best individual(s) found in the population:\n");
+        for (i = 0; i < pop->n_best_individuals; i++)
+        {
+            fprintf(ptr, "[ ");
+            for (j = 0; j < pop->length; j++)
+            {
+                fprintf(ptr, "%d ", pop->individuals[
+                                        pop->best_indexes[i]][j]);
+            }
+            fprintf(ptr, "]\n");
+        }
+        fprintf(ptr, "The best fo for this population is: %.8f\n",
+                pop->best_fo);
+    }
+}
+
+void
+print_end_results(FILE *ptr, struct IntPopulation *pop, int k)
+{
+/* Simple function to print end results of the GA to an external file.
+   =ARGUMENTS=
+   - '*ptr' : A FILE pointer.
+   - '*pop' : An already evaluated IntPopulation struct.
+   - 'k' : The last iteration. */
+    int i, j;
+
+    fprintf(ptr,
+        "\n\nAfter %d iterations this is the best fo found!!"
+        " Good for you!\n", k);
+    fprintf(ptr,
+        "Best individual(s) found through all iters:\n");
+    for (i = 0; i < pop->n_best_indv_alltime; i++)
+    {
+        fprintf(ptr, "[ ");
+        for (j = 0; j < pop->length; j++)
+        {
+            fprintf(ptr, "%d ", pop->best_indv_alltime[i][j]);
+        }
+        fprintf(ptr, "]\n");
+    }
+    fprintf(ptr,
+            "The best fo value found through all iters: %.8f\n",
+            pop->best_fo_alltime);
+}
+
+/*==========================*/
+/* Functions for allocation of useful pointers. */
+void
+int_init_ext_ptrs(struct IntPopulation *pop)
+{
+/* Function to alloc the external pointers:
+   - 'ext_parents'
+   - 'ext_childs'
+   - 'ext_individuals'
+   These pointers are used in 'ga_one_iter' function, but can
+   also be used by the user in his own GA steps'
+   The rows belong to the pop ('pop->ext_parents', ...), they are
+   alloc'd once and the externals point to the ones of the last pop
+   passed here, so several pops can live in the same program.
+   =ARGUMENTS=
+   - '*pop' : A pointer to an IntPopulation struct. */
+    int i;
+
+    if (pop->ext_rows == 0)
+    {
+        pop->ext_rows = pop->n_population_alloc;
+        pop->ext_parents = ec_calloc(pop->ext_rows, sizeof(int*),
+            __LINE__, __FILE__);
+        pop->ext_childs = ec_calloc(pop->ext_rows, sizeof(int*),
+            __LINE__, __FILE__);
+        pop->ext_new_individuals = ec_calloc(pop->ext_rows, sizeof(int*),
+            __LINE__, __FILE__);
+        for (i = 0; i < pop->ext_rows && pop->storage == STORAGE_MMAP; i++)
+        {
+            /* Rows inside the mapped file. */
+            pop->ext_new_individuals[i] = int_mmap_row(pop,
+                                              1 - pop->mmap_current, i);
+            pop->ext_parents[i] = int_mmap_row(pop, MMAP_REGION_PARENTS, i);
+            pop->ext_childs[i] = int_mmap_row(pop, MMAP_REGION_CHILDS, i);
+        }
+        for (i = 0; i < pop->ext_rows && pop->storage == STORAGE_HEAP; i++)
+        {
+            pop->ext_new_individuals[i] = ec_calloc(pop->length, sizeof(int),
+                __LINE__, __FILE__);
+            pop->ext_parents[i] = ec_calloc(pop->length, sizeof(int),
+                __LINE__, __FILE__);
+            pop->ext_childs[i] = ec_calloc(pop->length, sizeof(int),
+                __LINE__, __FILE__);
+        }
+    }
+    ext_parents = pop->ext_parents;
+    ext_childs = pop->ext_childs;
+    ext_new_individuals = pop->ext_new_individuals;
+    ext_ptrs_state = PTR_ALLOCD;
+}
+
+void
+int_init_competitors_winner(struct IntPopulation *pop)
+{
+/* Function to alloc 'pop->winner', the row used by
+   'int_tournament_selection' to keep number of allocations constant.
+   Since the tournament works with indexes (see 'int_tournament_index'),
+   only the winner is copied. Each pop has it's own row (of it's
+   length).
+   =ARGUMENTS=
+   - '*pop' : A pointer to an IntPopulation struct. */
+    if (pop->winner == NULL)
+        pop->winner = ec_calloc(pop->length, sizeof(int),
+                                __LINE__, __FILE__);
+}
+
+void
+int_resize_ext_ptrs(struct IntPopulation *pop, int new_n_rows)
+{
+/* Function to resize the external pointers to 'new_n_rows' rows,
+   following a population resize. Nothing is done if they
+   are not alloc'd.
+   =ARGUMENTS=
+   - '*pop' : A pointer to an IntPopulation struct.
+   - 'new_n_rows' : The new number of rows. */
+    int bound = (ext_ptrs_state == PTR_ALLOCD &&
+                 ext_parents == pop->ext_parents);
+
+    if (pop->ext_rows > 0 && new_n_rows != pop->ext_rows)
+    {
+        pop->ext_parents = int_realloc_rows(pop->ext_parents, pop->ext_rows,
+                                            new_n_rows, pop->length);
+        pop->ext_childs = int_realloc_rows(pop->ext_childs, pop->ext_rows,
+                                           new_n_rows, pop->length);
+        pop->ext_new_individuals = int_realloc_rows(pop->ext_new_individuals,
+                                                    pop->ext_rows,
+                                                    new_n_rows,
+                                                    pop->length);
+        pop->ext_rows = new_n_rows;
+        if (bound)
+            int_init_ext_ptrs(pop);
+    }
+}
+
+/*==========================*/
+/* Functions to free the useful pointers and population. */
+void
+int_free_ext_ptrs(struct IntPopulation *pop)
+{
+/* Function to free alloc'd external pointers:
+   - 'ext_parents'
+   - 'ext_childs'
+   - 'ext_individuals'
+   These pointers are used in 'ga_one_iter' function, but can
+   also be used by the user in his own GA steps'
+   If the externals point to the rows of 'pop', they go back to NULL
+   (PTR_NOT_ALLOCD).
+   =ARGUMENTS=
+   - '*pop' : A pointer to an IntPopulation struct. */
+    int i;
+
+    if (pop->ext_rows == 0)
+        return;
+    if (ext_ptrs_state == PTR_ALLOCD && ext_parents == pop->ext_parents)
+    {
+        ext_parents = NULL;
+        ext_childs = NULL;
+        ext_new_individuals = NULL;
+        ext_ptrs_state = PTR_NOT_ALLOCD;
+    }
+    /* Rows inside the mapped file are not free'd. */
+    for (i = 0; i < pop->ext_rows && pop->storage == STORAGE_HEAP; i++)
+    {
+        free(pop->ext_new_individuals[i]);
+        free(pop->ext_childs[i]);
+        free(pop->ext_parents[i]);
+    }
+    free(pop->ext_new_individuals);
+    free(pop->ext_childs);
+    free(pop->ext_parents);
+    pop->ext_parents = NULL;
+    pop->ext_childs = NULL;
+    pop->ext_new_individuals = NULL;
+    pop->ext_rows = 0;
+}
+
+void
+int_free_competitors_winner(struct IntPopulation *pop)
+{
+/* Function to free 'pop->winner' (see 'int_init_competitors_winner').
+   =ARGUMENTS=
+   - '*pop' : A pointer to an IntPopulation struct. */
+    free(pop->winner);
+    pop->winner = NULL;
+}
+
+void
+int_free_population(struct IntPopulation *pop)
+{
+/* This function frees an IntPopulation struct and all it's members.
+   It MUST be called in the end of your program to free heap memory.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated. */
+    int i;
+
+    int_fork_stop(pop);
+    int_process_stop(pop);
+    int_free_competitors_winner(pop);
+    int_free_ext_ptrs(pop);
+
+    if (pop->non_repeatable == NO_REPEAT)
+        free(pop->reference_arr);
+
+    if (pop->storage == STORAGE_MMAP)
+    {
+        /* Only the row pointers are alloc'd. */
+        free(pop->individuals);
+    }
+    else if (strcmp(pop->init_mode, "unalloc") != 0)
+    {
+        /* No allocation for these members in this init_mode. Shared
+           rows (see 'int_set_genome_sharing') are free'd with their
+           last reference. */
+        for (i = 0; i < pop->n_population_alloc; i++)
+        {
+            if (int_cow_release(pop, pop->individuals[i]))
+                free(pop->individuals[i]);
+        }
+        free(pop->individuals);
+    }
+    if (pop->first_population == POP_EVALUATED)
+    {
+        /* Only if the population was evaluated. */
+        int_hof_free(pop);
+        free(pop->best_indexes);
+        free(pop->fos);
+        free(pop->sorted_fos_indexes);
+        free(pop->sorted_fos);
+    }
+    free(pop->locus_counts);
+    free(pop->clogc_table);
+    free(pop->hashes);
+    free(pop->parent_indexes);
+    free(pop->eval_skip);
+    free(pop->child_hashes);
+    free(pop->next_fos);
+    free(pop->next_fo_known);
+    free(pop->genome_table);
+    free(pop->select_prob);
+    free(pop->select_alias);
+    free(pop->select_work);
+    for (i = 0; i < pop->breed_rows; i++)
+    {
+        free(pop->breed_scratch[i]);
+    }
+    free(pop->breed_scratch);
+    for (i = 0; i < pop->ls_rows; i++)
+    {
+        free(pop->ls_work[i]);
+    }
+    free(pop->ls_work);
+    free(pop->ls_targets);
+    free(pop->ls_fos);
+    free(pop->gm_genes);
+    int_mo_free(pop);
+    free(pop->niche_fos);
+    free(pop->niche_counts);
+    free(pop->niche_order);
+    free(pop->niche_lsh_loci);
+    free(pop->niche_pairs);
+    free(pop->snap_genome);
+    int_cow_free_spare(pop);
+    free(pop->cow_spare);
+    free(pop->cow_clones);
+    free(pop->cow_table);
+    free(pop->block_scores);
+    free(pop->next_block_scores);
+    free(pop->block_dirty);
+    free(pop->next_block_dirty);
+    int_surrogate_free(pop);
+    if (pop->storage == STORAGE_MMAP)
+        int_unmap_population(pop);
+    free(pop);
+}
+
+/*==========================*/
+/* GA operators and related functions definition. */
+void
+int_init_solution(struct IntPopulation *pop, int *arr)
+{
+/* This functions fullfills an array with random values
+   within the pop boundaries.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct pointer with variables
+              length, min_value, max_value, non-repeatable,
+              range and reference array already defined.
+   - '*arr' : The array to be fullfilled with size pop->length. */
+    int_init_solution_rng(pop, arr, &pop->rng_state);
+}
+
+void
+int_init_solution_rng(struct IntPopulation *pop, int *arr, uint64_t *rng)
+{
+/* Same as 'int_init_solution' using the random stream '*rng'. */
+    int j, k, tmp_value, mask, n_values = 0;
+    int *shuff_reference_arr, *table;
+
+    if (pop->non_repeatable == SUBSET)
+    {
+        /* Floyd's sampling of 'length' distinct values out of 'range'
+           (a hash set of the drawn values, 'range' is never scanned),
+           kept sorted. */
+        mask = int_subset_table_size(pop->length) - 1;
+        table = ec_calloc(mask + 1, sizeof(int), __LINE__, __FILE__);
+        for (j = pop->range - pop->length; j < pop->range; j++)
+        {
+            tmp_value = (int) rng_bounded(rng, (uint32_t) j + 1);
+            if (int_subset_insert(pop, table, mask,
+                                  pop->min_value + tmp_value) < 0)
+            {
+                /* Already drawn, j never was. */
+                tmp_value = j;
+                int_subset_insert(pop, table, mask, pop->min_value + j);
+            }
+            arr[n_values++] = pop->min_value + tmp_value;
+        }
+        free(table);
+        qsort(arr, pop->length, sizeof(int), compare);
+    }
+    else if (pop->non_repeatable == NO_REPEAT && pop->length == pop->range)
+    {
+        /* A whole permutation: inside-out Fisher-Yates, written
+           straight into the array. */
+        for (j = 0; j < pop->length; j++)
+        {
+            k = (int) rng_bounded(rng, (uint32_t) j + 1);
+            if (k != j)
+                arr[j] = arr[k];
+            arr[k] = pop->reference_arr[j];
+        }
+    }
+    else if (pop->non_repeatable == NO_REPEAT)
+    {
+        /* Partial Fisher-Yates over a copy of 'reference_arr' (on the
+           heap, 'range' may be too big for the stack): only the
+           'length' first values are drawn. */
+        shuff_reference_arr = ec_malloc(sizeof(int) * pop->range,
+                                        __LINE__, __FILE__);
+        memcpy(shuff_reference_arr, pop->reference_arr,
+               sizeof(shuff_reference_arr[0]) * pop->range);
+        for (j = 0; j < pop->length; j++)
+        {
+            k = j + (int) rng_bounded(rng, (uint32_t) (pop->range - j));
+            arr[j] = shuff_reference_arr[k];
+            shuff_reference_arr[k] = shuff_reference_arr[j];
+        }
+        free(shuff_reference_arr);
+    }
+    else
+    {
+        /* If repeated values are accepted, the creation of
+           the solution array is very simple. */
+        for (j = 0; j < pop->length; j++)
+        {
+            tmp_value = (int) rng_bounded(rng, (uint32_t) pop->range);
+            tmp_value += pop->min_value;
+            arr[j] = tmp_value;
+        }
+    }
+}
+
+void
+int_init_individuals(struct IntPopulation *pop, int **rows, int n_rows,
+                     int n_threads)
+{
+/* Random individuals for the 'n_rows' arrays of '**rows', in parallel
+   with 'n_threads' threads (OpenMP). Each individual has it's own
+   random stream (derived from 'pop->rng_state'), so the results do
+   not depend on 'n_threads'. */
+    int i;
+    uint64_t seed = rng_next(&pop->rng_state);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(n_threads) schedule(static) \
+    if (n_threads > 1)
+#else
+    (void) n_threads;
+#endif
+    for (i = 0; i < n_rows; i++)
+    {
+        uint64_t rng = int_block_stream(seed, i);
+
+        int_init_solution_rng(pop, rows[i], &rng);
+    }
+}
+
+int
+int_init_n_threads(void)
+{
+/* Threads for the initial random individuals: all the OpenMP ones
+   (OMP_NUM_THREADS), as no user function is called. */
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+int
+int_read_individuals(struct IntPopulation *pop, char *path, int **rows,
+                     int max_rows)
+{
+/* Reads up to 'max_rows' individuals from the text file at '*path':
+   'length' integers per individual, separated by blanks (one
+   individual per line is advised). '[' and ']' are ignored, so the
+   output of 'print_results' can be used, and '#' starts a comment
+   until the end of the line. Individuals out of the pop boundaries
+   (or with repeated values in non-repeatable solutions) are errors.
+   SUBSET individuals are sorted.
+   =RETURNS=
+   - The number of individuals read. */
+    int c, j = 0, n_rows = 0, bad = 0;
+    unsigned char *seen = NULL;
+    FILE *file;
+
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Can't open the individuals file '%s'.\n"
+               "====================\n", path);
+        exit(EXIT_FAILURE);
+    }
+    if (pop->non_repeatable == NO_REPEAT)
+        seen = ec_calloc(pop->range, sizeof(unsigned char),
+                         __LINE__, __FILE__);
+    while (n_rows < max_rows && !bad && (c = fgetc(file)) != EOF)
+    {
+        if (c == '#')
+        {
+            while (c != '\n' && c != EOF)
+                c = fgetc(file);
+            continue;
+        }
+        if (c == '[' || c == ']' || c == ' ' || c == '\t' || c == '\n' ||
+            c == '\r' || c == ',')
+            continue;
+        ungetc(c, file);
+        if (fscanf(file, "%d", &rows[n_rows][j]) != 1 ||
+            rows[n_rows][j] < pop->min_value ||
+            rows[n_rows][j] > pop->max_value)
+        {
+            bad = 1;
+            break;
+        }
+        if (seen != NULL && seen[rows[n_rows][j] - pop->min_value]++)
+        {
+            bad = 1;
+            break;
+        }
+        if (++j < pop->length)
+            continue;
+        /* One complete individual. */
+        j = 0;
+        if (seen != NULL)
+            memset(seen, 0, pop->range);
+        if (pop->non_repeatable == SUBSET)
+        {
+            qsort(rows[n_rows], pop->length, sizeof(int), compare);
+            for (j = 1; j < pop->length && !bad; j++)
+            {
+                if (rows[n_rows][j] == rows[n_rows][j - 1])
+                    bad = 1;
+            }
+            j = 0;
+            if (bad)
+                break;
+        }
+        n_rows++;
+    }
+    fclose(file);
+    free(seen);
+    if (bad || j != 0)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Individual %d of the file '%s' is %s.\n"
+               "Each individual must have %d values in [%d, %d]%s.\n"
+               "====================\n", n_rows + 1, path,
+               bad ? "invalid" : "incomplete", pop->length,
+               pop->min_value, pop->max_value,
+               (pop->non_repeatable == REPEATABLE) ? ""
+               : " without repetitions");
+        exit(EXIT_FAILURE);
+    }
+    return n_rows;
+}
+
+struct IntPopulation
+*int_init_population(char *init_mode, int n_population, int length,
+                     int min_value, int max_value, int non_repeatable)
+{
+/* This function returns an initalized IntPopulation struct. It's the
+   first call in your program, defining the initial population. After this
+   you MUST evaluate the population with 'int_evaluate_population' function.
+   =ARGUMENTS=
+                    - 'random'  : Init a random pop according to
+                                  solution boundaries.
+                    - 'empty'   : An empty pop (arrays of 0s) - In case
+                                  a non-random start method (as heuristic one)
+                                  could be used.
+                    - 'unalloc' : The pop will begin with 'pop->individuals'
+                                  unallocated. Useful for generation > 0.
+                    - 'seed:<path>' : Like 'random', but the first
+                                  individuals (e.g. from a heuristic) are
+                                  read from the text file at <path> (see
+                                  'int_read_individuals').
+                  Random individuals are built with Fisher-Yates (or
+                  Floyd's sampling for SUBSET solutions), in parallel with
+                  all the OpenMP threads (results don't depend on them).
+   - 'n_population' : The number of individuals inside population.
+   - 'length' : Length of the solution presentation (len of individual array).
+   - 'min_value' : The minimum value contained in the solution presentation.
+   - 'max_value' : The maximum value contained in the solution presentation.
+   - 'non_repeatable' : - REPEATABLE : Any value in each gene.
+                        - NO_REPEAT  : Distinct values (e.g. permutations),
+                                       costs linear in 'range'.
+                        - SUBSET     : A set of 'length' distinct values,
+                                       kept sorted, whose costs depend only
+                                       on 'length' (e.g. 500 ids out of
+                                       10^9). Needs 'union' crossover and
+                                       'uniform' mutation.
+   =RETURNS=
+   - 'pop' : A pointer to an IntPopulation struct. This struct has the
+             the following variables initialized:
+             - 'length'
+             - 'min_value'
+             - 'max_value'
+             - 'non_repeatable'
+             - 'n_population'
+             - 'individuals'
+             - 'init_mode' */
+
+    /* Sanity check. */
+    check_null(init_mode, __LINE__, __FILE__);
+    if ((long long) max_value + 1 - min_value > INT_MAX)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "(max_value-min_value) must be < %d.\n"
+               "====================\n", INT_MAX);
+        exit(EXIT_FAILURE);
+    }
+    if (non_repeatable == NO_REPEAT || non_repeatable == SUBSET)
+    {
+        if ((max_value + 1 - min_value) < length)
+        {
+            fprintf(stderr, "Impossible to build non-repeatable Solution\n"
+                   "for this population.\n"
+                   "====> (max_value-min_value) < length\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int i, j = 0;
+    struct IntPopulation *pop;
+
+    pop = ec_malloc(sizeof(struct IntPopulation), __LINE__, __FILE__);
+    pop->n_population = n_population;
+    pop->n_population_orig = n_population;
+    pop->n_population_alloc = n_population;
+    pop->ext_parents = NULL;
+    pop->ext_childs = NULL;
+    pop->ext_new_individuals = NULL;
+    pop->ext_rows = 0;
+    pop->winner = NULL;
+    pop->init_mode = init_mode;
+    pop->length = length;
+    pop->min_value = min_value;
+    pop->max_value = max_value;
+    pop->range = max_value + 1 - min_value;
+    pop->first_population = POP_NOT_EVAL;
+    pop->non_repeatable = non_repeatable;
+    pop->generation = 0;
+    pop->n_stagnant_gens = 0;
+    pop->objective_function = NULL;
+    pop->resize_mode = RESIZE_NONE;
+    pop->diversity_mode = DIVERSITY_NONE;
+    pop->diversity_synced = 0;
+    pop->diversity_rows = 0;
+    pop->diversity_entropy = -1.0;
+    pop->diversity_hamming = 0.0;
+    pop->n_unique_individuals = 0;
+    pop->locus_counts = NULL;
+    pop->clogc_table = NULL;
+    pop->hashes = NULL;
+    pop->stagnation_mode = STAGNATION_NONE;
+    pop->n_restarts = 0;
+    pop->stop = 0;
+    pop->dedup_mode = DEDUP_NONE;
+    pop->dedup_rows = 0;
+    pop->n_evaluations = 0;
+    pop->n_evals_saved = 0;
+    pop->n_duplicates = 0;
+    pop->parent_indexes = NULL;
+    pop->eval_skip = NULL;
+    pop->n_eval_skip = 0;
+    pop->child_hashes = NULL;
+    pop->next_fos = NULL;
+    pop->next_fo_known = NULL;
+    pop->genome_table = NULL;
+    pop->genome_table_size = 0;
+    pop->storage = STORAGE_HEAP;
+    pop->mmap_base = NULL;
+    pop->alltime_restored = 0;
+    pop->select_mode = SELECT_TOURNAMENT;
+    pop->select_param = 0.0; /* 'tournament_size' of int_ga_one_iter. */
+    pop->select_rows = 0;
+    pop->select_prob = NULL;
+    pop->select_alias = NULL;
+    pop->select_work = NULL;
+    pop->n_threads = 1;
+    pop->breed_rows = 0;
+    pop->breed_scratch = NULL;
+    pop->ls_mode = LS_NONE;
+    pop->ls_writeback = LS_LAMARCKIAN;
+    pop->ls_rows = 0;
+    pop->ls_delta = NULL;
+    pop->ls_work = NULL;
+    pop->ls_targets = NULL;
+    pop->ls_fos = NULL;
+    pop->n_ls_evaluations = 0;
+    pop->n_ls_improved = 0;
+    pop->hof_capacity = HOF_DEFAULT_CAPACITY;
+    pop->hof_size = 0;
+    pop->hof_table_size = 0;
+    pop->hof_genomes = NULL;
+    pop->hof_fos = NULL;
+    pop->hof_hashes = NULL;
+    pop->hof_heap = NULL;
+    pop->hof_heap_pos = NULL;
+    pop->hof_table = NULL;
+    pop->best_indv_alltime = NULL;
+    pop->n_best_indv_alltime = 0;
+    pop->batch_objective = NULL;
+    pop->gm_genes = NULL;
+    pop->gm_stride = 0;
+    pop->gm_rows = 0;
+    pop->cell_neighborhood = CELL_NONE;
+    pop->cell_update = CELL_SYNC;
+    pop->cell_rows = 0;
+    pop->cell_cols = 0;
+    pop->mo_n_objectives = 0;
+    pop->mo_rows = 0;
+    pop->mo_stride = 0;
+    pop->mo_function = NULL;
+    pop->mo_objs = NULL;
+    pop->mo_crowding = NULL;
+    pop->mo_rank = NULL;
+    pop->mo_archive_capacity = 0;
+    pop->mo_archive_size = 0;
+    pop->mo_archive = NULL;
+    pop->mo_archive_objs = NULL;
+    pop->mo_archive_hashes = NULL;
+    pop->niche_mode = NICHE_NONE;
+    pop->niche_search = NICHE_EXACT;
+    pop->niche_radius = 0;
+    pop->niche_rows = 0;
+    pop->niche_synced = 0;
+    pop->niche_param = 1.0;
+    pop->niche_fos = NULL;
+    pop->niche_counts = NULL;
+    pop->niche_order = NULL;
+    pop->niche_lsh_loci = NULL;
+    pop->niche_lsh_k = 0;
+    pop->niche_pairs = NULL;
+    pop->niche_n_pairs = 0;
+    pop->niche_pairs_cap = 0;
+    pop->n_niches = 0;
+    pop->n_niche_distances = 0;
+    pop->run_max_iter = 0;
+    pop->run_max_stagnant = 0;
+    pop->run_has_target = 0;
+    pop->run_max_seconds = 0.0;
+    pop->run_max_evaluations = 0;
+    pop->run_target_fo = 0.0;
+    pop->run_callback = NULL;
+    pop->run_callback_data = NULL;
+    pop->run_callback_every = 1;
+    pop->run_stop = 0;
+    pop->run_reason = 0;
+    pop->run_generation = 0;
+    pop->run_seconds = 0.0;
+    pop->snap_genome = NULL;
+    pop->snap_fo = 0.0;
+    pop->snap_generation = 0;
+    pop->snap_evaluations = 0;
+    pop->snap_seq = 0;
+    pop->cow_mode = COW_NONE;
+    pop->cow_rows = 0;
+    pop->cow_table_size = 0;
+    pop->n_cow_spare = 0;
+    pop->cow_table = NULL;
+    pop->cow_spare = NULL;
+    pop->cow_clones = NULL;
+    pop->n_cow_shared = 0;
+    pop->n_cow_copies = 0;
+    pop->n_cow_clones = 0;
+    pop->block_function = NULL;
+    pop->block_size = 0;
+    pop->n_blocks = 0;
+    pop->block_rows = 0;
+    pop->block_synced = 0;
+    pop->block_scores = NULL;
+    pop->next_block_scores = NULL;
+    pop->block_dirty = NULL;
+    pop->next_block_dirty = NULL;
+    pop->n_block_evaluations = 0;
+    pop->n_blocks_reused = 0;
+    pop->fork_n_workers = 0;
+    pop->fork_done_fds[0] = -1;
+    pop->fork_done_fds[1] = -1;
+    pop->fork_shared = NULL;
+    pop->fork_shared_size = 0;
+    pop->fork_tasks = NULL;
+    pop->fork_done = NULL;
+    pop->fork_slots = NULL;
+    pop->fork_rows = NULL;
+    pop->fork_fos = NULL;
+    pop->fork_pids = NULL;
+    pop->fork_polls = NULL;
+    pop->fork_wake_fds = NULL;
+    pop->fork_pending = NULL;
+    pop->fork_retries = NULL;
+    pop->n_fork_restarts = 0;
+    pop->n_fork_failures = 0;
+    pop->proc_command = NULL;
+    pop->proc_n_processes = 0;
+    pop->proc_protocol = PROC_TEXT;
+    pop->proc_batch = 1;
+    pop->proc_timeout = 0.0;
+    pop->proc_penalty = 0.0;
+    pop->proc_list = NULL;
+    pop->proc_requeue = NULL;
+    pop->proc_n_requeued = 0;
+    pop->proc_polls = NULL;
+    pop->n_proc_failures = 0;
+    pop->n_proc_timeouts = 0;
+    pop->n_proc_respawns = 0;
+    pop->surr_genomes = NULL;
+    pop->surr_fos = NULL;
+    pop->surr_weights = NULL;
+    pop->surr_cands = NULL;
+    pop->surr_cand_parents = NULL;
+    pop->surr_cand_fos = NULL;
+    pop->surr_preds = NULL;
+    int_surrogate_free(pop);
+    pop->surr_factor = 1;
+    pop->surr_capacity = 0;
+    pop->surr_retrain = 1;
+    pop->surr_k = 1;
+    pop->surr_rank_corr = 0.0;
+    pop->surr_mae = 0.0;
+    pop->n_surr_fits = 0;
+    pop->n_surr_predictions = 0;
+    pop->n_surr_rejected = 0;
+    /* The pop random stream follows srand(). */
+    pop->rng_state = ((uint64_t) rand() << 32) ^ (uint64_t) rand();
+
+    if (non_repeatable == NO_REPEAT)
+    {
+        pop->reference_arr = ec_malloc(sizeof(int) * pop->range,
+                                 __LINE__, __FILE__);
+        for (i = min_value; i < max_value + 1; i++)
+        {
+            pop->reference_arr[j++] = i;
+        }
+    }
+
+    if (strcmp(init_mode, "random") == 0 ||
+        strncmp(init_mode, "seed:", 5) == 0)
+    {
+        pop->individuals = ec_calloc(n_population, sizeof(int*),
+                               __LINE__, __FILE__);
+        for (i = 0; i < pop->n_population; i++)
+        {
+            pop->individuals[i] = ec_malloc(pop->length * sizeof(int),
+                                       __LINE__, __FILE__);
+        }
+        /* Seed individuals first, random ones for the rest. */
+        if (strncmp(init_mode, "seed:", 5) == 0)
+            j = int_read_individuals(pop, init_mode + 5, pop->individuals,
+                                     n_population);
+        else
+            j = 0;
+        int_init_individuals(pop, pop->individuals + j, n_population - j,
+                             int_init_n_threads());
+    }
+    else if (strcmp(init_mode, "empty") == 0)
+    {
+        pop->individuals = ec_calloc(n_population, sizeof(int*),
+                               __LINE__, __FILE__);
+        /* Just a bunch of 0s. */
+        for (i = 0; i < n_population; i++)
+        {
+             pop->individuals[i] = ec_calloc(length, sizeof(int),
+                                       __LINE__, __FILE__);
+        }
+    }
+    else if (strcmp(init_mode, "unalloc") == 0)
+    {
+        /* pop->individuals not allocated because it will
+           be assigned to an already alloc'd pointer of pointers
+           with [n_population][length] size. */
+    }
+    else if (strncmp(init_mode, "mmap:", 5) == 0)
+    {
+        /* Random individuals inside a new mapped file. */
+        int_map_population(pop, init_mode + 5, 0);
+    }
+    else if (strncmp(init_mode, "remap:", 6) == 0)
+    {
+        /* Individuals from an existing mapped file. */
+        int_map_population(pop, init_mode + 6, 1);
+    }
+    else if (strcmp(init_mode, "shared") == 0)
+    {
+        /* Random individuals in anonymous shared memory. */
+        int_map_population(pop, NULL, 0);
+    }
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'init_mode' ('%s') argument passed\nto "
+               "'int_init_population' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'random'  :    randomly initialize population according"
+               "\n\t\tto solution boundaries.\n"
+               "-'empty'   :    individuals inside population start as"
+               "\n\t\tempty (0s) arrays.\n"
+               "-'unalloc' :    pop->individuals not alloc'd.\n"
+               "-'seed:<path>'  : individuals read from the file at"
+               "\n\t\t<path>, random ones for the rest.\n"
+               "-'mmap:<path>'  : random pop stored in a memory"
+               "\n\t\tmapped file created at <path>.\n"
+               "-'remap:<path>' : restart from an existing mapped"
+               "\n\t\tfile at <path>.\n"
+               "-'shared'  :    random pop stored in anonymous shared"
+               "\n\t\tmemory (seen by forked processes).\n"
+               "====================\n", init_mode);
+        free(pop);
+        exit(EXIT_FAILURE);
+    }
+    return pop;
+}
+
+void
+int_evaluate_population(struct IntPopulation *pop,
+                        float (*objective_function)())
+{
+/* Evaluate a int population defining the struct variables:
+   - 'fos'
+   - 'best_fo'
+   - 'n_best_individuals'
+   - 'best_indexes'
+   - 'sorted_fos'
+   - 'sorted_fos_indexes'
+   - 'best_fo_alltime'
+   - 'n_best_indv_alltime'
+   - 'best_indv_alltime'
+   - The hall of fame (see 'int_set_hall_of_fame').
+   It should be called after the generation of a population.
+   =ARGUMENTS=
+   - '*pop' : An IntPopulation struct already initialized.
+   - '(*objective_function)()' : A fo calculation with inputs:
+                                 - 'int *arr'   : int solution array.
+                                 - 'int length' : length of int solution arr.
+*/
+    int i, start, end, chunk;
+    long n_evaluations = 0;
+
+    if (pop->first_population == POP_NOT_EVAL)
+    {
+        /* After evaluation 'first_population' goes to POP_EVALUATED
+           to avoid multiple callocs. */
+        pop->best_indexes = ec_malloc(pop->n_population_alloc * sizeof(int),
+                                __LINE__, __FILE__);
+        pop->fos = ec_malloc(pop->n_population_alloc * sizeof(float),
+                       __LINE__, __FILE__);
+        pop->sorted_fos_indexes = ec_malloc(
+                                      pop->n_population_alloc * sizeof(int),
+                                      __LINE__, __FILE__);
+        pop->sorted_fos = ec_malloc(pop->n_population_alloc * sizeof(float),
+                              __LINE__, __FILE__);
+        /* 'hof_size' is the number of entries in the file of a
+           remapped population. */
+        i = pop->hof_size;
+        int_hof_alloc(pop, pop->hof_capacity);
+        if (pop->alltime_restored)
+            int_hof_restore(pop, i, objective_function);
+        else
+        {
+            pop->best_fo_alltime = 0.0;
+            pop->generation = 0;
+        }
+    }
+    else
+        pop->generation++;
+    pop->objective_function = objective_function;
+    if (pop->mo_n_objectives > 0)
+    {
+        /* Multi-objective mode: objective vectors, fronts and crowding
+           distances (see 'int_set_multi_objective'). */
+        int_mo_alloc(pop);
+        pop->n_evaluations += int_mo_evaluate(pop, pop->individuals, 0,
+                                              pop->n_population);
+        int_mo_rank(pop, pop->n_population);
+        int_mo_finish(pop);
+        return;
+    }
+
+    /* Getting fo for each individual (but the ones with an already
+       known fo, see 'int_set_dedup'), one by one, by blocks of the
+       gene-major view (see 'int_set_batch_objective'), from it's
+       block scores (see 'int_set_block_objective'), by external
+       programs (see 'int_set_process_evaluator') or in the worker
+       processes (see 'int_set_fork_evaluator'). Mapped
+       individuals are streamed in chunks of MMAP_EVAL_CHUNK bytes,
+       prefetching the next chunk and releasing the evaluated one. */
+    chunk = pop->n_population;
+    if (pop->storage == STORAGE_MMAP)
+        chunk = MMAP_EVAL_CHUNK / (pop->length * sizeof(int)) + 1;
+    if (pop->batch_objective != NULL)
+        /* Blocks start at multiples of GM_BLOCK. */
+        chunk = (chunk + GM_BLOCK - 1) / GM_BLOCK * GM_BLOCK;
+    if (pop->block_function != NULL)
+    {
+        /* Block scores are only kept through fused breedings (see
+           'int_set_block_objective'), otherwise all of them are
+           evaluated. */
+        int_block_alloc(pop);
+        if (!pop->block_synced)
+            memset(pop->block_dirty, 1,
+                   (size_t) pop->n_population * pop->n_blocks);
+        pop->block_synced = 0;
+    }
+    for (start = 0; start < pop->n_population; start += chunk)
+    {
+        end = (start + chunk < pop->n_population) ?
+              start + chunk : pop->n_population;
+        if (pop->storage == STORAGE_MMAP && end < pop->n_population)
+            int_mmap_advise(pop, pop->individuals[end],
+                            (end + chunk < pop->n_population) ?
+                            chunk : pop->n_population - end,
+                            MADV_WILLNEED);
+        if (pop->block_function != NULL)
+            n_evaluations += int_evaluate_blocks(pop, start, end);
+        else if (pop->batch_objective != NULL)
+            n_evaluations += int_evaluate_batch(pop, start, end);
+        else if (pop->proc_n_processes > 0)
+            n_evaluations += int_process_evaluate(pop, start, end);
+        else if (pop->fork_n_workers > 0)
+            n_evaluations += int_fork_evaluate(pop, start, end,
+                                               objective_function);
+        else
+        {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 16) \
+    reduction(+:n_evaluations) if (pop->n_threads > 1)
+#endif
+            for (i = start; i < end; i++)
+            {
+                if (pop->n_eval_skip > 0 && pop->eval_skip[i])
+                    continue;
+                pop->fos[i] = objective_function(pop->individuals[i],
+                                                 pop->length);
+                n_evaluations++;
+            }
+        }
+        if (pop->storage == STORAGE_MMAP)
+            int_mmap_advise(pop, pop->individuals[start], end - start,
+                            MADV_DONTNEED);
+    }
+    /* Training samples and accuracy of the surrogate (see
+       'int_set_surrogate'). */
+    if (pop->surr_mode != SURR_NONE)
+        int_surrogate_collect(pop);
+    pop->n_evaluations += n_evaluations;
+    pop->n_evals_saved += pop->n_eval_skip;
+    pop->n_eval_skip = 0;
+    /* Local search stage (memetic mode, see 'int_set_local_search'). */
+    if (pop->ls_mode != LS_NONE)
+    {
+        int_update_ranking(pop);
+        int_local_search(pop, objective_function);
+    }
+    /* Best fo, best individuals and sorted fos. */
+    int_update_ranking(pop);
+    /* Updating all time best individuals and fo. */
+    if (int_update_alltime(pop))
+        pop->n_stagnant_gens = 0;
+    else
+        pop->n_stagnant_gens++;
+    pop->first_population = POP_EVALUATED;
+    /* Genome hashes and diversity statistics (incremental if
+       'int_ga_one_iter' already updated them). */
+    if (int_tracks_hashes(pop))
+    {
+        if (!pop->diversity_synced)
+            int_update_diversity(pop);
+        else if (pop->diversity_mode != DIVERSITY_NONE)
+            int_diversity_stats(pop);
+        pop->diversity_synced = 0;
+    }
+    /* Identical genomes share their rows (see 'int_set_genome_sharing'). */
+    if (pop->cow_mode == COW_SHARE)
+        int_share_rows(pop);
+    /* Niche counts and niched fos (see 'int_set_niching'). */
+    if (pop->niche_mode != NICHE_NONE)
+        int_update_niches(pop);
+    if (pop->storage == STORAGE_MMAP)
+        int_mmap_write_header(pop);
+}
+
+int
+int_update_alltime(struct IntPopulation *pop)
+{
+/* Updates 'best_fo_alltime' and offers the individuals of an already
+   ranked population to the hall of fame, best first, until one can't
+   enter it (so the others can't either). Genome hashes kept for
+   diversity/dedup are reused.
+   =RETURNS=
+   - 1 if the all time best fo was updated, 0 otherwise. */
+    int i, index, improved, changed = 0;
+    int known_hashes = int_tracks_hashes(pop) && pop->diversity_synced;
+    uint64_t hash;
+
+    improved = (pop->best_fo < pop->best_fo_alltime ||
+                (pop->first_population == POP_NOT_EVAL &&
+                 !pop->alltime_restored));
+    for (i = 0; i < pop->n_population; i++)
+    {
+        if (pop->hof_size == pop->hof_capacity &&
+            pop->sorted_fos[i] >= pop->hof_fos[pop->hof_heap[0]])
+            break;
+        index = pop->sorted_fos_indexes[i];
+        hash = known_hashes ? pop->hashes[index]
+               : int_hof_hash(pop, pop->individuals[index]);
+        changed |= int_hof_offer(pop, pop->individuals[index],
+                                 pop->sorted_fos[i], hash);
+    }
+    if (improved)
+        pop->best_fo_alltime = pop->best_fo;
+    if (changed || improved)
+        int_hof_update_best(pop);
+    return improved;
+}
+
+void
+int_update_ranking(struct IntPopulation *pop)
+{
+/* Defines 'best_fo', 'n_best_individuals', 'best_indexes',
+   'sorted_fos' and 'sorted_fos_indexes' from the current 'fos'.
+   Sorting is done once over (fo, index) pairs, so tied individuals
+   keep the population order.
+   =ARGUMENTS=
+   - '*pop' : An IntPopulation struct with 'fos' defined. */
+    int i;
+    struct IntRank *ranks;
+
+    ranks = ec_malloc(pop->n_population * sizeof(struct IntRank),
+                      __LINE__, __FILE__);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        ranks[i].fo = pop->fos[i];
+        ranks[i].index = i;
+    }
+    qsort(ranks, pop->n_population, sizeof(struct IntRank), compare_ranks);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        pop->sorted_fos[i] = ranks[i].fo;
+        pop->sorted_fos_indexes[i] = ranks[i].index;
+    }
+    free(ranks);
+    pop->niche_synced = 0;
+
+    /* Looking for individuals with fo == best_fo (already sorted). */
+    pop->best_fo = pop->sorted_fos[0];
+    pop->n_best_individuals = 0;
+    for (i = 0; i < pop->n_population; i++)
+    {
+        if (pop->sorted_fos[i] != pop->best_fo)
+            break;
+        pop->best_indexes[pop->n_best_individuals++] =
+            pop->sorted_fos_indexes[i];
+    }
+}
+
+int
+*int_tournament_selection(struct IntPopulation *pop, int tournament_size)
+{
+/* This function return the winner (int solution array) pointer
+   after the ocorrence of a tournament inside the population.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - 'tournament_size' : The number of simultaneous competitors.
+   =RETURNS=
+   - 'winner' : A pointer to a int solution array with the minor fo
+                from the tournament. */
+
+    /* Initializing competitors and winner. */
+    int_init_competitors_winner(pop);
+
+    memcpy(pop->winner,
+           pop->individuals[int_tournament_index(pop, tournament_size)],
+           sizeof(int) * pop->length);
+    return pop->winner;
+}
+
+int
+int_tournament_index(struct IntPopulation *pop, int tournament_size)
+{
+/* Same as 'int_tournament_selection' but returns the index (inside
+   pop->individuals) of the winner, without copying it. */
+    if (pop->niche_mode != NICHE_NONE && !pop->niche_synced)
+        int_update_niches(pop);
+    return int_tournament_draw(pop, tournament_size, &pop->rng_state);
+}
+
+int
+int_tournament_draw(struct IntPopulation *pop, int tournament_size,
+                    uint64_t *rng)
+{
+/* One tournament using the random stream '*rng'. Distinct competitors
+   are drawn with Floyd's sampling (a competitor can't compete with
+   itself), which needs exactly 'tournament_size' draws (no retries). */
+    int i, j, candidate, n_competitors = 0, winner_index = 0;
+    int competitor_indexes[tournament_size];
+    float winner_fo = 0.0, *fos = int_select_fos(pop);
+
+    if (tournament_size > pop->n_population)
+        tournament_size = pop->n_population;
+    for (j = pop->n_population - tournament_size; j < pop->n_population; j++)
+    {
+        candidate = (int) rng_bounded(rng, (uint32_t) j + 1);
+        for (i = 0; i < n_competitors; i++)
+        {
+            if (competitor_indexes[i] == candidate)
+            {
+                /* Already competing, j never was. */
+                candidate = j;
+                break;
+            }
+        }
+        competitor_indexes[n_competitors++] = candidate;
+
+        /* Best competitor evaluation. */
+        if (n_competitors == 1 || fos[candidate] <= winner_fo)
+        {
+            winner_index = candidate;
+            winner_fo = fos[candidate];
+        }
+    }
+    /* We don't care too much with tied competitors,
+       as if a tie happens, the winner index is already
+       randomly selected from the population. */
+    return winner_index;
+}
+
+int
+int_select_mode_code(char *select_mode)
+{
+/* Returns the SELECT_* code of '*select_mode' (-1 if unknown). */
+    if (strcmp(select_mode, "tournament") == 0)
+        return SELECT_TOURNAMENT;
+    else if (strcmp(select_mode, "roulette") == 0)
+        return SELECT_ROULETTE;
+    else if (strcmp(select_mode, "sus") == 0)
+        return SELECT_SUS;
+    else if (strcmp(select_mode, "linrank") == 0)
+        return SELECT_LINRANK;
+    else if (strcmp(select_mode, "exprank") == 0)
+        return SELECT_EXPRANK;
+    else if (strcmp(select_mode, "truncation") == 0)
+        return SELECT_TRUNCATION;
+    return -1;
+}
+
+void
+int_init_select_buffers(struct IntPopulation *pop)
+{
+/* Allocs (or reallocs, after a population resize) the alias tables
+   with 'pop->n_population_alloc' elements. */
+    int rows = pop->n_population_alloc;
+
+    if (pop->select_rows == rows)
+        return;
+    pop->select_prob = realloc(pop->select_prob, rows * sizeof(double));
+    check_null(pop->select_prob, __LINE__, __FILE__);
+    pop->select_alias = realloc(pop->select_alias, rows * sizeof(int));
+    check_null(pop->select_alias, __LINE__, __FILE__);
+    pop->select_work = realloc(pop->select_work, rows * sizeof(int));
+    check_null(pop->select_work, __LINE__, __FILE__);
+    pop->select_rows = rows;
+}
+
+void
+int_selection_weights(struct IntPopulation *pop, int select_mode,
+                      float select_param)
+{
+/* Defines 'pop->select_prob' with the (non normalized) selection
+   weight of each individual for the roulette, sus and ranking modes. */
+    int i, rank, n = pop->n_population;
+    float *fos = int_select_fos(pop);
+    int *order = int_select_order(pop);
+    float worst_fo = fos[order[n - 1]];
+    double weight = 1.0;
+
+    switch (select_mode)
+    {
+        case SELECT_ROULETTE:
+        case SELECT_SUS:
+            /* Fitness of a minimization problem. */
+            for (i = 0; i < n; i++)
+            {
+                pop->select_prob[i] = (double) (worst_fo - fos[i]);
+            }
+            if (worst_fo == fos[order[0]])
+                for (i = 0; i < n; i++)
+                {
+                    pop->select_prob[i] = 1.0; /* All tied. */
+                }
+            break;
+        case SELECT_LINRANK:
+            for (rank = 0; rank < n; rank++)
+            {
+                pop->select_prob[order[rank]] = (n > 1) ?
+                    select_param - (2.0 * select_param - 2.0)
+                    * rank / (n - 1) : 1.0;
+            }
+            break;
+        case SELECT_EXPRANK:
+            for (rank = 0; rank < n; rank++)
+            {
+                pop->select_prob[order[rank]] = weight;
+                weight *= select_param;
+            }
+            break;
+    }
+}
+
+void
+int_build_alias(struct IntPopulation *pop)
+{
+/* Builds the alias tables (Vose's version of Walker's method) from the
+   weights inside 'pop->select_prob', in O(n_population). After it, each
+   draw is O(1): a random slot i is kept with probability
+   'select_prob[i]', otherwise 'select_alias[i]' is returned. */
+    int i, small, large, n = pop->n_population;
+    int n_small = 0, n_large = 0;
+    int *work = pop->select_work; /* small from the start, large from
+                                     the end. */
+    double sum = 0.0;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += pop->select_prob[i];
+    }
+    for (i = 0; i < n; i++)
+    {
+        pop->select_prob[i] = pop->select_prob[i] * n / sum;
+        pop->select_alias[i] = i;
+        if (pop->select_prob[i] < 1.0)
+            work[n_small++] = i;
+        else
+            work[n - 1 - n_large++] = i;
+    }
+    while (n_small > 0 && n_large > 0)
+    {
+        small = work[--n_small];
+        large = work[n - n_large];
+        pop->select_alias[small] = large;
+        pop->select_prob[large] += pop->select_prob[small] - 1.0;
+        if (pop->select_prob[large] < 1.0)
+        {
+            /* 'large' moves to the small ones. */
+            n_large--;
+            work[n_small++] = large;
+        }
+    }
+    /* Remaining ones (rounding errors) are kept with probability 1. */
+    while (n_large > 0)
+    {
+        pop->select_prob[work[n - n_large--]] = 1.0;
+    }
+    while (n_small > 0)
+    {
+        pop->select_prob[work[--n_small]] = 1.0;
+    }
+}
+
+int
+int_alias_draw(struct IntPopulation *pop, uint64_t *rng)
+{
+/* One O(1) draw from the alias tables. */
+    int i = (int) rng_bounded(rng, (uint32_t) pop->n_population);
+
+    if (rng_double(rng) < pop->select_prob[i])
+        return i;
+    return pop->select_alias[i];
+}
+
+void
+int_select_indexes(struct IntPopulation *pop, int select_mode,
+                   float select_param, int *indexes, int n_select)
+{
+/* Batched selection (see 'int_selection') with an already
+   validated 'select_mode' code, using the pop random stream. */
+    int i, k, tmp, n_truncation;
+    double step, pointer, cumulative;
+
+    /* Niched fos of the current generation (see 'int_set_niching'). */
+    if (pop->niche_mode != NICHE_NONE && !pop->niche_synced)
+        int_update_niches(pop);
+    switch (select_mode)
+    {
+        case SELECT_TOURNAMENT:
+            for (k = 0; k < n_select; k++)
+            {
+                indexes[k] = int_tournament_draw(pop, (int) select_param,
+                                                 &pop->rng_state);
+            }
+            break;
+        case SELECT_ROULETTE:
+        case SELECT_LINRANK:
+        case SELECT_EXPRANK:
+            int_init_select_buffers(pop);
+            int_selection_weights(pop, select_mode, select_param);
+            int_build_alias(pop);
+            for (k = 0; k < n_select; k++)
+            {
+                indexes[k] = int_alias_draw(pop, &pop->rng_state);
+            }
+            break;
+        case SELECT_SUS:
+            /* 'n_select' equally spaced pointers over the cumulative
+               weights, in a single pass. */
+            int_init_select_buffers(pop);
+            int_selection_weights(pop, select_mode, select_param);
+            cumulative = 0.0;
+            for (i = 0; i < pop->n_population; i++)
+            {
+                cumulative += pop->select_prob[i];
+            }
+            step = cumulative / n_select;
+            pointer = rng_double(&pop->rng_state) * step;
+            i = 0;
+            cumulative = pop->select_prob[0];
+            for (k = 0; k < n_select; k++)
+            {
+                while (cumulative <= pointer && i < pop->n_population - 1)
+                {
+                    cumulative += pop->select_prob[++i];
+                }
+                indexes[k] = i;
+                pointer += step;
+            }
+            /* Shuffling (Fisher-Yates), so the pairing of parents
+               doesn't depend on the population order. */
+            for (k = n_select - 1; k > 0; k--)
+            {
+                i = (int) rng_bounded(&pop->rng_state, (uint32_t) k + 1);
+                tmp = indexes[k];
+                indexes[k] = indexes[i];
+                indexes[i] = tmp;
+            }
+            break;
+        case SELECT_TRUNCATION:
+            n_truncation = (int) (select_param * (float) pop->n_population);
+            if (n_truncation < 1)
+                n_truncation = 1;
+            if (n_truncation > pop->n_population)
+                n_truncation = pop->n_population;
+            for (k = 0; k < n_select; k++)
+            {
+                indexes[k] = int_select_order(pop)[
+                    rng_bounded(&pop->rng_state, (uint32_t) n_truncation)];
+            }
+            break;
+    }
+}
+
+void
+int_selection(char *select_mode, struct IntPopulation *pop,
+              int *indexes, int n_select, float select_param)
+{
+/* This function selects 'n_select' individuals (e.g. all the parents of
+   a generation) in one batched call, defining their indexes (inside
+   pop->individuals) in '*indexes'. Any needed table is built once per
+   call (O(n_population)) and each draw is O(1) (O(tournament_size) for
+   tournaments). As fos are minimized, fitness proportional modes use
+   (worst_fo - fo) as the fitness of each individual.
+   More info on these methods:
+   https://en.wikipedia.org/wiki/Selection_(genetic_algorithm)
+   =ARGUMENTS=
+   - '*select_mode' : 'tournament', 'roulette', 'sus', 'linrank',
+                      'exprank' or 'truncation' (see GA_int.h).
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - '*indexes' : Array with 'n_select' elements for the selected indexes.
+   - 'n_select' : Number of individuals to be selected.
+   - 'select_param' : Tournament size, selection pressure, base or
+                      fraction, depending on '*select_mode'. */
+    int code;
+
+    /* Sanity check. */
+    check_null(select_mode, __LINE__, __FILE__);
+    code = int_select_mode_code(select_mode);
+    if (code < 0 ||
+        (code == SELECT_TOURNAMENT && select_param < 1.0) ||
+        (code == SELECT_LINRANK &&
+         (select_param < 1.0 || select_param > 2.0)) ||
+        (code == SELECT_EXPRANK &&
+         (select_param <= 0.0 || select_param >= 1.0)) ||
+        (code == SELECT_TRUNCATION &&
+         (select_param <= 0.0 || select_param > 1.0)))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'select_mode' ('%s') or 'select_param' (%f)\n"
+               "arguments passed to 'int_selection' function.\n"
+               "The supported arguments are (so far):\n"
+               "-'tournament' :   best of 'select_param' (>= 1) random"
+               "\n\t\tcompetitors.\n"
+               "-'roulette'   :   fitness proportional (alias method).\n"
+               "-'sus'        :   stochastic universal sampling.\n"
+               "-'linrank'    :   linear ranking, pressure 'select_param'"
+               "\n\t\tin [1, 2].\n"
+               "-'exprank'    :   exponential ranking, base 'select_param'"
+               "\n\t\tin (0, 1).\n"
+               "-'truncation' :   uniform among the best 'select_param'"
+               "\n\t\tfraction (0, 1] of the pop.\n"
+               "====================\n", select_mode, select_param);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (n_select > 0)
+        int_select_indexes(pop, code, select_param, indexes, n_select);
+}
+
+void
+int_set_selection(struct IntPopulation *pop, char *select_mode,
+                  float select_param)
+{
+/* Defines the selection method used by 'int_ga_one_iter' (tournaments
+   with it's 'tournament_size' argument by default). See 'int_selection'
+   for the accepted arguments. */
+
+    /* Validating the arguments with an empty selection (the pop
+       doesn't need to be evaluated yet). */
+    int_selection(select_mode, pop, NULL, 0, select_param);
+    pop->select_mode = int_select_mode_code(select_mode);
+    pop->select_param = select_param;
+}
+
+uint64_t
+int_block_stream(uint64_t seed, int block)
+{
+/* Initial state of the random stream of breeding 'block' (a pair of
+   childs or an individual) from the per call 'seed'. */
+    return hash_mix64(seed ^ hash_mix64((uint64_t) block + 1));
+}
+
+void
+int_init_breed_buffers(struct IntPopulation *pop)
+{
+/* Allocs one breeding buffer per thread, used by the repair of
+   non-repeatable childs and by 'int_breed_pair': 2 * 'length' ints per
+   child of the pair, 'range' shared ints for the missing values and
+   one byte per value and child for the marks (see 'int_scratch_marks'),
+   which are always kept to 0 after use. Everything is on the heap and
+   linear in 'length' and 'range'. SUBSET solutions use a hash set
+   (see 'int_subset_replace') instead of the 'range' sized parts. */
+    size_t size = 4 * (size_t) pop->length;
+    int i;
+
+    if (pop->breed_rows == pop->n_threads)
+        return;
+    if (pop->non_repeatable == SUBSET)
+        size += int_subset_table_size(pop->length);
+    else
+        size += pop->range + (2 * (size_t) pop->range + 3) / 4;
+    for (i = 0; i < pop->breed_rows; i++)
+    {
+        free(pop->breed_scratch[i]);
+    }
+    free(pop->breed_scratch);
+    pop->breed_scratch = ec_malloc(pop->n_threads * sizeof(int*),
+                                   __LINE__, __FILE__);
+    for (i = 0; i < pop->n_threads; i++)
+    {
+        pop->breed_scratch[i] = ec_calloc(size, sizeof(int),
+                                          __LINE__, __FILE__);
+    }
+    pop->breed_rows = pop->n_threads;
+}
+
+int
+*int_thread_scratch(struct IntPopulation *pop)
+{
+/* Repair buffer of the calling thread. */
+#ifdef _OPENMP
+    return pop->breed_scratch[omp_get_thread_num()];
+#else
+    return pop->breed_scratch[0];
+#endif
+}
+
+unsigned char
+*int_scratch_marks(struct IntPopulation *pop, int *scratch, int child)
+{
+/* Per value marks of 'child' (0 or 1) inside a breeding buffer. */
+    return (unsigned char*) (scratch + 4 * (size_t) pop->length
+                             + pop->range) + (size_t) child * pop->range;
+}
+
+int
+int_next_mutation(int j, float mutate_rate, double log_keep,
+                  uint64_t *rng)
+{
+/* Index of the next mutated gene after gene 'j' (j = -1 for the
+   first one): the gaps between mutations are geometric, so only one
+   random number is drawn per mutation instead of one per gene.
+   'log_keep' is log(1 - mutate_rate).
+   =RETURNS=
+   - The index, which may be >= length (no more mutations). */
+    double gap;
+
+    if (mutate_rate <= 0.0f)
+        return INT_MAX;
+    if (mutate_rate >= 1.0f)
+        return j + 1;
+    /* 1 - rng_double is in (0, 1]. */
+    gap = floor(log(1.0 - rng_double(rng)) / log_keep);
+    if (gap >= (double) (INT_MAX - 1 - j))
+        return INT_MAX;
+    return j + 1 + (int) gap;
+}
+
+void
+int_repair_marked(struct IntPopulation *pop, int *child, int *repeated,
+                  int n_repeated, unsigned char *marks, int *missing,
+                  uint64_t *hash, uint64_t *rng)
+{
+/* Gives random missing values (values not marked in '*marks') to the
+   'n_repeated' genes listed in '*repeated', updating '*hash' if not
+   NULL, and clears the marks. Linear in 'range'. */
+    int j, k, m, tmp, n_missing = 0;
+
+    if (n_repeated > 0)
+    {
+        for (k = 0; k < pop->range; k++)
+        {
+            if (!marks[k])
+                missing[n_missing++] = pop->min_value + k;
+        }
+        /* Partial Fisher-Yates: only the used missing values are
+           drawn. */
+        for (k = 0; k < n_repeated && k < n_missing; k++)
+        {
+            m = k + (int) rng_bounded(rng, (uint32_t) (n_missing - k));
+            tmp = missing[m];
+            missing[m] = missing[k];
+            missing[k] = tmp;
+            j = repeated[k];
+            if (hash != NULL)
+                *hash ^= int_gene_hash(j, child[j]) ^
+                         int_gene_hash(j, tmp);
+            child[j] = tmp;
+        }
+    }
+    memset(marks, 0, pop->range);
+}
+
+void
+int_set_n_threads(struct IntPopulation *pop, int n_threads)
+{
+/* Defines the number of threads used by 'int_crossover',
+   'int_replace_repeated', 'int_mutation' and 'int_evaluate_population'
+   (1 by default). It only has effect when compiled with OpenMP
+   ('-fopenmp'); with n_threads > 1 the objective function must be
+   thread safe. Childs are bred in pairs, each pair with it's own random
+   stream (derived from 'pop->rng_state'), so the results do not depend
+   on 'n_threads'. */
+    if (n_threads < 1)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'n_threads' (%d) passed to 'int_set_n_threads'\n"
+               "must be >= 1.\n"
+               "====================\n", n_threads);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+#ifdef _OPENMP
+    pop->n_threads = n_threads;
+#else
+    pop->n_threads = 1;
+#endif
+}
+
+void
+int_repair_child(struct IntPopulation *pop, int *child, int *scratch,
+                 uint64_t *rng)
+{
+/* Replaces the repeated values of one child by it's missing values
+   (in random order), in a single pass over the genes plus one over the
+   values. '*scratch' must come from 'int_init_breed_buffers'. */
+    int j, value, n_repeated_indexes = 0;
+    int *repeated_indexes = scratch;
+    int *missing_val = scratch + 4 * pop->length;
+    unsigned char *marks = int_scratch_marks(pop, scratch, 0);
+
+    /* Here we check where are the repeated values (the first
+       occurrence of each value is kept). */
+    for (j = 0; j < pop->length; j++)
+    {
+        value = child[j] - pop->min_value;
+        if (marks[value])
+            repeated_indexes[n_repeated_indexes++] = j;
+        else
+            marks[value] = 1;
+    }
+    int_repair_marked(pop, child, repeated_indexes, n_repeated_indexes,
+                      marks, missing_val, NULL, rng);
+}
+
+int
+int_subset_table_size(int length)
+{
+/* Size (power of 2, at least 2 * 'length') of the hash sets used with
+   SUBSET solutions. */
+    int size = 2;
+
+    while (size < 2 * length)
+        size *= 2;
+    return size;
+}
+
+int
+int_subset_insert(struct IntPopulation *pop, int *table, int mask,
+                  int value)
+{
+/* Inserts 'value' in the open addressing hash set '*table' ('mask' + 1
+   entries, 0 for empty ones, the others store value - min_value + 1).
+   =RETURNS=
+   - The entry of 'value' inside '*table' or -1 if it was already
+     there. */
+    int key = value - pop->min_value + 1;
+    int slot = (int) (hash_mix64((uint64_t) key) & (uint64_t) mask);
+
+    while (table[slot] != 0)
+    {
+        if (table[slot] == key)
+            return -1;
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = key;
+    return slot;
+}
+
+int
+int_subset_contains(int *arr, int n, int value)
+{
+/* Binary search of 'value' inside the sorted '*arr' of 'n' ints. */
+    int lo = 0, hi = n - 1, mid;
+
+    while (lo <= hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (arr[mid] == value)
+            return 1;
+        if (arr[mid] < value)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return 0;
+}
+
+void
+int_subset_cross(struct IntPopulation *pop, int *parent1, int *parent2,
+                 int *child1, int *child2, uint64_t *rng)
+{
+/* Union sampling crossover of two SUBSET (sorted) parents: both childs
+   keep the values shared by the parents and the other values of the
+   union are randomly split between them, so each child gets 'length'
+   distinct values, already sorted. Linear in 'length'. */
+    int i = 0, k = 0, n1 = 0, n2 = 0, n_common = 0, n_left, n_take;
+    int value;
+
+    /* Shared values (merge of the sorted parents). */
+    while (i < pop->length && k < pop->length)
+    {
+        if (parent1[i] == parent2[k])
+        {
+            n_common++;
+            i++;
+            k++;
+        }
+        else if (parent1[i] < parent2[k])
+            i++;
+        else
+            k++;
+    }
+    n_take = pop->length - n_common;
+    n_left = 2 * n_take;
+    i = 0;
+    k = 0;
+    while (i < pop->length || k < pop->length)
+    {
+        if (k >= pop->length ||
+            (i < pop->length && parent1[i] < parent2[k]))
+            value = parent1[i++];
+        else if (i >= pop->length || parent2[k] < parent1[i])
+            value = parent2[k++];
+        else
+        {
+            child1[n1++] = parent1[i];
+            child2[n2++] = parent1[i];
+            i++;
+            k++;
+            continue;
+        }
+        /* Selection sampling: 'n_take' of the 'n_left' values left
+           go to the first child, in order. */
+        if ((int) rng_bounded(rng, (uint32_t) n_left) < n_take)
+        {
+            child1[n1++] = value;
+            n_take--;
+        }
+        else
+            child2[n2++] = value;
+        n_left--;
+    }
+}
+
+int
+int_subset_replace(struct IntPopulation *pop, int *child, int *positions,
+                   int n_positions, int *scratch, uint64_t *rng)
+{
+/* Replaces the genes of the SUBSET (sorted) '*child' at the increasing
+   'positions' by random values not in the child, keeping it sorted.
+   The drawn values go through a hash set inside '*scratch' (from
+   'int_init_breed_buffers', left empty after use), so the cost depends
+   on 'length' and 'n_positions', not on 'range'.
+   =RETURNS=
+   - The number of replaced genes. */
+    int i, j, k, value, mask = int_subset_table_size(pop->length) - 1;
+    int *values = scratch + pop->length;
+    int *slots = scratch + 2 * pop->length;
+    int *table = scratch + 4 * pop->length;
+
+    /* Only 'range' - 'length' values are out of the child. */
+    if (n_positions > pop->range - pop->length)
+        n_positions = pop->range - pop->length;
+    for (k = 0; k < n_positions; k++)
+    {
+        do
+        {
+            value = pop->min_value + (int) rng_bounded(rng,
+                                                (uint32_t) pop->range);
+        } while (int_subset_contains(child, pop->length, value) ||
+                 (slots[k] = int_subset_insert(pop, table, mask,
+                                               value)) < 0);
+        values[k] = value;
+    }
+    for (k = 0; k < n_positions; k++)
+    {
+        table[slots[k]] = 0;
+    }
+    if (n_positions == 0)
+        return 0;
+
+    /* Removing the replaced genes and merging the sorted new values
+       from the end. */
+    qsort(values, n_positions, sizeof(int), compare);
+    for (i = 0, j = 0, k = 0; j < pop->length; j++)
+    {
+        if (k < n_positions && positions[k] == j)
+            k++;
+        else
+            child[i++] = child[j];
+    }
+    i--;
+    k = n_positions - 1;
+    for (j = pop->length - 1; k >= 0; j--)
+    {
+        if (i >= 0 && child[i] > values[k])
+            child[j] = child[i--];
+        else
+            child[j] = values[k--];
+    }
+    return n_positions;
+}
+
+void
+int_subset_mutate(struct IntPopulation *pop, int *child, float mutate_rate,
+                  int *scratch, uint64_t *rng)
+{
+/* Uniform mutation of a SUBSET child: each gene is replaced with
+   probability 'mutate_rate' by a value out of the set. */
+    int j, n_positions = 0;
+    double log_keep = log(1.0 - (double) mutate_rate);
+
+    for (j = int_next_mutation(-1, mutate_rate, log_keep, rng);
+         j < pop->length;
+         j = int_next_mutation(j, mutate_rate, log_keep, rng))
+    {
+        scratch[n_positions++] = j;
+    }
+    int_subset_replace(pop, child, scratch, n_positions, scratch, rng);
+}
+
+void
+int_replace_repeated(struct IntPopulation *pop, int **childs,
+                     int n_childs)
+/* This function replaces repeated values from each pointer
+   in **childs - useful after crossover in non-repeatable solutions. */
+{
+    int i;
+    uint64_t seed = rng_next(&pop->rng_state);
+
+    int_init_breed_buffers(pop);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_childs; i++)
+    {
+        uint64_t rng = int_block_stream(seed, i);
+
+        int_repair_child(pop, childs[i], int_thread_scratch(pop), &rng);
+    }
+}
+
+void
+int_cross_pair(struct IntPopulation *pop, int cross_code,
+               int *parent1, int *parent2, int *child1, int *child2,
+               uint64_t *rng)
+{
+/* Crossover of a single pair of parents (see 'int_crossover') using
+   the random stream '*rng'. */
+    int j, k1, k2;
+    uint64_t bits = 0;
+
+    if (cross_code == CROSS_UNION)
+    {
+        int_subset_cross(pop, parent1, parent2, child1, child2, rng);
+        return;
+    }
+    int_cross_points(pop, cross_code, &k1, &k2, rng);
+    for (j = 0; j < pop->length; j++)
+    {
+        if (cross_code == CROSS_UNIFORM)
+        {
+            /* Selecting from parents with equal probability, one
+               random bit per gene. */
+            if ((j & 63) == 0)
+                bits = rng_next(rng);
+            k1 = (int) (bits & 1);
+            bits >>= 1;
+            if (k1)
+            {
+                child1[j] = parent2[j];
+                child2[j] = parent1[j];
+            }
+            else
+            {
+                child1[j] = parent1[j];
+                child2[j] = parent2[j];
+            }
+        }
+        else if (j >= k1 && j < k2)
+        {
+            /* Performing crossover between k1 and k2. */
+            child1[j] = parent2[j];
+            child2[j] = parent1[j];
+        }
+        else
+        {
+            child1[j] = parent1[j];
+            child2[j] = parent2[j];
+        }
+    }
+}
+
+void
+int_cross_points(struct IntPopulation *pop, int cross_code, int *k1,
+                 int *k2, uint64_t *rng)
+{
+/* Genes in [k1, k2) are exchanged by '1kpoint' and '2kpoints'
+   crossovers (k1 = k2 = 0 for 'uniform'). */
+    int tmp;
+
+    *k1 = 0;
+    *k2 = 0;
+    if (cross_code == CROSS_1KPOINT)
+    {
+        /* k1 must be > 0 and < pop->length, genes before it
+           are exchanged ([0, k1) range). */
+        if (pop->length > 1)
+            *k2 = 1 + (int) rng_bounded(rng, (uint32_t) pop->length - 1);
+    }
+    else if (cross_code == CROSS_2KPOINTS)
+    {
+        /* k1 must be >= 0 and < k2
+           k2 must be > k1 and <= pop->length. Two distinct points
+           out of [0, length] with no retries. */
+        *k1 = (int) rng_bounded(rng, (uint32_t) pop->length + 1);
+        *k2 = (int) rng_bounded(rng, (uint32_t) pop->length);
+        if (*k2 >= *k1)
+            (*k2)++;
+        else
+        {
+            tmp = *k1;
+            *k1 = *k2;
+            *k2 = tmp;
+        }
+    }
+}
+
+void
+int_breed_pair(struct IntPopulation *pop, int cross_code, int mutate_code,
+               float mutate_rate, int *parent1, int *parent2,
+               int *child1, int *child2, uint64_t *hash1, uint64_t *hash2,
+               unsigned char *blocks1, unsigned char *blocks2,
+               int *scratch, uint64_t *rng)
+{
+/* Fused crossover, mutation and repair of one pair of parents, read in
+   place. Each gene of the childs is written once: uniform mutation is
+   applied as the crossover writes the gene, repeated values (non-
+   repeatable solutions) and swap mutations are recorded in the same
+   pass and later applied only on the recorded genes. If not NULL,
+   '*hash1' and '*hash2' start with the genome hashes of 'parent1' and
+   'parent2' and end with the ones of the childs, and '*blocks1' and
+   '*blocks2' get the state of each block of the childs (BLOCK_OWN,
+   BLOCK_OTHER or BLOCK_CHANGED, see 'int_set_block_objective').
+   '*scratch' must come from 'int_init_breed_buffers'. */
+    int c, j, k, m, k1, k2, value, tmp, exchange;
+    int n_repeated[2] = {0, 0}, n_swaps[2] = {0, 0}, next_mutation[2];
+    int b = 0, block_end = pop->block_size, same[2] = {3, 3};
+    int *childs[2], *parents[2], *repeated[2], *swaps[2];
+    int *missing = scratch + 4 * pop->length;
+    unsigned char *marks[2], *blocks[2];
+    double log_keep = log(1.0 - (double) mutate_rate);
+    uint64_t bits = 0, *hashes[2];
+
+    childs[0] = child1;
+    childs[1] = child2;
+    parents[0] = parent1;
+    parents[1] = parent2;
+    hashes[0] = hash1;
+    hashes[1] = hash2;
+    blocks[0] = blocks1;
+    blocks[1] = blocks2;
+    for (c = 0; c < 2; c++)
+    {
+        repeated[c] = scratch + 2 * c * pop->length;
+        swaps[c] = repeated[c] + pop->length;
+        marks[c] = int_scratch_marks(pop, scratch, c);
+        next_mutation[c] = int_next_mutation(-1, mutate_rate, log_keep,
+                                             rng);
+    }
+
+    if (pop->non_repeatable == SUBSET)
+    {
+        /* Sets: union crossover and uniform mutation. The values move
+           inside the sorted childs, so their hashes are computed
+           again. */
+        int_subset_cross(pop, parent1, parent2, child1, child2, rng);
+        for (c = 0; c < 2; c++)
+        {
+            int_subset_mutate(pop, childs[c], mutate_rate, scratch, rng);
+            if (blocks[c] != NULL)
+                memset(blocks[c], BLOCK_CHANGED, pop->n_blocks);
+            if (hashes[c] == NULL)
+                continue;
+            *hashes[c] = 0;
+            for (j = 0; j < pop->length; j++)
+            {
+                *hashes[c] ^= int_gene_hash(j, childs[c][j]);
+            }
+        }
+        return;
+    }
+
+    int_cross_points(pop, cross_code, &k1, &k2, rng);
+    for (j = 0; j < pop->length; j++)
+    {
+        /* Crossover. */
+        if (cross_code == CROSS_UNIFORM)
+        {
+            if ((j & 63) == 0)
+                bits = rng_next(rng);
+            exchange = (int) (bits & 1);
+            bits >>= 1;
+        }
+        else
+            exchange = (j >= k1 && j < k2);
+        for (c = 0; c < 2; c++)
+        {
+            value = parents[c ^ exchange][j];
+            /* Mutation (only the drawn genes are visited). */
+            if (j == next_mutation[c])
+            {
+                next_mutation[c] = int_next_mutation(j, mutate_rate,
+                                                     log_keep, rng);
+                if (mutate_code == MUTATE_SWAP)
+                    swaps[c][n_swaps[c]++] = j;
+                else if (pop->range > 1)
+                {
+                    tmp = pop->min_value + (int) rng_bounded(rng,
+                                                (uint32_t) pop->range - 1);
+                    value = (tmp >= value) ? tmp + 1 : tmp;
+                }
+            }
+            /* Repeated values. */
+            if (pop->non_repeatable == NO_REPEAT)
+            {
+                if (marks[c][value - pop->min_value])
+                    repeated[c][n_repeated[c]++] = j;
+                else
+                    marks[c][value - pop->min_value] = 1;
+            }
+            childs[c][j] = value;
+            if (hashes[c] != NULL && value != parents[c][j])
+                *hashes[c] ^= int_gene_hash(j, parents[c][j]) ^
+                              int_gene_hash(j, value);
+            /* Block still equal to the own (bit 1) and the other
+               (bit 2) parent. */
+            if (blocks[c] != NULL)
+                same[c] &= ~((value != parents[c][j]) |
+                             ((value != parents[c ^ 1][j]) << 1));
+        }
+        if ((blocks[0] != NULL || blocks[1] != NULL) &&
+            (j + 1 == block_end || j + 1 == pop->length))
+        {
+            for (c = 0; c < 2; c++)
+            {
+                if (blocks[c] != NULL)
+                    blocks[c][b] = (same[c] & 1) ? BLOCK_OWN :
+                                   (same[c] & 2) ? BLOCK_OTHER :
+                                   BLOCK_CHANGED;
+                same[c] = 3;
+            }
+            b++;
+            block_end += pop->block_size;
+        }
+    }
+
+    for (c = 0; c < 2; c++)
+    {
+        /* Repair: repeated genes get random missing values. */
+        for (k = 0; k < n_repeated[c] && blocks[c] != NULL; k++)
+        {
+            blocks[c][repeated[c][k] / pop->block_size] = BLOCK_CHANGED;
+        }
+        if (pop->non_repeatable == NO_REPEAT)
+            int_repair_marked(pop, childs[c], repeated[c], n_repeated[c],
+                              marks[c], missing, hashes[c], rng);
+        /* Swap mutations (after the repair, as in 'int_mutation'). */
+        for (k = 0; k < n_swaps[c] && pop->length > 1; k++)
+        {
+            j = swaps[c][k];
+            m = (int) rng_bounded(rng, (uint32_t) pop->length - 1);
+            if (m >= j)
+                m++;
+            if (blocks[c] != NULL)
+            {
+                blocks[c][j / pop->block_size] = BLOCK_CHANGED;
+                blocks[c][m / pop->block_size] = BLOCK_CHANGED;
+            }
+            if (hashes[c] != NULL)
+                *hashes[c] ^= int_gene_hash(j, childs[c][j]) ^
+                              int_gene_hash(m, childs[c][m]) ^
+                              int_gene_hash(j, childs[c][m]) ^
+                              int_gene_hash(m, childs[c][j]);
+            tmp = childs[c][m];
+            childs[c][m] = childs[c][j];
+            childs[c][j] = tmp;
+        }
+    }
+}
+
+void
+int_breed(struct IntPopulation *pop, char *cross_mode, char *mutate_mode,
+          float mutate_rate, int *selected, int n_parents, int n_childs)
+{
+/* Fused breeding for 'int_ga_one_iter': the 'n_childs' childs of the
+   'selected' parents (indexes inside pop->individuals, read in place)
+   are written straight into 'ext_new_individuals'. With genome hashes
+   (see 'int_tracks_hashes'), their hashes go to 'pop->child_hashes'.
+   With genome sharing, parents with the same row have clones or
+   mutated copies as childs (see 'int_cow_plan_childs'). With a block
+   objective, the block scores of the childs are taken from their
+   parents ('next_block_scores', see 'int_set_block_objective'). */
+    int i, cross_code, mutate_code;
+    int cow = (pop->cow_mode == COW_SHARE);
+    int blocks = (pop->block_function != NULL && pop->mo_n_objectives == 0);
+    uint64_t seed;
+
+    cross_code = int_cross_mode_code(pop, cross_mode, n_parents);
+    mutate_code = int_mutate_mode_code(pop, mutate_mode);
+    seed = rng_next(&pop->rng_state);
+    int_init_breed_buffers(pop);
+    if (cow)
+        int_cow_plan_childs(pop, selected, n_childs, mutate_rate, seed);
+    if (blocks)
+    {
+        int_block_alloc(pop);
+        pop->block_synced = 1;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_childs; i += 2)
+    {
+        uint64_t rng = int_block_stream(seed, i / 2);
+        /* An odd last child has it's sibling in 'ext_childs[0]'. */
+        int k, last = (i + 1 == n_childs);
+        uint64_t *hashes = int_tracks_hashes(pop) ? pop->child_hashes
+                                                  : NULL;
+        uint64_t sibling_hash = 0;
+        /* Block states, resolved to scores below. */
+        unsigned char *codes = blocks ? pop->next_block_dirty
+                                        + (size_t) i * pop->n_blocks
+                                      : NULL;
+
+        if (hashes != NULL)
+        {
+            hashes[i] = pop->hashes[selected[i]];
+            if (!last)
+                hashes[i + 1] = pop->hashes[selected[i + 1]];
+        }
+        if (cow && pop->individuals[selected[i]] ==
+                   pop->individuals[selected[i + 1]])
+        {
+            /* Twins, each one with it's own stream (see
+               'int_cow_plan_childs'). */
+            for (k = i; k < i + 2 && k < n_childs; k++)
+            {
+                rng = int_block_stream(seed, n_childs + k);
+                if (!pop->cow_clones[k])
+                    int_cow_breed_twin(pop, mutate_code, mutate_rate,
+                                       pop->individuals[selected[k]],
+                                       pop->ext_new_individuals[k],
+                                       hashes ? &hashes[k] : NULL, &rng);
+                if (!blocks)
+                    continue;
+                if (pop->cow_clones[k])
+                    memset(codes + (size_t) (k - i) * pop->n_blocks,
+                           BLOCK_OWN, pop->n_blocks);
+                else
+                    int_block_compare(pop, codes + (size_t) (k - i)
+                                           * pop->n_blocks,
+                                      pop->individuals[selected[k]],
+                                      pop->ext_new_individuals[k]);
+                int_block_resolve(pop, k, selected[k], selected[k]);
+            }
+            continue;
+        }
+        int_breed_pair(pop, cross_code, mutate_code, mutate_rate,
+                       pop->individuals[selected[i]],
+                       pop->individuals[selected[i + 1]],
+                       pop->ext_new_individuals[i],
+                       last ? pop->ext_childs[0]
+                            : pop->ext_new_individuals[i + 1],
+                       hashes ? &hashes[i] : NULL,
+                       hashes ? (last ? &sibling_hash : &hashes[i + 1])
+                              : NULL,
+                       codes, (codes && !last) ? codes + pop->n_blocks
+                                               : NULL,
+                       int_thread_scratch(pop), &rng);
+        if (!blocks)
+            continue;
+        int_block_resolve(pop, i, selected[i], selected[i + 1]);
+        if (!last)
+            int_block_resolve(pop, i + 1, selected[i + 1], selected[i]);
+    }
+}
+
+int
+int_adopt_childs(struct IntPopulation *pop, int n_childs)
+{
+/* Completes the next generation after 'int_breed': the childs are
+   already in 'ext_new_individuals' and the remaining individuals are
+   the elites. For heap storage the rows are swapped (elites keep their
+   own rows, the released ones go back to 'ext_new_individuals', unless
+   they are still shared), for mapped storage elites are copied and the
+   regions swapped.
+   =RETURNS=
+   - 1 if the genome hashes of the next generation are tracked
+     (see 'int_tracks_hashes'), 0 otherwise. */
+    int i, j, n_free = 0;
+    int n_elites = pop->n_population - n_childs;
+    int synced = int_tracks_hashes(pop);
+    int *is_elite, **rows;
+    /* Best individuals first (by the niched fos, if set). */
+    int *elites = int_select_order(pop);
+    uint64_t *hashes = NULL;
+
+    for (i = 0; i < n_elites && pop->dedup_mode != DEDUP_NONE; i++)
+    {
+        /* Elites don't need to be evaluated again. */
+        pop->next_fos[n_childs + i] = pop->fos[elites[i]];
+        pop->next_fo_known[n_childs + i] = 1;
+    }
+    if (synced)
+    {
+        hashes = ec_malloc(pop->n_population * sizeof(uint64_t),
+                           __LINE__, __FILE__);
+        for (i = 0; i < pop->n_population; i++)
+        {
+            hashes[i] = (i < n_childs) ? pop->child_hashes[i] :
+                        pop->hashes[elites[i - n_childs]];
+        }
+        memcpy(pop->hashes, hashes, pop->n_population * sizeof(uint64_t));
+        free(hashes);
+    }
+    if (pop->block_synced)
+    {
+        /* Block scores of the elites, then the ones of the next
+           generation become current (see 'int_set_block_objective'). */
+        for (i = 0; i < n_elites; i++)
+        {
+            memcpy(pop->next_block_scores
+                   + (size_t) (n_childs + i) * pop->n_blocks,
+                   pop->block_scores + (size_t) elites[i] * pop->n_blocks,
+                   pop->n_blocks * sizeof(float));
+            memcpy(pop->next_block_dirty
+                   + (size_t) (n_childs + i) * pop->n_blocks,
+                   pop->block_dirty + (size_t) elites[i] * pop->n_blocks,
+                   pop->n_blocks);
+        }
+        int_block_swap(pop);
+    }
+
+    if (pop->storage == STORAGE_MMAP)
+    {
+        for (i = 0; i < n_elites; i++)
+        {
+            memcpy(pop->ext_new_individuals[n_childs + i],
+                   pop->individuals[elites[i]],
+                   sizeof(int) * pop->length);
+        }
+        /* Mapped generations are swapped instead of copied. */
+        int_mmap_set_current(pop, 1 - pop->mmap_current);
+        return synced;
+    }
+
+    is_elite = ec_calloc(pop->n_population, sizeof(int), __LINE__, __FILE__);
+    rows = ec_malloc(pop->n_population * sizeof(int*), __LINE__, __FILE__);
+    for (i = 0; i < n_elites; i++)
+    {
+        is_elite[elites[i]] = 1;
+        rows[n_childs + i] = pop->individuals[elites[i]];
+    }
+    for (i = 0; i < n_childs; i++)
+    {
+        rows[i] = pop->ext_new_individuals[i];
+    }
+    /* Released rows (non elites) replace the childs ones. With genome
+       sharing (see 'int_set_genome_sharing'), rows still shared are left
+       to their other references and the others are spare rows, only as
+       many as the childs written by the last breeding are kept (childs
+       get their rows when bred, see 'int_cow_plan_childs'). */
+    for (j = 0; j < pop->n_population; j++)
+    {
+        if (is_elite[j])
+            continue;
+        if (pop->cow_mode != COW_SHARE)
+            pop->ext_new_individuals[n_free++] = pop->individuals[j];
+        else if (int_cow_release(pop, pop->individuals[j]))
+            int_cow_spare_row(pop, pop->individuals[j]);
+    }
+    memcpy(pop->individuals, rows, pop->n_population * sizeof(int*));
+    for (i = 0; i < n_childs && pop->cow_mode == COW_SHARE; i++)
+    {
+        n_free += !pop->cow_clones[i];
+        pop->ext_new_individuals[i] = NULL;
+    }
+    while (pop->n_cow_spare > n_free && pop->cow_mode == COW_SHARE)
+    {
+        free(pop->cow_spare[--pop->n_cow_spare]);
+    }
+    free(rows);
+    free(is_elite);
+    return synced;
+}
+
+void
+int_mutate_child(struct IntPopulation *pop, int mutate_code, int *child,
+                 float mutate_rate, uint64_t *rng)
+{
+/* Mutation of a single individual (see 'int_mutation') using the
+   random stream '*rng'. Only the mutated genes are visited (see
+   'int_next_mutation'). */
+    int j, p1, tmp;
+    double log_keep = log(1.0 - (double) mutate_rate);
+
+    if (pop->non_repeatable == SUBSET)
+    {
+        int_subset_mutate(pop, child, mutate_rate, int_thread_scratch(pop),
+                          rng);
+        return;
+    }
+    for (j = int_next_mutation(-1, mutate_rate, log_keep, rng);
+         j < pop->length;
+         j = int_next_mutation(j, mutate_rate, log_keep, rng))
+    {
+        if (mutate_code == MUTATE_SWAP)
+        {
+            /* Swap item individual[p1] with item individual[j],
+               p1 != j. */
+            if (pop->length < 2)
+                return;
+            p1 = (int) rng_bounded(rng, (uint32_t) pop->length - 1);
+            if (p1 >= j)
+                p1++;
+            tmp = child[p1];
+            child[p1] = child[j];
+            child[j] = tmp;
+        }
+        else
+        {
+            /* Switching by another random value within
+               solution min_value and max_value. */
+            if (pop->range < 2)
+                return;
+            p1 = pop->min_value + (int) rng_bounded(rng,
+                                                    (uint32_t) pop->range - 1);
+            if (p1 >= child[j])
+                p1++;
+            child[j] = p1;
+        }
+    }
+}
+
+int
+int_cross_mode_code(struct IntPopulation *pop, char *cross_mode,
+                    int n_parents)
+{
+/* Returns the CROSS_* code of '*cross_mode' (see 'int_crossover'),
+   exiting with an error for unknown modes or odd 'n_parents'. */
+    int cross_code = -1;
+
+    /* Sanity check. */
+    check_null(cross_mode, __LINE__, __FILE__);
+
+    if (strcmp(cross_mode, "1kpoint") == 0)
+        cross_code = CROSS_1KPOINT;
+    else if (strcmp(cross_mode, "2kpoints") == 0)
+        cross_code = CROSS_2KPOINTS;
+    else if (strcmp(cross_mode, "uniform") == 0)
+        cross_code = CROSS_UNIFORM;
+    else if (strcmp(cross_mode, "union") == 0)
+        cross_code = CROSS_UNION;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'cross_mode' ('%s') argument passed to\n"
+               "'int_crossover' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'1kpoint'  :   swap content of parent 1 with parent"
+               " 2\n\t\tfrom index 0 to random index k1.\n"
+               "-'2kpoints' :   swap content of parent 1 with parent"
+               "2\n\t\tfrom random index k1 to random index k2"
+               "\n\t\t(k2 > k1).\n"
+               "-'uniform'  :   For each gene, there's a 0.5 probability"
+               " that\n\t\ta gene will be selected from one parent or"
+               "\n\t\tthe other.\n"
+               "-'union'    :   (SUBSET solutions only) shared values are"
+               "\n\t\tkept, the others randomly split between"
+               "\n\t\tthe childs.\n"
+               "====================\n", cross_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if ((cross_code == CROSS_UNION) != (pop->non_repeatable == SUBSET))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "SUBSET solutions need (and only them accept)\n"
+               "'union' crossover ('%s' passed).\n"
+               "====================\n", cross_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (n_parents % 2 != 0)
+    {
+        fprintf(stderr, "For %s crossover the number of\n"
+               "parents must be even!.\n", cross_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    return cross_code;
+}
+
+int
+int_mutate_mode_code(struct IntPopulation *pop, char *mutate_mode)
+{
+/* Returns the MUTATE_* code of '*mutate_mode' (see 'int_mutation'),
+   exiting with an error for unknown modes. */
+
+    /* Sanity check. */
+    check_null(mutate_mode, __LINE__, __FILE__);
+
+    if ((strcmp(mutate_mode, "swap") == 0) &&
+        (pop->non_repeatable != SUBSET))
+    {
+        /* Does not depend on 'non-repeatable' value (meaningless for
+           sorted SUBSET solutions). */
+        return MUTATE_SWAP;
+    }
+    else if ((strcmp(mutate_mode, "uniform") == 0) &&
+            (pop->non_repeatable != NO_REPEAT))
+    {
+        /* Can't be applied to non-repeatable solutions (SUBSET ones
+           get values out of the set). */
+        return MUTATE_UNIFORM;
+    }
+    fprintf(stderr, "===ARGUMENT ERROR===\n"
+           "Wrong 'mutate_mode' ('%s') argument passed\nto"
+           "'int_mutation' function.\nThe supported"
+           " arguments are (so far):\n"
+           "-'swap'    :    Probability of 'mutate_rate' that one gene"
+           "\n\t\twill be swapped with another random gene\n\t\tfrom the"
+           " same individual (not for SUBSET solutions).\n"
+           "-'uniform' :    Probability of 'mutate_rate' that one gene"
+           "\n\t\twill be replaced with a different random\n\t\t"
+           "possible gene from the solution boundaries.\n"
+           "====================\n", mutate_mode);
+    int_free_population(pop);
+    exit(EXIT_FAILURE);
+}
+
+void
+int_crossover(char *cross_mode, struct IntPopulation *pop,
+              int **parents, int **childs, int n_parents)
+{
+/* This function defines the pointers from '**childs' using a crossover
+   method defined by '*cross_mode' applied to the parents inside
+   '**parents'. Shape of '**parents' is [n_parents][pop->length].
+   The shape of parents depends on the '**cross_mode'.
+   More info on some methods:
+   https://en.wikipedia.org/wiki/Genetic_algorithm
+   =ARGUMENTS=
+   - '*cross_mode' : Method for crossover between '**parents'. Know-methods:
+                        - '1kpoint'  : Select random k1 point and exchange
+                                       around it within 2 parents.
+                                       '**childs' shape:
+                                       [n_parents][pop->length].
+                        - '2kpoints' : Select two random k1, k2 points and
+                                       exchange between them in 2 parents.
+                                       '**childs' shape:
+                                       [n_parents][pop->length].
+                        - 'uniform' :  Choose one value from two parents with
+                                       equal probability.
+                                       '**childs' shape:
+                                       [n_parents][pop->length].
+                        - 'union' :    (SUBSET solutions, which only accept
+                                       this one) Shared values are kept and
+                                       the others of both parents are
+                                       randomly split between the childs.
+                                       '**childs' shape:
+                                       [n_parents][pop->length].
+   - '*pop' : IntPopulation struct already initialized and evaluated.
+   - '**parents' : Pointer of parents (int arrays) with shape:
+                   [n_parents][pop->length]
+                   Usually defined using selection method.
+   - '**childs'  : An initialized via calloc/malloc pointer of pointers
+                   with shape selected from method:
+                   [n_childs][pop->length]
+                   e.g. for '1kpoint':
+                   [n_parents][pop->length]; n_parents = n_childs.
+                   But there are a few crossover methods in which
+                   n_parents != n_childs, and the correct shape within
+                   **childs must be provided.
+                   Each child values will be defined via crossover method.
+   - 'n_parents' : Number of parents (pointers inside '**parents'). */
+
+    int i, cross_code;
+    uint64_t seed;
+
+    cross_code = int_cross_mode_code(pop, cross_mode, n_parents);
+    seed = rng_next(&pop->rng_state);
+    int_init_breed_buffers(pop);
+    /* Independent pairs, each with it's own random stream. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_parents; i += 2)
+    {
+        uint64_t rng = int_block_stream(seed, i / 2);
+
+        int_cross_pair(pop, cross_code, parents[i], parents[i+1],
+                       childs[i], childs[i+1], &rng);
+        if (pop->non_repeatable == NO_REPEAT)
+        {
+            /* Replace the repeated values after crossover. */
+            int_repair_child(pop, childs[i], int_thread_scratch(pop), &rng);
+            int_repair_child(pop, childs[i+1], int_thread_scratch(pop),
+                             &rng);
+        }
+    }
+}
+
+void
+int_mutation(char *mutate_mode, struct IntPopulation *pop,
+             int **new_individuals, int n_new_individuals,
+             float mutate_rate)
+{
+/* This function performs the mutation operation inside
+   a pointer of individuals ('**new_individuals').
+   This operator is an absolut must, as generates diversification
+   across future generations. Without it, the chances that the GA
+   algorithm will convert are very low. A few mutation types are accepted,
+   more info on these, check:
+   https://en.wikipedia.org/wiki/Mutation_(genetic_algorithm)
+   =ARGUMENTS=
+   - '*mutate_mode': A string containing the method used for mutation.:
+                     - 'swap' : For the mutated individual, one of it's
+                                gene will be swapped with another of it's
+                                own gene. Useful in non-repeatable solutions.
+                                Not for SUBSET solutions.
+                     - 'uniform' : The mutated individual will have one of
+                                   it's gene randomly replaced with another
+                                   possible value for the solution. Can't be
+                                   applied to NO_REPEAT solutions (SUBSET
+                                   ones get a value out of the set). For
+                                   binary-coded solutions (i.e. pop->max_value
+                                   =1 and pop->min_value=0) it's the same as
+                                   'flip bit' mutation type.
+   - '**new_individuals' : A pointer to int pointers of the problem solution.
+                           In the most general case, can be pop->individuals
+                           or ext_childs if n_parents < n_population.
+   - 'n_new_individuals' : Number of pointers inside '**new_individuals'.
+   - '*pop' : A pointer to the current already initialized/defined
+              IntPopulation structure.
+   - '*mutate_rate' : The probability that an gene will be mutate. */
+
+    int i, mutate_code;
+    uint64_t seed;
+
+    mutate_code = int_mutate_mode_code(pop, mutate_mode);
+    seed = rng_next(&pop->rng_state);
+    int_init_breed_buffers(pop);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_new_individuals; i++)
+    {
+        uint64_t rng = int_block_stream(seed, i);
+
+        int_mutate_child(pop, mutate_code, new_individuals[i],
+                         mutate_rate, &rng);
+    }
+}
+
+/*==========================*/
+/* Population resizing. */
+void
+int_set_population_alloc(struct IntPopulation *pop, int new_n_alloc)
+{
+/* Reallocs every population sized buffer (individuals, evaluation
+   arrays, all time best and the external pointers) to 'new_n_alloc'
+   rows. Rows >= 'new_n_alloc' are lost, so the caller must have
+   compacted the population before.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - 'new_n_alloc' : New number of alloc'd rows (>= pop->n_population). */
+    if (new_n_alloc == pop->n_population_alloc)
+        return;
+    if (pop->storage == STORAGE_MMAP)
+    {
+        /* The mapped file keeps it's size: rows are only reused. */
+        if (new_n_alloc > pop->n_population_alloc)
+        {
+            fprintf(stderr, "Impossible to grow a memory mapped population"
+                   "\nbeyond the %d individuals of it's file.\n",
+                   pop->n_population_alloc);
+            int_free_population(pop);
+            exit(EXIT_FAILURE);
+        }
+        return;
+    }
+
+    pop->individuals = int_realloc_rows(pop->individuals,
+                                        pop->n_population_alloc,
+                                        new_n_alloc, pop->length);
+    pop->fos = realloc(pop->fos, new_n_alloc * sizeof(float));
+    check_null(pop->fos, __LINE__, __FILE__);
+    pop->sorted_fos = realloc(pop->sorted_fos, new_n_alloc * sizeof(float));
+    check_null(pop->sorted_fos, __LINE__, __FILE__);
+    pop->sorted_fos_indexes = realloc(pop->sorted_fos_indexes,
+                                      new_n_alloc * sizeof(int));
+    check_null(pop->sorted_fos_indexes, __LINE__, __FILE__);
+    pop->best_indexes = realloc(pop->best_indexes,
+                                new_n_alloc * sizeof(int));
+    check_null(pop->best_indexes, __LINE__, __FILE__);
+    pop->n_population_alloc = new_n_alloc;
+    int_resize_ext_ptrs(pop, new_n_alloc);
+}
+
+void
+int_resize_population(struct IntPopulation *pop, int new_n_population,
+                      int release_memory)
+{
+/* This function changes the number of individuals of an already
+   evaluated population, keeping all the pop buffers (individuals,
+   fos, rankings, external pointers) consistent.
+   - Shrinking keeps the best 'new_n_population' individuals, which are
+     compacted (by pointer, not copy) to the first rows in ranking order.
+   - Growing fills the new rows with random individuals (see
+     'int_init_solution') evaluated with the last objective function
+     passed to 'int_evaluate_population', reallocating if needed.
+   The ranking ('sorted_fos', 'sorted_fos_indexes', 'best_indexes' and
+   'best_fo') is always valid after the call.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+              Populations with 'unalloc' init_mode can't be resized.
+   - 'new_n_population' : The new number of individuals (>= 2).
+   - 'release_memory' : RELEASE_MEMORY frees the rows and buffers not used
+                        after a shrink, KEEP_MEMORY keeps them alloc'd so a
+                        later growth doesn't need new allocations. */
+    int i, n_population = pop->n_population;
+    int **ranked;
+
+    /* Sanity check. */
+    if (pop->first_population == POP_NOT_EVAL ||
+        strcmp(pop->init_mode, "unalloc") == 0 ||
+        new_n_population < 2)
+    {
+        fprintf(stderr, "Impossible to resize the population:\n"
+               "it must be evaluated, have library alloc'd individuals\n"
+               "(init_mode != 'unalloc') and 'new_n_population' >= 2.\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    /* Rows are moved, free'd and reused as private ones. */
+    int_unshare_rows(pop);
+
+    if (new_n_population < n_population)
+    {
+        /* Compacting the individuals in ranking order, so the best
+           'new_n_population' ones are the first rows. Only pointers
+           are moved, the rows of the removed individuals stay behind
+           them to be reused or free'd. */
+        ranked = ec_malloc(n_population * sizeof(int*), __LINE__, __FILE__);
+        for (i = 0; i < n_population; i++)
+        {
+            ranked[i] = pop->individuals[pop->sorted_fos_indexes[i]];
+        }
+        if (pop->storage == STORAGE_MMAP)
+        {
+            /* Mapped rows must keep the file order (sequential access
+               and restarts), so the kept individuals are copied to
+               the other individuals region, which becomes current. */
+            for (i = 0; i < new_n_population; i++)
+            {
+                memcpy(int_mmap_row(pop, 1 - pop->mmap_current, i),
+                       ranked[i], sizeof(int) * pop->length);
+            }
+            int_mmap_set_current(pop, 1 - pop->mmap_current);
+        }
+        else
+            memcpy(pop->individuals, ranked, n_population * sizeof(int*));
+        free(ranked);
+        for (i = 0; i < n_population; i++)
+        {
+            pop->fos[i] = pop->sorted_fos[i];
+            pop->sorted_fos_indexes[i] = i;
+        }
+        pop->n_population = new_n_population;
+        if (pop->n_best_individuals > new_n_population)
+            pop->n_best_individuals = new_n_population;
+        for (i = 0; i < pop->n_best_individuals; i++)
+        {
+            pop->best_indexes[i] = i;
+        }
+        if (release_memory == RELEASE_MEMORY)
+            int_set_population_alloc(pop, new_n_population);
+    }
+    else if (new_n_population > n_population)
+    {
+        if (pop->objective_function == NULL)
+        {
+            fprintf(stderr, "Impossible to grow the population without\n"
+                   "an objective function to evaluate new individuals.\n");
+            int_free_population(pop);
+            exit(EXIT_FAILURE);
+        }
+        if (new_n_population > pop->n_population_alloc)
+            int_set_population_alloc(pop, new_n_population);
+        /* New random individuals. */
+        int_init_individuals(pop, pop->individuals + n_population,
+                             new_n_population - n_population,
+                             pop->n_threads);
+        for (i = n_population; i < new_n_population; i++)
+        {
+            pop->fos[i] = pop->objective_function(pop->individuals[i],
+                                                  pop->length);
+            pop->n_evaluations++;
+        }
+        pop->n_population = new_n_population;
+        int_update_ranking(pop);
+    }
+    /* Rows moved or new: their block scores are evaluated again. */
+    for (i = 0; i < pop->n_population; i++)
+    {
+        int_block_invalidate(pop, i);
+    }
+    if (int_tracks_hashes(pop))
+        int_update_diversity(pop);
+}
+
+void
+int_set_resize_schedule(struct IntPopulation *pop, char *resize_mode,
+                        float factor, int min_pop, int max_pop,
+                        int patience, double time_budget,
+                        int release_memory)
+{
+/* This function defines a schedule used by 'int_ga_one_iter' to resize
+   the population (through 'int_resize_population') after each evaluation.
+   When a schedule is active, the 'n_parents' and 'n_childs' arguments of
+   'int_ga_one_iter' refer to 'n_population_orig' and are scaled to the
+   current population size (rounded down to even values).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*resize_mode' : 'none', 'improvement', 'stagnation', 'adaptive'
+                      or 'time' (see GA_int.h for details).
+   - 'factor' : Resize factor.
+   - 'min_pop', 'max_pop' : Boundaries for the population size.
+   - 'patience' : Stagnant generations before growing.
+   - 'time_budget' : Seconds for the 'time' mode.
+   - 'release_memory' : See 'int_resize_population'. */
+
+    /* Sanity check. */
+    check_null(resize_mode, __LINE__, __FILE__);
+
+    if (strcmp(resize_mode, "none") == 0)
+        pop->resize_mode = RESIZE_NONE;
+    else if (strcmp(resize_mode, "improvement") == 0)
+        pop->resize_mode = RESIZE_IMPROVEMENT;
+    else if (strcmp(resize_mode, "stagnation") == 0)
+        pop->resize_mode = RESIZE_STAGNATION;
+    else if (strcmp(resize_mode, "adaptive") == 0)
+        pop->resize_mode = RESIZE_ADAPTIVE;
+    else if (strcmp(resize_mode, "time") == 0)
+        pop->resize_mode = RESIZE_TIME;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'resize_mode' ('%s') argument passed\nto "
+               "'int_set_resize_schedule' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none'        :    no population resizing.\n"
+               "-'improvement' :    multiply pop size by 'factor' on"
+               "\n\t\tevery improvement of the best fo.\n"
+               "-'stagnation'  :    multiply pop size by 'factor' after"
+               "\n\t\t'patience' generations without improvement.\n"
+               "-'adaptive'    :    shrink by 'factor' on improvement and"
+               "\n\t\tgrow by 1/'factor' on stagnation.\n"
+               "-'time'        :    linear reduction to 'min_pop' within"
+               "\n\t\t'time_budget' seconds.\n"
+               "====================\n", resize_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (min_pop < 2 || max_pop < min_pop || factor <= 0.0 ||
+        ((pop->resize_mode == RESIZE_STAGNATION ||
+          pop->resize_mode == RESIZE_ADAPTIVE) && patience < 1) ||
+        (pop->resize_mode == RESIZE_TIME && time_budget <= 0.0))
+    {
+        fprintf(stderr, "Invalid resize schedule for '%s' mode:\n"
+               "needs 2 <= min_pop <= max_pop, factor > 0,\n"
+               "patience >= 1 (stagnation/adaptive) and\n"
+               "time_budget > 0 (time).\n", resize_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->resize_factor = factor;
+    pop->resize_min_pop = min_pop;
+    pop->resize_max_pop = max_pop;
+    pop->resize_patience = patience;
+    pop->resize_time_budget = time_budget;
+    pop->resize_release_memory = release_memory;
+    clock_gettime(CLOCK_MONOTONIC, &pop->resize_start);
+}
+
+int
+int_apply_resize_schedule(struct IntPopulation *pop)
+{
+/* Applies the schedule defined by 'int_set_resize_schedule' to an
+   evaluated population. Called automatically by 'int_ga_one_iter'.
+   =RETURNS=
+   - 1 if the population was resized, 0 otherwise. */
+    int new_n_population = pop->n_population;
+    int improved, stagnated;
+    double elapsed;
+    struct timespec now;
+
+    improved = (pop->n_stagnant_gens == 0 && pop->generation > 0);
+    stagnated = (pop->n_stagnant_gens > 0 && pop->resize_patience > 0 &&
+                 pop->n_stagnant_gens % pop->resize_patience == 0);
+
+    switch (pop->resize_mode)
+    {
+        case RESIZE_IMPROVEMENT:
+            if (improved)
+                new_n_population = (int) ((float) pop->n_population
+                                          * pop->resize_factor);
+            break;
+        case RESIZE_STAGNATION:
+            if (stagnated)
+                new_n_population = (int) ((float) pop->n_population
+                                          * pop->resize_factor);
+            break;
+        case RESIZE_ADAPTIVE:
+            if (improved)
+                new_n_population = (int) ((float) pop->n_population
+                                          * pop->resize_factor);
+            else if (stagnated)
+                new_n_population = (int) ((float) pop->n_population
+                                          / pop->resize_factor);
+            break;
+        case RESIZE_TIME:
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            elapsed = now.tv_sec - pop->resize_start.tv_sec
+                      + (now.tv_nsec - pop->resize_start.tv_nsec) / 1e9;
+            elapsed /= pop->resize_time_budget;
+            if (elapsed > 1.0)
+                elapsed = 1.0;
+            new_n_population = pop->n_population_orig - (int) (elapsed
+                * (pop->n_population_orig - pop->resize_min_pop));
+            break;
+        default:
+            return 0;
+    }
+    if (new_n_population < pop->resize_min_pop)
+        new_n_population = pop->resize_min_pop;
+    if (new_n_population > pop->resize_max_pop)
+        new_n_population = pop->resize_max_pop;
+    if (new_n_population == pop->n_population)
+        return 0;
+    int_resize_population(pop, new_n_population,
+                          pop->resize_release_memory);
+    return 1;
+}
+
+int
+int_scale_to_pop(struct IntPopulation *pop, int n)
+{
+/* Scales a number of parents/childs given for 'n_population_orig'
+   to the current population size when a resize schedule is set.
+   The result is even, >= 2 and <= pop->n_population. */
+    if (pop->resize_mode == RESIZE_NONE)
+        return n;
+    n = (int) ((float) n * (float) pop->n_population
+               / (float) pop->n_population_orig);
+    if (n > pop->n_population)
+        n = pop->n_population;
+    if (n % 2)
+        n--; /* Only even values. */
+    if (n < 2)
+        n = 2;
+    return n;
+}
+
+/*==========================*/
+/* Memory mapped storage. */
+int
+*int_mmap_row(struct IntPopulation *pop, int region, int row)
+{
+/* Returns the pointer to 'row' of 'region' inside the mapped file. */
+    return (int*) (pop->mmap_base + MMAP_HEADER_SIZE
+                   + (size_t) region * pop->mmap_region_size
+                   + (size_t) row * pop->length * sizeof(int));
+}
+
+void
+int_mmap_advise(struct IntPopulation *pop, int *row, int n_rows,
+                int advice)
+{
+/* 'madvise' for 'n_rows' consecutive mapped rows starting at 'row'
+   (the range is page aligned, as required by madvise). */
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t start = (size_t) ((char*) row - pop->mmap_base);
+    size_t end = start + (size_t) n_rows * pop->length * sizeof(int);
+
+    start -= start % page;
+    if (end > pop->mmap_size)
+        end = pop->mmap_size;
+    if (n_rows > 0 && end > start)
+        madvise(pop->mmap_base + start, end - start, advice);
+}
+
+void
+int_mmap_set_current(struct IntPopulation *pop, int region)
+{
+/* Makes 'region' (0 or 1) the current individuals region: pop
+   individuals point to it's rows, and 'ext_new_individuals'
+   (if alloc'd) to the other region. */
+    int i;
+
+    pop->mmap_current = region;
+    for (i = 0; i < pop->n_population_alloc; i++)
+    {
+        pop->individuals[i] = int_mmap_row(pop, region, i);
+    }
+    for (i = 0; i < pop->ext_rows; i++)
+    {
+        pop->ext_new_individuals[i] = int_mmap_row(pop, 1 - region, i);
+    }
+    int_mmap_write_header(pop);
+}
+
+void
+int_mmap_write_header(struct IntPopulation *pop)
+{
+/* Writes the population metadata needed for a restart
+   in the header of the mapped file. */
+    struct IntMmapHeader *header = (struct IntMmapHeader*) pop->mmap_base;
+
+    header->n_population = pop->n_population;
+    header->current = pop->mmap_current;
+    header->generation = pop->generation;
+    header->hof_size = pop->hof_size;
+    header->best_fo_alltime = pop->best_fo_alltime;
+}
+
+void
+int_map_population(struct IntPopulation *pop, char *path, int remap)
+{
+/* Maps the individuals of 'pop' to the file at 'path'. If 'remap' == 0,
+   the file is created and the individuals are randomly initialized,
+   otherwise the existing file is mapped and checked against the pop
+   boundaries. A NULL 'path' maps anonymous shared memory instead of a
+   file ('shared' init_mode). */
+    int fd = -1;
+    struct IntMmapHeader header;
+
+    if (path != NULL)
+        fd = open(path, remap ? O_RDWR : (O_RDWR | O_CREAT | O_TRUNC), 0644);
+    if (path != NULL && fd < 0)
+    {
+        fprintf(stderr, "Impossible to open '%s' for the memory mapped\n"
+               "population.\n", path);
+        free(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (remap)
+    {
+        /* Population boundaries must be the same. */
+        if (pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+            memcmp(header.magic, MMAP_MAGIC, 8) != 0 ||
+            header.length != pop->length ||
+            header.min_value != pop->min_value ||
+            header.max_value != pop->max_value ||
+            header.non_repeatable != pop->non_repeatable)
+        {
+            fprintf(stderr, "The file '%s' is not a mapped population\n"
+                   "with the same solution boundaries.\n", path);
+            close(fd);
+            free(pop);
+            exit(EXIT_FAILURE);
+        }
+        pop->n_population = header.n_population;
+        pop->n_population_orig = header.n_rows;
+        pop->n_population_alloc = header.n_rows;
+    }
+
+    pop->storage = STORAGE_MMAP;
+    pop->mmap_fd = fd;
+    pop->mmap_region_size = (size_t) pop->n_population_alloc
+                            * pop->length * sizeof(int);
+    /* Regions are page aligned. */
+    pop->mmap_region_size += MMAP_HEADER_SIZE
+                             - pop->mmap_region_size % MMAP_HEADER_SIZE;
+    pop->mmap_size = MMAP_HEADER_SIZE
+                     + MMAP_N_REGIONS * pop->mmap_region_size;
+    if (fd >= 0 && !remap && ftruncate(fd, (off_t) pop->mmap_size) != 0)
+    {
+        fprintf(stderr, "Impossible to resize '%s' to %zu bytes.\n",
+                path, pop->mmap_size);
+        close(fd);
+        free(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->mmap_base = mmap(NULL, pop->mmap_size, PROT_READ | PROT_WRITE,
+                          (fd < 0) ? (MAP_SHARED | MAP_ANONYMOUS) : MAP_SHARED,
+                          fd, 0);
+    if (pop->mmap_base == MAP_FAILED)
+    {
+        fprintf(stderr, "Impossible to map '%s'.\n",
+                (path != NULL) ? path : "shared memory");
+        if (fd >= 0)
+            close(fd);
+        free(pop);
+        exit(EXIT_FAILURE);
+    }
+    /* Generations are read and written sequentially. */
+    madvise(pop->mmap_base, pop->mmap_size, MADV_SEQUENTIAL);
+
+    pop->individuals = ec_calloc(pop->n_population_alloc, sizeof(int*),
+                                 __LINE__, __FILE__);
+    if (remap)
+    {
+        int_mmap_set_current(pop, header.current);
+        pop->generation = header.generation;
+        pop->best_fo_alltime = header.best_fo_alltime;
+        /* The hall of fame is rebuilt by the first evaluation. */
+        pop->hof_size = header.hof_size;
+        pop->alltime_restored = (header.hof_size > 0);
+    }
+    else
+    {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MMAP_MAGIC, 8);
+        header.length = pop->length;
+        header.n_rows = pop->n_population_alloc;
+        header.min_value = pop->min_value;
+        header.max_value = pop->max_value;
+        header.non_repeatable = pop->non_repeatable;
+        memcpy(pop->mmap_base, &header, sizeof(header));
+        pop->hof_size = 0;
+        int_mmap_set_current(pop, 0);
+        int_init_individuals(pop, pop->individuals, pop->n_population,
+                             int_init_n_threads());
+    }
+}
+
+void
+int_sync_population(struct IntPopulation *pop)
+{
+/* For 'mmap:<path>' populations, writes the current state to the file
+   (blocking until it's on disk), so the run can be restarted with
+   'remap:<path>'. Nothing is done for other populations. */
+    if (pop->storage != STORAGE_MMAP || pop->mmap_fd < 0)
+        return;
+    int_mmap_write_header(pop);
+    msync(pop->mmap_base, pop->mmap_size, MS_SYNC);
+}
+
+void
+int_unmap_population(struct IntPopulation *pop)
+{
+/* Writes the header and unmaps/closes the population file. */
+    int_mmap_write_header(pop);
+    munmap(pop->mmap_base, pop->mmap_size);
+    if (pop->mmap_fd >= 0)
+        close(pop->mmap_fd);
+}
+
+void
+int_set_fork_evaluator(struct IntPopulation *pop, int n_workers)
+{
+/* This function makes 'int_evaluate_population' evaluate the individuals
+   in 'n_workers' forked processes, for objective functions that are not
+   thread safe (global state, non reentrant libraries) or that may
+   crash. The workers are forked once, here, and evaluate every
+   generation:
+   - The individuals are not copied: the workers read them from the
+     shared mapping of the pop, and write the fos to a shared array.
+   - Each worker claims the next index of a shared queue (atomic compare
+     and swap), so fast and slow evaluations are balanced.
+   - A worker that dies (crash, abort, kill) is restarted and the
+     individual it was evaluating is queued again. If it crashes again
+     after FORK_MAX_RETRIES retries it gets FLT_MAX (the worst fo, as
+     fos are minimized).
+   Workers see the globals of the program as they were when they were
+   forked (here, or when restarted). The objective function must not
+   use OpenMP (the workers are forked). Other single evaluations (local
+   search, stagnation triggers, resizes, cellular and crowding engines)
+   and the batch, block and multi-objective modes are done in the
+   calling process. 'n_fork_restarts' and 'n_fork_failures' keep the
+   statistics. The workers are stopped by 'int_free_population'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct initialized with 'shared' or
+              'mmap:<path>' (or 'remap:<path>') init_mode.
+   - 'n_workers' : Number of worker processes (0 stops them). */
+    int k, w, capacity;
+    size_t sizes[6], offsets[6];
+
+    if (n_workers < 0 || (n_workers > 0 && pop->storage != STORAGE_MMAP))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong arguments passed to 'int_set_fork_evaluator':\n"
+               "'n_workers' (%d) must be >= 0, and the workers need the\n"
+               "individuals in shared memory ('shared' or 'mmap:<path>'"
+               "\ninit_mode of 'int_init_population').\n"
+               "====================\n", n_workers);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_fork_stop(pop);
+    if (n_workers == 0)
+        return;
+
+    /* Shared region: control, rows, fos, queue (room for the retries),
+       done flags and worker slots, each one cache line aligned. The
+       mapping is inherited by every worker forked from now on. */
+    capacity = pop->n_population_alloc;
+    sizes[0] = sizeof(struct IntForkControl);
+    sizes[1] = (size_t) capacity * sizeof(int*);
+    sizes[2] = (size_t) capacity * sizeof(float);
+    sizes[3] = (size_t) capacity * (FORK_MAX_RETRIES + 1) * sizeof(int);
+    sizes[4] = (size_t) capacity * sizeof(int);
+    sizes[5] = (size_t) n_workers * sizeof(int);
+    pop->fork_shared_size = 0;
+    for (k = 0; k < 6; k++)
+    {
+        offsets[k] = pop->fork_shared_size;
+        pop->fork_shared_size += (sizes[k] + 63) / 64 * 64;
+    }
+    pop->fork_shared = mmap(NULL, pop->fork_shared_size,
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (pop->fork_shared == MAP_FAILED)
+    {
+        fprintf(stderr, "Impossible to map the %zu bytes of the fork\n"
+               "evaluator queue.\n", pop->fork_shared_size);
+        pop->fork_shared = NULL;
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->fork_rows = (int**) (pop->fork_shared + offsets[1]);
+    pop->fork_fos = (float*) (pop->fork_shared + offsets[2]);
+    pop->fork_tasks = (int*) (pop->fork_shared + offsets[3]);
+    pop->fork_done = (int*) (pop->fork_shared + offsets[4]);
+    pop->fork_slots = (int*) (pop->fork_shared + offsets[5]);
+
+    pop->fork_n_workers = n_workers;
+    pop->fork_pids = ec_calloc(n_workers, sizeof(pid_t), __LINE__, __FILE__);
+    pop->fork_polls = ec_malloc((n_workers + 1) * sizeof(struct pollfd),
+                                __LINE__, __FILE__);
+    pop->fork_wake_fds = ec_malloc(n_workers * sizeof(int),
+                                   __LINE__, __FILE__);
+    pop->fork_pending = ec_calloc(n_workers, sizeof(int), __LINE__, __FILE__);
+    pop->fork_retries = ec_calloc(capacity, sizeof(int), __LINE__, __FILE__);
+    for (w = 0; w < n_workers; w++)
+    {
+        pop->fork_wake_fds[w] = -1;
+    }
+    /* Workers report through a single pipe, read without blocking. */
+    if (pipe(pop->fork_done_fds) != 0)
+    {
+        fprintf(stderr, "Impossible to create the pipe of the fork\n"
+               "evaluator.\n");
+        pop->fork_done_fds[0] = -1;
+        pop->fork_done_fds[1] = -1;
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    fcntl(pop->fork_done_fds[0], F_SETFL,
+          fcntl(pop->fork_done_fds[0], F_GETFL) | O_NONBLOCK);
+    /* Programs started by the workers don't keep it. */
+    fcntl(pop->fork_done_fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(pop->fork_done_fds[1], F_SETFD, FD_CLOEXEC);
+    for (w = 0; w < n_workers; w++)
+    {
+        int_fork_spawn(pop, w);
+    }
+}
+
+void
+int_fork_spawn(struct IntPopulation *pop, int w)
+{
+/* Forks worker 'w', woken by the parent through a new socket (a closed
+   one returns an error instead of raising SIGPIPE in the parent). */
+    int v, fds[2];
+    pid_t pid;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+    {
+        fprintf(stderr, "Impossible to create the socket of the fork\n"
+               "evaluator worker %d.\n", w);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->fork_slots[w] = -1;
+    /* Buffered output would be written again by the worker. */
+    fflush(NULL);
+    pid = fork();
+    if (pid < 0)
+    {
+        fprintf(stderr, "Impossible to fork the fork evaluator worker %d."
+               "\n", w);
+        close(fds[0]);
+        close(fds[1]);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0)
+    {
+        /* The worker keeps only it's end of the socket and the write
+           end of the pipe: the other workers must get EOF when the
+           parent closes their sockets. */
+        close(fds[0]);
+        close(pop->fork_done_fds[0]);
+        for (v = 0; v < pop->fork_n_workers; v++)
+        {
+            if (v != w && pop->fork_wake_fds[v] >= 0)
+                close(pop->fork_wake_fds[v]);
+        }
+        int_fork_worker(pop, w, fds[1]);
+    }
+    close(fds[1]);
+    pop->fork_wake_fds[w] = fds[0];
+    pop->fork_pids[w] = pid;
+    pop->fork_pending[w] = 0;
+}
+
+void
+int_fork_worker(struct IntPopulation *pop, int w, int wake_fd)
+{
+/* Loop of worker 'w' (never returns): each byte read from 'wake_fd'
+   starts the evaluation of the queued individuals, and the worker pid
+   is written to the pipe once the queue is empty. The worker exits
+   when the parent closes the socket. */
+    struct IntForkControl *control = (struct IntForkControl*) pop->fork_shared;
+    pid_t self = getpid();
+    ssize_t n_read;
+    char byte;
+    int i;
+
+    for (;;)
+    {
+        n_read = read(wake_fd, &byte, 1);
+        if (n_read < 0 && errno == EINTR)
+            continue;
+        if (n_read <= 0)
+            _exit(EXIT_SUCCESS);
+        while ((i = int_fork_claim(pop, w)) >= 0)
+        {
+            pop->fork_fos[i] = control->objective_function(pop->fork_rows[i],
+                                                           pop->length);
+            if (__atomic_exchange_n(&pop->fork_done[i], 1,
+                                    __ATOMIC_ACQ_REL) == 0)
+                __atomic_fetch_add(&control->n_done, 1, __ATOMIC_ACQ_REL);
+            __atomic_store_n(&pop->fork_slots[w], -1, __ATOMIC_RELEASE);
+        }
+        fflush(NULL);
+        if (write(pop->fork_done_fds[1], &self, sizeof(pid_t))
+            != sizeof(pid_t))
+            _exit(EXIT_FAILURE);
+    }
+}
+
+int
+int_fork_claim(struct IntPopulation *pop, int w)
+{
+/* Claims the next queued individual for worker 'w' without locks. The
+   slot of the worker is written before the compare and swap, so the
+   parent always knows the individual of a worker that dies (at worst,
+   one claimed by another worker, evaluated twice).
+   =RETURNS=
+   - The index of the individual, -1 if the queue is empty. */
+    struct IntForkControl *control = (struct IntForkControl*) pop->fork_shared;
+    int t, i;
+
+    for (;;)
+    {
+        t = __atomic_load_n(&control->next, __ATOMIC_ACQUIRE);
+        if (t >= __atomic_load_n(&control->n_tasks, __ATOMIC_ACQUIRE))
+            return -1;
+        i = pop->fork_tasks[t];
+        __atomic_store_n(&pop->fork_slots[w], i, __ATOMIC_RELEASE);
+        if (__atomic_compare_exchange_n(&control->next, &t, t + 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return i;
+    }
+}
+
+void
+int_fork_wake(struct IntPopulation *pop, int w)
+{
+/* Wakes worker 'w' (a dead one is found by 'int_fork_evaluate'). */
+    char byte = 1;
+
+    if (send(pop->fork_wake_fds[w], &byte, 1, MSG_NOSIGNAL) == 1)
+        pop->fork_pending[w]++;
+}
+
+void
+int_fork_restart(struct IntPopulation *pop, int w)
+{
+/* Worker 'w' died: the individual it was evaluating is queued again (or
+   gets FLT_MAX after FORK_MAX_RETRIES retries), and a new worker is
+   forked and woken. */
+    struct IntForkControl *control = (struct IntForkControl*) pop->fork_shared;
+    int i = __atomic_load_n(&pop->fork_slots[w], __ATOMIC_ACQUIRE);
+    int n_tasks;
+
+    close(pop->fork_wake_fds[w]);
+    pop->fork_wake_fds[w] = -1;
+    pop->fork_pending[w] = 0;
+    pop->n_fork_restarts++;
+    if (i >= 0 && !__atomic_load_n(&pop->fork_done[i], __ATOMIC_ACQUIRE))
+    {
+        if (++pop->fork_retries[i] > FORK_MAX_RETRIES)
+        {
+            pop->fork_fos[i] = FLT_MAX;
+            if (__atomic_exchange_n(&pop->fork_done[i], 1,
+                                    __ATOMIC_ACQ_REL) == 0)
+                __atomic_fetch_add(&control->n_done, 1, __ATOMIC_ACQ_REL);
+            pop->n_fork_failures++;
+        }
+        else
+        {
+            /* There is room for every retry in the queue. */
+            n_tasks = control->n_tasks;
+            pop->fork_tasks[n_tasks] = i;
+            __atomic_store_n(&control->n_tasks, n_tasks + 1,
+                             __ATOMIC_RELEASE);
+        }
+    }
+    int_fork_spawn(pop, w);
+    int_fork_wake(pop, w);
+}
+
+long
+int_fork_evaluate(struct IntPopulation *pop, int start, int end,
+                  float (*objective_function)())
+{
+/* Evaluates the individuals [start, end) (but the skipped ones) in the
+   worker processes, and waits until every one has it's fo and every
+   worker is idle, restarting the dead ones.
+   =RETURNS=
+   - The number of evaluated individuals. */
+    struct IntForkControl *control = (struct IntForkControl*) pop->fork_shared;
+    int i, t, w, busy, n_tasks = 0;
+    long n_local = 0;
+    pid_t pid;
+
+    for (i = start; i < end; i++)
+    {
+        if (pop->n_eval_skip > 0 && pop->eval_skip[i])
+            continue;
+        if ((char*) pop->individuals[i] < pop->mmap_base ||
+            (char*) pop->individuals[i] >= pop->mmap_base + pop->mmap_size)
+        {
+            /* A row out of the shared mapping (set by the user) is not
+               seen by the workers. */
+            pop->fos[i] = objective_function(pop->individuals[i],
+                                             pop->length);
+            n_local++;
+            continue;
+        }
+        pop->fork_tasks[n_tasks++] = i;
+        pop->fork_rows[i] = pop->individuals[i];
+        pop->fork_done[i] = 0;
+        pop->fork_retries[i] = 0;
+    }
+    if (n_tasks == 0)
+        return n_local;
+    control->objective_function = objective_function;
+    control->next = 0;
+    control->n_done = 0;
+    __atomic_store_n(&control->n_tasks, n_tasks, __ATOMIC_RELEASE);
+    for (w = 0; w < pop->fork_n_workers; w++)
+    {
+        int_fork_wake(pop, w);
+    }
+
+    for (;;)
+    {
+        busy = 0;
+        for (w = 0; w < pop->fork_n_workers; w++)
+        {
+            busy |= (pop->fork_pending[w] > 0);
+        }
+        if (!busy)
+        {
+            if (__atomic_load_n(&control->n_done, __ATOMIC_ACQUIRE)
+                >= n_tasks)
+                break;
+            /* Every wake was lost (dead workers not restarted yet). */
+            for (w = 0; w < pop->fork_n_workers; w++)
+            {
+                int_fork_wake(pop, w);
+            }
+        }
+        /* Waiting for reports, or for the socket of a dead worker to
+           hang up (the period only bounds a missed one). */
+        pop->fork_polls[0].fd = pop->fork_done_fds[0];
+        pop->fork_polls[0].events = POLLIN;
+        for (w = 0; w < pop->fork_n_workers; w++)
+        {
+            pop->fork_polls[w + 1].fd = pop->fork_wake_fds[w];
+            pop->fork_polls[w + 1].events = POLLIN;
+        }
+        poll(pop->fork_polls, pop->fork_n_workers + 1, FORK_POLL_MS);
+        /* Reports of dead workers (unknown pids) are ignored. */
+        while (read(pop->fork_done_fds[0], &pid, sizeof(pid_t))
+               == sizeof(pid_t))
+        {
+            for (w = 0; w < pop->fork_n_workers; w++)
+            {
+                if (pop->fork_pids[w] == pid && pop->fork_pending[w] > 0)
+                    pop->fork_pending[w]--;
+            }
+        }
+        for (w = 0; w < pop->fork_n_workers; w++)
+        {
+            if (waitpid(pop->fork_pids[w], NULL, WNOHANG)
+                == pop->fork_pids[w])
+                int_fork_restart(pop, w);
+        }
+    }
+    for (t = 0; t < n_tasks; t++)
+    {
+        i = pop->fork_tasks[t];
+        pop->fos[i] = pop->fork_fos[i];
+    }
+    __atomic_store_n(&control->n_tasks, 0, __ATOMIC_RELEASE);
+    return n_tasks + n_local;
+}
+
+void
+int_fork_stop(struct IntPopulation *pop)
+{
+/* Stops the workers of the fork evaluator (EOF on their sockets) and
+   frees it. */
+    int w;
+
+    if (pop->fork_shared == NULL)
+        return;
+    for (w = 0; w < pop->fork_n_workers; w++)
+    {
+        if (pop->fork_wake_fds[w] >= 0)
+            close(pop->fork_wake_fds[w]);
+    }
+    for (w = 0; w < pop->fork_n_workers; w++)
+    {
+        if (pop->fork_pids[w] > 0)
+            waitpid(pop->fork_pids[w], NULL, 0);
+    }
+    if (pop->fork_done_fds[0] >= 0)
+    {
+        close(pop->fork_done_fds[0]);
+        close(pop->fork_done_fds[1]);
+    }
+    munmap(pop->fork_shared, pop->fork_shared_size);
+    free(pop->fork_pids);
+    free(pop->fork_polls);
+    free(pop->fork_wake_fds);
+    free(pop->fork_pending);
+    free(pop->fork_retries);
+    pop->fork_shared = NULL;
+    pop->fork_pids = NULL;
+    pop->fork_polls = NULL;
+    pop->fork_wake_fds = NULL;
+    pop->fork_pending = NULL;
+    pop->fork_retries = NULL;
+    pop->fork_done_fds[0] = -1;
+    pop->fork_done_fds[1] = -1;
+    pop->fork_n_workers = 0;
+}
+
+/*==========================*/
+/* Duplicate elimination. */
+void
+int_set_dedup(struct IntPopulation *pop, char *dedup_mode, int max_tries)
+{
+/* This function enables duplicate elimination inside 'int_ga_one_iter'.
+   Childs that are exact copies of a genome of the next generation
+   (elites or previous childs) are changed before evaluation, and childs
+   equal to any known genome reuse it's fo instead of being evaluated.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*dedup_mode' : - 'none'     : No duplicate elimination (default).
+                     - 'remutate' : Duplicates are mutated again.
+                     - 'reject'   : Duplicates are replaced by a new random
+                                    individual.
+   - 'max_tries' : Max. tries for each duplicate. */
+
+    /* Sanity check. */
+    check_null(dedup_mode, __LINE__, __FILE__);
+
+    if (strcmp(dedup_mode, "none") == 0)
+        pop->dedup_mode = DEDUP_NONE;
+    else if (strcmp(dedup_mode, "remutate") == 0)
+        pop->dedup_mode = DEDUP_REMUTATE;
+    else if (strcmp(dedup_mode, "reject") == 0)
+        pop->dedup_mode = DEDUP_REJECT;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'dedup_mode' ('%s') argument passed\nto "
+               "'int_set_dedup' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none'     :    no duplicate elimination.\n"
+               "-'remutate' :    duplicated childs are mutated again.\n"
+               "-'reject'   :    duplicated childs are replaced by"
+               "\n\t\trandom individuals.\n"
+               "====================\n", dedup_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->dedup_max_tries = max_tries;
+    pop->diversity_synced = 0;
+    if (pop->dedup_mode != DEDUP_NONE &&
+        pop->first_population == POP_EVALUATED)
+        int_update_diversity(pop); /* Genome hashes. */
+}
+
+void
+int_init_dedup_buffers(struct IntPopulation *pop)
+{
+/* Allocs (or reallocs, after a population resize) the buffers used by
+   the duplicate elimination, with 'pop->n_population_alloc' rows. The
+   genome table has a power of 2 size >= 4 * rows (known genomes of the
+   current generation plus the childs). */
+    int rows = pop->n_population_alloc;
+
+    if (pop->dedup_rows == rows)
+        return;
+    pop->parent_indexes = realloc(pop->parent_indexes, rows * sizeof(int));
+    check_null(pop->parent_indexes, __LINE__, __FILE__);
+    pop->eval_skip = realloc(pop->eval_skip, rows * sizeof(int));
+    check_null(pop->eval_skip, __LINE__, __FILE__);
+    pop->child_hashes = realloc(pop->child_hashes, rows * sizeof(uint64_t));
+    check_null(pop->child_hashes, __LINE__, __FILE__);
+    pop->next_fos = realloc(pop->next_fos, rows * sizeof(float));
+    check_null(pop->next_fos, __LINE__, __FILE__);
+    pop->next_fo_known = realloc(pop->next_fo_known, rows * sizeof(int));
+    check_null(pop->next_fo_known, __LINE__, __FILE__);
+    pop->genome_table_size = 1;
+    while (pop->genome_table_size < 4 * rows)
+    {
+        pop->genome_table_size *= 2;
+    }
+    free(pop->genome_table);
+    pop->genome_table = ec_malloc(pop->genome_table_size
+                                  * sizeof(struct IntGenomeEntry),
+                                  __LINE__, __FILE__);
+    pop->dedup_rows = rows;
+}
+
+struct IntGenomeEntry
+*int_genome_lookup(struct IntPopulation *pop, uint64_t hash, int *genome)
+{
+/* Looks for 'genome' (with hash 'hash') inside the genome table
+   (open addressing). Genomes are compared gene by gene, so hash
+   collisions are not a problem. If not found, the genome is inserted
+   and the new entry ('entry->genome == genome') is returned. */
+    int mask = pop->genome_table_size - 1;
+    int index = (int) (hash & (uint64_t) mask);
+    struct IntGenomeEntry *entry;
+
+    while (pop->genome_table[index].genome != NULL)
+    {
+        entry = &pop->genome_table[index];
+        if (entry->hash == hash &&
+            (entry->genome == genome ||
+             memcmp(entry->genome, genome,
+                    sizeof(int) * pop->length) == 0))
+            return entry;
+        index = (index + 1) & mask;
+    }
+    entry = &pop->genome_table[index];
+    entry->hash = hash;
+    entry->genome = genome;
+    entry->fo_known = 0;
+    entry->in_next_gen = 0;
+    return entry;
+}
+
+int
+int_dedup_change(struct IntPopulation *pop, int *child, uint64_t *hash,
+                 char *mutate_mode)
+{
+/* Changes a duplicated 'child' according to 'pop->dedup_mode', updating
+   it's hash.
+   =RETURNS=
+   - 0 if the child can't be changed, 1 otherwise. */
+    int j, p1, p2, tmp;
+
+    if (pop->dedup_mode == DEDUP_REJECT)
+    {
+        int_init_solution(pop, child);
+        *hash = 0;
+        for (j = 0; j < pop->length; j++)
+        {
+            *hash ^= int_gene_hash(j, child[j]);
+        }
+    }
+    else if (pop->non_repeatable == SUBSET)
+    {
+        /* One forced replacement by a value out of the set. The
+           values move inside the sorted child, so the hash is computed
+           again. */
+        p1 = (int) rng_bounded(&pop->rng_state, (uint32_t) pop->length);
+        int_init_breed_buffers(pop);
+        if (int_subset_replace(pop, child, &p1, 1, int_thread_scratch(pop),
+                               &pop->rng_state) == 0)
+            return 0;
+        *hash = 0;
+        for (j = 0; j < pop->length; j++)
+        {
+            *hash ^= int_gene_hash(j, child[j]);
+        }
+    }
+    else if (strcmp(mutate_mode, "swap") == 0 ||
+             pop->non_repeatable == NO_REPEAT)
+    {
+        /* One forced swap. */
+        if (pop->length < 2)
+            return 0;
+        p1 = (int) rng_bounded(&pop->rng_state, (uint32_t) pop->length);
+        p2 = (int) rng_bounded(&pop->rng_state,
+                               (uint32_t) (pop->length - 1));
+        if (p2 >= p1)
+            p2++;
+        *hash ^= int_gene_hash(p1, child[p1]) ^ int_gene_hash(p2, child[p2])
+                 ^ int_gene_hash(p1, child[p2])
+                 ^ int_gene_hash(p2, child[p1]);
+        tmp = child[p1];
+        child[p1] = child[p2];
+        child[p2] = tmp;
+    }
+    else
+    {
+        /* One forced uniform change. */
+        if (pop->range < 2)
+            return 0;
+        p1 = (int) rng_bounded(&pop->rng_state, (uint32_t) pop->length);
+        tmp = pop->min_value
+              + (int) rng_bounded(&pop->rng_state,
+                                  (uint32_t) (pop->range - 1));
+        if (tmp >= child[p1])
+            tmp++;
+        *hash ^= int_gene_hash(p1, child[p1]) ^ int_gene_hash(p1, tmp);
+        child[p1] = tmp;
+    }
+    return 1;
+}
+
+void
+int_dedup_childs(struct IntPopulation *pop, char *mutate_mode,
+                 int **childs, int n_childs, int hashes_known)
+{
+/* Duplicate elimination over '**childs' (after mutation) for
+   'int_ga_one_iter'. If not 'hashes_known', the parents must be
+   recorded in 'pop->parent_indexes' (otherwise 'pop->child_hashes'
+   must be defined). Defines 'next_fos' and 'next_fo_known' for the
+   first 'n_childs' individuals of the next generation. */
+    int c, i, j, tries;
+    int n_elites = pop->n_population - n_childs;
+    int *child, *parent;
+    uint64_t hash;
+    struct IntGenomeEntry *entry;
+
+    /* Child hashes from the first parent hash, only for the genes
+       changed by crossover and mutation. */
+    for (c = 0; c < n_childs && !hashes_known; c++)
+    {
+        child = childs[c];
+        parent = pop->individuals[pop->parent_indexes[c]];
+        hash = pop->hashes[pop->parent_indexes[c]];
+        for (j = 0; j < pop->length; j++)
+        {
+            if (child[j] != parent[j])
+                hash ^= int_gene_hash(j, parent[j]) ^
+                        int_gene_hash(j, child[j]);
+        }
+        pop->child_hashes[c] = hash;
+    }
+
+    /* Known genomes: the current population, elites are part
+       of the next generation. */
+    memset(pop->genome_table, 0,
+           pop->genome_table_size * sizeof(struct IntGenomeEntry));
+    for (i = 0; i < pop->n_population; i++)
+    {
+        entry = int_genome_lookup(pop, pop->hashes[i], pop->individuals[i]);
+        entry->fo = pop->fos[i];
+        entry->fo_known = 1;
+    }
+    for (i = 0; i < n_elites; i++)
+    {
+        j = int_select_order(pop)[i];
+        int_genome_lookup(pop, pop->hashes[j],
+                          pop->individuals[j])->in_next_gen = 1;
+    }
+
+    for (c = 0; c < n_childs; c++)
+    {
+        child = childs[c];
+        pop->next_fo_known[c] = 0;
+        for (tries = 0; ; tries++)
+        {
+            entry = int_genome_lookup(pop, pop->child_hashes[c], child);
+            /* Clone childs (see 'int_set_genome_sharing') are the row
+               of a known genome. */
+            if (entry->genome == child && !entry->fo_known)
+            {
+                /* A new genome. */
+                entry->in_next_gen = 1;
+                break;
+            }
+            if (!entry->in_next_gen)
+            {
+                /* Known genome (not a duplicate in the next gen). */
+                entry->in_next_gen = 1;
+                pop->next_fos[c] = entry->fo;
+                pop->next_fo_known[c] = entry->fo_known;
+                break;
+            }
+            /* Duplicate. */
+            if (tries == 0)
+                pop->n_duplicates++;
+            if (tries < pop->dedup_max_tries)
+            {
+                /* Changed below, a shared clone is copied first. */
+                int_cow_private(pop, &childs[c]);
+                child = childs[c];
+            }
+            if (tries >= pop->dedup_max_tries ||
+                !int_dedup_change(pop, child, &pop->child_hashes[c],
+                                  mutate_mode))
+            {
+                /* Kept, reusing the fo if known. */
+                pop->next_fos[c] = entry->fo;
+                pop->next_fo_known[c] = entry->fo_known;
+                break;
+            }
+            /* Block scores of a changed fused child are evaluated
+               again. */
+            if (hashes_known && pop->block_synced)
+                memset(pop->next_block_dirty + (size_t) c * pop->n_blocks,
+                       1, pop->n_blocks);
+        }
+    }
+}
+
+/*==========================*/
+/* Diversity statistics and stagnation. */
+void
+int_set_diversity(struct IntPopulation *pop, char *diversity_mode)
+{
+/* This function enables the per-generation diversity statistics
+   ('diversity_entropy', 'diversity_hamming', 'n_unique_individuals'),
+   computed at the end of each 'int_evaluate_population' call.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*diversity_mode' : - 'none'    : No statistics (default).
+                         - 'locus'   : Per-locus value frequencies, exact
+                                       entropy and mean Hamming distance.
+                         - 'sampled' : Mean Hamming distance estimated with
+                                       DIVERSITY_N_SAMPLES random pairs. */
+
+    /* Sanity check. */
+    check_null(diversity_mode, __LINE__, __FILE__);
+
+    if (strcmp(diversity_mode, "none") == 0)
+        pop->diversity_mode = DIVERSITY_NONE;
+    else if (strcmp(diversity_mode, "locus") == 0)
+    {
+        if ((double) pop->length * (double) pop->range
+            > (double) DIVERSITY_MAX_COUNTS)
+            /* Too many counters, estimating by sampling. */
+            pop->diversity_mode = DIVERSITY_SAMPLED;
+        else
+            pop->diversity_mode = DIVERSITY_LOCUS;
+    }
+    else if (strcmp(diversity_mode, "sampled") == 0)
+        pop->diversity_mode = DIVERSITY_SAMPLED;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'diversity_mode' ('%s') argument passed\nto "
+               "'int_set_diversity' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none'    :    no diversity statistics.\n"
+               "-'locus'   :    per-locus value frequencies, entropy"
+               "\n\t\tand exact mean Hamming distance.\n"
+               "-'sampled' :    mean Hamming distance estimated from"
+               "\n\t\trandom pairs of individuals.\n"
+               "====================\n", diversity_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (pop->diversity_mode == DIVERSITY_LOCUS && pop->locus_counts == NULL)
+        pop->locus_counts = ec_calloc(pop->length * pop->range, sizeof(int),
+                                      __LINE__, __FILE__);
+    pop->diversity_synced = 0;
+    if (pop->diversity_mode != DIVERSITY_NONE &&
+        pop->first_population == POP_EVALUATED)
+        int_update_diversity(pop);
+}
+
+void
+int_update_diversity(struct IntPopulation *pop)
+{
+/* Rebuilds all the diversity statistics from scratch. Useful if the
+   individuals were changed outside the library operators. */
+    int i, j;
+    uint64_t hash;
+
+    if (!int_tracks_hashes(pop))
+        return;
+    if (pop->diversity_rows != pop->n_population_alloc)
+    {
+        /* Buffers follow the population alloc (see resizing). */
+        pop->diversity_rows = pop->n_population_alloc;
+        pop->hashes = realloc(pop->hashes,
+                              pop->diversity_rows * sizeof(uint64_t));
+        check_null(pop->hashes, __LINE__, __FILE__);
+        /* c * log(c) for every possible count, used by the entropy. */
+        pop->clogc_table = realloc(pop->clogc_table,
+                                   (pop->diversity_rows + 1)
+                                   * sizeof(double));
+        check_null(pop->clogc_table, __LINE__, __FILE__);
+        pop->clogc_table[0] = 0.0;
+        for (i = 1; i <= pop->diversity_rows; i++)
+        {
+            pop->clogc_table[i] = (double) i * log((double) i);
+        }
+    }
+    if (pop->diversity_mode == DIVERSITY_LOCUS)
+    {
+        memset(pop->locus_counts, 0,
+               sizeof(int) * pop->length * pop->range);
+        pop->locus_sum_sq = 0;
+        pop->locus_sum_clogc = 0.0;
+    }
+    for (i = 0; i < pop->n_population; i++)
+    {
+        hash = 0;
+        for (j = 0; j < pop->length; j++)
+        {
+            hash ^= int_gene_hash(j, pop->individuals[i][j]);
+            if (pop->diversity_mode == DIVERSITY_LOCUS)
+                int_locus_count(pop, j, pop->individuals[i][j], 1);
+        }
+        pop->hashes[i] = hash;
+    }
+    if (pop->diversity_mode != DIVERSITY_NONE)
+        int_diversity_stats(pop);
+}
+
+int
+int_tracks_hashes(struct IntPopulation *pop)
+{
+/* Genome hashes are kept for diversity statistics, duplicate
+   elimination and genome sharing. */
+    return (pop->diversity_mode != DIVERSITY_NONE ||
+            pop->dedup_mode != DEDUP_NONE ||
+            pop->cow_mode == COW_SHARE);
+}
+
+void
+int_locus_count(struct IntPopulation *pop, int locus, int value,
+                int delta)
+{
+/* Adds 'delta' to the frequency of 'value' in gene 'locus', updating
+   the sums of squares and of c*log(c) in O(1). */
+    int *count;
+
+    if (value < pop->min_value || value > pop->max_value)
+        return; /* Out of boundaries (e.g. user defined values). */
+    count = &pop->locus_counts[locus * pop->range + value - pop->min_value];
+    pop->locus_sum_sq -= (long long) *count * *count;
+    pop->locus_sum_clogc -= pop->clogc_table[*count];
+    *count += delta;
+    pop->locus_sum_sq += (long long) *count * *count;
+    pop->locus_sum_clogc += pop->clogc_table[*count];
+}
+
+void
+int_diversity_replace(struct IntPopulation *pop, int index,
+                      int *new_individual, int copy)
+{
+/* Copies 'new_individual' to 'pop->individuals[index]' (if 'copy' != 0,
+   otherwise the caller swaps the rows) updating the statistics only
+   for the genes that actually changed. */
+    int j, *individual = pop->individuals[index];
+    uint64_t hash = pop->hashes[index];
+
+    for (j = 0; j < pop->length; j++)
+    {
+        if (individual[j] == new_individual[j])
+            continue;
+        hash ^= int_gene_hash(j, individual[j]) ^
+                int_gene_hash(j, new_individual[j]);
+        if (pop->diversity_mode == DIVERSITY_LOCUS)
+        {
+            int_locus_count(pop, j, individual[j], -1);
+            int_locus_count(pop, j, new_individual[j], 1);
+        }
+        if (copy)
+            individual[j] = new_individual[j];
+    }
+    pop->hashes[index] = hash;
+}
+
+void
+int_diversity_stats(struct IntPopulation *pop)
+{
+/* Computes 'diversity_entropy', 'diversity_hamming' and
+   'n_unique_individuals' from the per-locus sums (or sampling)
+   and the genome hashes. */
+    int i, a, b, n = pop->n_population;
+    double entropy, max_entropy, distance = 0.0;
+    uint64_t *sorted_hashes;
+
+    if (pop->diversity_mode == DIVERSITY_LOCUS)
+    {
+        /* Pairs differing in a locus = (n^2 - sum(c^2)) / 2. */
+        pop->diversity_hamming = (float) (((double) pop->length * n * n
+                                 - (double) pop->locus_sum_sq)
+                                 / ((double) n * (n - 1)));
+        /* Mean entropy = log(n) - sum(c * log(c)) / (n * length). */
+        entropy = log((double) n) - pop->locus_sum_clogc
+                  / ((double) n * pop->length);
+        max_entropy = log((double) (n < pop->range ? n : pop->range));
+        pop->diversity_entropy = (max_entropy > 0.0) ?
+                                 (float) (entropy / max_entropy) : 0.0;
+    }
+    else
+    {
+        for (i = 0; i < DIVERSITY_N_SAMPLES; i++)
+        {
+            a = (int) rng_bounded(&pop->rng_state, (uint32_t) n);
+            b = (int) rng_bounded(&pop->rng_state, (uint32_t) (n - 1));
+            if (b >= a)
+                b++; /* b != a. */
+            distance += int_hamming_distance(pop->individuals[a],
+                                             pop->individuals[b],
+                                             pop->length, pop->length);
+        }
+        pop->diversity_hamming = (float) (distance / DIVERSITY_N_SAMPLES);
+        pop->diversity_entropy = -1.0;
+    }
+    /* Unique genomes from the sorted hashes. */
+    sorted_hashes = ec_malloc(n * sizeof(uint64_t), __LINE__, __FILE__);
+    memcpy(sorted_hashes, pop->hashes, n * sizeof(uint64_t));
+    qsort(sorted_hashes, n, sizeof(uint64_t), compare_hashes);
+    pop->n_unique_individuals = 1;
+    for (i = 1; i < n; i++)
+    {
+        if (sorted_hashes[i] != sorted_hashes[i-1])
+            pop->n_unique_individuals++;
+    }
+    free(sorted_hashes);
+}
+
+int
+int_locus_frequency(struct IntPopulation *pop, int locus, int value)
+{
+/* Returns how many individuals have 'value' in gene 'locus'
+   ('locus' diversity mode only, -1 otherwise). */
+    if (pop->diversity_mode != DIVERSITY_LOCUS ||
+        locus < 0 || locus >= pop->length ||
+        value < pop->min_value || value > pop->max_value)
+        return -1;
+    return pop->locus_counts[locus * pop->range + value - pop->min_value];
+}
+
+void
+int_set_stagnation(struct IntPopulation *pop, char *stagnation_mode,
+                   int patience, float min_diversity,
+                   float keep_fraction, float rate)
+{
+/* This function defines what 'int_ga_one_iter' does when the population
+   stagnates, i.e., 'best_fo_alltime' did not improve in 'patience'
+   generations or the normalized mean Hamming distance
+   (diversity_hamming / length) is lower than 'min_diversity'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*stagnation_mode' : 'none', 'stop', 'restart' or 'hypermutate'
+                          (see GA_int.h for details).
+   - 'patience' : Generations without improvement (0 to disable).
+   - 'min_diversity' : Diversity threshold (0.0 to disable).
+   - 'keep_fraction' : Fraction of the best individuals kept (at least 1).
+   - 'rate' : Mutation rate for 'hypermutate'. */
+
+    /* Sanity check. */
+    check_null(stagnation_mode, __LINE__, __FILE__);
+
+    if (strcmp(stagnation_mode, "none") == 0)
+        pop->stagnation_mode = STAGNATION_NONE;
+    else if (strcmp(stagnation_mode, "stop") == 0)
+        pop->stagnation_mode = STAGNATION_STOP;
+    else if (strcmp(stagnation_mode, "restart") == 0)
+        pop->stagnation_mode = STAGNATION_RESTART;
+    else if (strcmp(stagnation_mode, "hypermutate") == 0)
+        pop->stagnation_mode = STAGNATION_HYPERMUTATE;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'stagnation_mode' ('%s') argument passed\nto "
+               "'int_set_stagnation' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none'        :    nothing is done.\n"
+               "-'stop'        :    pop->stop is set to 1.\n"
+               "-'restart'     :    re-init all but the best individuals.\n"
+               "-'hypermutate' :    mutate all but the best individuals"
+               "\n\t\twith 'rate'.\n"
+               "====================\n", stagnation_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (min_diversity > 0.0 && pop->diversity_mode == DIVERSITY_NONE)
+    {
+        fprintf(stderr, "A 'min_diversity' stagnation trigger needs\n"
+               "'int_set_diversity' to be called before.\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->stagnation_patience = patience;
+    pop->stagnation_min_diversity = min_diversity;
+    pop->stagnation_keep_fraction = keep_fraction;
+    pop->stagnation_rate = rate;
+    pop->stop = 0;
+}
+
+int
+int_apply_stagnation(struct IntPopulation *pop, char *mutate_mode)
+{
+/* Checks the stagnation trigger defined by 'int_set_stagnation' and
+   applies it to an evaluated population. The restarted/hypermutated
+   individuals are evaluated with the last objective function.
+   =RETURNS=
+   - 1 if the trigger fired, 0 otherwise. */
+    int i, index, n_keep, n_changed = 0;
+    int **changed;
+
+    if (!((pop->stagnation_patience > 0 &&
+           pop->n_stagnant_gens >= pop->stagnation_patience) ||
+          (pop->stagnation_min_diversity > 0.0 &&
+           pop->diversity_hamming / (float) pop->length
+           < pop->stagnation_min_diversity)))
+        return 0;
+    if (pop->stagnation_mode == STAGNATION_STOP)
+    {
+        pop->stop = 1;
+        return 1;
+    }
+
+    n_keep = (int) (pop->stagnation_keep_fraction
+                    * (float) pop->n_population);
+    if (n_keep < 1)
+        n_keep = 1;
+    changed = ec_malloc(pop->n_population * sizeof(int*),
+                        __LINE__, __FILE__);
+    for (i = n_keep; i < pop->n_population; i++)
+    {
+        changed[n_changed++] = int_own_row(pop, pop->sorted_fos_indexes[i]);
+        int_block_invalidate(pop, pop->sorted_fos_indexes[i]);
+    }
+    if (pop->stagnation_mode == STAGNATION_RESTART)
+        int_init_individuals(pop, changed, n_changed, pop->n_threads);
+    else
+        int_mutation(mutate_mode, pop, changed, n_changed,
+                     pop->stagnation_rate);
+    free(changed);
+    /* Evaluating the changed individuals. */
+    for (i = n_keep; i < pop->n_population; i++)
+    {
+        index = pop->sorted_fos_indexes[i];
+        pop->fos[index] = pop->objective_function(pop->individuals[index],
+                                                  pop->length);
+        pop->n_evaluations++;
+    }
+    int_update_ranking(pop);
+    int_update_alltime(pop);
+    pop->n_stagnant_gens = 0;
+    pop->n_restarts++;
+    if (int_tracks_hashes(pop))
+        int_update_diversity(pop);
+    return 1;
+}
+
+/*==========================*/
+/* Local search (memetic mode). */
+void
+int_set_local_search(struct IntPopulation *pop, char *ls_mode,
+                     char *writeback_mode, int n_top, float fraction,
+                     int budget, float (*delta_function)())
+{
+/* This function enables a local search stage, applied by
+   'int_evaluate_population' (so after each evaluation inside
+   'int_ga_one_iter') to the 'n_top' best individuals and to a random
+   'fraction' of the others, in parallel (see 'int_set_n_threads').
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*ls_mode' : 'none', 'first', 'best' or 'minconflicts' (see
+                  GA_int.h for details).
+   - '*writeback_mode' : 'lamarckian' or 'baldwinian'.
+   - 'n_top' : Number of best individuals searched each generation.
+   - 'fraction' : Probability for each other individual to be searched.
+   - 'budget' : Maximum number of moves evaluated per individual.
+   - '(*delta_function)()' : Fo change of a move (or NULL). */
+
+    /* Sanity check. */
+    check_null(ls_mode, __LINE__, __FILE__);
+    check_null(writeback_mode, __LINE__, __FILE__);
+
+    if (strcmp(ls_mode, "none") == 0)
+        pop->ls_mode = LS_NONE;
+    else if (strcmp(ls_mode, "first") == 0)
+        pop->ls_mode = LS_FIRST;
+    else if (strcmp(ls_mode, "best") == 0)
+        pop->ls_mode = LS_BEST;
+    else if (strcmp(ls_mode, "minconflicts") == 0)
+        pop->ls_mode = LS_MINCONFLICTS;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'ls_mode' ('%s') argument passed\nto "
+               "'int_set_local_search' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none'         :    no local search.\n"
+               "-'first'        :    first improvement hill climbing.\n"
+               "-'best'         :    best improvement hill climbing.\n"
+               "-'minconflicts' :    best move of a random gene.\n"
+               "====================\n", ls_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(writeback_mode, "lamarckian") == 0)
+        pop->ls_writeback = LS_LAMARCKIAN;
+    else if (strcmp(writeback_mode, "baldwinian") == 0)
+        pop->ls_writeback = LS_BALDWINIAN;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'writeback_mode' ('%s') argument passed\nto "
+               "'int_set_local_search' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'lamarckian' :    improved genomes replace individuals.\n"
+               "-'baldwinian' :    only the improved fo is kept.\n"
+               "====================\n", writeback_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (pop->ls_mode != LS_NONE &&
+        (pop->non_repeatable == SUBSET || n_top < 0 || fraction < 0.0 ||
+         budget < 1))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_set_local_search' needs n_top >= 0, fraction >= 0\n"
+               "and budget >= 1, and doesn't support SUBSET solutions.\n"
+               "====================\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->ls_n_top = n_top;
+    pop->ls_fraction = fraction;
+    pop->ls_budget = budget;
+    pop->ls_delta = delta_function;
+}
+
+int
+int_ls_apply(struct IntPopulation *pop, int *work, int a, int b)
+{
+/* Applies the move (a, b) to '*work': genes a and b swapped for
+   non-repeatable solutions, gene a set to value b otherwise.
+   =RETURNS=
+   - The 'b' of the move (a, b) undoing it. */
+    int tmp = work[a];
+
+    if (pop->non_repeatable == NO_REPEAT)
+    {
+        work[a] = work[b];
+        work[b] = tmp;
+        return b;
+    }
+    work[a] = b;
+    return tmp;
+}
+
+float
+int_ls_delta(struct IntPopulation *pop, float (*objective_function)(),
+             int *work, float fo, int a, int b)
+{
+/* Fo change of the move (a, b) on '*work' (with fo 'fo'), from the
+   delta function or from a full evaluation. '*work' is left
+   unchanged. */
+    float new_fo;
+
+    if (pop->ls_delta != NULL)
+        return pop->ls_delta(work, pop->length, a, b);
+    b = int_ls_apply(pop, work, a, b);
+    new_fo = objective_function(work, pop->length);
+    int_ls_apply(pop, work, a, b);
+    return new_fo - fo;
+}
+
+float
+int_ls_climb(struct IntPopulation *pop, float (*objective_function)(),
+             int *work, float fo, uint64_t *rng, long *n_evals)
+{
+/* Local search ('pop->ls_mode') of the individual '*work' with fo
+   'fo', using at most 'pop->ls_budget' move evaluations (counted in
+   '*n_evals'). '*work' ends with the improved individual.
+   =RETURNS=
+   - The fo of the improved individual. */
+    int a, b, best_a = 0, best_b = 0, n_ties, n_fails = 0;
+    /* Moves of one gene. */
+    int n_moves = (pop->non_repeatable == NO_REPEAT) ? pop->length - 1
+                                                      : pop->range - 1;
+    float delta, best_delta;
+    long evals = 0;
+
+    if (n_moves < 1)
+        return fo;
+    while (evals < pop->ls_budget)
+    {
+        if (pop->ls_mode == LS_FIRST)
+        {
+            /* Random move, applied if improving. As many failures
+               in a row as moves in the neighborhood: local optimum
+               (with high probability). */
+            if ((double) n_fails >= (double) pop->length * n_moves)
+                break;
+            a = (int) rng_bounded(rng, (uint32_t) pop->length);
+            b = (int) rng_bounded(rng, (uint32_t) n_moves);
+            if (pop->non_repeatable == NO_REPEAT)
+                b += (b >= a);
+            else
+                b = pop->min_value + b + (pop->min_value + b >= work[a]);
+            delta = int_ls_delta(pop, objective_function, work, fo, a, b);
+            evals++;
+            if (delta < 0.0)
+            {
+                int_ls_apply(pop, work, a, b);
+                fo += delta;
+                n_fails = 0;
+            }
+            else
+                n_fails++;
+            continue;
+        }
+
+        /* 'best': all the genes, 'minconflicts': one random gene
+           (ties broken at random, sideways moves accepted). */
+        best_delta = 0.0;
+        n_ties = 0;
+        a = (pop->ls_mode == LS_BEST) ? 0
+            : (int) rng_bounded(rng, (uint32_t) pop->length);
+        for (; a < pop->length && evals < pop->ls_budget; a++)
+        {
+            for (b = (pop->non_repeatable == NO_REPEAT) ? 0
+                     : pop->min_value;
+                 b < ((pop->non_repeatable == NO_REPEAT) ? pop->length
+                      : pop->max_value + 1) && evals < pop->ls_budget;
+                 b++)
+            {
+                /* No identity moves, swaps counted once in 'best'. */
+                if ((pop->non_repeatable == NO_REPEAT && (b == a ||
+                     (pop->ls_mode == LS_BEST && b < a))) ||
+                    (pop->non_repeatable != NO_REPEAT && b == work[a]))
+                    continue;
+                delta = int_ls_delta(pop, objective_function, work, fo,
+                                     a, b);
+                evals++;
+                if (delta < best_delta)
+                {
+                    best_delta = delta;
+                    n_ties = 0;
+                }
+                if (delta == best_delta &&
+                    (pop->ls_mode == LS_MINCONFLICTS || n_ties == 0) &&
+                    rng_bounded(rng, (uint32_t) ++n_ties) == 0)
+                {
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+            if (pop->ls_mode == LS_MINCONFLICTS)
+                break;
+        }
+        if (pop->ls_mode == LS_BEST && best_delta >= 0.0)
+            /* Local optimum. */
+            break;
+        if (n_ties > 0)
+        {
+            int_ls_apply(pop, work, best_a, best_b);
+            fo += best_delta;
+        }
+        /* 'minconflicts' stops after 'length' genes in a row without
+           improvement. */
+        n_fails = (best_delta < 0.0) ? 0 : n_fails + 1;
+        if (n_fails >= pop->length)
+            break;
+    }
+    *n_evals += evals;
+    return fo;
+}
+
+void
+int_local_search(struct IntPopulation *pop, float (*objective_function)())
+{
+/* Local search stage (see 'int_set_local_search') of an evaluated and
+   ranked population. The targets are searched in parallel by chunks
+   of 'n_threads * LS_ROWS_PER_THREAD', each with it's own random
+   stream, and their results written back in order. */
+    int i, t, c, index, n_rows, n_chunk, n_targets = 0;
+    long n_evals = 0, n_raw = 0;
+    uint64_t seed;
+
+    /* Work rows for a chunk of targets (not one per individual). */
+    n_rows = pop->n_threads * LS_ROWS_PER_THREAD;
+    if (pop->ls_rows < n_rows)
+    {
+        pop->ls_work = realloc(pop->ls_work, n_rows * sizeof(int*));
+        check_null(pop->ls_work, __LINE__, __FILE__);
+        for (i = pop->ls_rows; i < n_rows; i++)
+        {
+            pop->ls_work[i] = ec_malloc(pop->length * sizeof(int),
+                                        __LINE__, __FILE__);
+        }
+        free(pop->ls_fos);
+        pop->ls_fos = ec_malloc(n_rows * sizeof(float), __LINE__, __FILE__);
+        pop->ls_rows = n_rows;
+    }
+    n_rows = pop->ls_rows;
+    /* Only indexes, resized with the population. */
+    pop->ls_targets = realloc(pop->ls_targets,
+                              pop->n_population * sizeof(int));
+    check_null(pop->ls_targets, __LINE__, __FILE__);
+    /* The 'n_top' best and a sampled 'fraction' of the others. */
+    for (i = 0; i < pop->n_population; i++)
+    {
+        if (i < pop->ls_n_top ||
+            (pop->ls_fraction > 0.0 &&
+             rng_double(&pop->rng_state) < pop->ls_fraction))
+            pop->ls_targets[n_targets++] = pop->sorted_fos_indexes[i];
+    }
+    seed = rng_next(&pop->rng_state);
+    /* Chunks of 'n_rows' targets. Each target keeps the stream of it's
+       position 'c + t', so the results don't depend on the chunks. */
+    for (c = 0; c < n_targets; c += n_chunk)
+    {
+        n_chunk = (n_targets - c < n_rows) ? n_targets - c : n_rows;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 1) \
+    reduction(+:n_evals, n_raw) if (pop->n_threads > 1)
+#endif
+        for (t = 0; t < n_chunk; t++)
+        {
+            uint64_t rng = int_block_stream(seed, c + t);
+            int *work = pop->ls_work[t];
+            float fo = pop->fos[pop->ls_targets[c + t]];
+
+            memcpy(work, pop->individuals[pop->ls_targets[c + t]],
+                   pop->length * sizeof(int));
+            if (pop->ls_writeback == LS_BALDWINIAN)
+            {
+                /* The fo kept may be a learned one, the search starts
+                   from the fo of the genome. */
+                fo = objective_function(work, pop->length);
+                n_raw++;
+            }
+            pop->ls_fos[t] = int_ls_climb(pop, objective_function, work,
+                                          fo, &rng, &n_evals);
+        }
+        /* Write back (in order, it may update the diversity
+           statistics). */
+        for (t = 0; t < n_chunk; t++)
+        {
+            index = pop->ls_targets[c + t];
+            if (pop->ls_fos[t] >= pop->fos[index])
+                continue;
+            pop->fos[index] = pop->ls_fos[t];
+            pop->n_ls_improved++;
+            if (pop->ls_writeback == LS_BALDWINIAN)
+                continue;
+            int_own_row(pop, index);
+            int_block_invalidate(pop, index);
+            if (int_tracks_hashes(pop) && pop->diversity_synced)
+                int_diversity_replace(pop, index, pop->ls_work[t], 1);
+            else
+                memcpy(pop->individuals[index], pop->ls_work[t],
+                       pop->length * sizeof(int));
+        }
+    }
+    pop->n_ls_evaluations += n_evals;
+    pop->n_evaluations += n_raw + ((pop->ls_delta == NULL) ? n_evals : 0);
+}
+
+/*==========================*/
+/* Gene-major view and batch evaluation. */
+void
+int_set_batch_objective(struct IntPopulation *pop,
+                        void (*batch_function)())
+{
+/* This function makes 'int_evaluate_population' evaluate the population
+   by blocks of up to GM_BLOCK individuals from the gene-major view.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '(*batch_function)()' : Batch objective with inputs
+                             (int *genes, int stride, int n, int length,
+                             float *fos), or NULL (see GA_int.h). */
+    pop->batch_objective = batch_function;
+}
+
+void
+int_update_gene_major(struct IntPopulation *pop)
+{
+/* Transposes all the individuals to the gene-major view. */
+    int_gm_alloc(pop);
+    int_gm_transpose(pop, 0, pop->n_population,
+                     (pop->n_population + GM_LANES - 1) / GM_LANES
+                     * GM_LANES);
+}
+
+void
+int_gm_alloc(struct IntPopulation *pop)
+{
+/* (Re)allocates the gene-major view for 'n_population_alloc'
+   individuals, 64 bytes aligned. */
+    void *genes;
+
+    if (pop->gm_genes != NULL && pop->gm_rows == pop->n_population_alloc)
+        return;
+    free(pop->gm_genes);
+    pop->gm_rows = pop->n_population_alloc;
+    pop->gm_stride = (pop->gm_rows + GM_LANES - 1) / GM_LANES * GM_LANES;
+    /* A stride multiple of 1 KB maps the genes of a transposed tile
+       (see 'int_gm_transpose') to a few cache sets. */
+    if (pop->gm_stride % 256 == 0)
+        pop->gm_stride += GM_LANES;
+    if (posix_memalign(&genes, 64, (size_t) pop->length * pop->gm_stride
+                                   * sizeof(int)) != 0)
+        genes = NULL;
+    check_null(genes, __LINE__, __FILE__);
+    pop->gm_genes = genes;
+}
+
+void
+int_gm_transpose(struct IntPopulation *pop, int first, int last,
+                 int padded_last)
+{
+/* Copies the individuals [first, last) to the columns of the view, and
+   the individual 'first' to the padding columns [last, padded_last).
+   Genes are copied by tiles of 16, so each row is read sequentially
+   while few output lines are written at a time. */
+    int i, j, j0, j1;
+    int *row, *genes;
+    size_t stride = pop->gm_stride;
+
+    for (j0 = 0; j0 < pop->length; j0 += 16)
+    {
+        j1 = (j0 + 16 < pop->length) ? j0 + 16 : pop->length;
+        for (i = first; i < padded_last; i++)
+        {
+            row = pop->individuals[(i < last) ? i : first];
+            genes = pop->gm_genes + i;
+            for (j = j0; j < j1; j++)
+            {
+                genes[j * stride] = row[j];
+            }
+        }
+    }
+}
+
+long
+int_evaluate_batch(struct IntPopulation *pop, int start, int end)
+{
+/* Evaluates the individuals [start, end) ('start' is a multiple of
+   GM_BLOCK) by blocks with the batch objective, in parallel. Blocks
+   without individuals to evaluate are not even transposed.
+   =RETURNS=
+   - The number of evaluated individuals. */
+    int b, n_blocks = (end - start + GM_BLOCK - 1) / GM_BLOCK;
+    long n_evaluations = 0;
+
+    int_gm_alloc(pop);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 1) \
+    reduction(+:n_evaluations) if (pop->n_threads > 1)
+#endif
+    for (b = 0; b < n_blocks; b++)
+    {
+        int i, n, n_eval = 0;
+        int first = start + b * GM_BLOCK;
+        int last = (first + GM_BLOCK < end) ? first + GM_BLOCK : end;
+        float fos[GM_BLOCK];
+
+        for (i = first; i < last; i++)
+        {
+            if (!(pop->n_eval_skip > 0 && pop->eval_skip[i]))
+                n_eval++;
+        }
+        if (n_eval == 0)
+            continue;
+        n = (last - first + GM_LANES - 1) / GM_LANES * GM_LANES;
+        int_gm_transpose(pop, first, last, first + n);
+        pop->batch_objective(pop->gm_genes + first, pop->gm_stride, n,
+                             pop->length, fos);
+        for (i = first; i < last; i++)
+        {
+            if (!(pop->n_eval_skip > 0 && pop->eval_skip[i]))
+                pop->fos[i] = fos[i - first];
+        }
+        n_evaluations += n_eval;
+    }
+    return n_evaluations;
+}
+
+/*==========================*/
+/* Hall of fame. */
+void
+int_set_hall_of_fame(struct IntPopulation *pop, int capacity)
+{
+/* This function defines the capacity of the hall of fame: the
+   'capacity' best distinct genomes found through all iters. If it
+   already has entries, the best ones are kept.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'capacity' : Max. number of entries (>= 1). */
+    int i, n;
+    int **rows;
+    float *fos;
+
+    if (capacity < 1 || (pop->storage == STORAGE_MMAP &&
+                         capacity > pop->n_population_alloc))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "The hall of fame capacity must be in [1, %d] (%d given).\n"
+               "====================\n", (pop->storage == STORAGE_MMAP)
+               ? pop->n_population_alloc : INT_MAX, capacity);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (pop->hof_genomes == NULL)
+    {
+        /* Allocated by the first evaluation. */
+        pop->hof_capacity = capacity;
+        return;
+    }
+    /* Rebuilt with the best entries. */
+    n = (pop->hof_size < capacity) ? pop->hof_size : capacity;
+    rows = ec_malloc(n * sizeof(int*), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        rows[i] = ec_malloc(pop->length * sizeof(int), __LINE__, __FILE__);
+    }
+    fos = ec_malloc(n * sizeof(float), __LINE__, __FILE__);
+    n = int_hall_of_fame(pop, rows, fos, n);
+    int_hof_free(pop);
+    int_hof_alloc(pop, capacity);
+    for (i = 0; i < n; i++)
+    {
+        int_hof_offer(pop, rows[i], fos[i], int_hof_hash(pop, rows[i]));
+        free(rows[i]);
+    }
+    int_hof_update_best(pop);
+    free(rows);
+    free(fos);
+}
+
+int
+int_hall_of_fame(struct IntPopulation *pop, int **genomes, float *fos,
+                 int max_entries)
+{
+/* This function copies the (at most) 'max_entries' best entries of the
+   hall of fame, best first.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already evaluated.
+   - '**genomes' : Shape [max_entries][pop->length] (or NULL).
+   - '*fos' : 'max_entries' fos (or NULL).
+   - 'max_entries' : Max. number of entries to copy.
+   =RETURNS=
+   - The number of entries copied. */
+    int i, n;
+    struct IntRank *ranks;
+
+    n = (pop->hof_size < max_entries) ? pop->hof_size : max_entries;
+    if (n <= 0)
+        return 0;
+    ranks = ec_malloc(pop->hof_size * sizeof(struct IntRank),
+                      __LINE__, __FILE__);
+    for (i = 0; i < pop->hof_size; i++)
+    {
+        ranks[i].fo = pop->hof_fos[i];
+        ranks[i].index = i;
+    }
+    qsort(ranks, pop->hof_size, sizeof(struct IntRank), compare_ranks);
+    for (i = 0; i < n; i++)
+    {
+        if (genomes != NULL)
+            memcpy(genomes[i], pop->hof_genomes[ranks[i].index],
+                   pop->length * sizeof(int));
+        if (fos != NULL)
+            fos[i] = ranks[i].fo;
+    }
+    free(ranks);
+    return n;
+}
+
+void
+int_hof_alloc(struct IntPopulation *pop, int capacity)
+{
+/* Allocates an empty hall of fame with 'capacity' entries. Mapped
+   populations keep the genomes in the region MMAP_REGION_BEST. */
+    int i;
+
+    if (pop->storage == STORAGE_MMAP && capacity > pop->n_population_alloc)
+        capacity = pop->n_population_alloc;
+    pop->hof_capacity = capacity;
+    pop->hof_size = 0;
+    for (pop->hof_table_size = 4; pop->hof_table_size < 2 * capacity;
+         pop->hof_table_size *= 2)
+        ;
+    pop->hof_genomes = ec_malloc(capacity * sizeof(int*),
+                                 __LINE__, __FILE__);
+    for (i = 0; i < capacity; i++)
+    {
+        if (pop->storage == STORAGE_MMAP)
+            pop->hof_genomes[i] = int_mmap_row(pop, MMAP_REGION_BEST, i);
+        else
+            pop->hof_genomes[i] = ec_malloc(pop->length * sizeof(int),
+                                            __LINE__, __FILE__);
+    }
+    pop->hof_fos = ec_malloc(capacity * sizeof(float), __LINE__, __FILE__);
+    pop->hof_hashes = ec_malloc(capacity * sizeof(uint64_t),
+                                __LINE__, __FILE__);
+    pop->hof_heap = ec_malloc(capacity * sizeof(int), __LINE__, __FILE__);
+    pop->hof_heap_pos = ec_malloc(capacity * sizeof(int),
+                                  __LINE__, __FILE__);
+    pop->hof_table = ec_calloc(pop->hof_table_size, sizeof(int),
+                               __LINE__, __FILE__);
+    pop->best_indv_alltime = ec_malloc(capacity * sizeof(int*),
+                                       __LINE__, __FILE__);
+    pop->n_best_indv_alltime = 0;
+}
+
+void
+int_hof_free(struct IntPopulation *pop)
+{
+/* Frees the hall of fame ('hof_size' is kept for the header of mapped
+   populations). */
+    int i;
+
+    for (i = 0; i < pop->hof_capacity && pop->hof_genomes != NULL &&
+                pop->storage == STORAGE_HEAP; i++)
+    {
+        free(pop->hof_genomes[i]);
+    }
+    free(pop->hof_genomes);
+    free(pop->hof_fos);
+    free(pop->hof_hashes);
+    free(pop->hof_heap);
+    free(pop->hof_heap_pos);
+    free(pop->hof_table);
+    free(pop->best_indv_alltime);
+    pop->hof_genomes = NULL;
+    pop->best_indv_alltime = NULL;
+    pop->n_best_indv_alltime = 0;
+}
+
+uint64_t
+int_hof_hash(struct IntPopulation *pop, int *arr)
+{
+/* Genome hash, the same one kept in 'pop->hashes'. */
+    int j;
+    uint64_t hash = 0;
+
+    for (j = 0; j < pop->length; j++)
+    {
+        hash ^= int_gene_hash(j, arr[j]);
+    }
+    return hash;
+}
+
+int
+int_hof_table_find(struct IntPopulation *pop, int *arr, uint64_t hash)
+{
+/* Returns the position in 'hof_table' of the genome '*arr', or of the
+   empty entry where it would be inserted. */
+    int pos, slot, mask = pop->hof_table_size - 1;
+
+    for (pos = (int) (hash & mask); pop->hof_table[pos] != 0;
+         pos = (pos + 1) & mask)
+    {
+        slot = pop->hof_table[pos] - 1;
+        if (pop->hof_hashes[slot] == hash &&
+            memcmp(pop->hof_genomes[slot], arr,
+                   pop->length * sizeof(int)) == 0)
+            break;
+    }
+    return pos;
+}
+
+void
+int_hof_table_remove(struct IntPopulation *pop, int slot)
+{
+/* Removes 'slot' from 'hof_table', shifting back the following entries
+   of the cluster (no tombstones). */
+    int pos, next, home, mask = pop->hof_table_size - 1;
+
+    pos = int_hof_table_find(pop, pop->hof_genomes[slot],
+                             pop->hof_hashes[slot]);
+    pop->hof_table[pos] = 0;
+    for (next = (pos + 1) & mask; pop->hof_table[next] != 0;
+         next = (next + 1) & mask)
+    {
+        home = (int) (pop->hof_hashes[pop->hof_table[next] - 1] & mask);
+        /* The entry can move to 'pos' if it's home is not in
+           (pos, next] (cyclically). */
+        if ((next > pos) ? (home <= pos || home > next)
+                         : (home <= pos && home > next))
+        {
+            pop->hof_table[pos] = pop->hof_table[next];
+            pop->hof_table[next] = 0;
+            pos = next;
+        }
+    }
+}
+
+void
+int_hof_sift(struct IntPopulation *pop, int pos)
+{
+/* Restores the heap property (worst fo on top) around 'pos'. */
+    int parent, child, tmp;
+    int *heap = pop->hof_heap;
+    float *fos = pop->hof_fos;
+
+    while (pos > 0 && fos[heap[(parent = (pos - 1) / 2)]] < fos[heap[pos]])
+    {
+        tmp = heap[parent];
+        heap[parent] = heap[pos];
+        heap[pos] = tmp;
+        pop->hof_heap_pos[heap[pos]] = pos;
+        pop->hof_heap_pos[heap[parent]] = parent;
+        pos = parent;
+    }
+    while ((child = 2 * pos + 1) < pop->hof_size)
+    {
+        if (child + 1 < pop->hof_size && fos[heap[child + 1]] > fos[heap[child]])
+            child++;
+        if (fos[heap[child]] <= fos[heap[pos]])
+            break;
+        tmp = heap[child];
+        heap[child] = heap[pos];
+        heap[pos] = tmp;
+        pop->hof_heap_pos[heap[pos]] = pos;
+        pop->hof_heap_pos[heap[child]] = child;
+        pos = child;
+    }
+}
+
+void
+int_hof_index(struct IntPopulation *pop, int slot, float fo, uint64_t hash)
+{
+/* Adds the genome already copied to the new 'slot' (== 'hof_size') to
+   the heap and the hash table. */
+    pop->hof_fos[slot] = fo;
+    pop->hof_hashes[slot] = hash;
+    pop->hof_table[int_hof_table_find(pop, pop->hof_genomes[slot], hash)] =
+        slot + 1;
+    pop->hof_heap[pop->hof_size] = slot;
+    pop->hof_heap_pos[slot] = pop->hof_size;
+    pop->hof_size++;
+    int_hof_sift(pop, pop->hof_size - 1);
+}
+
+int
+int_hof_offer(struct IntPopulation *pop, int *arr, float fo,
+              uint64_t hash)
+{
+/* Inserts the genome '*arr' with 'fo' in the hall of fame if it's not
+   full or 'fo' is better than it's worst entry (which is replaced),
+   and if it's not already there. O(log capacity) plus the copy.
+   =RETURNS=
+   - 1 if it was inserted, 0 otherwise. */
+    int slot, pos;
+
+    if (pop->hof_size == pop->hof_capacity &&
+        fo >= pop->hof_fos[pop->hof_heap[0]])
+        return 0;
+    pos = int_hof_table_find(pop, arr, hash);
+    if (pop->hof_table[pos] != 0)
+        return 0;
+    if (pop->hof_size < pop->hof_capacity)
+    {
+        slot = pop->hof_size;
+        memcpy(pop->hof_genomes[slot], arr, pop->length * sizeof(int));
+        int_hof_index(pop, slot, fo, hash);
+        return 1;
+    }
+    /* Replacing the worst entry (top of the heap). */
+    slot = pop->hof_heap[0];
+    int_hof_table_remove(pop, slot);
+    memcpy(pop->hof_genomes[slot], arr, pop->length * sizeof(int));
+    pop->hof_fos[slot] = fo;
+    pop->hof_hashes[slot] = hash;
+    pop->hof_table[int_hof_table_find(pop, arr, hash)] = slot + 1;
+    int_hof_sift(pop, 0);
+    return 1;
+}
+
+void
+int_hof_restore(struct IntPopulation *pop, int n_restored,
+                float (*objective_function)())
+{
+/* Rebuilds the hall of fame of a remapped population from the genomes
+   kept in it's file (their fos are evaluated again). */
+    int slot;
+
+    if (n_restored > pop->hof_capacity)
+        n_restored = pop->hof_capacity;
+    for (slot = 0; slot < n_restored; slot++)
+    {
+        int_hof_index(pop, slot,
+                      objective_function(pop->hof_genomes[slot],
+                                         pop->length),
+                      int_hof_hash(pop, pop->hof_genomes[slot]));
+        pop->n_evaluations++;
+    }
+    int_hof_update_best(pop);
+}
+
+void
+int_hof_update_best(struct IntPopulation *pop)
+{
+/* Points 'best_indv_alltime' to the entries with 'best_fo_alltime'. */
+    int slot;
+
+    pop->n_best_indv_alltime = 0;
+    for (slot = 0; slot < pop->hof_size; slot++)
+    {
+        if (pop->hof_fos[slot] == pop->best_fo_alltime)
+            pop->best_indv_alltime[pop->n_best_indv_alltime++] =
+                pop->hof_genomes[slot];
+    }
+}
+
+/*==========================*/
+/* Cellular GA. */
+void
+int_set_cellular(struct IntPopulation *pop, int n_rows,
+                 char *neighborhood, char *update_mode)
+{
+/* This function places the individuals on a 2D toroidal grid, used by
+   'int_cellular_one_iter'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'n_rows' : Number of rows of the grid (divisor of 'n_population').
+   - '*neighborhood' : 'vonneumann', 'moore' or 'none' (see GA_int.h).
+   - '*update_mode' : 'sync' or 'async'. */
+
+    /* Sanity check. */
+    check_null(neighborhood, __LINE__, __FILE__);
+    check_null(update_mode, __LINE__, __FILE__);
+
+    if (strcmp(neighborhood, "none") == 0)
+    {
+        pop->cell_neighborhood = CELL_NONE;
+        return;
+    }
+    else if (strcmp(neighborhood, "vonneumann") == 0)
+        pop->cell_neighborhood = CELL_VON_NEUMANN;
+    else if (strcmp(neighborhood, "moore") == 0)
+        pop->cell_neighborhood = CELL_MOORE;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'neighborhood' ('%s') argument passed\nto "
+               "'int_set_cellular' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'vonneumann' :    the 4 nearest cells.\n"
+               "-'moore'      :    the 8 surrounding cells.\n"
+               "-'none'       :    no grid.\n"
+               "====================\n", neighborhood);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(update_mode, "sync") == 0)
+        pop->cell_update = CELL_SYNC;
+    else if (strcmp(update_mode, "async") == 0)
+        pop->cell_update = CELL_ASYNC;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'update_mode' ('%s') argument passed\nto "
+               "'int_set_cellular' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'sync'  :    all the cells replaced at once.\n"
+               "-'async' :    cells updated in place (line sweep).\n"
+               "====================\n", update_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (n_rows < 1 || pop->n_population % n_rows != 0)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'n_rows' (%d) passed to 'int_set_cellular' must be\n"
+               "a divisor of 'n_population' (%d).\n"
+               "====================\n", n_rows, pop->n_population);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->cell_rows = n_rows;
+    pop->cell_cols = pop->n_population / n_rows;
+}
+
+int
+int_cell_neighbors(struct IntPopulation *pop, int cell, int *neighbors)
+{
+/* Indexes of the neighbors of 'cell' on the toroidal grid: N, S, W, E
+   and, for 'moore', the 4 diagonals.
+   =RETURNS=
+   - The number of neighbors (4 or 8). */
+    static const int d_row[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static const int d_col[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+    int k, n_neighbors = (pop->cell_neighborhood == CELL_MOORE) ? 8 : 4;
+    int row = cell / pop->cell_cols, col = cell % pop->cell_cols;
+
+    for (k = 0; k < n_neighbors; k++)
+    {
+        neighbors[k] = (row + d_row[k] + pop->cell_rows) % pop->cell_rows
+                       * pop->cell_cols
+                       + (col + d_col[k] + pop->cell_cols) % pop->cell_cols;
+    }
+    return n_neighbors;
+}
+
+int
+int_cell_update(struct IntPopulation *pop, int cell, int cross_code,
+                int mutate_code, float mutate_rate, int tournament_size,
+                float (*objective_function)(), uint64_t *rng)
+{
+/* Breeds the child of 'cell' using the random stream '*rng': the cell
+   is mated with the winner of a tournament among it's neighbors
+   (distinct competitors, partial Fisher-Yates) and the first child of
+   the pair goes to 'ext_new_individuals[cell]', with it's fo in
+   'pop->next_fos[cell]' (the sibling is left in 'ext_childs[cell]').
+   =RETURNS=
+   - 1 if the child is not worse than the cell, 0 otherwise. */
+    int k, m, tmp, winner = -1, n_neighbors;
+    int neighbors[8];
+
+    n_neighbors = int_cell_neighbors(pop, cell, neighbors);
+    if (tournament_size > n_neighbors)
+        tournament_size = n_neighbors;
+    for (k = 0; k < tournament_size || winner < 0; k++)
+    {
+        m = k + (int) rng_bounded(rng, (uint32_t) (n_neighbors - k));
+        tmp = neighbors[m];
+        neighbors[m] = neighbors[k];
+        neighbors[k] = tmp;
+        if (winner < 0 || pop->fos[neighbors[k]] < pop->fos[winner])
+            winner = neighbors[k];
+    }
+    int_breed_pair(pop, cross_code, mutate_code, mutate_rate,
+                   pop->individuals[cell], pop->individuals[winner],
+                   pop->ext_new_individuals[cell], pop->ext_childs[cell],
+                   NULL, NULL, NULL, NULL, int_thread_scratch(pop), rng);
+    pop->next_fos[cell] = objective_function(pop->ext_new_individuals[cell],
+                                             pop->length);
+    return pop->next_fos[cell] <= pop->fos[cell];
+}
+
+void
+int_accept_child(struct IntPopulation *pop, int i)
+{
+/* The child in 'ext_new_individuals[i]' (with fo 'pop->next_fos[i]')
+   replaces the individual i. Rows owned by the pop are swapped, mapped
+   and 'unalloc' ones are copied. A released row still shared (see
+   'int_set_genome_sharing') is replaced by a new one (critical section,
+   asynchronous cells accept their childs in parallel). */
+    int *tmp;
+
+    if (pop->storage == STORAGE_MMAP ||
+        strcmp(pop->init_mode, "unalloc") == 0)
+        memcpy(pop->individuals[i], pop->ext_new_individuals[i],
+               sizeof(int) * pop->length);
+    else
+    {
+        tmp = pop->individuals[i];
+        pop->individuals[i] = pop->ext_new_individuals[i];
+        pop->ext_new_individuals[i] = tmp;
+        if (pop->cow_mode == COW_SHARE)
+        {
+#ifdef _OPENMP
+#pragma omp critical (int_cow)
+#endif
+            if (!int_cow_release(pop, tmp))
+                pop->ext_new_individuals[i] = int_cow_new_row(pop);
+        }
+    }
+    pop->fos[i] = pop->next_fos[i];
+}
+
+void
+int_adopt_known_fos(struct IntPopulation *pop,
+                    float (*objective_function)(), char *mutate_mode,
+                    long n_evaluated)
+{
+/* Ends a generation whose fos are already known (replacement schemes
+   evaluating their childs as they breed them): only the ranking, all
+   time best, local search and statistics of 'int_evaluate_population'
+   are left, then stagnation triggers are applied. 'n_evaluated' childs
+   were evaluated. */
+    int i;
+
+    pop->n_evaluations += n_evaluated;
+    for (i = 0; i < pop->n_population; i++)
+    {
+        pop->eval_skip[i] = 1;
+    }
+    pop->n_eval_skip = pop->n_population;
+    /* They are not saved evaluations either. */
+    pop->n_evals_saved -= pop->n_population;
+    pop->diversity_synced = 0;
+    int_evaluate_population(pop, objective_function);
+    /* Stagnation triggers (if set). */
+    if (pop->stagnation_mode != STAGNATION_NONE)
+        int_apply_stagnation(pop, mutate_mode);
+}
+
+void
+int_cellular_one_iter(struct IntPopulation *pop,
+                      float (*objective_function)(), int tournament_size,
+                      char *cross_mode, char *mutate_mode,
+                      float mutate_rate)
+{
+/* The purpose of this function is to apply a complete iteration of
+   the cellular GA defined by 'int_set_cellular'. Each cell is mated
+   with the winner of a neighborhood tournament and replaced by the
+   child if it's not worse. With 'sync' updates, all the childs are
+   bred from the current generation (one random stream per cell) and
+   adopted at once. With 'async' updates, bands of CELL_TILE_ROWS rows
+   (tiles, one random stream each) are swept in place: even tiles
+   first, then odd ones (and the last one alone if their number is
+   odd), so tiles updated at the same time never share a halo row.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated,
+              with a grid.
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'tournament_size' : Competitors within each neighborhood tournament.
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+    int i, tile, phase, n_tiles, n_phases, tile_cells;
+    int cross_code, mutate_code;
+    uint64_t seed;
+
+    if (pop->cell_neighborhood == CELL_NONE ||
+        pop->cell_rows * pop->cell_cols != pop->n_population ||
+        pop->first_population == POP_NOT_EVAL)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_cellular_one_iter' needs an evaluated population\n"
+               "with a grid of 'n_population' cells (see "
+               "'int_set_cellular').\n"
+               "====================\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_init_ext_ptrs(pop);
+    /* Slots left without row by a fused breeding. */
+    int_cow_fill_rows(pop);
+    int_init_dedup_buffers(pop);
+    int_init_breed_buffers(pop);
+    cross_code = int_cross_mode_code(pop, cross_mode, 2);
+    mutate_code = int_mutate_mode_code(pop, mutate_mode);
+    seed = rng_next(&pop->rng_state);
+
+    if (pop->cell_update == CELL_SYNC)
+    {
+        /* Cells read only the current generation, static bands of
+           cells per thread. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+        for (i = 0; i < pop->n_population; i++)
+        {
+            uint64_t rng = int_block_stream(seed, i);
+
+            pop->next_fo_known[i] = int_cell_update(pop, i, cross_code,
+                                                    mutate_code, mutate_rate,
+                                                    tournament_size,
+                                                    objective_function,
+                                                    &rng);
+        }
+        for (i = 0; i < pop->n_population; i++)
+        {
+            if (pop->next_fo_known[i])
+                int_accept_child(pop, i);
+        }
+    }
+    else
+    {
+        tile_cells = CELL_TILE_ROWS * pop->cell_cols;
+        n_tiles = (pop->cell_rows + CELL_TILE_ROWS - 1) / CELL_TILE_ROWS;
+        n_phases = (n_tiles > 1 && n_tiles % 2 == 1) ? 3 : 2;
+        for (phase = 0; phase < n_phases; phase++)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 1) \
+    if (pop->n_threads > 1)
+#endif
+            for (tile = 0; tile < n_tiles; tile++)
+            {
+                uint64_t rng = int_block_stream(seed, tile);
+                int cell, last;
+
+                /* The last tile of an odd number goes alone. */
+                if (((n_phases == 3 && tile == n_tiles - 1) ? 2 : tile % 2)
+                    != phase)
+                    continue;
+                last = (tile + 1) * tile_cells;
+                if (last > pop->n_population)
+                    last = pop->n_population;
+                for (cell = tile * tile_cells; cell < last; cell++)
+                {
+                    if (int_cell_update(pop, cell, cross_code, mutate_code,
+                                        mutate_rate, tournament_size,
+                                        objective_function, &rng))
+                        int_accept_child(pop, cell);
+                }
+            }
+        }
+    }
+
+    int_adopt_known_fos(pop, objective_function, mutate_mode,
+                        pop->n_population);
+}
+
+/*==========================*/
+/* Niching. */
+void
+int_set_niching(struct IntPopulation *pop, char *niche_mode,
+                char *search_mode, float radius, float niche_param)
+{
+/* This function sets the niching method used by the selection.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*niche_mode' : 'sharing', 'clearing', 'count' or 'none'
+                     (see GA_int.h).
+   - '*search_mode' : 'exact' or 'lsh'.
+   - 'radius' : Niche radius, as a fraction (0, 1] of the genes.
+   - 'niche_param' : Sharing exponent or clearing capacity. */
+    int t, m, k, tmp, *loci;
+    uint64_t rng;
+
+    /* Sanity check. */
+    check_null(niche_mode, __LINE__, __FILE__);
+    check_null(search_mode, __LINE__, __FILE__);
+
+    if (strcmp(niche_mode, "none") == 0)
+    {
+        pop->niche_mode = NICHE_NONE;
+        return;
+    }
+    else if (strcmp(niche_mode, "sharing") == 0)
+        pop->niche_mode = NICHE_SHARING;
+    else if (strcmp(niche_mode, "clearing") == 0)
+        pop->niche_mode = NICHE_CLEARING;
+    else if (strcmp(niche_mode, "count") == 0)
+        pop->niche_mode = NICHE_COUNT;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'niche_mode' ('%s') argument passed\nto "
+               "'int_set_niching' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'sharing'  :    fitness sharing.\n"
+               "-'clearing' :    clearing (best 'niche_param' per niche).\n"
+               "-'count'    :    only the niche counts.\n"
+               "-'none'     :    no niching.\n"
+               "====================\n", niche_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(search_mode, "exact") == 0)
+        pop->niche_search = NICHE_EXACT;
+    else if (strcmp(search_mode, "lsh") == 0)
+        pop->niche_search = NICHE_LSH;
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'search_mode' ('%s') argument passed\nto "
+               "'int_set_niching' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'exact' :    all the pairs are compared.\n"
+               "-'lsh'   :    only the pairs of a same LSH bucket.\n"
+               "====================\n", search_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (radius <= 0.0 || radius > 1.0 ||
+        (pop->niche_mode == NICHE_SHARING && niche_param <= 0.0) ||
+        (pop->niche_mode == NICHE_CLEARING && niche_param < 1.0))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_set_niching' needs a 'radius' in (0, 1] (%f passed)\n"
+               "and a 'niche_param' > 0 for 'sharing' or >= 1 for\n"
+               "'clearing' (%f passed).\n"
+               "====================\n", radius, niche_param);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    pop->niche_radius = (int) ceil(radius * pop->length);
+    pop->niche_param = niche_param;
+    pop->niche_synced = 0;
+    if (pop->niche_search != NICHE_LSH)
+        return;
+
+    /* Loci per table, so a pair at distance 'niche_radius' agrees in
+       all of them with probability (1 - radius)^k ~ 0.5. */
+    if (pop->niche_radius >= pop->length)
+        k = 1;
+    else
+        k = (int) ceil(log(0.5) / log(1.0 - (double) pop->niche_radius
+                                               / pop->length));
+    if (k > NICHE_LSH_MAX_LOCI)
+        k = NICHE_LSH_MAX_LOCI;
+    if (k > pop->length)
+        k = pop->length;
+    if (k < 1)
+        k = 1;
+    pop->niche_lsh_k = k;
+    free(pop->niche_lsh_loci);
+    pop->niche_lsh_loci = ec_malloc(NICHE_LSH_TABLES * k * sizeof(int),
+                                    __LINE__, __FILE__);
+    loci = ec_malloc(pop->length * sizeof(int), __LINE__, __FILE__);
+    for (t = 0; t < NICHE_LSH_TABLES; t++)
+    {
+        /* Distinct loci (partial Fisher-Yates), from a stream of it's
+           own so the pop stream is not moved. */
+        rng = int_block_stream(pop->rng_state, t);
+        for (m = 0; m < pop->length; m++)
+        {
+            loci[m] = m;
+        }
+        for (m = 0; m < k; m++)
+        {
+            tmp = m + (int) rng_bounded(&rng, (uint32_t) (pop->length - m));
+            pop->niche_lsh_loci[t * k + m] = loci[tmp];
+            loci[tmp] = loci[m];
+        }
+    }
+    free(loci);
+}
+
+int
+int_hamming_distance(int *arr1, int *arr2, int length, int limit)
+{
+/* Returns the number of genes in which 'arr1' and 'arr2' differ,
+   stopping after the first block of NICHE_HAMMING_BLOCK genes with
+   more than 'limit' differences. */
+    int j, k, end, distance = 0;
+
+    for (j = 0; j < length && distance <= limit; j = end)
+    {
+        end = (j + NICHE_HAMMING_BLOCK < length) ?
+              j + NICHE_HAMMING_BLOCK : length;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:distance)
+#endif
+        for (k = j; k < end; k++)
+        {
+            distance += (arr1[k] != arr2[k]);
+        }
+    }
+    return distance;
+}
+
+void
+int_init_niche_buffers(struct IntPopulation *pop)
+{
+/* Allocs (or reallocs, after a population resize) the niched fos,
+   counts and order with 'pop->n_population_alloc' elements. */
+    int rows = pop->n_population_alloc;
+
+    if (pop->niche_rows == rows)
+        return;
+    pop->niche_fos = realloc(pop->niche_fos, rows * sizeof(float));
+    check_null(pop->niche_fos, __LINE__, __FILE__);
+    pop->niche_counts = realloc(pop->niche_counts, rows * sizeof(float));
+    check_null(pop->niche_counts, __LINE__, __FILE__);
+    pop->niche_order = realloc(pop->niche_order, rows * sizeof(int));
+    check_null(pop->niche_order, __LINE__, __FILE__);
+    pop->niche_rows = rows;
+}
+
+void
+int_niche_push(struct IntNichePair **pairs, long *n_pairs, long *cap,
+               int i, int j, int distance, float weight)
+{
+/* Appends the pair (i, j) to '*pairs' ('*cap' elements alloc'd),
+   doubling it when full. */
+    if (*n_pairs == *cap)
+    {
+        *cap = (*cap > 0) ? 2 * *cap : 1024;
+        *pairs = realloc(*pairs, *cap * sizeof(struct IntNichePair));
+        check_null(*pairs, __LINE__, __FILE__);
+    }
+    (*pairs)[*n_pairs].i = i;
+    (*pairs)[*n_pairs].j = j;
+    (*pairs)[*n_pairs].distance = distance;
+    (*pairs)[*n_pairs].weight = weight;
+    (*n_pairs)++;
+}
+
+long
+int_niche_exact_pairs(struct IntPopulation *pop)
+{
+/* Compares all the pairs of individuals and keeps the close ones,
+   sorted, in 'pop->niche_pairs'. Each thread fills a list of it's own
+   with the pairs of the rows it compares, merged by row at the end.
+   =RETURNS=
+   - The number of distances computed. */
+    int i, n = pop->n_population, limit = pop->niche_radius - 1;
+    int *row_list;
+    long p, *row_start, *row_end, *list_size;
+    struct IntNichePair **lists, *pair;
+
+    lists = ec_calloc(pop->n_threads, sizeof(struct IntNichePair*),
+                      __LINE__, __FILE__);
+    list_size = ec_calloc(pop->n_threads, sizeof(long), __LINE__, __FILE__);
+    row_list = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    row_start = ec_malloc(n * sizeof(long), __LINE__, __FILE__);
+    row_end = ec_malloc(n * sizeof(long), __LINE__, __FILE__);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(pop->n_threads) if (pop->n_threads > 1)
+#endif
+    {
+        int j, distance, list = 0;
+        long cap = 0;
+
+#ifdef _OPENMP
+        list = omp_get_thread_num();
+#pragma omp for schedule(dynamic, 16)
+#endif
+        for (i = 0; i < n; i++)
+        {
+            row_list[i] = list;
+            row_start[i] = list_size[list];
+            for (j = i + 1; j < n; j++)
+            {
+                distance = int_hamming_distance(pop->individuals[i],
+                                                pop->individuals[j],
+                                                pop->length, limit);
+                if (distance <= limit)
+                    int_niche_push(&lists[list], &list_size[list], &cap,
+                                   i, j, distance, 1.0);
+            }
+            row_end[i] = list_size[list];
+        }
+    }
+
+    /* Merging the rows, in order. */
+    pop->niche_n_pairs = 0;
+    for (i = 0; i < n; i++)
+    {
+        for (p = row_start[i]; p < row_end[i]; p++)
+        {
+            pair = &lists[row_list[i]][p];
+            int_niche_push(&pop->niche_pairs, &pop->niche_n_pairs,
+                           &pop->niche_pairs_cap, pair->i, pair->j,
+                           pair->distance, 1.0);
+        }
+    }
+    for (i = 0; i < pop->n_threads; i++)
+    {
+        free(lists[i]);
+    }
+    free(lists);
+    free(list_size);
+    free(row_list);
+    free(row_start);
+    free(row_end);
+    return (long) n * (n - 1) / 2;
+}
+
+long
+int_niche_lsh_pairs(struct IntPopulation *pop)
+{
+/* Candidate pairs from the buckets (same hash of the sampled loci) of
+   each LSH table: buckets of up to 2 * NICHE_LSH_WINDOW + 1 members are
+   compared whole, larger ones as a ring (each member with the next
+   NICHE_LSH_WINDOW ones), each pair standing for
+   (size - 1) / (2 * NICHE_LSH_WINDOW) pairs of the bucket. Candidates
+   of several tables are compared once (with the least weight) and the
+   close ones are kept, sorted, in 'pop->niche_pairs'.
+   =RETURNS=
+   - The number of distances computed. */
+    int i, t, a, m, start, end, size, n = pop->n_population;
+    int k = pop->niche_lsh_k, limit = pop->niche_radius - 1;
+    long c, n_candidates;
+    long long *keys;
+    struct IntNichePair *pairs;
+    float weight;
+
+    pop->niche_n_pairs = 0;
+    keys = ec_malloc(n * sizeof(long long), __LINE__, __FILE__);
+    for (t = 0; t < NICHE_LSH_TABLES; t++)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(static) \
+    if (pop->n_threads > 1)
+#endif
+        for (i = 0; i < n; i++)
+        {
+            int l, *loci = pop->niche_lsh_loci + t * k;
+            uint64_t hash = 0;
+
+            for (l = 0; l < k; l++)
+            {
+                hash ^= int_gene_hash(loci[l], pop->individuals[i][loci[l]]);
+            }
+            /* Bucket (31 bits of the hash) and index. */
+            keys[i] = ((long long) (hash >> 33) << 32) | i;
+        }
+        qsort(keys, n, sizeof(long long), compare_longs);
+        for (start = 0; start < n; start = end)
+        {
+            for (end = start + 1;
+                 end < n && (keys[end] >> 32) == (keys[start] >> 32); end++)
+                ;
+            size = end - start;
+            if (size <= 2 * NICHE_LSH_WINDOW + 1)
+            {
+                for (a = start; a < end; a++)
+                {
+                    for (m = a + 1; m < end; m++)
+                    {
+                        int_niche_push(&pop->niche_pairs,
+                                       &pop->niche_n_pairs,
+                                       &pop->niche_pairs_cap,
+                                       (int) (keys[a] & 0xffffffff),
+                                       (int) (keys[m] & 0xffffffff), 0, 1.0);
+                    }
+                }
+                continue;
+            }
+            weight = (float) (size - 1) / (2 * NICHE_LSH_WINDOW);
+            for (a = 0; a < size; a++)
+            {
+                for (m = 1; m <= NICHE_LSH_WINDOW; m++)
+                {
+                    int_niche_push(&pop->niche_pairs, &pop->niche_n_pairs,
+                                   &pop->niche_pairs_cap,
+                                   (int) (keys[start + a] & 0xffffffff),
+                                   (int) (keys[start + (a + m) % size]
+                                          & 0xffffffff), 0, weight);
+                }
+            }
+        }
+    }
+    free(keys);
+
+    /* Unique candidates, (i, j) with i < j. */
+    pairs = pop->niche_pairs;
+    for (c = 0; c < pop->niche_n_pairs; c++)
+    {
+        if (pairs[c].i > pairs[c].j)
+        {
+            i = pairs[c].i;
+            pairs[c].i = pairs[c].j;
+            pairs[c].j = i;
+        }
+    }
+    if (pop->niche_n_pairs > 1)
+        qsort(pairs, pop->niche_n_pairs, sizeof(struct IntNichePair),
+              compare_niche_pairs);
+    n_candidates = 0;
+    for (c = 0; c < pop->niche_n_pairs; c++)
+    {
+        if (n_candidates > 0 && pairs[c].i == pairs[n_candidates - 1].i &&
+            pairs[c].j == pairs[n_candidates - 1].j)
+        {
+            if (pairs[c].weight < pairs[n_candidates - 1].weight)
+                pairs[n_candidates - 1].weight = pairs[c].weight;
+            continue;
+        }
+        pairs[n_candidates++] = pairs[c];
+    }
+
+    /* Exact distances of the candidates. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 64) \
+    if (pop->n_threads > 1)
+#endif
+    for (c = 0; c < n_candidates; c++)
+    {
+        pairs[c].distance = int_hamming_distance(
+            pop->individuals[pairs[c].i], pop->individuals[pairs[c].j],
+            pop->length, limit);
+    }
+    pop->niche_n_pairs = 0;
+    for (c = 0; c < n_candidates; c++)
+    {
+        if (pairs[c].distance <= limit)
+            pairs[pop->niche_n_pairs++] = pairs[c];
+    }
+    return n_candidates;
+}
+
+void
+int_niche_clearing(struct IntPopulation *pop, long *first, int *adjacency)
+{
+/* Clearing of 'pop->niche_fos': going from the best fo, each individual
+   not cleared yet keeps it's best 'niche_param' - 1 neighbors not
+   cleared ('adjacency[first[k]:first[k+1]]' holds the sorted positions
+   inside 'sorted_fos_indexes' of the neighbors of the k-th best) and
+   clears the rest, which get the worst fo. */
+    int k, i, j, winners, n = pop->n_population;
+    long q;
+    char *cleared;
+
+    cleared = ec_calloc(n, sizeof(char), __LINE__, __FILE__);
+    for (k = 0; k < n; k++)
+    {
+        i = pop->sorted_fos_indexes[k];
+        pop->niche_fos[i] = pop->fos[i];
+    }
+    for (k = 0; k < n; k++)
+    {
+        i = pop->sorted_fos_indexes[k];
+        if (cleared[i])
+            continue;
+        winners = 1;
+        for (q = first[k]; q < first[k + 1]; q++)
+        {
+            if (adjacency[q] < k)
+                continue;
+            j = pop->sorted_fos_indexes[adjacency[q]];
+            if (cleared[j])
+                continue;
+            if (winners < (int) pop->niche_param)
+                winners++;
+            else
+            {
+                cleared[j] = 1;
+                pop->niche_fos[j] = pop->sorted_fos[n - 1];
+            }
+        }
+    }
+    free(cleared);
+}
+
+void
+int_update_niches(struct IntPopulation *pop)
+{
+/* This function finds the close pairs of the population and defines
+   the niche counts, 'n_niches' and the niched fos of the selection.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already evaluated, with a niching
+              mode (see 'int_set_niching'). */
+    int i, j, k, n = pop->n_population;
+    int *position, *adjacency;
+    long p, *first, *fill;
+    float share, worst_fo;
+    char *covered;
+    struct IntNichePair *pair;
+    struct IntRank *ranks;
+
+    if (pop->niche_mode == NICHE_NONE)
+        return;
+    int_init_niche_buffers(pop);
+    if (pop->niche_search == NICHE_LSH)
+        pop->n_niche_distances = int_niche_lsh_pairs(pop);
+    else
+        pop->n_niche_distances = int_niche_exact_pairs(pop);
+
+    /* Niche counts and sharing terms (inside 'niche_fos'). */
+    for (i = 0; i < n; i++)
+    {
+        pop->niche_counts[i] = 1.0;
+        pop->niche_fos[i] = 1.0;
+    }
+    for (p = 0; p < pop->niche_n_pairs; p++)
+    {
+        pair = &pop->niche_pairs[p];
+        pop->niche_counts[pair->i] += pair->weight;
+        pop->niche_counts[pair->j] += pair->weight;
+        if (pop->niche_mode == NICHE_SHARING)
+        {
+            share = pair->weight * (1.0 - powf((float) pair->distance
+                                               / pop->niche_radius,
+                                               pop->niche_param));
+            pop->niche_fos[pair->i] += share;
+            pop->niche_fos[pair->j] += share;
+        }
+    }
+
+    /* Neighbors by rank: 'adjacency[first[k]:first[k+1]]' holds the
+       positions (inside 'sorted_fos_indexes') of the neighbors of the
+       k-th best individual. */
+    position = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    first = ec_calloc(n + 1, sizeof(long), __LINE__, __FILE__);
+    fill = ec_malloc(n * sizeof(long), __LINE__, __FILE__);
+    adjacency = ec_malloc((2 * pop->niche_n_pairs + 1) * sizeof(int),
+                          __LINE__, __FILE__);
+    for (k = 0; k < n; k++)
+    {
+        position[pop->sorted_fos_indexes[k]] = k;
+    }
+    for (p = 0; p < pop->niche_n_pairs; p++)
+    {
+        first[position[pop->niche_pairs[p].i] + 1]++;
+        first[position[pop->niche_pairs[p].j] + 1]++;
+    }
+    for (k = 0; k < n; k++)
+    {
+        first[k + 1] += first[k];
+        fill[k] = first[k];
+    }
+    for (p = 0; p < pop->niche_n_pairs; p++)
+    {
+        i = position[pop->niche_pairs[p].i];
+        j = position[pop->niche_pairs[p].j];
+        adjacency[fill[i]++] = j;
+        adjacency[fill[j]++] = i;
+    }
+
+    /* Niche centers: going from the best fo, the individuals without a
+       previous center within the radius. */
+    covered = ec_calloc(n, sizeof(char), __LINE__, __FILE__);
+    pop->n_niches = 0;
+    for (k = 0; k < n; k++)
+    {
+        if (covered[k])
+            continue;
+        pop->n_niches++;
+        for (p = first[k]; p < first[k + 1]; p++)
+        {
+            covered[adjacency[p]] = 1;
+        }
+    }
+    free(covered);
+
+    if (pop->niche_mode == NICHE_SHARING)
+    {
+        /* f / m with the fitness f = (worst_fo - fo). */
+        worst_fo = pop->sorted_fos[n - 1];
+        for (i = 0; i < n; i++)
+        {
+            pop->niche_fos[i] = worst_fo - (worst_fo - pop->fos[i])
+                                           / pop->niche_fos[i];
+        }
+    }
+    else if (pop->niche_mode == NICHE_CLEARING)
+    {
+        for (k = 0; k < n; k++)
+        {
+            qsort(adjacency + first[k], first[k + 1] - first[k],
+                  sizeof(int), compare);
+        }
+        int_niche_clearing(pop, first, adjacency);
+    }
+    free(position);
+    free(first);
+    free(fill);
+    free(adjacency);
+
+    if (pop->niche_mode == NICHE_SHARING || pop->niche_mode == NICHE_CLEARING)
+    {
+        ranks = ec_malloc(n * sizeof(struct IntRank), __LINE__, __FILE__);
+        for (i = 0; i < n; i++)
+        {
+            ranks[i].fo = pop->niche_fos[i];
+            ranks[i].index = i;
+        }
+        qsort(ranks, n, sizeof(struct IntRank), compare_ranks);
+        for (i = 0; i < n; i++)
+        {
+            pop->niche_order[i] = ranks[i].index;
+        }
+        free(ranks);
+    }
+    pop->niche_synced = 1;
+}
+
+float
+*int_select_fos(struct IntPopulation *pop)
+{
+/* fos used by the selection: the niched ones with 'sharing' or
+   'clearing' (see 'int_set_niching'), 'pop->fos' otherwise. */
+    if (pop->niche_mode == NICHE_SHARING || pop->niche_mode == NICHE_CLEARING)
+        return pop->niche_fos;
+    return pop->fos;
+}
+
+int
+*int_select_order(struct IntPopulation *pop)
+{
+/* Indexes sorted by the fos of 'int_select_fos'. */
+    if (pop->niche_mode == NICHE_SHARING || pop->niche_mode == NICHE_CLEARING)
+        return pop->niche_order;
+    return pop->sorted_fos_indexes;
+}
+
+void
+int_crowding_one_iter(struct IntPopulation *pop,
+                      float (*objective_function)(), char *cross_mode,
+                      char *mutate_mode, float mutate_rate)
+{
+/* The purpose of this function is to apply a complete iteration of
+   deterministic crowding: random pairs of individuals are bred and
+   each child replaces the most similar parent if it's not worse.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+    int i, m, tmp, n_pairs, cross_code, mutate_code;
+    int *order;
+    uint64_t seed;
+
+    if (pop->first_population == POP_NOT_EVAL)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_crowding_one_iter' needs an evaluated population.\n"
+               "====================\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_init_ext_ptrs(pop);
+    /* Slots left without row by a fused breeding. */
+    int_cow_fill_rows(pop);
+    int_init_dedup_buffers(pop);
+    int_init_breed_buffers(pop);
+    cross_code = int_cross_mode_code(pop, cross_mode, 2);
+    mutate_code = int_mutate_mode_code(pop, mutate_mode);
+
+    /* Random pairing (Fisher-Yates). */
+    order = ec_malloc(pop->n_population * sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        order[i] = i;
+        pop->next_fo_known[i] = 0;
+    }
+    for (i = pop->n_population - 1; i > 0; i--)
+    {
+        m = (int) rng_bounded(&pop->rng_state, (uint32_t) i + 1);
+        tmp = order[i];
+        order[i] = order[m];
+        order[m] = tmp;
+    }
+    seed = rng_next(&pop->rng_state);
+    n_pairs = pop->n_population / 2;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 4) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n_pairs; i++)
+    {
+        uint64_t rng = int_block_stream(seed, i);
+        int a = order[2 * i], b = order[2 * i + 1], *child;
+        float fo;
+
+        int_breed_pair(pop, cross_code, mutate_code, mutate_rate,
+                       pop->individuals[a], pop->individuals[b],
+                       pop->ext_new_individuals[a],
+                       pop->ext_new_individuals[b],
+                       NULL, NULL, NULL, NULL, int_thread_scratch(pop), &rng);
+        pop->next_fos[a] = objective_function(pop->ext_new_individuals[a],
+                                              pop->length);
+        pop->next_fos[b] = objective_function(pop->ext_new_individuals[b],
+                                              pop->length);
+        /* Each child competes with the closest parent. */
+        if (int_hamming_distance(pop->individuals[a],
+                                 pop->ext_new_individuals[a], pop->length,
+                                 pop->length)
+            + int_hamming_distance(pop->individuals[b],
+                                   pop->ext_new_individuals[b], pop->length,
+                                   pop->length)
+            > int_hamming_distance(pop->individuals[a],
+                                   pop->ext_new_individuals[b], pop->length,
+                                   pop->length)
+            + int_hamming_distance(pop->individuals[b],
+                                   pop->ext_new_individuals[a], pop->length,
+                                   pop->length))
+        {
+            child = pop->ext_new_individuals[a];
+            pop->ext_new_individuals[a] = pop->ext_new_individuals[b];
+            pop->ext_new_individuals[b] = child;
+            fo = pop->next_fos[a];
+            pop->next_fos[a] = pop->next_fos[b];
+            pop->next_fos[b] = fo;
+        }
+        pop->next_fo_known[a] = pop->next_fos[a] <= pop->fos[a];
+        pop->next_fo_known[b] = pop->next_fos[b] <= pop->fos[b];
+    }
+    free(order);
+    for (i = 0; i < pop->n_population; i++)
+    {
+        if (pop->next_fo_known[i])
+            int_accept_child(pop, i);
+    }
+    int_adopt_known_fos(pop, objective_function, mutate_mode,
+                        2 * (long) n_pairs);
+}
+
+/*==========================*/
+/* Multi-objective GA (NSGA-II). */
+void
+int_set_multi_objective(struct IntPopulation *pop, int n_objectives,
+                        void (*mo_function)(), int archive_capacity)
+{
+/* This function makes the population multi-objective (see GA_int.h).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'n_objectives' : Number of objectives, in [2, MO_MAX_OBJECTIVES].
+   - '(*mo_function)()' : Objective function with inputs (int *arr,
+                          int length, float *objs).
+   - 'archive_capacity' : Max. number of genomes in the Pareto archive. */
+    int i;
+
+    if (n_objectives < 2 || n_objectives > MO_MAX_OBJECTIVES ||
+        mo_function == NULL || archive_capacity < 1)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_set_multi_objective' needs a 'mo_function', 'n_objectives'\n"
+               "in [2, %d] (%d passed) and 'archive_capacity' >= 1 (%d passed).\n"
+               "====================\n", MO_MAX_OBJECTIVES, n_objectives,
+               archive_capacity);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_mo_free(pop);
+    /* NSGA-II selection moves rows, they are never shared. */
+    int_unshare_rows(pop);
+    pop->mo_n_objectives = n_objectives;
+    pop->mo_function = mo_function;
+    int_mo_alloc(pop);
+    pop->mo_archive_capacity = archive_capacity;
+    pop->mo_archive_size = 0;
+    pop->mo_archive = ec_malloc(archive_capacity * sizeof(int*),
+                                __LINE__, __FILE__);
+    for (i = 0; i < archive_capacity; i++)
+    {
+        pop->mo_archive[i] = ec_malloc(pop->length * sizeof(int),
+                                       __LINE__, __FILE__);
+    }
+    pop->mo_archive_objs = ec_malloc((size_t) archive_capacity * n_objectives
+                                     * sizeof(float), __LINE__, __FILE__);
+    pop->mo_archive_hashes = ec_malloc(archive_capacity * sizeof(uint64_t),
+                                       __LINE__, __FILE__);
+}
+
+void
+int_nsga2_one_iter(struct IntPopulation *pop, int tournament_size,
+                   char *cross_mode, char *mutate_mode, float mutate_rate)
+{
+/* The purpose of this function is to apply a complete NSGA-II
+   generation: crowded tournaments, fused breeding of 'n_population'
+   childs into 'ext_new_individuals', evaluation of their objectives,
+   non dominated sort of parents and childs together and selection of
+   the next generation (see GA_int.h).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated,
+              with 'int_set_multi_objective'.
+   - 'tournament_size' : How many competitors within each tournament.
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+    int i, n_parents;
+    int *selected;
+
+    if (pop->mo_n_objectives == 0 || pop->first_population == POP_NOT_EVAL)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'int_nsga2_one_iter' needs an evaluated population\n"
+               "with 'int_set_multi_objective'.\n"
+               "====================\n");
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_init_ext_ptrs(pop);
+    /* Slots left without row by a fused breeding. */
+    int_cow_fill_rows(pop);
+    int_mo_alloc(pop);
+    if (int_tracks_hashes(pop))
+        int_init_dedup_buffers(pop);
+
+    /* Crowded tournaments, an even number of parents for the pairs. */
+    n_parents = (pop->n_population + 1) / 2 * 2;
+    selected = ec_malloc(n_parents * sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n_parents; i++)
+    {
+        selected[i] = int_mo_tournament(pop, tournament_size,
+                                        &pop->rng_state);
+    }
+    int_breed(pop, cross_mode, mutate_mode, mutate_rate, selected,
+              n_parents, pop->n_population);
+    free(selected);
+    pop->n_evaluations += int_mo_evaluate(pop, pop->ext_new_individuals,
+                                          pop->n_population,
+                                          pop->n_population);
+
+    /* Parents and childs ranked together. */
+    int_mo_rank(pop, 2 * pop->n_population);
+    int_mo_select(pop);
+    pop->generation++;
+    int_mo_finish(pop);
+}
+
+int
+int_pareto_front(struct IntPopulation *pop, int **genomes, float *objs,
+                 int max_entries)
+{
+/* This function copies the (at most) 'max_entries' genomes of the
+   Pareto archive, sorted by their first objective.
+   =ARGUMENTS=
+   - '*pop' : A multi-objective IntPopulation struct already evaluated.
+   - '**genomes' : Shape [max_entries][pop->length] (or NULL).
+   - '*objs' : Shape [max_entries][n_objectives] (or NULL).
+   - 'max_entries' : Max. number of entries to copy.
+   =RETURNS=
+   - The number of entries copied. */
+    int i, m, n = pop->mo_archive_size;
+    struct IntRank *ranks;
+
+    if (n > max_entries)
+        n = max_entries;
+    if (n <= 0)
+        return 0;
+    ranks = ec_malloc(pop->mo_archive_size * sizeof(struct IntRank),
+                      __LINE__, __FILE__);
+    for (i = 0; i < pop->mo_archive_size; i++)
+    {
+        ranks[i].fo = pop->mo_archive_objs[i];
+        ranks[i].index = i;
+    }
+    qsort(ranks, pop->mo_archive_size, sizeof(struct IntRank),
+          compare_ranks);
+    for (i = 0; i < n; i++)
+    {
+        if (genomes != NULL)
+            memcpy(genomes[i], pop->mo_archive[ranks[i].index],
+                   sizeof(int) * pop->length);
+        for (m = 0; m < pop->mo_n_objectives && objs != NULL; m++)
+        {
+            objs[i * pop->mo_n_objectives + m] =
+                pop->mo_archive_objs[m * pop->mo_archive_capacity
+                                     + ranks[i].index];
+        }
+    }
+    free(ranks);
+    return n;
+}
+
+int
+int_nondominated_sort(float *objs, int stride, int n, int n_objectives,
+                      int *rank)
+{
+/* This function sorts 'n' points (objective m of point i in
+   'objs[m * stride + i]') into non dominated fronts, 'rank[i]' being
+   the front of point i. Points are swept in lexicographic order and
+   each one goes to the first front that doesn't dominate it, found by
+   a binary search (efficient non dominated sort). The domination by a
+   front only needs it's previous members:
+   - 2 objectives : The 2nd objective of the last member (the lowest).
+   - 3 objectives : A staircase with the non dominated (2nd, 3rd)
+                    objectives of the members, sorted by the 2nd one.
+   - More         : All the members, newest first.
+   =RETURNS=
+   - The number of fronts. */
+    int i, j, k, m, p, lo, hi, mid, end, dominated, n_fronts = 0;
+    int M = n_objectives;
+    float *points, *q, *st;
+    float *last = NULL, **stairs = NULL;
+    int *stair_n = NULL, *stair_cap = NULL, *head = NULL, *next = NULL;
+    struct IntMoPoint *order;
+
+    if (n <= 0)
+        return 0;
+    /* Points copied in lexicographic order (contiguous objectives). */
+    points = ec_malloc((size_t) n * M * sizeof(float), __LINE__, __FILE__);
+    order = ec_malloc(n * sizeof(struct IntMoPoint), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        for (m = 0; m < M; m++)
+        {
+            points[(size_t) i * M + m] = objs[(size_t) m * stride + i];
+        }
+        order[i].objs = points + (size_t) i * M;
+        order[i].n_objectives = M;
+        order[i].index = i;
+    }
+    qsort(order, n, sizeof(struct IntMoPoint), compare_mo_points);
+    if (M == 2)
+        last = ec_malloc(n * sizeof(float), __LINE__, __FILE__);
+    else if (M == 3)
+    {
+        stairs = ec_malloc(n * sizeof(float*), __LINE__, __FILE__);
+        stair_n = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+        stair_cap = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    }
+    else
+    {
+        head = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+        next = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    }
+
+    for (p = 0; p < n; p++)
+    {
+        q = order[p].objs;
+        /* Copies of the previous point go to it's front. */
+        m = 0;
+        while (p > 0 && m < M && q[m] == order[p - 1].objs[m])
+            m++;
+        if (p > 0 && m == M)
+        {
+            rank[order[p].index] = rank[order[p - 1].index];
+            continue;
+        }
+        /* Previous points have a lower (or equal) 1st objective, so
+           only the others are compared. */
+        lo = 0;
+        hi = n_fronts;
+        while (lo < hi)
+        {
+            mid = (lo + hi) / 2;
+            if (M == 2)
+                dominated = (last[mid] <= q[1]);
+            else if (M == 3)
+            {
+                /* Member with the largest 2nd objective <= q[1]. */
+                st = stairs[mid];
+                i = 0;
+                j = stair_n[mid];
+                while (i < j)
+                {
+                    k = (i + j) / 2;
+                    if (st[2 * k] <= q[1])
+                        i = k + 1;
+                    else
+                        j = k;
+                }
+                dominated = (i > 0 && st[2 * (i - 1) + 1] <= q[2]);
+            }
+            else
+            {
+                dominated = 0;
+                for (k = head[mid]; k >= 0 && !dominated; k = next[k])
+                {
+                    m = 1;
+                    while (m < M && order[k].objs[m] <= q[m])
+                        m++;
+                    dominated = (m == M);
+                }
+            }
+            if (dominated)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == n_fronts)
+        {
+            /* New front. */
+            n_fronts++;
+            if (M == 3)
+            {
+                stair_n[lo] = 0;
+                stair_cap[lo] = 4;
+                stairs[lo] = ec_malloc(2 * 4 * sizeof(float),
+                                       __LINE__, __FILE__);
+            }
+            else if (M > 3)
+                head[lo] = -1;
+        }
+        rank[order[p].index] = lo;
+
+        /* Adding the point to it's front. */
+        if (M == 2)
+            last[lo] = q[1];
+        else if (M == 3)
+        {
+            /* Members with a 2nd objective >= q[1] and a 3rd one
+               >= q[2] (contiguous) are replaced by the point. */
+            st = stairs[lo];
+            i = 0;
+            j = stair_n[lo];
+            while (i < j)
+            {
+                k = (i + j) / 2;
+                if (st[2 * k] < q[1])
+                    i = k + 1;
+                else
+                    j = k;
+            }
+            end = i;
+            while (end < stair_n[lo] && st[2 * end + 1] >= q[2])
+                end++;
+            if (end == i)
+            {
+                if (stair_n[lo] == stair_cap[lo])
+                {
+                    stair_cap[lo] *= 2;
+                    stairs[lo] = realloc(stairs[lo],
+                                         2 * stair_cap[lo] * sizeof(float));
+                    check_null(stairs[lo], __LINE__, __FILE__);
+                    st = stairs[lo];
+                }
+                end = i + 1;
+                memmove(st + 2 * end, st + 2 * i,
+                        2 * (stair_n[lo] - i) * sizeof(float));
+                stair_n[lo]++;
+            }
+            else
+            {
+                memmove(st + 2 * (i + 1), st + 2 * end,
+                        2 * (stair_n[lo] - end) * sizeof(float));
+                stair_n[lo] -= end - i - 1;
+            }
+            st[2 * i] = q[1];
+            st[2 * i + 1] = q[2];
+        }
+        else
+        {
+            next[p] = head[lo];
+            head[lo] = p;
+        }
+    }
+
+    for (k = 0; M == 3 && k < n_fronts; k++)
+    {
+        free(stairs[k]);
+    }
+    free(stairs);
+    free(stair_n);
+    free(stair_cap);
+    free(last);
+    free(head);
+    free(next);
+    free(order);
+    free(points);
+    return n_fronts;
+}
+
+void
+int_crowding_distance(float *objs, int stride, int *members,
+                      int n_members, int n_objectives, float *crowding)
+{
+/* Crowding distance of each point of a front: for each objective, the
+   members are sorted and the normalized gaps between neighbors are
+   computed in a contiguous loop (vectorized) and then added to their
+   point. */
+    int k, m;
+    float range, *values, *gaps;
+    struct IntRank *ranks;
+
+    for (k = 0; k < n_members; k++)
+    {
+        crowding[members[k]] = (n_members < 3) ? INFINITY : 0.0;
+    }
+    if (n_members < 3)
+        return;
+    ranks = ec_malloc(n_members * sizeof(struct IntRank), __LINE__, __FILE__);
+    values = ec_malloc(n_members * sizeof(float), __LINE__, __FILE__);
+    gaps = ec_malloc(n_members * sizeof(float), __LINE__, __FILE__);
+    for (m = 0; m < n_objectives; m++)
+    {
+        for (k = 0; k < n_members; k++)
+        {
+            ranks[k].fo = objs[(size_t) m * stride + members[k]];
+            ranks[k].index = members[k];
+        }
+        qsort(ranks, n_members, sizeof(struct IntRank), compare_ranks);
+        for (k = 0; k < n_members; k++)
+        {
+            values[k] = ranks[k].fo;
+        }
+        crowding[ranks[0].index] = INFINITY;
+        crowding[ranks[n_members - 1].index] = INFINITY;
+        range = values[n_members - 1] - values[0];
+        if (range <= 0.0)
+            continue;
+        for (k = 1; k < n_members - 1; k++)
+        {
+            gaps[k] = (values[k + 1] - values[k - 1]) / range;
+        }
+        for (k = 1; k < n_members - 1; k++)
+        {
+            crowding[ranks[k].index] += gaps[k];
+        }
+    }
+    free(gaps);
+    free(values);
+    free(ranks);
+}
+
 void
-int_init_competitors_winner(struct IntPopulation *pop);
+int_mo_alloc(struct IntPopulation *pop)
+{
+/* Allocs (or reallocs, after a population resize) the objectives,
+   fronts and crowding distances of 2 * 'n_population_alloc' points
+   (individuals and childs). */
+    if (pop->mo_rows == pop->n_population_alloc)
+        return;
+    pop->mo_rows = pop->n_population_alloc;
+    pop->mo_stride = 2 * pop->mo_rows;
+    free(pop->mo_objs);
+    free(pop->mo_crowding);
+    free(pop->mo_rank);
+    pop->mo_objs = ec_malloc((size_t) pop->mo_stride * pop->mo_n_objectives
+                             * sizeof(float), __LINE__, __FILE__);
+    pop->mo_crowding = ec_malloc(pop->mo_stride * sizeof(float),
+                                 __LINE__, __FILE__);
+    pop->mo_rank = ec_malloc(pop->mo_stride * sizeof(int),
+                             __LINE__, __FILE__);
+}
 
 void
-int_free_competitors_winner(struct IntPopulation *pop);
+int_mo_free(struct IntPopulation *pop)
+{
+/* Frees the multi-objective buffers and the Pareto archive. */
+    int i;
+
+    for (i = 0; i < pop->mo_archive_capacity; i++)
+    {
+        free(pop->mo_archive[i]);
+    }
+    free(pop->mo_archive);
+    free(pop->mo_archive_objs);
+    free(pop->mo_archive_hashes);
+    free(pop->mo_objs);
+    free(pop->mo_crowding);
+    free(pop->mo_rank);
+    pop->mo_archive = NULL;
+    pop->mo_archive_objs = NULL;
+    pop->mo_archive_hashes = NULL;
+    pop->mo_objs = NULL;
+    pop->mo_crowding = NULL;
+    pop->mo_rank = NULL;
+    pop->mo_archive_capacity = 0;
+    pop->mo_archive_size = 0;
+    pop->mo_rows = 0;
+}
+
+long
+int_mo_evaluate(struct IntPopulation *pop, int **rows, int first, int n)
+{
+/* Evaluates the objectives of the individuals 'rows' [0, n) into the
+   points [first, first + n), in parallel.
+   =RETURNS=
+   - The number of evaluations. */
+    int i;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 16) \
+    if (pop->n_threads > 1)
+#endif
+    for (i = 0; i < n; i++)
+    {
+        float objs[MO_MAX_OBJECTIVES];
+        int m;
+
+        pop->mo_function(rows[i], pop->length, objs);
+        for (m = 0; m < pop->mo_n_objectives; m++)
+        {
+            pop->mo_objs[(size_t) m * pop->mo_stride + first + i] = objs[m];
+        }
+    }
+    return n;
+}
 
-/*==========================*/
-/* Miscellanous functions. */
 int
-compare (const void *a, const void *b)
+*int_mo_fronts(int *rank, int n, int n_fronts, int *start)
+{
+/* Groups the points [0, n) by front (counting sort): the members of
+   front f are 'members[start[f] .. start[f + 1])', in index order.
+   '*start' has 'n_fronts' + 1 ints.
+   =RETURNS=
+   - 'members' (to be freed). */
+    int i, f;
+    int *members, *pos;
+
+    members = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    pos = ec_calloc(n_fronts + 1, sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        pos[rank[i] + 1]++;
+    }
+    for (f = 0; f < n_fronts; f++)
+    {
+        pos[f + 1] += pos[f];
+    }
+    memcpy(start, pos, (n_fronts + 1) * sizeof(int));
+    for (i = 0; i < n; i++)
+    {
+        members[pos[rank[i]]++] = i;
+    }
+    free(pos);
+    return members;
+}
+
+int
+int_mo_rank(struct IntPopulation *pop, int n)
 {
-    /* To use in qsort. */
-    return ( *(int*)a - *(int*)b );
+/* Fronts and crowding distances (one front per thread) of the points
+   [0, n).
+   =RETURNS=
+   - The number of fronts. */
+    int f, n_fronts;
+    int *start, *members;
+
+    n_fronts = int_nondominated_sort(pop->mo_objs, pop->mo_stride, n,
+                                     pop->mo_n_objectives, pop->mo_rank);
+    start = ec_malloc((n_fronts + 1) * sizeof(int), __LINE__, __FILE__);
+    members = int_mo_fronts(pop->mo_rank, n, n_fronts, start);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 1) \
+    if (pop->n_threads > 1)
+#endif
+    for (f = 0; f < n_fronts; f++)
+    {
+        int_crowding_distance(pop->mo_objs, pop->mo_stride,
+                              members + start[f], start[f + 1] - start[f],
+                              pop->mo_n_objectives, pop->mo_crowding);
+    }
+    free(members);
+    free(start);
+    return n_fronts;
+}
+
+int
+int_mo_tournament(struct IntPopulation *pop, int tournament_size,
+                  uint64_t *rng)
+{
+/* Crowded comparison tournament (competitors drawn with replacement):
+   the lowest front wins, and then the largest crowding distance.
+   =RETURNS=
+   - The index of the winner. */
+    int k, competitor;
+    int winner = (int) rng_bounded(rng, (uint32_t) pop->n_population);
+
+    for (k = 1; k < tournament_size; k++)
+    {
+        competitor = (int) rng_bounded(rng, (uint32_t) pop->n_population);
+        if (pop->mo_rank[competitor] < pop->mo_rank[winner] ||
+            (pop->mo_rank[competitor] == pop->mo_rank[winner] &&
+             pop->mo_crowding[competitor] > pop->mo_crowding[winner]))
+            winner = competitor;
+    }
+    return winner;
 }
 
-/*==========================*/
-/* Print functions. */
 void
-print_results(FILE *ptr, int print_mode,
-                struct IntPopulation *pop, int k)
+int_mo_select(struct IntPopulation *pop)
 {
-/* Simple function to print results of the current population
-   'pop' to an external file.
-   =ARGUMENTS=
-   - '*ptr' : A FILE pointer.
-   - 'print_mode': An integer that says how the results should be printed:
-                   - '1' : Only the best individual and the best fo
-                           of the current pop should be printed.
-                   - '2' : The best individual and all the population
-                           is printed.
-   - '*pop' : An already evaluated IntPopulation struct.
-   - 'k' : The current iteration. */
-    int i, j;
+/* NSGA-II replacement: out of the ranked individuals and childs (points
+   [0, 2 * n_population)), the next generation takes whole fronts, best
+   first, and the least crowded points of the last front that fits.
+   For heap storage the rows are swapped (the released ones go back to
+   'ext_new_individuals'), mapped and 'unalloc' rows are copied through
+   'ext_parents'. */
+    int i, f, m, k, n_selected = 0, n_fronts = 0;
+    int n = pop->n_population, swap_rows;
+    int *start, *members, *selected, *is_selected, *new_rank;
+    int **rows;
+    float *new_objs, *new_crowding;
+    struct IntRank *ranks;
 
-    /* Basic function to print results to ptr file. */
-    fprintf(ptr, "\n===POPULATION GEN %d===\n", k);
-    if (print_mode == PRINT_COMPLETE)
+    for (i = 0; i < 2 * n; i++)
     {
-        for (i = 0; i < pop->n_population; i++)
+        if (pop->mo_rank[i] >= n_fronts)
+            n_fronts = pop->mo_rank[i] + 1;
+    }
+    start = ec_malloc((n_fronts + 1) * sizeof(int), __LINE__, __FILE__);
+    members = int_mo_fronts(pop->mo_rank, 2 * n, n_fronts, start);
+    selected = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    for (f = 0; f < n_fronts && n_selected < n; f++)
+    {
+        k = start[f + 1] - start[f];
+        if (n_selected + k <= n)
         {
-            fprintf(ptr, "[ ");
-            for (j = 0; j < pop->length; j++)
-            {
-                fprintf(ptr, "%d ", pop->individuals[i][j]);
-            }
-            fprintf(ptr, "]\n");
+            memcpy(selected + n_selected, members + start[f],
+                   k * sizeof(int));
+            n_selected += k;
+            continue;
+        }
+        /* Last front, by decreasing crowding distance. */
+        ranks = ec_malloc(k * sizeof(struct IntRank), __LINE__, __FILE__);
+        for (i = 0; i < k; i++)
+        {
+            ranks[i].fo = -pop->mo_crowding[members[start[f] + i]];
+            ranks[i].index = members[start[f] + i];
+        }
+        qsort(ranks, k, sizeof(struct IntRank), compare_ranks);
+        for (i = 0; n_selected < n; i++)
+        {
+            selected[n_selected++] = ranks[i].index;
         }
+        free(ranks);
     }
-    if (print_mode == PRINT_INDV || print_mode == PRINT_COMPLETE)
+    free(members);
+    free(start);
+
+    /* Rows of the next generation. */
+    rows = ec_malloc(2 * n * sizeof(int*), __LINE__, __FILE__);
+    for (i = 0; i < 2 * n; i++)
     {
-        fprintf(ptr, "Best individual(s) found in the population:\n");
-        for (i = 0; i < pop->n_best_individuals; i++)
+        rows[i] = (i < n) ? pop->individuals[i]
+                          : pop->ext_new_individuals[i - n];
+    }
+    swap_rows = (pop->storage == STORAGE_HEAP &&
+                 strcmp(pop->init_mode, "unalloc") != 0);
+    if (swap_rows)
+    {
+        is_selected = ec_calloc(2 * n, sizeof(int), __LINE__, __FILE__);
+        for (i = 0; i < n; i++)
         {
-            fprintf(ptr, "[ ");
-            for (j = 0; j < pop->length; j++)
-            {
-                fprintf(ptr, "%d ", pop->individuals[
-                                        pop->best_indexes[i]][j]);
-            }
-            fprintf(ptr, "]\n");
+            is_selected[selected[i]] = 1;
+            pop->individuals[i] = rows[selected[i]];
         }
-        fprintf(ptr, "The best fo for this population is: %.8f\n",
-                pop->best_fo);
+        for (i = 0, k = 0; i < 2 * n; i++)
+        {
+            if (!is_selected[i])
+                pop->ext_new_individuals[k++] = rows[i];
+        }
+        free(is_selected);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            memcpy(pop->ext_parents[i], rows[selected[i]],
+                   sizeof(int) * pop->length);
+        }
+        for (i = 0; i < n; i++)
+        {
+            memcpy(pop->individuals[i], pop->ext_parents[i],
+                   sizeof(int) * pop->length);
+        }
+    }
+    free(rows);
+
+    /* Objectives, fronts and crowding distances of the selected
+       points go to [0, n). */
+    new_objs = ec_malloc((size_t) n * pop->mo_n_objectives * sizeof(float),
+                         __LINE__, __FILE__);
+    new_crowding = ec_malloc(n * sizeof(float), __LINE__, __FILE__);
+    new_rank = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        for (m = 0; m < pop->mo_n_objectives; m++)
+        {
+            new_objs[(size_t) m * n + i] =
+                pop->mo_objs[(size_t) m * pop->mo_stride + selected[i]];
+        }
+        new_crowding[i] = pop->mo_crowding[selected[i]];
+        new_rank[i] = pop->mo_rank[selected[i]];
+    }
+    for (m = 0; m < pop->mo_n_objectives; m++)
+    {
+        memcpy(pop->mo_objs + (size_t) m * pop->mo_stride,
+               new_objs + (size_t) m * n, n * sizeof(float));
+    }
+    memcpy(pop->mo_crowding, new_crowding, n * sizeof(float));
+    memcpy(pop->mo_rank, new_rank, n * sizeof(int));
+    free(new_rank);
+    free(new_crowding);
+    free(new_objs);
+    free(selected);
+}
+
+int
+int_mo_update_archive(struct IntPopulation *pop)
+{
+/* Merges the first front of the ranked population into the Pareto
+   archive: genomes not inside it yet (checked by hash and then gene by
+   gene) are sorted with the archive and only the non dominated points
+   are kept, the least crowded ones if they are more than
+   'mo_archive_capacity'.
+   =RETURNS=
+   - 1 if the archive changed, 0 otherwise. */
+    int i, k, m, slot, index = 0, n_keep = 0, changed, table_size = 1;
+    int M = pop->mo_n_objectives, capacity = pop->mo_archive_capacity;
+    int n_max = pop->mo_archive_size + pop->n_best_individuals;
+    int n_cand = 0, n_free = 0, n_fronts;
+    int **genomes, **free_rows, *table, *rank, *keep, *is_kept;
+    float *objs, *crowding, *archive_objs;
+    uint64_t hash, *hashes;
+    struct IntRank *ranks;
+
+    genomes = ec_malloc(n_max * sizeof(int*), __LINE__, __FILE__);
+    hashes = ec_malloc(n_max * sizeof(uint64_t), __LINE__, __FILE__);
+    objs = ec_malloc((size_t) n_max * M * sizeof(float), __LINE__, __FILE__);
+    while (table_size < 2 * n_max)
+    {
+        table_size *= 2;
+    }
+    /* Open addressing table of (candidate + 1) by genome hash. */
+    table = ec_calloc(table_size, sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n_max; i++)
+    {
+        if (i < pop->mo_archive_size)
+        {
+            genomes[n_cand] = pop->mo_archive[i];
+            hash = pop->mo_archive_hashes[i];
+        }
+        else
+        {
+            index = pop->best_indexes[i - pop->mo_archive_size];
+            genomes[n_cand] = pop->individuals[index];
+            hash = int_hof_hash(pop, genomes[n_cand]);
+        }
+        slot = (int) (hash & (uint64_t) (table_size - 1));
+        while (table[slot] != 0 &&
+               !(hashes[table[slot] - 1] == hash &&
+                 memcmp(genomes[table[slot] - 1], genomes[n_cand],
+                        sizeof(int) * pop->length) == 0))
+        {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        if (table[slot] != 0)
+            continue;
+        table[slot] = n_cand + 1;
+        hashes[n_cand] = hash;
+        for (m = 0; m < M; m++)
+        {
+            objs[(size_t) m * n_max + n_cand] = (i < pop->mo_archive_size) ?
+                pop->mo_archive_objs[(size_t) m * capacity + i] :
+                pop->mo_objs[(size_t) m * pop->mo_stride + index];
+        }
+        n_cand++;
+    }
+    free(table);
+    if (n_cand == pop->mo_archive_size)
+    {
+        /* No new genomes. */
+        free(objs);
+        free(hashes);
+        free(genomes);
+        return 0;
+    }
+
+    rank = ec_malloc(n_cand * sizeof(int), __LINE__, __FILE__);
+    keep = ec_malloc(n_cand * sizeof(int), __LINE__, __FILE__);
+    n_fronts = int_nondominated_sort(objs, n_max, n_cand, M, rank);
+    for (i = 0; i < n_cand && n_fronts > 0; i++)
+    {
+        if (rank[i] == 0)
+            keep[n_keep++] = i;
+    }
+    if (n_keep > capacity)
+    {
+        /* The least crowded ones. */
+        crowding = ec_malloc(n_cand * sizeof(float), __LINE__, __FILE__);
+        ranks = ec_malloc(n_keep * sizeof(struct IntRank), __LINE__, __FILE__);
+        int_crowding_distance(objs, n_max, keep, n_keep, M, crowding);
+        for (i = 0; i < n_keep; i++)
+        {
+            ranks[i].fo = -crowding[keep[i]];
+            ranks[i].index = keep[i];
+        }
+        qsort(ranks, n_keep, sizeof(struct IntRank), compare_ranks);
+        n_keep = capacity;
+        for (i = 0; i < n_keep; i++)
+        {
+            keep[i] = ranks[i].index;
+        }
+        free(ranks);
+        free(crowding);
+    }
+
+    /* Archive rows not kept (and the unused ones) receive the new
+       genomes. */
+    is_kept = ec_calloc(n_cand, sizeof(int), __LINE__, __FILE__);
+    changed = (n_keep != pop->mo_archive_size);
+    for (i = 0; i < n_keep; i++)
+    {
+        is_kept[keep[i]] = 1;
+        changed |= (keep[i] >= pop->mo_archive_size);
+    }
+    free_rows = ec_malloc(capacity * sizeof(int*), __LINE__, __FILE__);
+    for (i = 0; i < capacity; i++)
+    {
+        if (i >= pop->mo_archive_size || !is_kept[i])
+            free_rows[n_free++] = pop->mo_archive[i];
+    }
+    archive_objs = ec_malloc((size_t) capacity * M * sizeof(float),
+                             __LINE__, __FILE__);
+    for (k = 0; k < n_keep; k++)
+    {
+        i = keep[k];
+        if (i < pop->mo_archive_size)
+            pop->mo_archive[k] = genomes[i];
+        else
+        {
+            pop->mo_archive[k] = free_rows[--n_free];
+            memcpy(pop->mo_archive[k], genomes[i],
+                   sizeof(int) * pop->length);
+        }
+        pop->mo_archive_hashes[k] = hashes[i];
+        for (m = 0; m < M; m++)
+        {
+            archive_objs[(size_t) m * capacity + k] =
+                objs[(size_t) m * n_max + i];
+        }
+    }
+    for (k = n_keep; k < capacity; k++)
+    {
+        pop->mo_archive[k] = free_rows[--n_free];
     }
+    memcpy(pop->mo_archive_objs, archive_objs,
+           (size_t) capacity * M * sizeof(float));
+    pop->mo_archive_size = n_keep;
+    free(archive_objs);
+    free(free_rows);
+    free(is_kept);
+    free(keep);
+    free(rank);
+    free(objs);
+    free(hashes);
+    free(genomes);
+    return changed;
 }
 
 void
-print_end_results(FILE *ptr, struct IntPopulation *pop, int k)
+int_mo_finish(struct IntPopulation *pop)
 {
-/* Simple function to print end results of the GA to an external file.
+/* Completes the evaluation of a ranked multi-objective population:
+   'fos' (the fronts), ranking, Pareto archive and statistics. */
+    int i;
+
+    for (i = 0; i < pop->n_population; i++)
+    {
+        pop->fos[i] = (float) pop->mo_rank[i];
+    }
+    int_update_ranking(pop);
+    pop->best_fo_alltime = pop->best_fo;
+    if (int_mo_update_archive(pop))
+        pop->n_stagnant_gens = 0;
+    else
+        pop->n_stagnant_gens++;
+    pop->first_population = POP_EVALUATED;
+    if (int_tracks_hashes(pop))
+    {
+        int_update_diversity(pop);
+        pop->diversity_synced = 0;
+    }
+    if (pop->storage == STORAGE_MMAP)
+        int_mmap_write_header(pop);
+}
+
+void
+int_copy_parents(struct IntPopulation *pop, int *indexes, int n_parents)
+{
+/* Copies the individuals 'indexes' to 'ext_parents'. For mapped
+   populations, rows are read in increasing index order (each parent
+   still goes to it's own slot), so the file is read sequentially. */
+    int i, slot;
+    long long *order;
+
+    if (pop->storage == STORAGE_HEAP)
+    {
+        for (i = 0; i < n_parents; i++)
+        {
+            memcpy(pop->ext_parents[i], pop->individuals[indexes[i]],
+                   sizeof(int) * pop->length);
+        }
+        return;
+    }
+    order = ec_malloc(n_parents * sizeof(long long), __LINE__, __FILE__);
+    for (i = 0; i < n_parents; i++)
+    {
+        order[i] = ((long long) indexes[i] << 32) | i;
+    }
+    qsort(order, n_parents, sizeof(long long), compare_longs);
+    for (i = 0; i < n_parents; i++)
+    {
+        slot = (int) (order[i] & 0xFFFFFFFF);
+        memcpy(pop->ext_parents[slot], pop->individuals[order[i] >> 32],
+               sizeof(int) * pop->length);
+    }
+    free(order);
+}
+
+void
+int_ga_one_iter(struct IntPopulation *pop,
+                float (*objective_function)(), int tournament_size,
+                char *cross_mode, int n_parents, int n_childs,
+                char *mutate_mode, float mutate_rate)
+/* The purpose of this function is to apply a complete iteration
+   of the GA algorithm. This means:
+   -> Apply crossover using '*cross_mode' with 'n_parents' to
+      'n_childs'. Parents are defined after 'n_parents' tournaments
+      with 'tournament_size' competitors (or with the method defined
+      by 'int_set_selection').
+   -> Apply mutation to the childs with '*mutate_mode' and
+      'mutate_rate'.
+   -> If a surrogate is set (see 'int_set_surrogate'), only the best
+      predicted childs out of several batches are kept.
+   -> If n_childs < n_population, the rest of the individuals of the
+      next generation will be selected by elitism.
+   -> After having a full population, evaluate it.
+   -> If a local search is set (see 'int_set_local_search'), it's
+      applied within the evaluation.
+   -> If a resize schedule is set (see 'int_set_resize_schedule'),
+      apply it.
+   Childs are bred straight into 'ext_new_individuals' (crossover,
+   mutation and repair in a single pass, parents read in place) and
+   their rows are swapped into the pop. The external pointers
+   'ext_parents' and 'ext_childs' are only used if n_childs > n_parents,
+   for 'unalloc' pops, with 'locus' diversity statistics or a
+   surrogate.
    =ARGUMENTS=
-   - '*ptr' : A FILE pointer.
-   - '*pop' : An already evaluated IntPopulation struct.
-   - 'k' : The last iteration. */
-    int i, j;
+   - '*pop' : pointer to alread initialized IntPopulation struct.
+   - '(*objective_function)()' : pointer to the objective function (fo)'.
+   - 'tournament_size' : How many competitors within each tournament.
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'n_parents' : Number of parents to be combined.
+   - 'n_childs' : Number of childs to be formed after crossover.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+{
+    int i, j = 0, synced, shared;
+    int *selected;
+    float select_param;
+    /* Fused breeding needs the childs slots ('n_childs' <= 'n_parents')
+       and rows owned by the pop ('locus' diversity statistics are
+       updated from the per gene differences instead). Surrogate
+       candidates are bred apart from the slots. */
+    int fused = (n_childs <= n_parents &&
+                 strcmp(pop->init_mode, "unalloc") != 0 &&
+                 pop->diversity_mode != DIVERSITY_LOCUS &&
+                 pop->surr_mode == SURR_NONE);
 
-    fprintf(ptr,
-        "\n\nAfter %d iterations this is the best fo found!!"
-        " Good for you!\n", k);
-    fprintf(ptr,
-        "Best individual(s) found through all iters:\n");
-    for (i = 0; i < pop->n_best_indv_alltime; i++)
+    /* Alloc'ng the parents, childs and new_individuals
+       for new populations. */
+    int_init_ext_ptrs(pop);
+    /* With a resize schedule, n_parents and n_childs are
+       given for 'n_population_orig'. */
+    n_parents = int_scale_to_pop(pop, n_parents);
+    n_childs = int_scale_to_pop(pop, n_childs);
+
+    if (pop->dedup_mode != DEDUP_NONE ||
+        (fused && int_tracks_hashes(pop)))
+        int_init_dedup_buffers(pop);
+
+    /* Defining parents by tournaments (or the method defined with
+       'int_set_selection') in one batch. */
+    selected = ec_malloc(n_parents * sizeof(int), __LINE__, __FILE__);
+    select_param = (pop->select_mode == SELECT_TOURNAMENT &&
+                    pop->select_param < 1.0) ?
+                   (float) tournament_size : pop->select_param;
+    int_select_indexes(pop, pop->select_mode, select_param, selected,
+                       n_parents);
+    if (fused)
+    {
+        /* Childs bred straight into their final slot. */
+        int_breed(pop, cross_mode, mutate_mode, mutate_rate, selected,
+                  n_parents, n_childs);
+        free(selected);
+        /* Removing duplicated childs. */
+        if (pop->dedup_mode != DEDUP_NONE)
+            int_dedup_childs(pop, mutate_mode, pop->ext_new_individuals,
+                             n_childs, 1);
+        /* Elitism and upgrading the individuals inside pop. */
+        synced = int_adopt_childs(pop, n_childs);
+    }
+    else
+    {
+        /* Slots left without row by a fused breeding. */
+        int_cow_fill_rows(pop);
+        for (i = 0; i < n_parents && pop->dedup_mode != DEDUP_NONE; i++)
+        {
+            pop->parent_indexes[i] = selected[i];
+        }
+        int_copy_parents(pop, selected, n_parents);
+        /* Defining childs from crossover. */
+        int_crossover(cross_mode, pop, pop->ext_parents, pop->ext_childs,
+                      n_parents);
+        /* Applying mutation to the childs. */
+        int_mutation(mutate_mode, pop, pop->ext_childs, n_childs, mutate_rate);
+        /* Keeping the best predicted childs (once the surrogate has a
+           population worth of samples or a full archive). */
+        if (pop->surr_mode != SURR_NONE &&
+            (pop->surr_n_samples >= pop->n_population ||
+             pop->surr_n_samples == pop->surr_capacity))
+            int_surrogate_screen(pop, cross_mode, mutate_mode, mutate_rate,
+                                 select_param, selected, n_parents,
+                                 n_childs);
+        free(selected);
+        /* Removing duplicated childs. */
+        if (pop->dedup_mode != DEDUP_NONE)
+            int_dedup_childs(pop, mutate_mode, pop->ext_childs, n_childs, 0);
+
+        /* Defining 'new_individuals'. */
+        /* If n_childs < n_population, the remaining individuals are
+           selected by elitism. */
+        for (i = 0; i < pop->n_population; i++)
+        {
+            if (i < n_childs)
+                memcpy(pop->ext_new_individuals[i], pop->ext_childs[i],
+                       sizeof(int)*pop->length);
+            else
+            {
+                /* Elitism. */
+                memcpy(pop->ext_new_individuals[i],
+                       pop->individuals[int_select_order(pop)[j]],
+                       sizeof(int)*pop->length);
+                if (pop->dedup_mode != DEDUP_NONE)
+                {
+                    /* Elites don't need to be evaluated again. */
+                    pop->next_fos[i] = pop->fos[int_select_order(pop)[j]];
+                    pop->next_fo_known[i] = 1;
+                }
+                j++;
+            }
+        }
+        /* Upgrading individuals inside pop. With genome hashes (diversity
+           statistics or dedup), they are updated only for the genes that
+           changed. Shared rows (see 'int_set_genome_sharing') are not
+           written, the new row is swapped in instead. */
+        for (i = 0; i < pop->n_population; i++)
+        {
+            shared = (int_cow_find(pop, pop->individuals[i], 0) != NULL);
+            if (int_tracks_hashes(pop))
+                int_diversity_replace(pop, i, pop->ext_new_individuals[i],
+                                      pop->storage == STORAGE_HEAP &&
+                                      !shared);
+            else if (pop->storage == STORAGE_HEAP && !shared)
+                memcpy(pop->individuals[i], pop->ext_new_individuals[i],
+                       sizeof(int)*pop->length);
+            if (shared)
+            {
+                int_cow_release(pop, pop->individuals[i]);
+                pop->individuals[i] = pop->ext_new_individuals[i];
+                pop->ext_new_individuals[i] = int_cow_new_row(pop);
+            }
+        }
+        if (pop->storage == STORAGE_MMAP)
+            /* Mapped generations are swapped instead of copied. */
+            int_mmap_set_current(pop, 1 - pop->mmap_current);
+        synced = int_tracks_hashes(pop);
+    }
+    pop->diversity_synced = synced;
+    if (pop->dedup_mode != DEDUP_NONE)
     {
-        fprintf(ptr, "[ ");
-        for (j = 0; j < pop->length; j++)
+        /* Individuals with known fo are not evaluated. */
+        pop->n_eval_skip = 0;
+        for (i = 0; i < pop->n_population; i++)
         {
-            fprintf(ptr, "%d ", pop->best_indv_alltime[i][j]);
+            pop->eval_skip[i] = pop->next_fo_known[i];
+            if (pop->next_fo_known[i])
+            {
+                pop->fos[i] = pop->next_fos[i];
+                pop->n_eval_skip++;
+            }
         }
-        fprintf(ptr, "]\n");
     }
-    fprintf(ptr,
-            "The best fo value found through all iters: %.8f\n",
-            pop->best_fo_alltime);
+    /* Evaluating new individuals inside pop. */
+    int_evaluate_population(pop, objective_function);
+    /* Resizing the population (if a schedule is set). */
+    if (pop->resize_mode != RESIZE_NONE)
+        int_apply_resize_schedule(pop);
+    /* Stagnation triggers (if set). */
+    if (pop->stagnation_mode != STAGNATION_NONE)
+        int_apply_stagnation(pop, mutate_mode);
 }
 
 /*==========================*/
-/* Functions for allocation of useful pointers. */
+/* Anytime run driver. */
 void
-int_init_ext_ptrs(struct IntPopulation *pop)
+int_set_run_limits(struct IntPopulation *pop, int max_iter,
+                   double max_seconds, long max_evaluations,
+                   int max_stagnant_gens)
 {
-/* Function to alloc the external pointers:
-   - 'ext_parents'
-   - 'ext_childs'
-   - 'ext_individuals'
-   These pointers are used in 'ga_one_iter' function, but can
-   also be used by the user in his own GA steps'
+/* This function sets the budgets of 'int_ga_run' (0 for no limit).
    =ARGUMENTS=
-   - '*pop' : A pointer to an IntPopulation struct. */
-    int i;
-    /* By default ext_ptrs_state will be 0 since it's a global. */
-    if (ext_ptrs_state == PTR_NOT_ALLOCD)
-    {
-        ext_parents = ec_calloc(pop->n_population_orig, sizeof(int*),
-            __LINE__, __FILE__);
-        ext_childs = ec_calloc(pop->n_population_orig, sizeof(int*),
-            __LINE__, __FILE__);
-        ext_new_individuals = ec_calloc(pop->n_population_orig, sizeof(int*),
-            __LINE__, __FILE__);
-        for (i = 0; i < pop->n_population_orig; i++)
-        {
-            ext_new_individuals[i] = ec_calloc(pop->length, sizeof(int),
-                __LINE__, __FILE__);
-            ext_parents[i] = ec_calloc(pop->length, sizeof(int),
-                __LINE__, __FILE__);
-            ext_childs[i] = ec_calloc(pop->length, sizeof(int),
-                __LINE__, __FILE__);
-        }
-        ext_ptrs_state = PTR_ALLOCD;
-    }
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'max_iter' : Max. number of generations.
+   - 'max_seconds' : Max. wall time.
+   - 'max_evaluations' : Max. number of objective function calls.
+   - 'max_stagnant_gens' : Max. generations without improvements. */
+    pop->run_max_iter = max_iter;
+    pop->run_max_seconds = max_seconds;
+    pop->run_max_evaluations = max_evaluations;
+    pop->run_max_stagnant = max_stagnant_gens;
 }
 
 void
-int_init_competitors_winner(struct IntPopulation *pop)
+int_set_run_target(struct IntPopulation *pop, float target_fo)
 {
-/* Function to alloc the global pointers:
-   - 'competitors'
-   - 'winner'
-   These pointers are used in 'int_tournament_selection' function
-   to keep number of allocations constant.
-   =ARGUMENTS=
-   - '*pop' : A pointer to an IntPopulation struct. */
-    int i;
-
-    if (glb_compet_win_state == PTR_NOT_ALLOCD)
-    {
-        competitors = ec_calloc(pop->n_population_orig, sizeof(int*),
-                          __LINE__, __FILE__);
-        winner = ec_calloc(pop->length, sizeof(int),
-                     __LINE__, __FILE__);
-        for (i = 0; i < pop->n_population_orig; i++)
-        {
-            competitors[i] = ec_calloc(pop->length, sizeof(int),
-                                 __LINE__, __FILE__);
-        }
-        glb_compet_win_state = PTR_ALLOCD;
-    }
+/* 'int_ga_run' stops once 'best_fo_alltime' <= 'target_fo'. */
+    pop->run_target_fo = target_fo;
+    pop->run_has_target = 1;
 }
 
-/*==========================*/
-/* Functions to free the useful pointers and population. */
 void
-int_free_ext_ptrs(struct IntPopulation *pop)
+int_set_run_callback(struct IntPopulation *pop, int (*callback)(),
+                     void *data, int every)
 {
-/* Function to free alloc'd external pointers:
-   - 'ext_parents'
-   - 'ext_childs'
-   - 'ext_individuals'
-   These pointers are used in 'ga_one_iter' function, but can
-   also be used by the user in his own GA steps'
-   =ARGUMENTS=
-   - '*pop' : A pointer to an IntPopulation struct. */
-    int i;
-    if (ext_ptrs_state == PTR_ALLOCD)
+/* Callback (struct IntPopulation *pop, void *data) of 'int_ga_run',
+   called every 'every' generations. */
+    if (callback != NULL && every < 1)
     {
-        for (i = 0; i < pop->n_population_orig; i++)
-        {
-            free(ext_new_individuals[i]);
-            free(ext_childs[i]);
-            free(ext_parents[i]);
-        }
-        free(ext_new_individuals);
-        free(ext_childs);
-        free(ext_parents);
-        ext_ptrs_state = PTR_FREE; /* No more alloc or free. */
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "'every' (%d) passed to 'int_set_run_callback' must be"
+               " >= 1.\n"
+               "====================\n", every);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
     }
+    pop->run_callback = callback;
+    pop->run_callback_data = data;
+    pop->run_callback_every = every;
 }
 
-void
-int_free_competitors_winner(struct IntPopulation *pop)
+double
+int_run_clock(void)
+{
+/* Monotonic wall time, in seconds. */
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int
+int_run_check(struct IntPopulation *pop, long n_evaluations,
+              double last_seconds, long last_evaluations)
+{
+/* Stop reason of 'int_ga_run' before starting a generation (0 to go
+   on), 'n_evaluations' being the evaluations of the run and
+   'last_seconds', 'last_evaluations' the cost of the last
+   generation. */
+    if (__atomic_load_n(&pop->run_stop, __ATOMIC_ACQUIRE))
+        return RUN_STOPPED;
+    if (pop->stop)
+        /* 'stop' action of the stagnation trigger. */
+        return RUN_STAGNATION;
+    if (pop->run_has_target && pop->best_fo_alltime <= pop->run_target_fo)
+        return RUN_TARGET;
+    if (pop->run_max_iter > 0 && pop->run_generation >= pop->run_max_iter)
+        return RUN_MAX_ITER;
+    if (pop->run_max_stagnant > 0 &&
+        pop->n_stagnant_gens >= pop->run_max_stagnant)
+        return RUN_STAGNATION;
+    if (pop->run_max_seconds > 0.0 &&
+        pop->run_seconds + last_seconds > pop->run_max_seconds)
+        return RUN_MAX_TIME;
+    if (pop->run_max_evaluations > 0 &&
+        n_evaluations + last_evaluations > pop->run_max_evaluations)
+        return RUN_MAX_EVALS;
+    return 0;
+}
+
+int
+int_ga_run(struct IntPopulation *pop, float (*objective_function)(),
+           int tournament_size, char *cross_mode, int n_parents,
+           int n_childs, char *mutate_mode, float mutate_rate)
 {
-/* Function to free the global pointers:
-   - 'competitors'
-   - 'winner'
-   These pointers are used in 'int_tournament_selection' function
-   to keep number of allocations constant.
+/* The purpose of this function is to run 'int_ga_one_iter' until a
+   limit, the target fo, the 'stop' stagnation trigger, the callback or
+   'int_stop_run' stops it, publishing each improvement of the all time
+   best.
    =ARGUMENTS=
-   - '*pop' : A pointer to an IntPopulation struct. */
-    int i;
+   Same as 'int_ga_one_iter'.
+   =RETURNS=
+   - The stop reason (RUN_* in GA_int.h). RUN_STAGNATION is returned
+     both for 'max_stagnant_gens' and for 'pop->stop' (set by
+     'int_set_stagnation' in 'stop' mode). */
+    double start = int_run_clock(), generation_start;
+    double last_seconds = 0.0;
+    long first_evaluations = pop->n_evaluations, generation_evaluations;
+    long last_evaluations = 0;
+    int reason;
 
-    if (glb_compet_win_state == PTR_ALLOCD)
+    pop->run_generation = 0;
+    pop->run_seconds = 0.0;
+    /* A stagnation stop of a previous run is not carried over. */
+    pop->stop = 0;
+    if (pop->first_population == POP_NOT_EVAL)
+        int_evaluate_population(pop, objective_function);
+    int_publish_best(pop);
+    pop->run_seconds = int_run_clock() - start;
+    for (;;)
     {
-        free(winner);
-        for (i = 0; i < pop->n_population_orig; i++)
+        reason = int_run_check(pop, pop->n_evaluations - first_evaluations,
+                               last_seconds, last_evaluations);
+        if (reason != 0)
+            break;
+        generation_start = int_run_clock();
+        generation_evaluations = pop->n_evaluations;
+        int_ga_one_iter(pop, objective_function, tournament_size,
+                        cross_mode, n_parents, n_childs, mutate_mode,
+                        mutate_rate);
+        pop->run_generation++;
+        if (pop->best_fo_alltime < pop->snap_fo)
+            int_publish_best(pop);
+        pop->run_seconds = int_run_clock() - start;
+        last_seconds = pop->run_seconds - (generation_start - start);
+        last_evaluations = pop->n_evaluations - generation_evaluations;
+        if (pop->run_callback != NULL &&
+            pop->run_generation % pop->run_callback_every == 0 &&
+            pop->run_callback(pop, pop->run_callback_data))
         {
-            free(competitors[i]);
+            reason = RUN_CALLBACK;
+            break;
         }
-        free(competitors);
-        glb_compet_win_state = PTR_FREE; /* No more alloc or free. */
     }
+    /* The request is consumed by this run. */
+    if (reason == RUN_STOPPED)
+        __atomic_store_n(&pop->run_stop, 0, __ATOMIC_RELEASE);
+    pop->run_reason = reason;
+    return reason;
 }
 
 void
-int_free_population(struct IntPopulation *pop)
+int_stop_run(struct IntPopulation *pop)
 {
-/* This function frees an IntPopulation struct and all it's members.
-   It MUST be called in the end of your program to free heap memory.
-   =ARGUMENTS=
-   - '*pop' : A IntPopulation struct already initialized AND evaluated. */
-    int i;
-
-    int_free_competitors_winner(pop);
-    int_free_ext_ptrs(pop);
+/* Asks 'int_ga_run' to stop after the current generation. */
+    __atomic_store_n(&pop->run_stop, 1, __ATOMIC_RELEASE);
+}
 
-    if (pop->non_repeatable == NO_REPEAT)
-        free(pop->reference_arr);
+void
+int_publish_best(struct IntPopulation *pop)
+{
+/* Copies the all time best genome to the snapshot of 'int_read_best'
+   (seqlock writer: 'snap_seq' is odd while the copy is written). The
+   snapshot is written with relaxed atomics, as readers may copy it at
+   the same time (their copy is then discarded). */
+    int j, *best;
+    unsigned long seq = pop->snap_seq;
 
-    if (strcmp(pop->init_mode, "unalloc") != 0)
+    if (pop->n_best_indv_alltime > 0)
+        best = pop->best_indv_alltime[0];
+    else
+        /* Multi-objective pops don't have a hall of fame. */
+        best = pop->individuals[pop->best_indexes[0]];
+    if (pop->snap_genome == NULL)
+        /* Alloc'd before the first publication, so readers only see
+           it once 'snap_seq' > 0. */
+        pop->snap_genome = ec_malloc(pop->length * sizeof(int),
+                                     __LINE__, __FILE__);
+    __atomic_store_n(&pop->snap_seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (j = 0; j < pop->length; j++)
     {
-        /* No allocation for these members in this init_mode. */
-        for (i = 0; i < pop->n_population_orig; i++)
-        {
-            free(pop->individuals[i]);
-        }
-        free(pop->individuals);
+        __atomic_store_n(&pop->snap_genome[j], best[j], __ATOMIC_RELAXED);
     }
-    if (pop->first_population == POP_EVALUATED)
+    __atomic_store(&pop->snap_fo, &pop->best_fo_alltime, __ATOMIC_RELAXED);
+    __atomic_store_n(&pop->snap_generation, pop->run_generation,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&pop->snap_evaluations, pop->n_evaluations,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&pop->snap_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+long
+int_read_best(struct IntPopulation *pop, int *arr, float *fo)
+{
+/* Copies the last published best genome and fo without locks
+   (seqlock reader, retried while a publication overlaps it).
+   =RETURNS=
+   - The generation of the run in which it was published, -1 if
+     nothing was published yet. */
+    int j;
+    unsigned long seq_before, seq_after;
+    long generation;
+    float snap_fo;
+
+    do
     {
-        /* Only if the population was evaluated. */
-        for (i = 0; i < pop->n_population_orig; i++)
+        seq_before = __atomic_load_n(&pop->snap_seq, __ATOMIC_ACQUIRE);
+        if (seq_before == 0)
+            return -1;
+        if (seq_before & 1)
+            continue; /* Being written. */
+        for (j = 0; arr != NULL && j < pop->length; j++)
         {
-            free(pop->best_indv_alltime[i]);
+            arr[j] = __atomic_load_n(&pop->snap_genome[j], __ATOMIC_RELAXED);
         }
-        free(pop->best_indv_alltime);
-        free(pop->best_indexes);
-        free(pop->fos);
-        free(pop->sorted_fos_indexes);
-        free(pop->sorted_fos);
-    }
-    free(pop);
+        __atomic_load(&pop->snap_fo, &snap_fo, __ATOMIC_RELAXED);
+        generation = __atomic_load_n(&pop->snap_generation,
+                                     __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_after = __atomic_load_n(&pop->snap_seq, __ATOMIC_RELAXED);
+    } while ((seq_before & 1) || seq_before != seq_after);
+    if (fo != NULL)
+        *fo = snap_fo;
+    return generation;
 }
 
 /*==========================*/
-/* GA operators and related functions definition. */
+/* Genome sharing (copy-on-write). */
 void
-int_init_solution(struct IntPopulation *pop, int *arr)
+int_set_genome_sharing(struct IntPopulation *pop, char *sharing_mode)
 {
-/* This functions fullfills an array with random values
-   within the pop boundaries.
+/* This function makes identical individuals share one row of genes
+   (reference counted) instead of keeping a private copy each, which
+   saves memory and copies in converged populations of long genomes:
+   - After each evaluation, individuals with the same genome (hash and
+     gene by gene comparison) are pointed to the same row and the
+     duplicated rows are free'd.
+   - Childs of two parents with the same row and no mutation are stored
+     as a reference to it (no genes written, no row needed), the others
+     are bred as usual. With mutation, identical parents are only copied
+     and mutated (crossover is the identity for them).
+   - A shared row is copied the first time it's written (local search,
+     stagnation triggers, duplicate elimination, resizes).
+   Genome hashes are kept (as with 'int_set_dedup'). Rows of
+   pop->individuals may be shared: user code writing an individual in
+   place MUST call 'int_own_row' first. Between generations of
+   'int_ga_one_iter' the 'ext_new_individuals' rows of the childs are
+   not kept (NULL).
    =ARGUMENTS=
-   - '*pop' : A IntPopulation struct pointer with variables
-              length, min_value, max_value, non-repeatable,
-              range and reference array already defined.
-   - '*arr' : The array to be fullfilled with size pop->length. */
+   - '*pop' : A IntPopulation struct already initialized, with library
+              alloc'd rows on the heap (not 'unalloc' nor mapped).
+   - '*sharing_mode' : - 'none' : Private rows (default), shared rows
+                                  are copied back.
+                       - 'cow'  : Shared rows, copied on write. */
 
-    int j, tmp_value;
-    int shuff_reference_arr[pop->range];
+    /* Sanity check. */
+    check_null(sharing_mode, __LINE__, __FILE__);
 
-    if (pop->non_repeatable == NO_REPEAT)
+    if (strcmp(sharing_mode, "none") == 0)
     {
-        /* We create a random array from selecting values
-           from a shuffled 'reference_arr' array. */
-        memcpy(shuff_reference_arr, pop->reference_arr,
-               sizeof(shuff_reference_arr[0]) * pop->range);
-        shuffle_arr(shuff_reference_arr, pop->range,
-                    sizeof(shuff_reference_arr[0]));
-        memcpy(arr, shuff_reference_arr,
-               sizeof(shuff_reference_arr[0]) * pop->length);
+        int_unshare_rows(pop);
+        int_cow_fill_rows(pop);
+        int_cow_free_spare(pop);
+        pop->cow_mode = COW_NONE;
+        pop->diversity_synced = 0;
     }
-    else
+    else if (strcmp(sharing_mode, "cow") == 0)
     {
-        /* If repeated values are accepted, the creation of
-           the solution array is very simple. */
-        for (j = 0; j < pop->length; j++)
+        if (pop->storage == STORAGE_MMAP ||
+            strcmp(pop->init_mode, "unalloc") == 0)
         {
-            tmp_value = rand() % pop->range;
-            tmp_value += pop->min_value;
-            arr[j] = tmp_value;
+            fprintf(stderr, "===ARGUMENT ERROR===\n"
+                   "Genome sharing needs library alloc'd rows on the"
+                   "\nheap (not 'unalloc' nor mapped populations).\n"
+                   "====================\n");
+            int_free_population(pop);
+            exit(EXIT_FAILURE);
         }
+        pop->cow_mode = COW_SHARE;
+        int_cow_alloc(pop);
+        pop->diversity_synced = 0;
+        if (pop->first_population == POP_EVALUATED)
+            int_update_diversity(pop); /* Genome hashes. */
+    }
+    else
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'sharing_mode' ('%s') argument passed\nto "
+               "'int_set_genome_sharing' function.\nThe supported"
+               " arguments are (so far):\n"
+               "-'none' :    private rows.\n"
+               "-'cow'  :    identical individuals share their row,"
+               "\n\t\tcopied on the first write.\n"
+               "====================\n", sharing_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
     }
 }
 
-struct IntPopulation
-*int_init_population(char *init_mode, int n_population, int length,
-                     int min_value, int max_value, int non_repeatable)
+int
+*int_own_row(struct IntPopulation *pop, int i)
 {
-/* This function returns an initalized IntPopulation struct. It's the
-   first call in your program, defining the initial population. After this
-   you MUST evaluate the population with 'int_evaluate_population' function.
-   =ARGUMENTS=
-                    - 'random'  : Init a random pop according to
-                                  solution boundaries.
-                    - 'empty'   : An empty pop (arrays of 0s) - In case
-                                  a non-random start method (as heuristic one)
-                                  could be used.
-                    - 'unalloc' : The pop will begin with 'pop->individuals'
-                                  unallocated. Useful for generation > 0.
-   - 'n_population' : The number of individuals inside population.
-   - 'length' : Length of the solution presentation (len of individual array).
-   - 'min_value' : The minimum value contained in the solution presentation.
-   - 'max_value' : The maximum value contained in the solution presentation.
+/* This function makes the row of individual 'i' private (copied if
+   it's shared, see 'int_set_genome_sharing') before writing it.
    =RETURNS=
-   - 'pop' : A pointer to an IntPopulation struct. This struct has the
-             the following variables initialized:
-             - 'length'
-             - 'min_value'
-             - 'max_value'
-             - 'non_repeatable'
-             - 'n_population'
-             - 'individuals'
-             - 'init_mode' */
-
-    /* Sanity check. */
-    check_null(init_mode, __LINE__, __FILE__);
-    if (non_repeatable == NO_REPEAT)
-    {
-        if ((max_value + 1 - min_value) < length)
-        {
-            fprintf(stderr, "Impossible to build non-repeatable Solution\n"
-                   "for this population.\n"
-                   "====> (max_value-min_value) < length\n");
-            exit(EXIT_FAILURE);
-        }
-    }
-
-    int i, j = 0;
-    struct IntPopulation *pop;
+   - The row, 'pop->individuals[i]'. */
+    int_cow_private(pop, &pop->individuals[i]);
+    return pop->individuals[i];
+}
 
-    pop = ec_malloc(sizeof(struct IntPopulation), __LINE__, __FILE__);
-    pop->n_population = n_population;
-    pop->n_population_orig = n_population;
-    pop->init_mode = init_mode;
-    pop->length = length;
-    pop->min_value = min_value;
-    pop->max_value = max_value;
-    pop->range = max_value + 1 - min_value;
-    pop->first_population = POP_NOT_EVAL;
-    pop->non_repeatable = non_repeatable;
+void
+int_cow_alloc(struct IntPopulation *pop)
+{
+/* Allocs (or grows, after a population resize) the reference counts
+   table, with a power of 2 size >= 4 * rows (at most one entry per two
+   references), the spare rows stack and the clone flags. */
+    int i, size = 1, old_size = pop->cow_table_size;
+    struct IntRowRef *old = pop->cow_table;
 
-    if (non_repeatable == NO_REPEAT)
+    if (pop->cow_rows < pop->n_population_alloc)
     {
-        pop->reference_arr = ec_malloc(sizeof(int) * pop->range,
-                                 __LINE__, __FILE__);
-        for (i = min_value; i < max_value + 1; i++)
-        {
-            pop->reference_arr[j++] = i;
-        }
+        pop->cow_spare = realloc(pop->cow_spare,
+                                 pop->n_population_alloc * sizeof(int*));
+        check_null(pop->cow_spare, __LINE__, __FILE__);
+        pop->cow_clones = realloc(pop->cow_clones,
+                                  pop->n_population_alloc * sizeof(int));
+        check_null(pop->cow_clones, __LINE__, __FILE__);
+        pop->cow_rows = pop->n_population_alloc;
     }
-
-    if (strcmp(init_mode, "random") == 0)
+    while (size < 4 * pop->n_population_alloc)
     {
-        pop->individuals = ec_calloc(n_population, sizeof(int*),
-                               __LINE__, __FILE__);
-        for (i = 0; i < pop->n_population; i++)
-        {
-            pop->individuals[i] = ec_calloc(pop->length, sizeof(int),
-                                       __LINE__, __FILE__);
-            int_init_solution(pop, pop->individuals[i]);
-        }
+        size *= 2;
     }
-    else if (strcmp(init_mode, "empty") == 0)
-    {
-        pop->individuals = ec_calloc(n_population, sizeof(int*),
+    if (size <= old_size)
+        return;
+    pop->cow_table = ec_calloc(size, sizeof(struct IntRowRef),
                                __LINE__, __FILE__);
-        /* Just a bunch of 0s. */
-        for (i = 0; i < n_population; i++)
-        {
-             pop->individuals[i] = ec_calloc(length, sizeof(int),
-                                       __LINE__, __FILE__);
-        }
+    pop->cow_table_size = size;
+    for (i = 0; i < old_size; i++)
+    {
+        if (old[i].row != NULL)
+            int_cow_find(pop, old[i].row, 1)->refs = old[i].refs;
     }
-    else if (strcmp(init_mode, "unalloc") == 0)
+    free(old);
+}
+
+struct IntRowRef
+*int_cow_find(struct IntPopulation *pop, int *row, int insert)
+{
+/* Returns the entry of 'row' in the reference counts table (open
+   addressing by pointer). If not found, returns NULL or, if 'insert',
+   a new entry with one reference. */
+    int pos, mask = pop->cow_table_size - 1;
+
+    if (pop->cow_table == NULL)
+        return NULL;
+    for (pos = (int) (hash_mix64((uint64_t) (uintptr_t) row) & mask);
+         pop->cow_table[pos].row != NULL; pos = (pos + 1) & mask)
     {
-        /* pop->individuals not allocated because it will
-           be assigned to an already alloc'd pointer of pointers
-           with [n_population][length] size. */
+        if (pop->cow_table[pos].row == row)
+            return &pop->cow_table[pos];
     }
-    else
+    if (!insert)
+        return NULL;
+    pop->cow_table[pos].row = row;
+    pop->cow_table[pos].refs = 1;
+    return &pop->cow_table[pos];
+}
+
+void
+int_cow_add_ref(struct IntPopulation *pop, int *row)
+{
+/* One more individual (or child) points to 'row'. */
+    int_cow_find(pop, row, 1)->refs++;
+    pop->n_cow_shared++;
+}
+
+int
+int_cow_release(struct IntPopulation *pop, int *row)
+{
+/* One reference to 'row' is dropped. Rows back to a single reference
+   leave the table, shifting back the following entries of the cluster
+   (no tombstones, as 'int_hof_table_remove').
+   =RETURNS=
+   - 1 if 'row' had no other reference (the caller owns it), 0 if it's
+     still used. */
+    int pos, next, home, mask = pop->cow_table_size - 1;
+    struct IntRowRef *entry = int_cow_find(pop, row, 0);
+
+    if (entry == NULL)
+        return 1;
+    pop->n_cow_shared--;
+    if (--entry->refs > 1)
+        return 0;
+    pos = (int) (entry - pop->cow_table);
+    pop->cow_table[pos].row = NULL;
+    for (next = (pos + 1) & mask; pop->cow_table[next].row != NULL;
+         next = (next + 1) & mask)
     {
-        fprintf(stderr, "===ARGUMENT ERROR===\n"
-               "Wrong 'init_mode' ('%s') argument passed\nto "
-               "'int_init_population' function.\nThe supported"
-               " arguments are (so far):\n"
-               "-'random'  :    randomly initialize population according"
-               "\n\t\tto solution boundaries.\n"
-               "-'empty'   :    individuals inside population start as"
-               "\n\t\tempty (0s) arrays.\n"
-               "-'unalloc' :    pop->individuals not alloc'd.\n"
-               "====================\n", init_mode);
-        free(pop);
-        exit(EXIT_FAILURE);
+        home = (int) (hash_mix64((uint64_t) (uintptr_t)
+                                 pop->cow_table[next].row) & mask);
+        if ((next > pos) ? (home <= pos || home > next)
+                         : (home <= pos && home > next))
+        {
+            pop->cow_table[pos] = pop->cow_table[next];
+            pop->cow_table[next].row = NULL;
+            pos = next;
+        }
     }
-    return pop;
+    return 0;
+}
+
+int
+*int_cow_new_row(struct IntPopulation *pop)
+{
+/* A row for a slot without one (or whose row is still shared): a spare
+   one or a new one. */
+    if (pop->n_cow_spare > 0)
+        return pop->cow_spare[--pop->n_cow_spare];
+    return ec_malloc(pop->length * sizeof(int), __LINE__, __FILE__);
+}
+
+void
+int_cow_spare_row(struct IntPopulation *pop, int *row)
+{
+/* An unused row goes to the spare rows (free'd if they are full). */
+    if (pop->n_cow_spare < pop->cow_rows)
+        pop->cow_spare[pop->n_cow_spare++] = row;
+    else
+        free(row);
 }
 
 void
-int_evaluate_population(struct IntPopulation *pop,
-                        float (*objective_function)())
+int_cow_free_spare(struct IntPopulation *pop)
 {
-/* Evaluate a int population defining the struct variables:
-   - 'fos'
-   - 'best_fo'
-   - 'n_best_individuals'
-   - 'best_indexes'
-   - 'sorted_fos'
-   - 'sorted_fos_indexes'
-   - 'best_fo_alltime'
-   - 'n_best_indv_alltime'
-   - 'best_indv_alltime'
-   It should be called after the generation of a population.
-   =ARGUMENTS=
-   - '*pop' : An IntPopulation struct already initialized.
-   - '(*objective_function)()' : A fo calculation with inputs:
-                                 - 'int *arr'   : int solution array.
-                                 - 'int length' : length of int solution arr.
-*/
-    int i, j, k;
-    int aux = 0;
-    float best_fo = 0.0;
-
-    if (pop->first_population == POP_NOT_EVAL)
+/* Frees the spare rows left. */
+    while (pop->n_cow_spare > 0)
     {
-        /* After evaluation 'first_population' goes to POP_EVALUATED
-           to avoid multiple callocs. */
-        pop->best_indexes = ec_malloc(pop->n_population_orig * sizeof(int),
-                                __LINE__, __FILE__);
-        pop->fos = ec_malloc(pop->n_population * sizeof(float),
-                       __LINE__, __FILE__);
-        pop->sorted_fos_indexes = ec_malloc(
-                                      pop->n_population_orig * sizeof(int),
-                                      __LINE__, __FILE__);
-        pop->sorted_fos = ec_malloc(pop->n_population_orig * sizeof(float),
-                              __LINE__, __FILE__);
-        pop->best_indv_alltime = ec_calloc(
-                                     pop->n_population_orig, sizeof(int*),
-                                     __LINE__, __FILE__);
-        for (i = 0; i < pop->n_population_orig; i++)
-        {
-            pop->best_indv_alltime[i] = ec_calloc(pop->length, sizeof(int),
-                                            __LINE__, __FILE__);
-        }
-        pop->n_best_indv_alltime = 0;
-        pop->best_fo_alltime = 0.0;
+        free(pop->cow_spare[--pop->n_cow_spare]);
     }
-    pop->n_best_individuals = 0;
+}
 
-    /* Getting fo for each individual and the best_fo. */
-    for (i = 0; i < pop->n_population; i++)
+void
+int_cow_private(struct IntPopulation *pop, int **row)
+{
+/* Copy on write: if '*row' is shared, it's replaced by a private copy
+   (the other references keep the original). */
+    int *copy;
+
+    if (int_cow_find(pop, *row, 0) == NULL)
+        return;
+    copy = int_cow_new_row(pop);
+    memcpy(copy, *row, pop->length * sizeof(int));
+    int_cow_release(pop, *row);
+    *row = copy;
+    pop->n_cow_copies++;
+}
+
+void
+int_unshare_rows(struct IntPopulation *pop)
+{
+/* Every individual gets a private row again (before paths that move
+   or write rows wholesale: population resizes, copying generations). */
+    int i;
+
+    for (i = 0; i < pop->n_population && pop->n_cow_shared > 0; i++)
     {
-        pop->fos[i] = objective_function(pop->individuals[i],
-                                         pop->length);
-        /* Assigning sorted_fos before sorting with qsort. */
-        pop->sorted_fos[i] = pop->fos[i];
-        /* Getting best_fo. */
-        if (pop->fos[i] < best_fo || i == 0)
-            best_fo = pop->fos[i];
+        int_cow_private(pop, &pop->individuals[i]);
     }
-    pop->best_fo = best_fo;
-    /* Looking for individuals with fo == best_fo. */
-    for (i = 0; i < pop->n_population; i++)
+}
+
+void
+int_share_rows(struct IntPopulation *pop)
+{
+/* Points the individuals with the same genome to the same row, freeing
+   the duplicated ones. Individuals are sorted by their genome hash
+   ('pop->hashes', see 'int_tracks_hashes') and each one compared with
+   the first of it's group, so genomes colliding in the 31 hash bits
+   kept are compared but may stay unshared. */
+    int j, k, start, n = pop->n_population;
+    int *leader;
+    long long *keys;
+
+    int_cow_alloc(pop);
+    keys = ec_malloc(n * sizeof(long long), __LINE__, __FILE__);
+    for (j = 0; j < n; j++)
     {
-        if (pop->fos[i] == pop->best_fo)
-            pop->best_indexes[pop->n_best_individuals++] = i;
+        keys[j] = (long long) ((pop->hashes[j] >> 33) << 32) | j;
     }
-    /* Sorting fos. */
-    qsort(pop->sorted_fos, pop->n_population, sizeof(float), compare);
-    /* Getting index for sorted fos.
-       aux == 0 if index is already inside 'sorted_fos_indexes'. */
-    for (i = 0; i < pop->n_population; i++)
+    if (n > 1)
+        qsort(keys, n, sizeof(long long), compare_longs);
+    for (start = 0; start < n; start = k)
     {
-        for (j = 0; j < pop->n_population; j++)
+        leader = pop->individuals[keys[start] & 0xFFFFFFFF];
+        for (k = start + 1; k < n && (keys[k] >> 32) == (keys[start] >> 32);
+             k++)
         {
-            for (k = 0; k < i; k++)
-            {
-                if (pop->sorted_fos_indexes[k] == j)
-                {
-                    aux = 0;
-                    break;
-                }
-                else
-                    aux = 1;
-            }
-            if ((aux || i == 0) && (pop->fos[j] == pop->sorted_fos[i]))
-            {
-                pop->sorted_fos_indexes[i] = j;
-                break;
-            }
+            j = (int) (keys[k] & 0xFFFFFFFF);
+            if (pop->individuals[j] == leader ||
+                memcmp(pop->individuals[j], leader,
+                       pop->length * sizeof(int)) != 0)
+                continue;
+            if (int_cow_release(pop, pop->individuals[j]))
+                free(pop->individuals[j]);
+            int_cow_add_ref(pop, leader);
+            pop->individuals[j] = leader;
         }
     }
-    /* Updating all time best individuals and fo. */
-    if (pop->best_fo < pop->best_fo_alltime ||
-        pop->first_population == POP_NOT_EVAL)
+    free(keys);
+}
+
+void
+int_cow_plan_childs(struct IntPopulation *pop, int *selected,
+                    int n_childs, float mutate_rate, uint64_t seed)
+{
+/* Before the fused breeding with genome sharing: childs of two parents
+   sharing a row (twins) are clones if their stream ('seed', block
+   n_childs + child) mutates no gene, and then point to the row. The
+   other childs get a row to be written (child rows are taken here and
+   given back by 'int_adopt_childs', so clones don't need any). */
+    int i, k;
+    double log_keep = log(1.0 - (double) mutate_rate);
+    uint64_t rng;
+
+    int_cow_alloc(pop);
+    for (k = 0; k < n_childs; k++)
     {
-        pop->best_fo_alltime = pop->best_fo;
-        pop->n_best_indv_alltime = pop->n_best_individuals;
-        for (i = 0; i < pop->n_best_individuals; i++)
+        i = k - k % 2;
+        rng = int_block_stream(seed, n_childs + k);
+        pop->cow_clones[k] = (pop->individuals[selected[i]] ==
+                              pop->individuals[selected[i + 1]] &&
+                              int_next_mutation(-1, mutate_rate, log_keep,
+                                                &rng) >= pop->length);
+        if (pop->cow_clones[k])
         {
-            memcpy(pop->best_indv_alltime[i],
-                   pop->individuals[pop->best_indexes[i]],
-                   sizeof(int) * pop->length);
+            if (pop->ext_new_individuals[k] != NULL)
+                int_cow_spare_row(pop, pop->ext_new_individuals[k]);
+            pop->ext_new_individuals[k] = pop->individuals[selected[k]];
+            int_cow_add_ref(pop, pop->ext_new_individuals[k]);
+            pop->n_cow_clones++;
         }
+        else if (pop->ext_new_individuals[k] == NULL)
+            pop->ext_new_individuals[k] = int_cow_new_row(pop);
     }
-    pop->first_population = POP_EVALUATED;
 }
 
-int
-*int_tournament_selection(struct IntPopulation *pop, int tournament_size)
+void
+int_cow_breed_twin(struct IntPopulation *pop, int mutate_code,
+                   float mutate_rate, int *parent, int *child,
+                   uint64_t *hash, uint64_t *rng)
 {
-/* This function return the winner (int solution array) pointer
-   after the ocorrence of a tournament inside the population.
+/* Child of two parents sharing the row 'parent', for which crossover
+   is the identity: a mutated copy. If not NULL, '*hash' starts with the
+   parent hash and ends with the one of the child. */
+    int j;
+
+    memcpy(child, parent, pop->length * sizeof(int));
+    int_mutate_child(pop, mutate_code, child, mutate_rate, rng);
+    for (j = 0; j < pop->length && hash != NULL; j++)
+    {
+        if (child[j] != parent[j])
+            *hash ^= int_gene_hash(j, parent[j]) ^
+                     int_gene_hash(j, child[j]);
+    }
+}
+
+void
+int_cow_fill_rows(struct IntPopulation *pop)
+{
+/* Gives a row to the 'ext_new_individuals' slots left without one by
+   the fused breeding (see 'int_adopt_childs'), before the paths that
+   write them all. */
+    int i;
+
+    for (i = 0; i < pop->ext_rows; i++)
+    {
+        if (pop->ext_new_individuals[i] == NULL)
+            pop->ext_new_individuals[i] = int_cow_new_row(pop);
+    }
+}
+
+/*==========================*/
+/* Decomposable objective. */
+void
+int_set_block_objective(struct IntPopulation *pop, int block_size,
+                        float (*block_function)())
+{
+/* This function declares the objective as a sum of independent terms
+   over blocks of 'block_size' genes, evaluating only the blocks that
+   changed since the parents of each individual.
    =ARGUMENTS=
-   - '*pop' : A IntPopulation struct already initialized AND evaluated.
-   - 'tournament_size' : The number of simultaneous competitors.
-   =RETURNS=
-   - 'winner' : A pointer to a int solution array with the minor fo
-                from the tournament. */
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'block_size' : Number of genes per block, in [1, length].
+   - '(*block_function)()' : Score of one block, with inputs
+                             (int *arr, int length, int first, int last),
+                             or NULL (see GA_int.h). */
+    if (block_function != NULL &&
+        (block_size < 1 || block_size > pop->length))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong 'block_size' (%d) argument passed to\n"
+               "'int_set_block_objective' function.\n"
+               "It must be in [1, length] (length = %d).\n"
+               "====================\n", block_size, pop->length);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    free(pop->block_scores);
+    free(pop->next_block_scores);
+    free(pop->block_dirty);
+    free(pop->next_block_dirty);
+    pop->block_scores = NULL;
+    pop->next_block_scores = NULL;
+    pop->block_dirty = NULL;
+    pop->next_block_dirty = NULL;
+    pop->block_rows = 0;
+    pop->block_synced = 0;
+    pop->block_function = block_function;
+    pop->block_size = (block_function != NULL) ? block_size : 0;
+    pop->n_blocks = (block_function != NULL) ?
+                    (pop->length + block_size - 1) / block_size : 0;
+    if (block_function != NULL)
+        int_block_alloc(pop);
+}
 
-    int i, j, repeated_index;
-    int random_indexes[tournament_size];
-    float winner_fo, fos[tournament_size];
+void
+int_block_invalidate(struct IntPopulation *pop, int i)
+{
+/* Marks all the blocks of individual 'i' to be evaluated again. */
+    if (pop->block_dirty != NULL && i < pop->block_rows)
+        memset(pop->block_dirty + (size_t) i * pop->n_blocks, 1,
+               pop->n_blocks);
+}
 
-    /* Initializing competitors and winner. */
-    int_init_competitors_winner(pop);
+void
+int_block_alloc(struct IntPopulation *pop)
+{
+/* (Re)allocates the block scores of the individuals and of the next
+   generation for 'n_population_alloc' rows, all the blocks dirty. */
+    size_t size;
 
-    for (i = 0; i < tournament_size; i++)
+    if (pop->block_scores != NULL &&
+        pop->block_rows == pop->n_population_alloc)
+        return;
+    free(pop->block_scores);
+    free(pop->next_block_scores);
+    free(pop->block_dirty);
+    free(pop->next_block_dirty);
+    pop->block_rows = pop->n_population_alloc;
+    size = (size_t) pop->block_rows * pop->n_blocks;
+    pop->block_scores = ec_malloc(size * sizeof(float), __LINE__, __FILE__);
+    pop->next_block_scores = ec_malloc(size * sizeof(float),
+                                       __LINE__, __FILE__);
+    pop->block_dirty = ec_malloc(size, __LINE__, __FILE__);
+    pop->next_block_dirty = ec_malloc(size, __LINE__, __FILE__);
+    memset(pop->block_dirty, 1, size);
+    memset(pop->next_block_dirty, 1, size);
+    pop->block_synced = 0;
+}
+
+void
+int_block_compare(struct IntPopulation *pop, unsigned char *codes,
+                  int *parent, int *child)
+{
+/* Block states of a 'child' bred from a single 'parent' (copied and
+   mutated): BLOCK_OWN for the blocks with the same genes, BLOCK_CHANGED
+   for the others. */
+    int b, first, last;
+
+    for (b = 0; b < pop->n_blocks; b++)
     {
-        /* Collecting competitors data. */
-        random_indexes[i] = rand() % pop->n_population;
-        repeated_index = 1;
-        while (repeated_index && i > 0)
-        {
-            /* This loop checks for non-repeated index,
-               i.e., a competitor can't compete with itself. */
-            for (j = 0; j < i; j++)
-            {
-                if (random_indexes[j] == random_indexes[i])
-                {
-                    repeated_index = 1;
-                    random_indexes[i] = rand() % pop->n_population;
-                    break;
-                }
-                else
-                    repeated_index = 0;
-            }
-        }
-        memcpy(competitors[i],
-               pop->individuals[random_indexes[i]],
-               sizeof(int) * pop->length);
-        fos[i] = pop->fos[random_indexes[i]];
+        first = b * pop->block_size;
+        last = (first + pop->block_size < pop->length) ?
+               first + pop->block_size : pop->length;
+        codes[b] = (memcmp(parent + first, child + first,
+                           (last - first) * sizeof(int)) == 0) ?
+                   BLOCK_OWN : BLOCK_CHANGED;
+    }
+}
 
-        /* Best competitor evaluation. */
-        if (i == 0 || fos[i] <= winner_fo)
+void
+int_block_resolve(struct IntPopulation *pop, int k, int own, int other)
+{
+/* Turns the block states of child 'k' (in 'next_block_dirty', see
+   'int_breed_pair') into it's block scores: blocks equal to the ones
+   of the individual 'own' or 'other' (it's parents) take their score
+   and dirty flag, changed blocks are dirty. */
+    int b, parent;
+    size_t n = pop->n_blocks;
+    float *scores = pop->next_block_scores + (size_t) k * n;
+    unsigned char *codes = pop->next_block_dirty + (size_t) k * n;
+
+    for (b = 0; b < pop->n_blocks; b++)
+    {
+        if (codes[b] == BLOCK_CHANGED)
         {
-            memcpy(winner, competitors[i],
-                   sizeof(int) * pop->length);
-            winner_fo = fos[i];
+            codes[b] = 1;
+            continue;
         }
+        parent = (codes[b] == BLOCK_OWN) ? own : other;
+        scores[b] = pop->block_scores[(size_t) parent * n + b];
+        codes[b] = pop->block_dirty[(size_t) parent * n + b];
     }
-    /* We don't care too much with tied competitors,
-       as if a tie happens, the winner index is already
-       randomly selected from the population. */
-    return winner;
 }
 
 void
-int_replace_repeated(struct IntPopulation *pop, int **childs,
-                     int n_childs)
-/* This function replaces repeated values from each pointer
-   in **childs - useful after crossover in non-repeatable solutions. */
+int_block_swap(struct IntPopulation *pop)
 {
-    int aux, i, j, k, l;
-    int n_repeated_indexes;
-    int repeated_indexes[pop->length];
-    int n_missing_val;
-    int missing_val[pop->range];
+/* The block scores of the next generation become the current ones. */
+    float *scores = pop->block_scores;
+    unsigned char *dirty = pop->block_dirty;
 
-    for (i = 0; i < n_childs; i++)
+    pop->block_scores = pop->next_block_scores;
+    pop->block_dirty = pop->next_block_dirty;
+    pop->next_block_scores = scores;
+    pop->next_block_dirty = dirty;
+}
+
+long
+int_evaluate_blocks(struct IntPopulation *pop, int start, int end)
+{
+/* Evaluates the individuals [start, end) as the sum of their block
+   scores, in parallel, calling the block objective only for the dirty
+   blocks.
+   =RETURNS=
+   - The number of evaluated individuals. */
+    int i;
+    long n_evaluations = 0, n_block_evaluations = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 16) \
+    reduction(+:n_evaluations, n_block_evaluations) if (pop->n_threads > 1)
+#endif
+    for (i = start; i < end; i++)
     {
-        /* Here we check where are the repeated
-           values (if any). */
-        n_repeated_indexes = 0;
-        for (j = 0; j < pop->length; j++)
-        {
-            for (k = j; k < pop->length; k++)
-            {
-                aux = 0;
-                for (l = 0; l < n_repeated_indexes; l++)
-                {
-                    if (repeated_indexes[l] == k)
-                    {
-                        aux = 1;
-                        break;
-                    }
-                }
-                if (childs[i][j] == childs[i][k] &&
-                    j != k && aux == 0)
-                {
-                    repeated_indexes[
-                        n_repeated_indexes++] = k;
-                }
-            }
-        }
-        /* If crossover did not repeat values. */
-        if (n_repeated_indexes == 0)
+        int b, first;
+        float fo = 0.0;
+        float *scores = pop->block_scores + (size_t) i * pop->n_blocks;
+        unsigned char *dirty = pop->block_dirty + (size_t) i * pop->n_blocks;
+
+        if (pop->n_eval_skip > 0 && pop->eval_skip[i])
             continue;
-        /* Identifying values that
-           are not included in this solution. */
-        n_missing_val = 0;
-        for (j = 0; j < pop->range; j++)
+        for (b = 0; b < pop->n_blocks; b++)
         {
-            for (k = 0; k < pop->length; k++)
+            if (dirty[b])
             {
-                if (pop->reference_arr[j] ==
-                    childs[i][k])
-                    break;
-                else if (k == pop->length-1)
-                    missing_val[
-                        n_missing_val++] = pop->reference_arr[j];
+                first = b * pop->block_size;
+                scores[b] = pop->block_function(pop->individuals[i],
+                                pop->length, first,
+                                (first + pop->block_size < pop->length) ?
+                                first + pop->block_size : pop->length);
+                dirty[b] = 0;
+                n_block_evaluations++;
             }
+            fo += scores[b];
         }
-        /* Correct the kids removing repeated values. */
-        shuffle_arr(missing_val, n_missing_val,
-                    sizeof(missing_val[0]));
-        for (j = 0; j <  n_repeated_indexes; j++)
-        {
-            childs[i][repeated_indexes[j]] = missing_val[j];
-        }
+        pop->fos[i] = fo;
+        n_evaluations++;
     }
+    pop->n_block_evaluations += n_block_evaluations;
+    pop->n_blocks_reused += n_evaluations * pop->n_blocks
+                            - n_block_evaluations;
+    return n_evaluations;
 }
 
+/*==========================*/
+/* External process evaluator. */
 void
-int_crossover(char *cross_mode, struct IntPopulation *pop,
-              int **parents, int **childs, int n_parents)
+int_set_process_evaluator(struct IntPopulation *pop, char *command,
+                          char *protocol, int n_processes, int batch_size,
+                          double timeout, float penalty)
 {
-/* This function defines the pointers from '**childs' using a crossover
-   method defined by '*cross_mode' applied to the parents inside
-   '**parents'. Shape of '**parents' is [n_parents][pop->length].
-   The shape of parents depends on the '**cross_mode'.
-   More info on some methods:
-   https://en.wikipedia.org/wiki/Genetic_algorithm
+/* This function makes 'int_evaluate_population' send the individuals
+   to 'n_processes' long-lived copies of an external program (e.g. a
+   simulator) instead of calling the objective function, so a program
+   is started once instead of once per evaluation. Each process is
+   'command' run by /bin/sh, with it's stdin and stdout connected to
+   the library: it reads one individual at a time from stdin and
+   writes it's fo to stdout (flushing it), until stdin is closed.
+   - Up to 'batch_size' individuals are sent to a process before it's
+     first reply, so it never waits for the next one. The replies are
+     in the order of the requests.
+   - A process that takes longer than 'timeout' seconds for an
+     individual is killed, as is a process that exits, closes stdout or
+     writes a malformed (or NaN) reply. The individual it was
+     evaluating gets the 'penalty' fo, the other ones sent to it are
+     sent again, and the process is started again.
+   Messages of the program must go to stderr (stdout is the protocol).
+   Other single evaluations (local search, stagnation triggers,
+   resizes, cellular and crowding engines) and the batch, block and
+   multi-objective modes use the objective function, in the calling
+   process; the fork evaluator (see 'int_set_fork_evaluator') is not
+   used while the processes are set. 'n_proc_failures',
+   'n_proc_timeouts' and 'n_proc_respawns' keep the statistics. The
+   processes are stopped by 'int_free_population' (stdin is closed,
+   they are killed if they are still alive after 'timeout' seconds).
    =ARGUMENTS=
-   - '*cross_mode' : Method for crossover between '**parents'. Know-methods:
-                        - '1kpoint'  : Select random k1 point and exchange
-                                       around it within 2 parents.
-                                       '**childs' shape:
-                                       [n_parents][pop->length].
-                        - '2kpoints' : Select two random k1, k2 points and
-                                       exchange between them in 2 parents.
-                                       '**childs' shape:
-                                       [n_parents][pop->length].
-                        - 'uniform' :  Choose one value from two parents with
-                                       equal probability.
-                                       '**childs' shape:
-                                       [n_parents][pop->length].
-   - '*pop' : IntPopulation struct already initialized and evaluated.
-   - '**parents' : Pointer of parents (int arrays) with shape:
-                   [n_parents][pop->length]
-                   Usually defined using selection method.
-   - '**childs'  : An initialized via calloc/malloc pointer of pointers
-                   with shape selected from method:
-                   [n_childs][pop->length]
-                   e.g. for '1kpoint':
-                   [n_parents][pop->length]; n_parents = n_childs.
-                   But there are a few crossover methods in which
-                   n_parents != n_childs, and the correct shape within
-                   **childs must be provided.
-                   Each child values will be defined via crossover method.
-   - 'n_parents' : Number of parents (pointers inside '**parents'). */
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*command' : Shell command of the program.
+   - '*protocol' : - 'text'   : An individual is a line with it's
+                                'length' genes in decimal, separated by
+                                spaces. The reply is a line with the fo
+                                (as read by strtof).
+                   - 'binary' : An individual is 'length' native ints
+                                (4 bytes each). The reply is a native
+                                float (4 bytes).
+   - 'n_processes' : Number of processes (0 stops them).
+   - 'batch_size' : Individuals in flight per process (>= 1).
+   - 'timeout' : Seconds allowed per evaluation (> 0).
+   - 'penalty' : Fo of the individuals whose evaluation failed (e.g.
+                 FLT_MAX, as fos are minimized). */
+    int k, protocol_code = PROC_TEXT;
+
+    /* Sanity check. */
+    check_null(protocol, __LINE__, __FILE__);
+    if (strcmp(protocol, "text") == 0)
+        protocol_code = PROC_TEXT;
+    else if (strcmp(protocol, "binary") == 0)
+        protocol_code = PROC_BINARY;
+    else
+        n_processes = -1;
+    if (n_processes < 0 || batch_size < 1 || !(timeout > 0.0) ||
+        (n_processes > 0 && command == NULL))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong arguments passed to 'int_set_process_evaluator':\n"
+               "-'command'     : the shell command of the program.\n"
+               "-'protocol'    : 'text' or 'binary' ('%s' given).\n"
+               "-'n_processes' : >= 0 (0 stops them).\n"
+               "-'batch_size'  : >= 1 (%d given).\n"
+               "-'timeout'     : > 0 seconds (%g given).\n"
+               "====================\n", protocol, batch_size, timeout);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    int_process_stop(pop);
+    if (n_processes == 0)
+        return;
+
+    pop->proc_command = ec_malloc(strlen(command) + 1, __LINE__, __FILE__);
+    strcpy(pop->proc_command, command);
+    pop->proc_protocol = protocol_code;
+    pop->proc_batch = batch_size;
+    pop->proc_timeout = timeout;
+    pop->proc_penalty = penalty;
+    /* Only the individuals in flight are queued again (at most all of
+       them at once). */
+    pop->proc_requeue = ec_malloc((size_t) n_processes * batch_size
+                                  * sizeof(int), __LINE__, __FILE__);
+    pop->proc_n_requeued = 0;
+    pop->proc_polls = ec_malloc(n_processes * sizeof(struct pollfd),
+                                __LINE__, __FILE__);
+    pop->proc_list = ec_calloc(n_processes, sizeof(struct IntProcess),
+                               __LINE__, __FILE__);
+    pop->proc_n_processes = n_processes;
+    for (k = 0; k < n_processes; k++)
+    {
+        pop->proc_list[k].pid = -1;
+        pop->proc_list[k].fd = -1;
+        pop->proc_list[k].inflight = ec_malloc(batch_size * sizeof(int),
+                                               __LINE__, __FILE__);
+        /* One request (the longest decimal int and a separator per
+           gene) and the replies read. */
+        pop->proc_list[k].out = ec_malloc((size_t) pop->length * 12 + 1,
+                                          __LINE__, __FILE__);
+        pop->proc_list[k].in = ec_malloc(PROC_LINE_MAX, __LINE__, __FILE__);
+    }
+    for (k = 0; k < n_processes; k++)
+    {
+        int_process_spawn(pop, k);
+    }
+}
+
+double
+int_process_clock(void)
+{
+/* Monotonic time in seconds, for the evaluation deadlines. */
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void
+int_process_spawn(struct IntPopulation *pop, int k)
+{
+/* Starts process 'k': 'proc_command' run by /bin/sh, with stdin and
+   stdout on a socket (a write to a dead process returns an error
+   instead of raising SIGPIPE in the calling process). */
+    struct IntProcess *proc = pop->proc_list + k;
+    int fds[2];
+    pid_t pid;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+    {
+        fprintf(stderr, "Impossible to create the socket of the external"
+               "\nprocess %d.\n", k);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    /* Buffered output would be written again by the child. */
+    fflush(NULL);
+    pid = fork();
+    if (pid < 0)
+    {
+        fprintf(stderr, "Impossible to fork the external process %d.\n", k);
+        close(fds[0]);
+        close(fds[1]);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0)
+    {
+        /* A process group of it's own, so the shell and everything it
+           starts are killed together. The copies on stdin and stdout
+           are kept by exec. */
+        setpgid(0, 0);
+        dup2(fds[1], STDIN_FILENO);
+        dup2(fds[1], STDOUT_FILENO);
+        execl("/bin/sh", "sh", "-c", pop->proc_command, (char*) NULL);
+        _exit(127);
+    }
+    close(fds[1]);
+    setpgid(pid, pid);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    proc->pid = pid;
+    proc->fd = fds[0];
+    proc->head = 0;
+    proc->n_inflight = 0;
+    proc->out_pos = 0;
+    proc->out_len = 0;
+    proc->in_len = 0;
+}
+
+void
+int_process_kill(struct IntPopulation *pop, int k)
+{
+/* Kills process 'k' (if it's still alive) with it's process group and
+   closes it's socket. */
+    struct IntProcess *proc = pop->proc_list + k;
+
+    if (proc->fd >= 0)
+        close(proc->fd);
+    if (proc->pid > 0)
+    {
+        kill(-proc->pid, SIGKILL);
+        waitpid(proc->pid, NULL, 0);
+    }
+    proc->fd = -1;
+    proc->pid = -1;
+}
+
+int
+int_process_next(struct IntPopulation *pop, int *next, int end)
+{
+/* Next individual to send: the ones queued again first, then the
+   individuals from '*next' to 'end' (but the skipped ones).
+   =RETURNS=
+   - The index of the individual, -1 if there are no more. */
+    if (pop->proc_n_requeued > 0)
+        return pop->proc_requeue[--pop->proc_n_requeued];
+    while (*next < end && pop->n_eval_skip > 0 && pop->eval_skip[*next])
+        (*next)++;
+    return (*next < end) ? (*next)++ : -1;
+}
+
+size_t
+int_process_encode(struct IntPopulation *pop, int *arr, char *out)
+{
+/* Writes the request of individual 'arr' to 'out' (see the protocols
+   in 'int_set_process_evaluator').
+   =RETURNS=
+   - The number of bytes of the request. */
+    int j, n;
+    unsigned int u;
+    char digits[12], *p = out;
+
+    if (pop->proc_protocol == PROC_BINARY)
+    {
+        memcpy(out, arr, pop->length * sizeof(int));
+        return pop->length * sizeof(int);
+    }
+    for (j = 0; j < pop->length; j++)
+    {
+        u = (unsigned int) arr[j];
+        if (arr[j] < 0)
+        {
+            *p++ = '-';
+            u = 0u - u;
+        }
+        n = 0;
+        do
+        {
+            digits[n++] = (char) ('0' + u % 10);
+            u /= 10;
+        } while (u > 0);
+        while (n > 0)
+            *p++ = digits[--n];
+        *p++ = (j + 1 < pop->length) ? ' ' : '\n';
+    }
+    return (size_t) (p - out);
+}
 
-    /* Sanity check. */
-    check_null(cross_mode, __LINE__, __FILE__);
+int
+int_process_send(struct IntPopulation *pop, int k, int *next, int end)
+{
+/* Sends individuals to process 'k' until it has 'proc_batch' of them
+   in flight, there are no more, or it's socket is full (the rest of
+   the request is written when it's writable again).
+   =RETURNS=
+   - 0, or -1 if the process can't be written (it's dead). */
+    struct IntProcess *proc = pop->proc_list + k;
+    ssize_t n_written;
+    int i;
 
-    int i, j;
+    for (;;)
+    {
+        if (proc->out_pos == proc->out_len)
+        {
+            if (proc->n_inflight == pop->proc_batch)
+                return 0;
+            i = int_process_next(pop, next, end);
+            if (i < 0)
+                return 0;
+            proc->inflight[(proc->head + proc->n_inflight) % pop->proc_batch]
+                = i;
+            if (proc->n_inflight++ == 0)
+                proc->deadline = int_process_clock() + pop->proc_timeout;
+            proc->out_len = int_process_encode(pop, pop->individuals[i],
+                                               proc->out);
+            proc->out_pos = 0;
+        }
+        n_written = send(proc->fd, proc->out + proc->out_pos,
+                         proc->out_len - proc->out_pos, MSG_NOSIGNAL);
+        if (n_written < 0)
+            return (errno == EAGAIN || errno == EWOULDBLOCK ||
+                    errno == EINTR) ? 0 : -1;
+        proc->out_pos += n_written;
+        if (proc->out_pos < proc->out_len)
+            return 0;
+    }
+}
 
-    if (strcmp(cross_mode, "1kpoint") == 0)
+int
+int_process_receive(struct IntPopulation *pop, int k, int *n_done)
+{
+/* Reads the replies of process 'k', setting the fos of the individuals
+   answered ('*n_done' is increased by their number).
+   =RETURNS=
+   - 0, or -1 if the process closed it's output or wrote a malformed
+     (or NaN) reply. */
+    struct IntProcess *proc = pop->proc_list + k;
+    ssize_t n_read;
+    size_t used = 0, record;
+    char *line_end, *parsed;
+    float fo;
+
+    n_read = read(proc->fd, proc->in + proc->in_len,
+                  PROC_LINE_MAX - proc->in_len);
+    if (n_read < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK ||
+                errno == EINTR) ? 0 : -1;
+    if (n_read == 0)
+        return -1;
+    proc->in_len += n_read;
+    while (used < proc->in_len)
     {
-        if (n_parents % 2 != 0)
+        /* A reply nobody asked for. */
+        if (proc->n_inflight == 0)
+            return -1;
+        if (pop->proc_protocol == PROC_BINARY)
         {
-            fprintf(stderr, "For %s crossover the number of\n"
-                   "parents must be even!.\n", cross_mode);
-            int_free_population(pop);
-            exit(EXIT_FAILURE);
+            if (proc->in_len - used < sizeof(float))
+                break;
+            memcpy(&fo, proc->in + used, sizeof(float));
+            record = sizeof(float);
         }
         else
         {
-            /* k1_record is so far kept only for
-               non-repeatable solutions. */
-            int k1;
-
-            for (i = 0; i < n_parents; i+=2)
-            {
-                /* k1 must be > 0 and < pop->length */
-                k1 = rand() % pop->length;;
-                while (k1 == 0)
-                {
-                    k1 = rand() % pop->length;
-                }
-                for (j = 0; j < pop->length; j++)
-                {
-                    /* Performing crossover before k1. */
-                    if (j < k1)
-                    {
-                        childs[i][j] = parents[i+1][j];
-                        childs[i+1][j] = parents[i][j];
-                    }
-                    else
-                    {
-                        childs[i][j] = parents[i][j];
-                        childs[i+1][j] = parents[i+1][j];
-                    }
-                }
-            }
-            if (pop->non_repeatable == NO_REPEAT)
+            line_end = memchr(proc->in + used, '\n', proc->in_len - used);
+            if (line_end == NULL)
             {
-                /* Replace the repeated values after crossover. */
-                int_replace_repeated(pop, childs, n_parents);
+                /* Incomplete line (malformed if it fills the buffer). */
+                if (used == 0 && proc->in_len == PROC_LINE_MAX)
+                    return -1;
+                break;
             }
+            *line_end = '\0';
+            fo = strtof(proc->in + used, &parsed);
+            if (parsed == proc->in + used)
+                return -1;
+            record = (size_t) (line_end - (proc->in + used)) + 1;
         }
+        if (isnan(fo))
+            return -1;
+        used += record;
+        pop->fos[proc->inflight[proc->head]] = fo;
+        proc->head = (proc->head + 1) % pop->proc_batch;
+        proc->n_inflight--;
+        (*n_done)++;
+        /* The next individual starts now. */
+        proc->deadline = int_process_clock() + pop->proc_timeout;
     }
-    else if (strcmp(cross_mode, "2kpoints") == 0)
+    memmove(proc->in, proc->in + used, proc->in_len - used);
+    proc->in_len -= used;
+    return 0;
+}
+
+int
+int_process_fail(struct IntPopulation *pop, int k)
+{
+/* Process 'k' failed: the individual it was evaluating gets the penalty
+   fo, the other ones in flight are queued again, and it's started
+   again.
+   =RETURNS=
+   - 1 if an individual got the penalty fo, 0 otherwise. */
+    struct IntProcess *proc = pop->proc_list + k;
+    int j, penalized = 0;
+
+    if (proc->n_inflight > 0)
     {
-        if (n_parents % 2 != 0)
+        pop->fos[proc->inflight[proc->head]] = pop->proc_penalty;
+        pop->n_proc_failures++;
+        penalized = 1;
+        for (j = 1; j < proc->n_inflight; j++)
         {
-            fprintf(stderr, "For %s crossover the number of\n"
-                   "parents must be even!.\n", cross_mode);
-            int_free_population(pop);
-            exit(EXIT_FAILURE);
+            pop->proc_requeue[pop->proc_n_requeued++] =
+                proc->inflight[(proc->head + j) % pop->proc_batch];
         }
-        else
-        {
-            int k1, k2;
+    }
+    int_process_kill(pop, k);
+    int_process_spawn(pop, k);
+    pop->n_proc_respawns++;
+    return penalized;
+}
 
-            for (i = 0; i < n_parents; i+=2)
-            {
-                /* k1 must be >= 0 and < k2
-                   k2 must be > k1 and <= pop->length. */
-                k1 = rand() % pop->length;
-                k2 = 1 + (rand() % pop->length);
-                while (k1 >= k2)
-                {
-                    k1 = rand() % pop->length;
-                    k2 = 1 + (rand() % pop->length);
-                }
+long
+int_process_evaluate(struct IntPopulation *pop, int start, int end)
+{
+/* Evaluates the individuals [start, end) (but the skipped ones) in the
+   external processes, waiting for every reply, failure or timeout.
+   =RETURNS=
+   - The number of evaluated individuals (penalized ones included). */
+    struct IntProcess *proc;
+    int i, k, wait_ms, next = start, n_tasks = 0, n_done = 0;
+    double now;
 
-                for (j = 0; j < pop->length; j++)
-                {
-                    /* Performing crossover around k1 and k2. */
-                    if (j >= k1 && j < k2)
-                    {
-                        childs[i][j] = parents[i+1][j];
-                        childs[i+1][j] = parents[i][j];
-                    }
-                    else
-                    {
-                        childs[i][j] = parents[i][j];
-                        childs[i+1][j] = parents[i+1][j];
-                    }
-                }
-            }
-            if (pop->non_repeatable == NO_REPEAT)
-            {
-                /* Replace the repeated values after crossover. */
-                int_replace_repeated(pop, childs, n_parents);
-            }
+    for (i = start; i < end; i++)
+    {
+        if (pop->n_eval_skip == 0 || !pop->eval_skip[i])
+            n_tasks++;
+    }
+    /* Processes that died while idle are started again (nothing to
+       penalize). */
+    for (k = 0; k < pop->proc_n_processes; k++)
+    {
+        proc = pop->proc_list + k;
+        if (proc->pid > 0 && waitpid(proc->pid, NULL, WNOHANG) == proc->pid)
+        {
+            proc->pid = -1;
+            int_process_kill(pop, k);
+            int_process_spawn(pop, k);
+            pop->n_proc_respawns++;
         }
     }
-    else if (strcmp(cross_mode, "uniform") == 0)
+    pop->proc_n_requeued = 0;
+    while (n_done < n_tasks)
     {
-        if (n_parents % 2 != 0)
+        /* Requests, and the wait until the first deadline. */
+        wait_ms = -1;
+        now = int_process_clock();
+        for (k = 0; k < pop->proc_n_processes; k++)
         {
-            fprintf(stderr, "For %s crossover the number of\n"
-                   "parents must be even!.\n", cross_mode);
-            int_free_population(pop);
-            exit(EXIT_FAILURE);
+            proc = pop->proc_list + k;
+            if (int_process_send(pop, k, &next, end) != 0)
+                n_done += int_process_fail(pop, k);
+            pop->proc_polls[k].fd = proc->fd;
+            pop->proc_polls[k].events = POLLIN;
+            if (proc->out_pos < proc->out_len)
+                pop->proc_polls[k].events |= POLLOUT;
+            if (proc->n_inflight > 0)
+            {
+                i = (proc->deadline - now < 1e6) ?
+                    (int) ((proc->deadline - now) * 1000.0) + 1 : 1000000000;
+                if (i < 0)
+                    i = 0;
+                if (wait_ms < 0 || i < wait_ms)
+                    wait_ms = i;
+            }
         }
-        else
+        /* Nothing in flight: individuals queued again are sent now. */
+        if (wait_ms < 0)
+            wait_ms = 0;
+        poll(pop->proc_polls, pop->proc_n_processes, wait_ms);
+        now = int_process_clock();
+        for (k = 0; k < pop->proc_n_processes; k++)
         {
-            for (i = 0; i < n_parents; i+=2)
+            proc = pop->proc_list + k;
+            if (pop->proc_polls[k].revents & (POLLIN | POLLHUP | POLLERR))
             {
-                for (j = 0; j < pop->length; j++)
+                if (int_process_receive(pop, k, &n_done) != 0)
                 {
-                    /* Performing uniform crossover:
-                       selecting from parents with equal
-                       probability. */
-                    if ((float) ((double) rand() / (double) RAND_MAX)
-                         > 0.5)
-                    {
-                        childs[i][j] = parents[i+1][j];
-                        childs[i+1][j] = parents[i][j];
-                    }
-                    else
-                    {
-                        childs[i][j] = parents[i][j];
-                        childs[i+1][j] = parents[i+1][j];
-                    }
+                    n_done += int_process_fail(pop, k);
+                    continue;
                 }
             }
-            if (pop->non_repeatable == NO_REPEAT)
+            if (proc->n_inflight > 0 && now >= proc->deadline)
+            {
+                pop->n_proc_timeouts++;
+                n_done += int_process_fail(pop, k);
+            }
+        }
+    }
+    return n_tasks;
+}
+
+void
+int_process_stop(struct IntPopulation *pop)
+{
+/* Closes the stdin of the external processes, waits up to
+   'proc_timeout' seconds for them to exit (killing the ones left) and
+   frees the evaluator. */
+    struct IntProcess *proc;
+    double deadline;
+    int k;
+
+    if (pop->proc_list == NULL)
+        return;
+    for (k = 0; k < pop->proc_n_processes; k++)
+    {
+        proc = pop->proc_list + k;
+        if (proc->fd >= 0)
+            close(proc->fd);
+        proc->fd = -1;
+    }
+    deadline = int_process_clock() + pop->proc_timeout;
+    for (k = 0; k < pop->proc_n_processes; k++)
+    {
+        proc = pop->proc_list + k;
+        while (proc->pid > 0 && waitpid(proc->pid, NULL, WNOHANG) == 0)
+        {
+            if (int_process_clock() >= deadline)
             {
-                /* Replace the repeated values after crossover. */
-                int_replace_repeated(pop, childs, n_parents);
+                int_process_kill(pop, k);
+                break;
             }
+            poll(NULL, 0, 10);
         }
+        free(proc->inflight);
+        free(proc->out);
+        free(proc->in);
     }
+    free(pop->proc_list);
+    free(pop->proc_requeue);
+    free(pop->proc_polls);
+    free(pop->proc_command);
+    pop->proc_list = NULL;
+    pop->proc_requeue = NULL;
+    pop->proc_polls = NULL;
+    pop->proc_command = NULL;
+    pop->proc_n_processes = 0;
+}
+
+/*==========================*/
+/* Surrogate pre-screening. */
+void
+int_set_surrogate(struct IntPopulation *pop, char *surrogate_mode,
+                  int factor, int archive_size, int retrain_every,
+                  int n_neighbors)
+{
+/* This function sets a surrogate model of the objective function for
+   'int_ga_one_iter', for objectives that cost much more than a
+   prediction. The model learns from the last 'archive_size' (genome,
+   fo) pairs evaluated by 'int_evaluate_population' (skipped, penalized
+   and non finite fos are left out). Once the archive holds a
+   population worth of samples (or is full), 'int_ga_one_iter' breeds
+   'factor'
+   batches of childs (each one from it's own selection), predicts
+   their fo and keeps the 'n_childs' best predicted ones (distinct
+   ones first), so the objective function only sees those.
+   The predictions of the kept childs are compared with their fo:
+   'surr_rank_corr' (Spearman, 1 is a perfect ranking) and 'surr_mae'
+   (mean absolute error) for the last generation. 'n_surr_predictions'
+   and 'n_surr_rejected' count the candidates predicted and the ones
+   never evaluated. Childs are bred apart from their slots (as with
+   n_childs > n_parents). Not used with multi-objective pops.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*surrogate_mode' : - 'none'   : No surrogate (default).
+                         - 'linear' : Sum of a weight per (locus, value)
+                                      plus a bias, fitted by passes of
+                                      normalized least mean squares over
+                                      the archive (length * range must
+                                      be <= SURR_MAX_WEIGHTS).
+                         - 'knn'    : Mean fo of the 'n_neighbors'
+                                      archived genomes at the smallest
+                                      Hamming distance, weighted by
+                                      1 / (1 + distance). It reads the
+                                      archive at each prediction (no
+                                      fit), O(archive_size * length).
+   - 'factor' : Candidates bred per child (>= 1, 1 only measures the
+                accuracy).
+   - 'archive_size' : Max. samples kept (>= 1).
+   - 'retrain_every' : Generations between fits of the 'linear' model
+                       (>= 1).
+   - 'n_neighbors' : For 'knn', in [1, SURR_MAX_NEIGHBORS]. */
+    int mode = SURR_NONE;
+
+    /* Sanity check. */
+    check_null(surrogate_mode, __LINE__, __FILE__);
+    if (strcmp(surrogate_mode, "none") == 0)
+        mode = SURR_NONE;
+    else if (strcmp(surrogate_mode, "linear") == 0)
+        mode = SURR_LINEAR;
+    else if (strcmp(surrogate_mode, "knn") == 0)
+        mode = SURR_KNN;
     else
     {
         fprintf(stderr, "===ARGUMENT ERROR===\n"
-               "Wrong 'cross_mode' ('%s') argument passed to\n"
-               "'int_crossover' function.\nThe supported"
+               "Wrong 'surrogate_mode' ('%s') argument passed\nto "
+               "'int_set_surrogate' function.\nThe supported"
                " arguments are (so far):\n"
-               "-'1kpoint'  :   swap content of parent 1 with parent"
-               " 2\n\t\tfrom index 0 to random index k1.\n"
-               "-'2kpoints' :   swap content of parent 1 with parent"
-               "2\n\t\tfrom random index k1 to random index k2"
-               "\n\t\t(k2 > k1).\n"
-               "-'uniform'  :   For each gene, there's a 0.5 probability"
-               " that\n\t\ta gene will be selected from one parent or"
-               "\n\t\tthe other.\n"
-               "====================\n", cross_mode);
+               "-'none'   :    no surrogate.\n"
+               "-'linear' :    a weight per locus and value.\n"
+               "-'knn'    :    nearest archived genomes.\n"
+               "====================\n", surrogate_mode);
+        int_free_population(pop);
+        exit(EXIT_FAILURE);
+    }
+    if (mode != SURR_NONE &&
+        (factor < 1 || archive_size < 1 || retrain_every < 1 ||
+         (mode == SURR_KNN &&
+          (n_neighbors < 1 || n_neighbors > SURR_MAX_NEIGHBORS)) ||
+         (mode == SURR_LINEAR &&
+          (double) pop->length * pop->range > SURR_MAX_WEIGHTS)))
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Wrong arguments passed to 'int_set_surrogate':\n"
+               "-'factor'        : >= 1 (%d given).\n"
+               "-'archive_size'  : >= 1 (%d given).\n"
+               "-'retrain_every' : >= 1 (%d given).\n"
+               "-'n_neighbors'   : in [1, %d] for 'knn' (%d given).\n"
+               "'linear' needs length * range <= %d.\n"
+               "====================\n", factor, archive_size,
+               retrain_every, SURR_MAX_NEIGHBORS, n_neighbors,
+               SURR_MAX_WEIGHTS);
         int_free_population(pop);
         exit(EXIT_FAILURE);
     }
+    int_surrogate_free(pop);
+    pop->surr_mode = mode;
+    if (mode == SURR_NONE)
+        return;
+
+    pop->surr_factor = factor;
+    pop->surr_capacity = archive_size;
+    pop->surr_retrain = retrain_every;
+    pop->surr_k = n_neighbors;
+    pop->surr_genomes = ec_malloc((size_t) archive_size * pop->length
+                                  * sizeof(int), __LINE__, __FILE__);
+    pop->surr_fos = ec_malloc(archive_size * sizeof(float),
+                              __LINE__, __FILE__);
+    if (mode == SURR_LINEAR)
+        pop->surr_weights = ec_calloc((size_t) pop->length * pop->range,
+                                      sizeof(float), __LINE__, __FILE__);
 }
 
 void
-int_mutation(char *mutate_mode, struct IntPopulation *pop,
-             int **new_individuals, int n_new_individuals,
-             float mutate_rate)
+int_surrogate_free(struct IntPopulation *pop)
 {
-/* This function performs the mutation operation inside
-   a pointer of individuals ('**new_individuals').
-   This operator is an absolut must, as generates diversification
-   across future generations. Without it, the chances that the GA
-   algorithm will convert are very low. A few mutation types are accepted,
-   more info on these, check:
-   https://en.wikipedia.org/wiki/Mutation_(genetic_algorithm)
-   =ARGUMENTS=
-   - '*mutate_mode': A string containing the method used for mutation.:
-                     - 'swap' : For the mutated individual, one of it's
-                                gene will be swapped with another of it's
-                                own gene. Useful in non-repeatable solutions.
-                     - 'uniform' : The mutated individual will have one of
-                                   it's gene randomly replaced with another
-                                   possible value for the solution. Can't be
-                                   applied to non-repeatable solutions. For
-                                   binary-coded solutions (i.e. pop->max_value
-                                   =1 and pop->min_value=0) it's the same as
-                                   'flip bit' mutation type.
-   - '**new_individuals' : A pointer to int pointers of the problem solution.
-                           In the most general case, can be pop->individuals
-                           or ext_childs if n_parents < n_population.
-   - 'n_new_individuals' : Number of pointers inside '**new_individuals'.
-   - '*pop' : A pointer to the current already initialized/defined
-              IntPopulation structure.
-   - '*mutate_rate' : The probability that an gene will be mutate. */
-
-    /* Sanity check. */
-    check_null(mutate_mode, __LINE__, __FILE__);
+/* Frees the archive, the model and the candidates of the surrogate
+   (see 'int_set_surrogate') and resets it's state. */
+    free(pop->surr_genomes);
+    free(pop->surr_fos);
+    free(pop->surr_weights);
+    free(pop->surr_cands);
+    free(pop->surr_cand_parents);
+    free(pop->surr_cand_fos);
+    free(pop->surr_preds);
+    pop->surr_mode = SURR_NONE;
+    pop->surr_genomes = NULL;
+    pop->surr_fos = NULL;
+    pop->surr_weights = NULL;
+    pop->surr_cands = NULL;
+    pop->surr_cand_parents = NULL;
+    pop->surr_cand_fos = NULL;
+    pop->surr_preds = NULL;
+    pop->surr_rows = 0;
+    pop->surr_n_samples = 0;
+    pop->surr_next = 0;
+    pop->surr_n_preds = 0;
+    pop->surr_fit_gen = 0;
+    pop->surr_bias = 0.0;
+}
 
-    int i, j, p1;
+void
+int_surrogate_fit(struct IntPopulation *pop)
+{
+/* Fits the 'linear' surrogate to the archive: SURR_EPOCHS passes in
+   random order of normalized least mean squares, starting from the
+   mean fo. Each sample has one active weight per locus plus the bias,
+   so a step moves it's prediction SURR_STEP of the way to it's fo. The
+   order comes from it's own stream, the pop random stream is not
+   used. */
+    int e, s, j, tmp, *order, *genome;
+    int n = pop->surr_n_samples;
+    float *weights = pop->surr_weights, delta;
+    double mean = 0.0;
+    uint64_t rng = hash_mix64((uint64_t) pop->n_surr_fits + 1);
 
-    if (strcmp(mutate_mode, "swap") == 0)
+    order = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    for (s = 0; s < n; s++)
     {
-        /* Does not depend on 'non-repeatable' value.
-           Swap item individual[p1] with item individual[p2]. */
-        int tmp;
-
-        for (i = 0; i < n_new_individuals; i++)
+        order[s] = s;
+        mean += pop->surr_fos[s];
+    }
+    memset(weights, 0, (size_t) pop->length * pop->range * sizeof(float));
+    pop->surr_bias = (float) (mean / n);
+    for (e = 0; e < SURR_EPOCHS; e++)
+    {
+        for (s = n - 1; s > 0; s--)
         {
+            j = (int) rng_bounded(&rng, (uint32_t) s + 1);
+            tmp = order[s];
+            order[s] = order[j];
+            order[j] = tmp;
+        }
+        for (s = 0; s < n; s++)
+        {
+            genome = pop->surr_genomes + (size_t) order[s] * pop->length;
+            delta = (float) SURR_STEP * (pop->surr_fos[order[s]]
+                    - int_surrogate_predict(pop, genome))
+                    / (pop->length + 1);
+            pop->surr_bias += delta;
             for (j = 0; j < pop->length; j++)
             {
-                /* If condition true do not mutate. */
-                if ((float) ((double)rand() / (double)RAND_MAX) > mutate_rate)
-                    continue;
-                p1 = rand() % pop->length;
-                while (j == p1)
-                {
-                    p1 = rand() % pop->length;
-                }
-                /* Swapping. */
-                tmp = new_individuals[i][p1];
-                new_individuals[i][p1] = new_individuals[i][j];
-                new_individuals[i][j] = tmp;
+                weights[(size_t) j * pop->range + genome[j]
+                        - pop->min_value] += delta;
             }
         }
     }
-    else if ((strcmp(mutate_mode, "uniform") == 0) &&
-            (pop->non_repeatable == REPEATABLE))
+    free(order);
+    pop->surr_fit_gen = pop->generation;
+    pop->n_surr_fits++;
+}
+
+float
+int_surrogate_predict(struct IntPopulation *pop, int *arr)
+{
+/* Predicted fo of '*arr' (thread safe, see 'int_set_surrogate'). For
+   'knn', the distance to a sample stops being counted once it's
+   beyond the farthest of the current neighbors. */
+    int s, j, m, d, n_found = 0, limit = pop->length + 1;
+    int dists[SURR_MAX_NEIGHBORS];
+    float fos[SURR_MAX_NEIGHBORS], *weights = pop->surr_weights;
+    float fo = pop->surr_bias;
+    int *genome;
+    double sum = 0.0, sum_weights = 0.0;
+
+    if (pop->surr_mode == SURR_LINEAR)
     {
-        /* Can't be applied to non-repeatable solutions. */
-        for (i = 0; i < n_new_individuals; i++)
+        for (j = 0; j < pop->length; j++)
         {
-            /* If condition true do not mutate. */
-            for (j = 0; j < pop->length; j++)
-            {
-                if ((float) ((double)rand() / (double)RAND_MAX) > mutate_rate)
-                    continue;
-                p1 = rand() % (pop->max_value + 1) + pop->min_value;
-                while (p1 == new_individuals[i][j])
-                {
-                    p1 = rand() % (pop->max_value + 1) + pop->min_value;
-                }
-                /* Switching by another random value within
-                   solution min_value and max_value. */
-                new_individuals[i][j] = p1;
-            }
+            fo += weights[(size_t) j * pop->range + arr[j]
+                          - pop->min_value];
         }
+        return fo;
     }
-    else
+    for (s = 0; s < pop->surr_n_samples; s++)
     {
-        fprintf(stderr, "===ARGUMENT ERROR===\n"
-               "Wrong 'mutate_mode' ('%s') argument passed\nto"
-               "'int_mutation' function.\nThe supported"
-               " arguments are (so far):\n"
-               "-'swap'    :    Probability of 'mutate_rate' that one gene"
-               "\n\t\twill be swapped with another random gene\n\t\tfrom the"
-               " same individual.\n"
-               "-'uniform' :    Probability of 'mutate_rate' that one gene"
-               "\n\t\twill be replaced with a different random\n\t\t"
-               "possible gene from the solution boundaries.\n"
-               "====================\n", mutate_mode);
-        int_free_population(pop);
-        exit(EXIT_FAILURE);
+        genome = pop->surr_genomes + (size_t) s * pop->length;
+        d = 0;
+        for (j = 0; j < pop->length && d < limit; j++)
+        {
+            d += (genome[j] != arr[j]);
+        }
+        if (d >= limit)
+            continue;
+        /* Insertion into the neighbors, sorted by distance. */
+        m = (n_found < pop->surr_k) ? n_found++ : n_found - 1;
+        for (; m > 0 && dists[m - 1] > d; m--)
+        {
+            dists[m] = dists[m - 1];
+            fos[m] = fos[m - 1];
+        }
+        dists[m] = d;
+        fos[m] = pop->surr_fos[s];
+        if (n_found == pop->surr_k)
+            limit = dists[n_found - 1];
+    }
+    for (m = 0; m < n_found; m++)
+    {
+        sum += fos[m] / (1.0 + dists[m]);
+        sum_weights += 1.0 / (1.0 + dists[m]);
     }
+    return (float) (sum / sum_weights);
 }
 
 void
-int_ga_one_iter(struct IntPopulation *pop,
-                float (*objective_function)(), int tournament_size,
-                char *cross_mode, int n_parents, int n_childs,
-                char *mutate_mode, float mutate_rate)
-/* The purpose of this function is to apply a complete iteration
-   of the GA algorithm. This means:
-   -> Apply crossover using '*cross_mode' with 'n_parents' to
-      'n_childs'. Parents are defined after 'n_parents' tournaments
-      with 'tournament_size' competitors.
-   -> Apply mutation to the childs with '*mutate_mode' and
-      'mutate_rate'.
-   -> If n_childs < n_population, the rest of the individuals of the
-      next generation will be selected by elitism.
-   -> After having a full population, evaluate it.
-   The parents, childs and future individuals used in this function are
-   the external pointers 'ext_parents', 'ext_childs', 'ext_new_individuals'.
-   =ARGUMENTS=
-   - '*pop' : pointer to alread initialized IntPopulation struct.
-   - '(*objective_function)()' : pointer to the objective function (fo)'.
-   - 'tournament_size' : How many competitors within each tournament.
-   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
-   - 'n_parents' : Number of parents to be combined.
-   - 'n_childs' : Number of childs to be formed after crossover.
-   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
-   - 'mutate_rate' : probability of one gene to suffer mutation. */
+int_surrogate_screen(struct IntPopulation *pop, char *cross_mode,
+                     char *mutate_mode, float mutate_rate,
+                     float select_param, int *selected, int n_parents,
+                     int n_childs)
 {
-    int i, j = 0;
+/* Surrogate pre-screening for 'int_ga_one_iter': the childs already
+   in 'ext_childs' (from the parents in '*selected') are the first
+   batch of candidates, 'surr_factor' - 1 more batches are bred from
+   new selections. The 'n_childs' candidates with the best predicted
+   fo replace the childs, candidates equal to a better ranked one only
+   if there are not enough distinct ones. With duplicate elimination,
+   the parent of each kept child goes to 'pop->parent_indexes'. */
+    int b, c, k, n_kept = 0, n_cands = pop->surr_factor * n_childs;
+    int *cand;
+    size_t row = pop->length * sizeof(int);
+    struct IntRank *ranks;
 
-    /* Alloc'ng the parents, childs and new_individuals
-       for new populations. */
-    int_init_ext_ptrs(pop);
+    if (n_cands > pop->surr_rows)
+    {
+        pop->surr_cands = realloc(pop->surr_cands, (size_t) n_cands * row);
+        check_null(pop->surr_cands, __LINE__, __FILE__);
+        pop->surr_cand_parents = realloc(pop->surr_cand_parents,
+                                         n_cands * sizeof(int));
+        check_null(pop->surr_cand_parents, __LINE__, __FILE__);
+        pop->surr_cand_fos = realloc(pop->surr_cand_fos,
+                                     n_cands * sizeof(float));
+        check_null(pop->surr_cand_fos, __LINE__, __FILE__);
+        pop->surr_preds = realloc(pop->surr_preds, n_cands * sizeof(float));
+        check_null(pop->surr_preds, __LINE__, __FILE__);
+        pop->surr_rows = n_cands;
+    }
+    if (pop->surr_mode == SURR_LINEAR &&
+        (pop->n_surr_fits == 0 ||
+         pop->generation - pop->surr_fit_gen >= pop->surr_retrain))
+        int_surrogate_fit(pop);
 
-    /* Defining parents by tournaments. */
-    for (i = 0; i < n_parents; i++)
+    for (b = 0; b < pop->surr_factor; b++)
     {
-        memcpy(ext_parents[i],
-               int_tournament_selection(pop, tournament_size),
-               sizeof(int) * pop->length);
+        if (b > 0)
+        {
+            int_select_indexes(pop, pop->select_mode, select_param,
+                               selected, n_parents);
+            int_copy_parents(pop, selected, n_parents);
+            int_crossover(cross_mode, pop, pop->ext_parents, pop->ext_childs,
+                          n_parents);
+            int_mutation(mutate_mode, pop, pop->ext_childs, n_childs,
+                         mutate_rate);
+        }
+        for (c = 0; c < n_childs; c++)
+        {
+            k = b * n_childs + c;
+            memcpy(pop->surr_cands + (size_t) k * pop->length,
+                   pop->ext_childs[c], row);
+            pop->surr_cand_parents[k] = selected[c % n_parents];
+        }
     }
-    /* Defining childs from crossover. */
-    int_crossover(cross_mode, pop, ext_parents, ext_childs, n_parents);
-    /* Applying mutation to the childs. */
-    int_mutation(mutate_mode, pop, ext_childs, n_childs, mutate_rate);
 
-    /* Defining 'new_individuals'. */
-    /* If n_childs < n_population, the remaining individuals are
-       selected by elitism. */
-    for (i = 0; i < pop->n_population; i++)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pop->n_threads) schedule(dynamic, 16) \
+    if (pop->n_threads > 1)
+#endif
+    for (k = 0; k < n_cands; k++)
     {
-        if (i < n_childs)
-            memcpy(ext_new_individuals[i], ext_childs[i],
-                   sizeof(int)*pop->length);
-        else
+        pop->surr_cand_fos[k] = int_surrogate_predict(pop,
+                                    pop->surr_cands
+                                    + (size_t) k * pop->length);
+    }
+    ranks = ec_malloc(n_cands * sizeof(struct IntRank), __LINE__, __FILE__);
+    for (k = 0; k < n_cands; k++)
+    {
+        ranks[k].fo = pop->surr_cand_fos[k];
+        ranks[k].index = k;
+    }
+    qsort(ranks, n_cands, sizeof(struct IntRank), compare_ranks);
+    /* Equal genomes have equal predictions: only the kept candidates
+       with the same prediction are compared. */
+    for (k = 0, b = 0; k < n_cands && n_kept < n_childs; k++)
+    {
+        if (k > 0 && ranks[k].fo != ranks[k - 1].fo)
+            b = n_kept;
+        cand = pop->surr_cands + (size_t) ranks[k].index * pop->length;
+        for (c = b; c < n_kept && memcmp(pop->ext_childs[c], cand, row); c++)
+            ;
+        if (c < n_kept)
+            continue;
+        memcpy(pop->ext_childs[n_kept], cand, row);
+        pop->surr_preds[n_kept] = ranks[k].fo;
+        if (pop->dedup_mode != DEDUP_NONE)
+            pop->parent_indexes[n_kept] =
+                pop->surr_cand_parents[ranks[k].index];
+        ranks[k].index = -1;
+        n_kept++;
+    }
+    for (k = 0; k < n_cands && n_kept < n_childs; k++)
+    {
+        if (ranks[k].index < 0)
+            continue;
+        memcpy(pop->ext_childs[n_kept],
+               pop->surr_cands + (size_t) ranks[k].index * pop->length, row);
+        pop->surr_preds[n_kept] = ranks[k].fo;
+        if (pop->dedup_mode != DEDUP_NONE)
+            pop->parent_indexes[n_kept] =
+                pop->surr_cand_parents[ranks[k].index];
+        n_kept++;
+    }
+    free(ranks);
+    pop->surr_n_preds = n_childs;
+    pop->n_surr_predictions += n_cands;
+    pop->n_surr_rejected += n_cands - n_childs;
+}
+
+void
+int_surrogate_ranks(struct IntRank *items, int n, float *ranks)
+{
+/* Ranks (from 0, tied items get the mean of their ranks) of the 'n'
+   '*items' by fo, written at 'ranks[items[i].index]'. */
+    int i, j, k;
+
+    qsort(items, n, sizeof(struct IntRank), compare_ranks);
+    for (i = 0; i < n; i = j)
+    {
+        for (j = i + 1; j < n && items[j].fo == items[i].fo; j++)
+            ;
+        for (k = i; k < j; k++)
         {
-            /* Elitism. */
-            memcpy(ext_new_individuals[i],
-                   pop->individuals[pop->sorted_fos_indexes[j]],
-                   sizeof(int)*pop->length);
-            j++;
+            ranks[items[k].index] = 0.5f * (i + j - 1);
         }
     }
-    /* Upgrading individuals inside pop. */
+}
+
+void
+int_surrogate_collect(struct IntPopulation *pop)
+{
+/* For 'int_evaluate_population', before the local search: adds the
+   evaluated individuals to the surrogate archive and compares the
+   predictions of the last screening with their fo ('surr_rank_corr'
+   and 'surr_mae', only if 2 or more were evaluated). */
+    int i, n = 0;
+    float *pred_ranks, *fo_ranks;
+    double error = 0.0, mean, cov = 0.0, var_a = 0.0, var_b = 0.0;
+    struct IntRank *preds, *fos;
+
+    preds = ec_malloc((pop->surr_n_preds + 1) * sizeof(struct IntRank),
+                      __LINE__, __FILE__);
+    fos = ec_malloc((pop->surr_n_preds + 1) * sizeof(struct IntRank),
+                    __LINE__, __FILE__);
     for (i = 0; i < pop->n_population; i++)
     {
-        memcpy(pop->individuals[i], ext_new_individuals[i],
-               sizeof(int)*pop->length);
+        if ((pop->n_eval_skip > 0 && pop->eval_skip[i]) ||
+            !isfinite(pop->fos[i]) || pop->fos[i] >= FLT_MAX)
+            continue;
+        if (i < pop->surr_n_preds)
+        {
+            preds[n].fo = pop->surr_preds[i];
+            preds[n].index = n;
+            fos[n].fo = pop->fos[i];
+            fos[n].index = n;
+            error += fabs(pop->surr_preds[i] - pop->fos[i]);
+            n++;
+        }
+        memcpy(pop->surr_genomes + (size_t) pop->surr_next * pop->length,
+               pop->individuals[i], pop->length * sizeof(int));
+        pop->surr_fos[pop->surr_next] = pop->fos[i];
+        pop->surr_next = (pop->surr_next + 1) % pop->surr_capacity;
+        if (pop->surr_n_samples < pop->surr_capacity)
+            pop->surr_n_samples++;
+    }
+    if (n >= 2)
+    {
+        pred_ranks = ec_malloc(2 * n * sizeof(float), __LINE__, __FILE__);
+        fo_ranks = pred_ranks + n;
+        int_surrogate_ranks(preds, n, pred_ranks);
+        int_surrogate_ranks(fos, n, fo_ranks);
+        /* Both ranks have the same mean. */
+        mean = 0.5 * (n - 1);
+        for (i = 0; i < n; i++)
+        {
+            cov += (pred_ranks[i] - mean) * (fo_ranks[i] - mean);
+            var_a += (pred_ranks[i] - mean) * (pred_ranks[i] - mean);
+            var_b += (fo_ranks[i] - mean) * (fo_ranks[i] - mean);
+        }
+        pop->surr_rank_corr = (var_a > 0.0 && var_b > 0.0) ?
+                              (float) (cov / sqrt(var_a * var_b)) : 0.0;
+        pop->surr_mae = (float) (error / n);
+        free(pred_ranks);
     }
-    /* Evaluating new individuals inside pop. */
-    int_evaluate_population(pop, objective_function);
+    free(preds);
+    free(fos);
+    pop->surr_n_preds = 0;
 }
@@ -15,6 +15,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
+#include <sys/types.h>
+#include <poll.h>
 #include "../generals/generals.h"
 
 /* For checks on the external and global pointers. */
@@ -30,6 +32,192 @@
 /* For 'non-repeatable' checks. */
 #define NO_REPEAT 1
 #define REPEATABLE 0
+#define SUBSET 2
+/* For 'pop->resize_mode' (see 'int_set_resize_schedule'). */
+#define RESIZE_NONE 0
+#define RESIZE_IMPROVEMENT 1
+#define RESIZE_STAGNATION 2
+#define RESIZE_ADAPTIVE 3
+#define RESIZE_TIME 4
+/* For 'release_memory' argument of resize functions. */
+#define KEEP_MEMORY 0
+#define RELEASE_MEMORY 1
+/* For 'pop->diversity_mode' (see 'int_set_diversity'). */
+#define DIVERSITY_NONE 0
+#define DIVERSITY_LOCUS 1
+#define DIVERSITY_SAMPLED 2
+/* Max. number of per-locus counters (length * range) for 'locus' mode. */
+#define DIVERSITY_MAX_COUNTS (1 << 24)
+/* Number of sampled pairs for the Hamming distance estimation. */
+#define DIVERSITY_N_SAMPLES 64
+/* For 'pop->dedup_mode' (see 'int_set_dedup'). */
+#define DEDUP_NONE 0
+#define DEDUP_REMUTATE 1
+#define DEDUP_REJECT 2
+/* For 'pop->select_mode' (see 'int_selection'). */
+#define SELECT_TOURNAMENT 0
+#define SELECT_ROULETTE 1
+#define SELECT_SUS 2
+#define SELECT_LINRANK 3
+#define SELECT_EXPRANK 4
+#define SELECT_TRUNCATION 5
+/* Codes of the 'cross_mode' and 'mutate_mode' strings. */
+#define CROSS_1KPOINT 0
+#define CROSS_2KPOINTS 1
+#define CROSS_UNIFORM 2
+#define CROSS_UNION 3
+#define MUTATE_SWAP 0
+#define MUTATE_UNIFORM 1
+/* For 'pop->storage' (where the individuals are stored). */
+#define STORAGE_HEAP 0
+#define STORAGE_MMAP 1
+/* Memory mapped storage ('mmap:<path>', 'remap:<path>' and 'shared'
+   init_mode, the last one without a file).
+   The file has a header page and MMAP_N_REGIONS regions of
+   [n_population_alloc][length] ints:
+   - 2 for the individuals of generations k and k + 1 (swapped).
+   - 1 for 'ext_parents' and 1 for 'ext_childs'.
+   - 1 for the all time best individuals. */
+#define MMAP_HEADER_SIZE 4096
+#define MMAP_N_REGIONS 5
+#define MMAP_REGION_PARENTS 2
+#define MMAP_REGION_CHILDS 3
+#define MMAP_REGION_BEST 4
+/* Bytes of individuals evaluated per chunk in mmap storage. */
+#define MMAP_EVAL_CHUNK (1 << 24)
+/* Fork evaluator pool (see 'int_set_fork_evaluator'): evaluations of an
+   individual retried after a worker crash, and longest wait (ms) of the
+   parent between checks for dead workers (they are usually found as
+   soon as their socket hangs up). */
+#define FORK_MAX_RETRIES 2
+#define FORK_POLL_MS 100
+/* For 'pop->proc_protocol' (see 'int_set_process_evaluator'). */
+#define PROC_TEXT 0
+#define PROC_BINARY 1
+/* Longest text reply (bytes) of an external process. */
+#define PROC_LINE_MAX 4096
+/* For 'pop->surr_mode' (see 'int_set_surrogate'). */
+#define SURR_NONE 0
+#define SURR_LINEAR 1
+#define SURR_KNN 2
+/* Passes over the archive and step of each fit of the 'linear'
+   surrogate, max. weights (length * range) of it and max. neighbors of
+   the 'knn' one. */
+#define SURR_EPOCHS 10
+#define SURR_STEP 0.5
+#define SURR_MAX_WEIGHTS (1 << 26)
+#define SURR_MAX_NEIGHBORS 64
+/* For 'pop->stagnation_mode' (see 'int_set_stagnation'). */
+#define STAGNATION_NONE 0
+#define STAGNATION_STOP 1
+#define STAGNATION_RESTART 2
+#define STAGNATION_HYPERMUTATE 3
+/* For 'pop->ls_mode' and 'pop->ls_writeback' (see 'int_set_local_search'). */
+#define LS_NONE 0
+#define LS_FIRST 1
+#define LS_BEST 2
+#define LS_MINCONFLICTS 3
+#define LS_LAMARCKIAN 0
+#define LS_BALDWINIAN 1
+/* Work rows of the local search per thread: the targets are searched
+   by chunks of 'n_threads * LS_ROWS_PER_THREAD' (see 'ls_work'). */
+#define LS_ROWS_PER_THREAD 4
+/* Default capacity of the hall of fame (see 'int_set_hall_of_fame'). */
+#define HOF_DEFAULT_CAPACITY 10
+/* Gene-major view (see 'int_set_batch_objective'): columns are padded
+   to GM_LANES (16 ints, one AVX-512 register) and batch objectives get
+   up to GM_BLOCK individuals per call. */
+#define GM_LANES 16
+#define GM_BLOCK 64
+/* For 'pop->cell_neighborhood' and 'pop->cell_update' (see
+   'int_set_cellular'). Asynchronous updates sweep bands of
+   CELL_TILE_ROWS grid rows (tiles), one thread per tile. */
+#define CELL_NONE 0
+#define CELL_VON_NEUMANN 1
+#define CELL_MOORE 2
+#define CELL_SYNC 0
+#define CELL_ASYNC 1
+#define CELL_TILE_ROWS 4
+/* Max. number of objectives of the multi-objective mode (see
+   'int_set_multi_objective'). */
+#define MO_MAX_OBJECTIVES 16
+/* For 'pop->niche_mode' and 'pop->niche_search' (see 'int_set_niching').
+   LSH searches hash NICHE_LSH_TABLES samples of up to
+   NICHE_LSH_MAX_LOCI loci, comparing each member of a bucket with
+   (at most) the next NICHE_LSH_WINDOW ones. Hamming distances are
+   computed by blocks of NICHE_HAMMING_BLOCK genes. */
+#define NICHE_NONE 0
+#define NICHE_SHARING 1
+#define NICHE_CLEARING 2
+#define NICHE_COUNT 3
+#define NICHE_EXACT 0
+#define NICHE_LSH 1
+#define NICHE_LSH_TABLES 8
+#define NICHE_LSH_MAX_LOCI 64
+#define NICHE_LSH_WINDOW 16
+#define NICHE_HAMMING_BLOCK 64
+/* Stop reasons of 'int_ga_run' (see 'int_set_run_limits'). */
+#define RUN_MAX_ITER 1
+#define RUN_MAX_TIME 2
+#define RUN_MAX_EVALS 3
+#define RUN_TARGET 4
+#define RUN_STAGNATION 5
+#define RUN_CALLBACK 6
+#define RUN_STOPPED 7
+/* Genome sharing modes (see 'int_set_genome_sharing'). */
+#define COW_NONE 0
+#define COW_SHARE 1
+/* Blocks of a child after a fused breeding (internal, see
+   'int_set_block_objective'): equal to it's own parent, equal to the
+   other parent or changed. */
+#define BLOCK_OWN 0
+#define BLOCK_OTHER 1
+#define BLOCK_CHANGED 2
+
+/*==========================*/
+/* Pair of individuals closer than the niche radius (internal, see
+   'int_update_niches'). 'weight' > 1 for pairs sampled from large
+   LSH buckets, standing for the pairs not compared. */
+struct IntNichePair
+{
+    int i, j, distance;
+    float weight;
+};
+
+/* Entry of the genome hash table used by duplicate elimination
+   (internal, see 'int_set_dedup'). */
+struct IntGenomeEntry
+{
+    uint64_t hash;
+    int *genome;     /* NULL if the entry is empty. */
+    float fo;
+    int fo_known;    /* 1 if 'fo' is already evaluated. */
+    int in_next_gen; /* 1 if the genome is part of the next generation. */
+};
+
+/* Child process of the external evaluator (internal, see
+   'int_set_process_evaluator'). */
+struct IntProcess
+{
+    pid_t pid;          /* -1 if there is no process. */
+    int fd;             /* Socket on it's stdin and stdout. */
+    int *inflight;      /* Individuals sent and not answered yet, a ring
+                           of 'proc_batch' entries starting at 'head'. */
+    int head, n_inflight;
+    char *out, *in;     /* Request being written, from 'out_pos' to
+                           'out_len', and replies read but not parsed
+                           ('in_len' bytes). */
+    size_t out_pos, out_len, in_len;
+    double deadline;    /* Time limit of the first individual in flight. */
+};
+
+/* Entry of the row reference counts of shared genomes (internal, see
+   'int_set_genome_sharing'). Rows without entry have one reference. */
+struct IntRowRef
+{
+    int *row;        /* NULL if the entry is empty. */
+    int refs;
+};
 
 /*==========================*/
 /* The main struct for solving GA. */
@@ -65,7 +253,15 @@ struct IntPopulation
     char *init_mode;
     int n_population;
     int n_population_orig;  /* In cases n_population is reduced. */
+    int n_population_alloc; /* Rows alloc'd for individuals and evals. */
     int **individuals;
+    /* Rows behind the external pointers of this pop ('ext_rows' each,
+       0 until 'int_init_ext_ptrs' allocs them). */
+    int **ext_parents, **ext_childs, **ext_new_individuals;
+    int ext_rows;
+    /* Row returned by 'int_tournament_selection' (NULL until it's first
+       call). */
+    int *winner;
     /* Evaluation related.
        - 'best_fo' : best of all fo from this pop (minor).
        - 'n_best_individuals' : Number of individuals with 'best_fo'.
@@ -77,17 +273,308 @@ struct IntPopulation
     float *fos, best_fo;
     float *sorted_fos;
     int *sorted_fos_indexes;
-    /* All time best indiv. and fo found through all iters in this pop. */
+    /* All time best indiv. and fo found through all iters in this pop.
+       'best_indv_alltime' points to the 'n_best_indv_alltime' distinct
+       genomes of the hall of fame with 'best_fo_alltime'. */
     float best_fo_alltime;
     int n_best_indv_alltime;
     int **best_indv_alltime;
+    /* Hall of fame (see 'int_set_hall_of_fame'): the 'hof_capacity' best
+       distinct genomes found through all iters.
+       - 'hof_genomes', 'hof_fos', 'hof_hashes' : Entries, in slots
+                                                  [0, hof_size).
+       - 'hof_heap' : Slots in a binary heap, worst fo on top (the one
+                      to be replaced); 'hof_heap_pos' is the inverse.
+       - 'hof_table' : Open addressing table of (slot + 1) by genome
+                       hash (0 = empty), with 'hof_table_size' entries. */
+    int hof_capacity, hof_size, hof_table_size;
+    int **hof_genomes;
+    float *hof_fos;
+    uint64_t *hof_hashes;
+    int *hof_heap, *hof_heap_pos, *hof_table;
     /* To make sure a few variables are calloc'd only on 1st init call. */
     int first_population;
+    /* Iteration bookkeeping (updated by 'int_evaluate_population').
+       - 'generation' : Number of evaluations of this pop (0 = first one).
+       - 'n_stagnant_gens' : Generations since 'best_fo_alltime' improved.
+       - 'objective_function' : Last fo used, to evaluate new individuals
+                                created by a population resize. */
+    int generation, n_stagnant_gens;
+    float (*objective_function)();
+    /* Population resize schedule (see 'int_set_resize_schedule'). */
+    int resize_mode, resize_min_pop, resize_max_pop;
+    int resize_patience, resize_release_memory;
+    float resize_factor;
+    double resize_time_budget;
+    struct timespec resize_start;
+    /* Diversity statistics (see 'int_set_diversity').
+       - 'diversity_entropy' : Mean per-locus entropy, normalized to [0, 1]
+                               (-1 if not computed, i.e. 'sampled' mode).
+       - 'diversity_hamming' : Mean pairwise Hamming distance (in genes).
+       - 'n_unique_individuals' : Number of distinct genomes.
+       - 'locus_counts' : Value frequencies with shape [length][range]
+                          ('locus' mode only, see 'int_locus_frequency').
+       - 'hashes' : Genome hash for each individual (also kept for
+                    duplicate elimination, see 'int_set_dedup'). */
+    int diversity_mode, diversity_synced, diversity_rows;
+    float diversity_entropy, diversity_hamming;
+    int n_unique_individuals;
+    int *locus_counts;
+    long long locus_sum_sq;
+    double locus_sum_clogc, *clogc_table;
+    uint64_t *hashes;
+    /* Duplicate elimination (see 'int_set_dedup').
+       - 'n_evaluations' : Number of objective function calls.
+       - 'n_evals_saved' : Evaluations avoided by reusing the fo of
+                           already known genomes.
+       - 'n_duplicates' : Duplicated childs found.
+       - 'eval_skip' : Individuals with 'fos' already defined, not
+                       evaluated by the next 'int_evaluate_population'. */
+    int dedup_mode, dedup_max_tries, dedup_rows;
+    long n_evaluations, n_evals_saved, n_duplicates;
+    int *parent_indexes, *eval_skip, n_eval_skip;
+    uint64_t *child_hashes;
+    float *next_fos;
+    int *next_fo_known;
+    struct IntGenomeEntry *genome_table;
+    int genome_table_size;
+    /* Selection used by 'int_ga_one_iter' (see 'int_set_selection').
+       - 'rng_state' : Random stream of the pop (seeded with rand()).
+       - 'select_prob', 'select_alias' : Walker's alias tables. */
+    int select_mode, select_rows;
+    float select_param;
+    uint64_t rng_state;
+    double *select_prob;
+    int *select_alias, *select_work;
+    /* Parallel breeding and evaluation (see 'int_set_n_threads').
+       - 'breed_scratch' : One repair buffer per thread. */
+    int n_threads, breed_rows;
+    int **breed_scratch;
+    /* Individuals storage. For STORAGE_MMAP, all the [rows][length]
+       buffers live in a memory mapped file (see 'int_init_population')
+       and only the metadata (fos, rankings, hashes) is kept in RAM.
+       - 'mmap_current' : Region with the current individuals (0 or 1).
+       - 'alltime_restored' : 1 if 'best_fo_alltime' and it's individuals
+                              were restored by a 'remap:<path>' init. */
+    int storage, mmap_fd, mmap_current, alltime_restored;
+    char *mmap_base;
+    size_t mmap_size, mmap_region_size;
+    /* Stagnation triggers (see 'int_set_stagnation').
+       - 'stop' : Set to 1 when the 'stop' trigger fires, the main
+                  loop should check it. */
+    int stagnation_mode, stagnation_patience, n_restarts, stop;
+    float stagnation_min_diversity, stagnation_keep_fraction;
+    float stagnation_rate;
+    /* Local search, memetic mode (see 'int_set_local_search').
+       - 'ls_delta' : Fo change of one move (NULL: full evaluations).
+       - 'ls_targets' : Indexes of the targets of a generation.
+       - 'ls_work', 'ls_fos' : Improved copy and fo of each target of a
+                               chunk ('ls_rows' of them). 
+       - 'n_ls_evaluations' : Moves evaluated by the local search.
+       - 'n_ls_improved' : Individuals improved by the local search. */
+    int ls_mode, ls_writeback, ls_n_top, ls_budget, ls_rows;
+    float ls_fraction;
+    float (*ls_delta)();
+    int **ls_work, *ls_targets;
+    float *ls_fos;
+    long n_ls_evaluations, n_ls_improved;
+    /* Gene-major (structure of arrays) view of the individuals (see
+       'int_set_batch_objective'): gene j of individual i is
+       'gm_genes[j * gm_stride + i]', 'gm_stride' being 'gm_rows'
+       (n_population_alloc) rounded up to GM_LANES (plus GM_LANES if
+       it's a multiple of 256).
+       - 'batch_objective' : Objective function evaluating a block of
+                             individuals from the view (or NULL). */
+    void (*batch_objective)();
+    int *gm_genes;
+    int gm_stride, gm_rows;
+    /* Cellular GA (see 'int_set_cellular'): individual i is the cell
+       (i / cell_cols, i % cell_cols) of a 'cell_rows' x 'cell_cols'
+       toroidal grid ('cell_neighborhood' == CELL_NONE if not set). */
+    int cell_neighborhood, cell_update, cell_rows, cell_cols;
+    /* Multi-objective mode (see 'int_set_multi_objective'): objective m
+       of point i is 'mo_objs[m * mo_stride + i]', points [0, n_population)
+       being the individuals and [n_population, 2 * n_population) the
+       childs of 'int_nsga2_one_iter' ('mo_stride' = 2 * 'mo_rows').
+       - 'mo_rank', 'mo_crowding' : Front (0 = non dominated) and
+                                    crowding distance of each point.
+                                    'fos' holds the front of each
+                                    individual.
+       - 'mo_archive' : Bounded Pareto archive, 'mo_archive_size'
+                        distinct non dominated genomes with objectives
+                        'mo_archive_objs[m * mo_archive_capacity + a]'. */
+    int mo_n_objectives, mo_rows, mo_stride;
+    void (*mo_function)();
+    float *mo_objs, *mo_crowding;
+    int *mo_rank;
+    int mo_archive_capacity, mo_archive_size;
+    int **mo_archive;
+    float *mo_archive_objs;
+    uint64_t *mo_archive_hashes;
+    /* Niching (see 'int_set_niching'): individuals closer than
+       'niche_radius' genes (Hamming distance) share a niche.
+       - 'niche_fos', 'niche_order' : Shared or cleared fos, used by the
+                                      selection instead of 'fos', and
+                                      the indexes sorted by them.
+       - 'niche_counts' : Individuals within the radius of each one
+                          (itself included).
+       - 'niche_pairs' : The 'niche_n_pairs' close pairs found.
+       - 'niche_lsh_loci' : 'niche_lsh_k' sampled loci per LSH table.
+       - 'n_niches' : Individuals without a better one (niche center)
+                      within the radius.
+       - 'n_niche_distances' : Distances computed by the last search. */
+    int niche_mode, niche_search, niche_radius, niche_rows, niche_synced;
+    float niche_param;
+    float *niche_fos, *niche_counts;
+    int *niche_order, *niche_lsh_loci, niche_lsh_k;
+    struct IntNichePair *niche_pairs;
+    long niche_n_pairs, niche_pairs_cap;
+    int n_niches;
+    long n_niche_distances;
+    /* Anytime run driver (see 'int_ga_run'). Limits are not used if
+       <= 0 ('run_has_target' == 0 for no target fo).
+       - 'run_callback' : Called every 'run_callback_every' generations
+                          (or NULL).
+       - 'run_stop' : Stop request of 'int_stop_run' (atomic).
+       - 'run_generation', 'run_seconds', 'run_reason' : Generations,
+                                                         time and stop
+                                                         reason of the
+                                                         last run.
+       - 'snap_genome', 'snap_fo', 'snap_generation',
+         'snap_evaluations' : Best genome published by
+                              'int_publish_best' (seqlock, odd
+                              'snap_seq' while it's written). */
+    int run_max_iter, run_max_stagnant, run_has_target;
+    double run_max_seconds;
+    long run_max_evaluations;
+    float run_target_fo;
+    int (*run_callback)();
+    void *run_callback_data;
+    int run_callback_every, run_stop, run_reason;
+    long run_generation;
+    double run_seconds;
+    int *snap_genome;
+    float snap_fo;
+    long snap_generation, snap_evaluations;
+    unsigned long snap_seq;
+    /* Genome sharing (see 'int_set_genome_sharing'): identical
+       individuals point to the same row, copied on the first write.
+       - 'cow_table' : Reference counts of the rows ('cow_table_size'
+                       entries, open addressing by row pointer).
+       - 'cow_spare' : 'n_cow_spare' unused rows, handed to the slots
+                       whose row is still shared.
+       - 'cow_clones' : Childs of the last breeding that are a reference
+                        to their parents row.
+       - 'n_cow_shared' : Individuals without a row of their own.
+       - 'n_cow_copies', 'n_cow_clones' : Copies on write and childs
+                                          stored as a reference. */
+    int cow_mode, cow_rows, cow_table_size, n_cow_spare;
+    struct IntRowRef *cow_table;
+    int **cow_spare, *cow_clones;
+    long n_cow_shared, n_cow_copies, n_cow_clones;
+    /* Decomposable objective (see 'int_set_block_objective'): the fo is
+       the sum of 'block_function' over 'n_blocks' blocks of
+       'block_size' genes.
+       - 'block_scores' : Score of block b of individual i at
+                          'block_scores[i * n_blocks + b]', evaluated
+                          again if 'block_dirty' (same index) is set.
+       - 'next_block_scores', 'next_block_dirty' : The same for the next
+                                                  generation, defined by
+                                                  the fused breeding
+                                                  ('block_synced' = 1).
+       - 'n_block_evaluations', 'n_blocks_reused' : Blocks evaluated and
+                                                    taken from a parent
+                                                    (or kept). */
+    float (*block_function)();
+    int block_size, n_blocks, block_rows, block_synced;
+    float *block_scores, *next_block_scores;
+    unsigned char *block_dirty, *next_block_dirty;
+    long n_block_evaluations, n_blocks_reused;
+    /* Fork evaluator pool (see 'int_set_fork_evaluator'): 'fork_n_workers'
+       processes evaluating the mapped individuals. The queue and results
+       live in 'fork_shared' ('fork_shared_size' bytes, MAP_SHARED):
+       - 'fork_tasks' : Indexes to evaluate, claimed in order.
+       - 'fork_rows' : Row of each queued individual.
+       - 'fork_fos', 'fork_done' : Fo and done flag of each individual.
+       - 'fork_slots' : Individual being evaluated by each worker (-1).
+       Only the parent uses:
+       - 'fork_pids', 'fork_wake_fds' : Worker pids and the socket that
+                                        wakes each one.
+       - 'fork_done_fds' : Pipe where workers report an empty queue.
+       - 'fork_polls' : The pipe and the sockets, polled for reports and
+                        dead workers (hang up).
+       - 'fork_pending' : Wakes not reported yet by each worker.
+       - 'fork_retries' : Crashes while evaluating each individual.
+       - 'n_fork_restarts', 'n_fork_failures' : Workers restarted and
+                                                individuals penalized
+                                                (FLT_MAX) after
+                                                FORK_MAX_RETRIES retries. */
+    int fork_n_workers, fork_done_fds[2];
+    char *fork_shared;
+    size_t fork_shared_size;
+    int *fork_tasks, *fork_done, *fork_slots;
+    int **fork_rows;
+    float *fork_fos;
+    pid_t *fork_pids;
+    struct pollfd *fork_polls;
+    int *fork_wake_fds, *fork_pending, *fork_retries;
+    long n_fork_restarts, n_fork_failures;
+    /* External process evaluator (see 'int_set_process_evaluator'):
+       'proc_n_processes' copies of 'proc_command' evaluating up to
+       'proc_batch' individuals each at a time.
+       - 'proc_list' : The processes.
+       - 'proc_requeue' : 'proc_n_requeued' individuals to send again,
+                          in flight in a process that failed.
+       - 'proc_polls' : The sockets, polled for replies.
+       - 'n_proc_failures' : Individuals with the 'proc_penalty' fo.
+       - 'n_proc_timeouts' : Failures after 'proc_timeout' seconds.
+       - 'n_proc_respawns' : Processes started again. */
+    char *proc_command;
+    int proc_n_processes, proc_protocol, proc_batch;
+    double proc_timeout;
+    float proc_penalty;
+    struct IntProcess *proc_list;
+    int *proc_requeue, proc_n_requeued;
+    struct pollfd *proc_polls;
+    long n_proc_failures, n_proc_timeouts, n_proc_respawns;
+    /* Surrogate pre-screening (see 'int_set_surrogate'): 'surr_factor'
+       candidates are bred per child and only the best predicted ones
+       are evaluated.
+       - 'surr_genomes', 'surr_fos' : Archive of 'surr_n_samples' (up to
+                                      'surr_capacity') evaluated genomes,
+                                      a ring written at 'surr_next'.
+       - 'surr_weights', 'surr_bias' : 'linear' model, the weight of
+                                       value v at locus j is at
+                                       'surr_weights[j * range + v -
+                                       min_value]'. Fitted again every
+                                       'surr_retrain' generations (last
+                                       one at 'surr_fit_gen').
+       - 'surr_k' : Neighbors of the 'knn' model.
+       - 'surr_cands', 'surr_cand_fos', 'surr_cand_parents' : Rows (of
+                      'length' ints), predicted fo and parent of the
+                      candidates (room for 'surr_rows' of them).
+       - 'surr_preds' : Predicted fo of the first 'surr_n_preds'
+                        individuals, compared with their fo by the next
+                        evaluation.
+       - 'surr_rank_corr', 'surr_mae' : Spearman rank correlation and
+                                        mean absolute error of the last
+                                        compared predictions.
+       - 'n_surr_fits', 'n_surr_predictions', 'n_surr_rejected' : Fits,
+                        candidates predicted and candidates discarded
+                        without evaluation. */
+    int surr_mode, surr_factor, surr_capacity, surr_retrain, surr_k;
+    int *surr_genomes, surr_n_samples, surr_next, surr_fit_gen;
+    float *surr_fos, *surr_weights, surr_bias;
+    int *surr_cands, *surr_cand_parents, surr_rows, surr_n_preds;
+    float *surr_cand_fos, *surr_preds;
+    float surr_rank_corr, surr_mae;
+    long n_surr_fits, n_surr_predictions, n_surr_rejected;
 };
 
 /*==========================*/
 /* Externals to make life easy. */
-int **ext_parents, **ext_childs, **ext_new_individuals, ext_ptrs_state;
+extern int **ext_parents, **ext_childs, **ext_new_individuals;
+extern int ext_ptrs_state;
 /* These three pointers are used inside 'ga_one_iter' function but can
    also be used by the end user for whatever means they want.
    - 'ext_parents' : a pointer of pointers to be generally used in
@@ -108,7 +595,9 @@ int **ext_parents, **ext_childs, **ext_new_individuals, ext_ptrs_state;
    - 'ext_ptrs_state' : a variable that's used by alloc and free functions
                         to avoid incorrect alloc and free calls.
    These three pointers can be alloc'd by 'int_init_ext_ptrs' function and
-   are free by 'int_free_ext_ptrs' function. */
+   are free by 'int_free_ext_ptrs' function. They point to the rows of
+   the last pop passed to 'int_init_ext_ptrs' (which 'int_ga_one_iter'
+   calls), so each pop of a program has it's own. */
 
 /*==========================*/
 /* Print functions. */
@@ -145,6 +634,9 @@ int_init_ext_ptrs(struct IntPopulation *pop);
    - 'ext_individuals'
    These pointers are used in 'ga_one_iter' function, but can
    also be used by the user in his own GA steps'
+   The rows belong to the pop ('pop->ext_parents', ...), they are
+   alloc'd once and the externals point to the ones of the last pop
+   passed here, so several pops can live in the same program.
    =ARGUMENTS=
    - '*pop' : A pointer to an IntPopulation struct. */
 
@@ -158,6 +650,8 @@ int_free_ext_ptrs(struct IntPopulation *pop);
    - 'ext_individuals'
    These pointers are used in 'ga_one_iter' function, but can
    also be used by the user in his own GA steps'
+   If the externals point to the rows of 'pop', they go back to NULL
+   (PTR_NOT_ALLOCD).
    =ARGUMENTS=
    - '*pop' : A pointer to an IntPopulation struct. */
 
@@ -194,10 +688,40 @@ struct IntPopulation
                                   could be used.
                     - 'unalloc' : The pop will begin with 'pop->individuals'
                                   unallocated. Useful for generation > 0.
+                    - 'mmap:<path>' : Like 'random', but the individuals
+                                  (and all other [n_population][length]
+                                  buffers) are stored in a memory mapped
+                                  file created at <path>, for populations
+                                  that don't fit in RAM. The indexing API
+                                  (pop->individuals[i][j]) is the same.
+                    - 'remap:<path>' : Restarts a run mapping an existing
+                                  <path> file (created with 'mmap:<path>').
+                                  The individuals and all time best are
+                                  restored; 'n_population' is taken from
+                                  the file. The pop must be evaluated again.
+                    - 'shared'  : Like 'mmap:<path>', without a file
+                                  (anonymous shared memory), so forked
+                                  processes see the individuals (see
+                                  'int_set_fork_evaluator').
+                    - 'seed:<path>' : Like 'random', but the first
+                                  individuals (e.g. from a heuristic) are
+                                  read from the text file at <path> (see
+                                  'int_read_individuals' in GA_int.c).
+                  Random individuals are built with Fisher-Yates (or
+                  Floyd's sampling for SUBSET solutions), in parallel with
+                  all the OpenMP threads (results don't depend on them).
    - 'n_population' : The number of individuals inside population.
    - 'length' : Length of the solution presentation (len of individual array).
    - 'min_value' : The minimum value contained in the solution presentation.
    - 'max_value' : The maximum value contained in the solution presentation.
+   - 'non_repeatable' : - REPEATABLE : Any value in each gene.
+                        - NO_REPEAT  : Distinct values (e.g. permutations),
+                                       costs linear in 'range'.
+                        - SUBSET     : A set of 'length' distinct values,
+                                       kept sorted, whose costs depend only
+                                       on 'length' (e.g. 500 ids out of
+                                       10^9). Needs 'union' crossover and
+                                       'uniform' mutation.
    =RETURNS=
    - 'pop' : A pointer to an IntPopulation struct. This struct has the
              the following variables initialized:
@@ -219,6 +743,9 @@ int_evaluate_population(struct IntPopulation *pop,
    - 'sorted_fos'
    - 'sorted_fos_indexes'
    It should be called after the generation of a population.
+   Multi-objective populations (see 'int_set_multi_objective') are
+   evaluated with their own objective function ('objective_function'
+   can be NULL).
    =ARGUMENTS=
    - '*pop' : An IntPopulation struct already initialized.
    - '(*objective_function)()' : A fo calculation with inputs:
@@ -235,7 +762,52 @@ int
    - 'tournament_size' : The number of simultaneous competitors.
    =RETURNS=
    - 'winner' : A pointer to a int solution array with the minor fo
-                from the tournament. */
+                from the tournament ('pop->winner', a copy overwritten
+                by the next call on the same pop). */
+
+int
+int_tournament_index(struct IntPopulation *pop, int tournament_size);
+/* Same as 'int_tournament_selection' but returns the index (inside
+   pop->individuals) of the winner, without copying it. */
+
+void
+int_selection(char *select_mode, struct IntPopulation *pop,
+              int *indexes, int n_select, float select_param);
+/* This function selects 'n_select' individuals (e.g. all the parents of
+   a generation) in one batched call, defining their indexes (inside
+   pop->individuals) in '*indexes'. Any needed table is built once per
+   call (O(n_population)) and each draw is O(1) (O(tournament_size) for
+   tournaments). As fos are minimized, fitness proportional modes use
+   (worst_fo - fo) as the fitness of each individual.
+   More info on these methods:
+   https://en.wikipedia.org/wiki/Selection_(genetic_algorithm)
+   =ARGUMENTS=
+   - '*select_mode' : - 'tournament' : Best of 'select_param' distinct
+                                       random competitors.
+                      - 'roulette'   : Fitness proportional, with Walker's
+                                       alias method.
+                      - 'sus'        : Stochastic universal sampling
+                                       (fitness proportional, equally
+                                       spaced pointers).
+                      - 'linrank'    : Linear ranking with selection
+                                       pressure 'select_param' in [1, 2]
+                                       (best gets 'select_param' / n).
+                      - 'exprank'    : Exponential ranking, the individual
+                                       with rank r gets 'select_param'^r,
+                                       'select_param' in (0, 1).
+                      - 'truncation' : Uniform among the best
+                                       'select_param' fraction of the pop.
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - '*indexes' : Array with 'n_select' elements for the selected indexes.
+   - 'n_select' : Number of individuals to be selected.
+   - 'select_param' : See '*select_mode'. */
+
+void
+int_set_selection(struct IntPopulation *pop, char *select_mode,
+                  float select_param);
+/* Defines the selection method used by 'int_ga_one_iter' (tournaments
+   with it's 'tournament_size' argument by default). See 'int_selection'
+   for the accepted arguments. */
 
 void
 int_replace_repeated(struct IntPopulation *pop, int **childs,
@@ -266,6 +838,12 @@ int_crossover(char *cross_mode, struct IntPopulation *pop,
                                        equal probability.
                                        '**childs' shape:
                                        [n_parents][pop->length].
+                        - 'union' :    (SUBSET solutions, which only accept
+                                       this one) Shared values are kept and
+                                       the others of both parents are
+                                       randomly split between the childs.
+                                       '**childs' shape:
+                                       [n_parents][pop->length].
    - '*pop' : IntPopulation struct already initialized and evaluated.
    - '**parents' : Pointer of parents (int arrays) with shape:
                    [n_parents][pop->length]
@@ -296,10 +874,12 @@ int_mutation(char *mutate_mode, struct IntPopulation *pop,
    - '*mutate_mode': A string containing the method used for mutation.:
                      - 'swap' : One of its gene gets swapped with another of it's
                                 own  individual. Useful in non-repeatable solutions.
+                                Not for SUBSET solutions.
                      - 'uniform' : For each gene, according to mutate_rate,
                                    it can be randomly replaced with another
                                    possible value for the solution. Can't be
-                                   applied to non-repeatable solutions. For
+                                   applied to NO_REPEAT solutions (SUBSET
+                                   ones get a value out of the set). For
                                    binary-coded solutions (i.e. pop->max_value
                                    =1 and pop->min_value=0) it's the same as
                                    'flip bit' mutation type.
@@ -310,6 +890,542 @@ int_mutation(char *mutate_mode, struct IntPopulation *pop,
               IntPopulation structure.
    - '*mutate_rate' : The probability that a gene will mutate. */
 
+/*==========================*/
+/* Parallel breeding and evaluation. */
+void
+int_set_n_threads(struct IntPopulation *pop, int n_threads);
+/* Defines the number of threads used by 'int_crossover',
+   'int_replace_repeated', 'int_mutation' and 'int_evaluate_population'
+   (1 by default). It only has effect when compiled with OpenMP
+   ('-fopenmp'); with n_threads > 1 the objective function must be
+   thread safe. Childs are bred in pairs, each pair with it's own random
+   stream (derived from 'pop->rng_state'), so the results do not depend
+   on 'n_threads'. */
+
+/*==========================*/
+/* Population resizing. */
+void
+int_resize_population(struct IntPopulation *pop, int new_n_population,
+                      int release_memory);
+/* This function changes the number of individuals of an already
+   evaluated population, keeping all the pop buffers (individuals,
+   fos, rankings, external pointers) consistent.
+   - Shrinking keeps the best 'new_n_population' individuals, which are
+     compacted (by pointer, not copy) to the first rows in ranking order.
+   - Growing fills the new rows with random individuals (see
+     'int_init_solution') evaluated with the last objective function
+     passed to 'int_evaluate_population', reallocating if needed.
+   The ranking ('sorted_fos', 'sorted_fos_indexes', 'best_indexes' and
+   'best_fo') is always valid after the call.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+              Populations with 'unalloc' init_mode can't be resized.
+   - 'new_n_population' : The new number of individuals (>= 2).
+   - 'release_memory' : RELEASE_MEMORY frees the rows and buffers not used
+                        after a shrink, KEEP_MEMORY keeps them alloc'd so a
+                        later growth doesn't need new allocations. */
+
+void
+int_set_resize_schedule(struct IntPopulation *pop, char *resize_mode,
+                        float factor, int min_pop, int max_pop,
+                        int patience, double time_budget,
+                        int release_memory);
+/* This function defines a schedule used by 'int_ga_one_iter' to resize
+   the population (through 'int_resize_population') after each evaluation.
+   When a schedule is active, the 'n_parents' and 'n_childs' arguments of
+   'int_ga_one_iter' refer to 'n_population_orig' and are scaled to the
+   current population size (rounded down to even values).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*resize_mode' : - 'none'        : No resizing (default).
+                      - 'improvement' : Multiply pop size by 'factor' (< 1)
+                                        every time 'best_fo_alltime' gets
+                                        better.
+                      - 'stagnation'  : Multiply pop size by 'factor' (> 1)
+                                        after 'patience' generations
+                                        without improvement.
+                      - 'adaptive'    : Shrink by 'factor' (< 1) on
+                                        improvement and grow by 1/'factor'
+                                        after 'patience' stagnant
+                                        generations.
+                      - 'time'        : Linearly go from n_population_orig
+                                        to 'min_pop' within 'time_budget'
+                                        seconds (counted from this call).
+   - 'factor' : Resize factor (see above).
+   - 'min_pop', 'max_pop' : Boundaries for the population size.
+   - 'patience' : Stagnant generations before growing.
+   - 'time_budget' : Seconds for the 'time' mode.
+   - 'release_memory' : See 'int_resize_population'. */
+
+int
+int_apply_resize_schedule(struct IntPopulation *pop);
+/* Applies the schedule defined by 'int_set_resize_schedule' to an
+   evaluated population. Called automatically by 'int_ga_one_iter'.
+   =RETURNS=
+   - 1 if the population was resized, 0 otherwise. */
+
+/*==========================*/
+/* Memory mapped storage. */
+void
+int_sync_population(struct IntPopulation *pop);
+/* For 'mmap:<path>' populations, writes the current state to the file
+   (blocking until it's on disk), so the run can be restarted with
+   'remap:<path>'. Nothing is done for other populations. */
+
+void
+int_set_fork_evaluator(struct IntPopulation *pop, int n_workers);
+/* This function makes 'int_evaluate_population' evaluate the individuals
+   in 'n_workers' forked processes, for objective functions that are not
+   thread safe (global state, non reentrant libraries) or that may
+   crash. The workers are forked once, here, and evaluate every
+   generation:
+   - The individuals are not copied: the workers read them from the
+     shared mapping of the pop, and write the fos to a shared array.
+   - Each worker claims the next index of a shared queue (atomic compare
+     and swap), so fast and slow evaluations are balanced.
+   - A worker that dies (crash, abort, kill) is restarted and the
+     individual it was evaluating is queued again. If it crashes again
+     after FORK_MAX_RETRIES retries it gets FLT_MAX (the worst fo, as
+     fos are minimized).
+   Workers see the globals of the program as they were when they were
+   forked (here, or when restarted). The objective function must not
+   use OpenMP (the workers are forked). Other single evaluations (local
+   search, stagnation triggers, resizes, cellular and crowding engines)
+   and the batch, block and multi-objective modes are done in the
+   calling process. 'n_fork_restarts' and 'n_fork_failures' keep the
+   statistics. The workers are stopped by 'int_free_population'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct initialized with 'shared' or
+              'mmap:<path>' (or 'remap:<path>') init_mode.
+   - 'n_workers' : Number of worker processes (0 stops them). */
+
+/*==========================*/
+/* Diversity statistics and stagnation. */
+void
+int_set_diversity(struct IntPopulation *pop, char *diversity_mode);
+/* This function enables the per-generation diversity statistics
+   ('diversity_entropy', 'diversity_hamming', 'n_unique_individuals'),
+   computed at the end of each 'int_evaluate_population' call.
+   Inside 'int_ga_one_iter' the statistics are updated incrementally,
+   only for the genes that changed from one generation to the next
+   (O(changed genes) + O(n_population log n_population) per generation).
+   If the individuals are changed outside of it, a full rebuild
+   (O(n_population * length)) is done in the next evaluation.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*diversity_mode' : - 'none'    : No statistics (default).
+                         - 'locus'   : Keeps the per-locus value frequencies,
+                                       giving exact entropy and mean Hamming
+                                       distance. Falls back to 'sampled' if
+                                       length * range > DIVERSITY_MAX_COUNTS.
+                         - 'sampled' : Mean Hamming distance estimated with
+                                       DIVERSITY_N_SAMPLES random pairs, no
+                                       entropy. */
+
+void
+int_update_diversity(struct IntPopulation *pop);
+/* Rebuilds all the diversity statistics from scratch. Useful if the
+   individuals were changed outside the library operators. */
+
+int
+int_locus_frequency(struct IntPopulation *pop, int locus, int value);
+/* Returns how many individuals have 'value' in gene 'locus'
+   ('locus' diversity mode only, -1 otherwise). */
+
+void
+int_set_stagnation(struct IntPopulation *pop, char *stagnation_mode,
+                   int patience, float min_diversity,
+                   float keep_fraction, float rate);
+/* This function defines what 'int_ga_one_iter' does when the population
+   stagnates, i.e., 'best_fo_alltime' did not improve in 'patience'
+   generations or the normalized mean Hamming distance
+   (diversity_hamming / length) is lower than 'min_diversity'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*stagnation_mode' : - 'none'        : Nothing is done (default).
+                          - 'stop'        : 'pop->stop' is set to 1
+                                            ('int_ga_run' returns
+                                            RUN_STAGNATION).
+                          - 'restart'     : Only the best 'keep_fraction' of
+                                            the pop is kept, the rest is
+                                            randomly initialized.
+                          - 'hypermutate' : All but the best 'keep_fraction'
+                                            individuals are mutated with
+                                            'rate'.
+   - 'patience' : Generations without improvement (0 to disable).
+   - 'min_diversity' : Diversity threshold (0.0 to disable). Needs
+                       'int_set_diversity' with 'locus' or 'sampled' mode.
+   - 'keep_fraction' : Fraction of the best individuals kept (at least 1).
+   - 'rate' : Mutation rate for 'hypermutate'. */
+
+/*==========================*/
+/* Duplicate elimination. */
+void
+int_set_dedup(struct IntPopulation *pop, char *dedup_mode, int max_tries);
+/* This function enables duplicate elimination inside 'int_ga_one_iter'.
+   Each child gets a genome hash right after mutation, updated from it's
+   first parent hash only for the genes that changed. Childs that are
+   exact copies of a genome of the next generation (elites or previous
+   childs) are changed before evaluation, and childs equal to any known
+   genome reuse it's fo instead of being evaluated (as the elites).
+   The number of saved evaluations is kept in 'pop->n_evals_saved'.
+   NOTE: Only use it with deterministic objective functions.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*dedup_mode' : - 'none'     : No duplicate elimination (default).
+                     - 'remutate' : Duplicates are mutated again (one forced
+                                    swap/uniform change per try).
+                     - 'reject'   : Duplicates are replaced by a new random
+                                    individual.
+   - 'max_tries' : Max. tries for each duplicate. If it's still a duplicate,
+                   it's kept (reusing the known fo). */
+
+/*==========================*/
+/* Local search (memetic mode). */
+void
+int_set_local_search(struct IntPopulation *pop, char *ls_mode,
+                     char *writeback_mode, int n_top, float fraction,
+                     int budget, float (*delta_function)());
+/* This function enables a local search stage, applied by
+   'int_evaluate_population' (so after each evaluation inside
+   'int_ga_one_iter') to the 'n_top' best individuals and to a random
+   'fraction' of the others, in parallel (see 'int_set_n_threads').
+   Moves swap two genes (non-repeatable solutions) or change the value
+   of one gene (repeatable ones); SUBSET solutions are not supported.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*ls_mode' : - 'none'         : No local search (default).
+                  - 'first'        : Hill climbing with random moves, the
+                                     first improving one is applied.
+                  - 'best'         : Hill climbing applying the best move
+                                     of the whole neighborhood.
+                  - 'minconflicts' : A random gene takes it's best move
+                                     (sideways moves accepted), as in
+                                     min-conflicts for constraint problems.
+   - '*writeback_mode' : - 'lamarckian' : The improved genome replaces the
+                                          individual.
+                         - 'baldwinian' : Only the improved fo is kept
+                                          (learned fitness).
+   - 'n_top' : Number of best individuals searched each generation.
+   - 'fraction' : Probability for each other individual to be searched.
+   - 'budget' : Maximum number of moves evaluated per individual.
+   - '(*delta_function)()' : If not NULL, the fo change of a move with
+                             inputs (int *arr, int length, int gene,
+                             int other), 'other' being the gene swapped
+                             with 'gene' (non-repeatable solutions) or
+                             it's new value (repeatable ones). It must
+                             leave '*arr' unchanged and be exact.
+                             Otherwise, each move is fully evaluated. */
+
+/*==========================*/
+/* Gene-major view and batch evaluation. */
+void
+int_set_batch_objective(struct IntPopulation *pop,
+                        void (*batch_function)());
+/* This function makes 'int_evaluate_population' evaluate the population
+   by blocks of up to GM_BLOCK individuals from a gene-major copy of
+   the individuals ('pop->gm_genes', see IntPopulation), so objective
+   functions can vectorize the same arithmetic across individuals
+   (e.g. 16 ints per AVX-512 instruction). Before each evaluation, only
+   the blocks with individuals to evaluate are transposed (all of them,
+   unless duplicate elimination already knows some fos). The objective
+   function passed to 'int_evaluate_population' is still used for
+   single individuals (local search, restarts, ...) and both must give
+   the same fos.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '(*batch_function)()' : Batch objective with inputs
+                             (int *genes, int stride, int n, int length,
+                             float *fos): gene j of the individual k of
+                             the block is 'genes[j * stride + k]' and
+                             it's fo goes to 'fos[k]', k in [0, n).
+                             'n' is a multiple of GM_LANES (padded with
+                             valid individuals) and 'genes' is 64 bytes
+                             aligned. NULL goes back to single
+                             evaluations. */
+
+void
+int_update_gene_major(struct IntPopulation *pop);
+/* Transposes all the individuals to the gene-major view ('gm_genes'),
+   e.g. to use it outside the evaluation. */
+
+/*==========================*/
+/* Hall of fame. */
+void
+int_set_hall_of_fame(struct IntPopulation *pop, int capacity);
+/* This function defines the capacity of the hall of fame: the
+   'capacity' best distinct genomes found through all iters
+   (HOF_DEFAULT_CAPACITY by default). It's updated by each
+   'int_evaluate_population' with the individuals better than it's worst
+   entry, in O(log capacity) each (plus the genome hash and copy), and
+   genomes already inside it are skipped. 'best_indv_alltime' points to
+   it's entries with 'best_fo_alltime'. It can be called at any time
+   (the best entries are kept); memory mapped populations keep it in
+   the file, so at most 'n_population' entries.
+   NOTE: Only use it with deterministic objective functions (each
+         genome keeps it's first fo). */
+
+int
+int_hall_of_fame(struct IntPopulation *pop, int **genomes, float *fos,
+                 int max_entries);
+/* This function copies the (at most) 'max_entries' best entries of the
+   hall of fame, best first. It can be called at any point of the run
+   (e.g. between generations).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already evaluated.
+   - '**genomes' : Shape [max_entries][pop->length] (or NULL to only
+                   get the fos).
+   - '*fos' : 'max_entries' fos (or NULL).
+   - 'max_entries' : Max. number of entries to copy.
+   =RETURNS=
+   - The number of entries copied. */
+
+/*==========================*/
+/* Cellular GA. */
+void
+int_set_cellular(struct IntPopulation *pop, int n_rows,
+                 char *neighborhood, char *update_mode);
+/* This function places the individuals on a 2D toroidal grid of
+   'n_rows' x (n_population / n_rows) cells, used by
+   'int_cellular_one_iter': each cell only mates with and is replaced by
+   individuals of it's neighborhood, so good genomes spread slowly
+   through the grid (diffusion) instead of taking over the whole
+   population, as with global tournaments.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'n_rows' : Number of rows of the grid, a divisor of 'n_population'
+                (square-ish grids spread genomes the slowest).
+   - '*neighborhood' : - 'vonneumann' : The 4 nearest cells (N, S, W, E).
+                       - 'moore'      : The 8 surrounding cells.
+                       - 'none'       : No grid (default).
+   - '*update_mode' : - 'sync'  : All the cells are bred from the
+                                  current generation and replaced at
+                                  once.
+                      - 'async' : Cells are updated in place, one after
+                                  another (line sweep), so a child
+                                  already mates within the same
+                                  generation. Tiles of CELL_TILE_ROWS
+                                  rows are updated in parallel, in 2
+                                  (or 3) phases of non adjacent tiles,
+                                  so the rows at the border of a tile
+                                  (halo) are never read while they
+                                  are written. */
+
+void
+int_cellular_one_iter(struct IntPopulation *pop,
+                      float (*objective_function)(), int tournament_size,
+                      char *cross_mode, char *mutate_mode,
+                      float mutate_rate);
+/* The purpose of this function is to apply a complete iteration of
+   the cellular GA defined by 'int_set_cellular' to an evaluated
+   population. For each cell:
+   -> The cell is mated with the winner of a tournament among
+      'tournament_size' of it's neighbors (all of them if
+      'tournament_size' >= 4 or 8), with '*cross_mode'.
+   -> The first child is mutated with '*mutate_mode' and 'mutate_rate'
+      and evaluated (the second one is dropped).
+   -> The child replaces the cell if it's fo is not worse.
+   The existing crossover, mutation and repair code is used (see
+   'int_ga_one_iter'), breeding cells in parallel (see
+   'int_set_n_threads') with one random stream per cell ('sync') or
+   per tile ('async'), so results don't depend on the number of threads.
+   After the replacement, the population is ranked as by
+   'int_evaluate_population' (all time best, hall of fame, local search
+   and diversity statistics) and stagnation triggers are applied.
+   Childs are evaluated one by one, duplicate elimination and resize
+   schedules are not applied (the grid keeps it's size).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated,
+              with a grid (see 'int_set_cellular').
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'tournament_size' : Competitors within each neighborhood tournament.
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+
+/*==========================*/
+/* Niching. */
+void
+int_set_niching(struct IntPopulation *pop, char *niche_mode,
+                char *search_mode, float radius, float niche_param);
+/* This function sets a niching method, so the selection (see
+   'int_selection' and 'int_ga_one_iter') keeps several optima instead
+   of converging to one. Individuals closer than 'radius' (Hamming
+   distance) share a niche. After each evaluation, the selection uses
+   the shared (or cleared) fos of 'pop->niche_fos', while 'fos', the
+   ranking, elitism, the all time best and the hall of fame keep the
+   raw ones. The niche counts are updated in all the modes (see
+   'int_update_niches').
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*niche_mode' : - 'sharing'  : Fitness sharing. With the fitness
+                                    f = (worst_fo - fo) (as 'roulette'),
+                                    each individual gets f / m, m being
+                                    1 + the sum of
+                                    1 - (d / radius)^'niche_param'
+                                    over it's neighbors at distance
+                                    d < radius.
+                     - 'clearing' : Clearing. Going from the best fo,
+                                    each individual keeps the best
+                                    'niche_param' (>= 1) of it's
+                                    neighbors (winners) and the rest
+                                    get the worst fo of the pop.
+                     - 'count'    : Only the diagnostics.
+                     - 'none'     : No niching (default).
+   - '*search_mode' : - 'exact' : All the n(n-1)/2 pairs are compared.
+                      - 'lsh'   : Locality sensitive hashing (bit
+                                  sampling): the genes of a few random
+                                  loci are hashed, in NICHE_LSH_TABLES
+                                  tables, and only the individuals of a
+                                  same bucket are compared (a pair at
+                                  distance 'radius' falls in the same
+                                  bucket of a table with probability
+                                  ~0.5, closer pairs more often).
+                                  Members of a large bucket are only
+                                  compared with NICHE_LSH_WINDOW
+                                  others each and stand for the rest
+                                  of the bucket in the niche counts.
+   - 'radius' : Niche radius, as a fraction (0, 1] of the genes.
+   - 'niche_param' : Sharing exponent (> 0, 1 for a triangular sharing
+                     function) or clearing capacity (ignored by
+                     'count'). */
+
+int
+int_hamming_distance(int *arr1, int *arr2, int length, int limit);
+/* Returns the number of genes in which 'arr1' and 'arr2' differ.
+   Genes are compared by blocks of NICHE_HAMMING_BLOCK (one branchless
+   SIMD loop each, with OpenMP) and the count stops after the first
+   block with more than 'limit' differences (pass 'length' for the
+   exact distance). */
+
+void
+int_update_niches(struct IntPopulation *pop);
+/* This function finds the close pairs of an evaluated population with
+   the search of 'int_set_niching' and defines 'pop->niche_counts',
+   'pop->n_niches', 'pop->n_niche_distances' and (with 'sharing' or
+   'clearing') 'pop->niche_fos' and 'pop->niche_order'. It's called by
+   'int_evaluate_population' when a niching mode is set. */
+
+void
+int_crowding_one_iter(struct IntPopulation *pop,
+                      float (*objective_function)(), char *cross_mode,
+                      char *mutate_mode, float mutate_rate);
+/* The purpose of this function is to apply a complete iteration of
+   deterministic crowding to an evaluated population:
+   -> The individuals are paired at random (an odd one is kept) and
+      each pair is crossed with '*cross_mode'.
+   -> The childs are mutated with '*mutate_mode' and 'mutate_rate' and
+      evaluated.
+   -> Each child competes with the most similar parent (the pairing of
+      childs and parents with the least total Hamming distance) and
+      replaces it if it's fo is not worse.
+   As childs only replace similar parents, different optima survive
+   without a niche radius. Pairs are bred in parallel (see
+   'int_set_n_threads') with one random stream each, so results don't
+   depend on the number of threads. After the replacement, the
+   population is ranked as by 'int_evaluate_population' and stagnation
+   triggers are applied. Duplicate elimination and resize schedules
+   are not applied.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated.
+   - '(*objective_function)()' : pointer to the objective function (fo).
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+
+/*==========================*/
+/* Multi-objective GA (NSGA-II). */
+void
+int_set_multi_objective(struct IntPopulation *pop, int n_objectives,
+                        void (*mo_function)(), int archive_capacity);
+/* This function makes the population multi-objective: each individual
+   gets a vector of 'n_objectives' objectives (all minimized), computed
+   by 'int_evaluate_population' (which then ignores it's objective
+   function) and ranked by non dominated fronts and crowding distances
+   (see 'int_nondominated_sort'). 'fos' holds the front of each
+   individual (0 = non dominated), so 'best_indexes' are the individuals
+   of the first front. The all time best and hall of fame are not used:
+   the non dominated genomes found through all iters are kept in a
+   bounded Pareto archive (see 'int_pareto_front'), and
+   'n_stagnant_gens' counts the generations without changes in it.
+   Generations are run with 'int_nsga2_one_iter'.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'n_objectives' : Number of objectives, in [2, MO_MAX_OBJECTIVES].
+   - '(*mo_function)()' : Objective function with inputs (int *arr,
+                          int length, float *objs), writing the
+                          'n_objectives' objectives of 'arr' to 'objs'.
+                          It's called from several threads (see
+                          'int_set_n_threads').
+   - 'archive_capacity' : Max. number of genomes in the Pareto archive
+                          (the least crowded are kept). */
+
+void
+int_nsga2_one_iter(struct IntPopulation *pop, int tournament_size,
+                   char *cross_mode, char *mutate_mode, float mutate_rate);
+/* The purpose of this function is to apply a complete NSGA-II
+   generation to an evaluated multi-objective population:
+   -> 'n_population' parents are selected by tournaments of
+      'tournament_size' competitors, the best being the one with the
+      lowest front and then the largest crowding distance.
+   -> 'n_population' childs are bred with '*cross_mode', '*mutate_mode'
+      and 'mutate_rate' (same fused breeding as 'int_ga_one_iter') and
+      evaluated.
+   -> Parents and childs are ranked together and the next generation
+      takes whole fronts, best first, and the least crowded individuals
+      of the last front that fits.
+   -> The Pareto archive is updated with the first front.
+   Resize schedules, local search, duplicate elimination and stagnation
+   triggers are not applied.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized AND evaluated,
+              with 'int_set_multi_objective'.
+   - 'tournament_size' : How many competitors within each tournament.
+   - 'cross_mode' : See 'int_crossover' function for details on accepted modes.
+   - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
+   - 'mutate_rate' : probability of one gene to suffer mutation. */
+
+int
+int_pareto_front(struct IntPopulation *pop, int **genomes, float *objs,
+                 int max_entries);
+/* This function copies the (at most) 'max_entries' genomes of the
+   Pareto archive, sorted by their first objective.
+   =ARGUMENTS=
+   - '*pop' : A multi-objective IntPopulation struct already evaluated.
+   - '**genomes' : Shape [max_entries][pop->length] (or NULL to only
+                   get the objectives).
+   - '*objs' : Shape [max_entries][n_objectives] (or NULL).
+   - 'max_entries' : Max. number of entries to copy.
+   =RETURNS=
+   - The number of entries copied. */
+
+int
+int_nondominated_sort(float *objs, int stride, int n, int n_objectives,
+                      int *rank);
+/* This function sorts 'n' points into non dominated fronts (all the
+   objectives minimized): 'rank[i]' is the front of point i, whose
+   objective m is 'objs[m * stride + i]'. Points are swept in
+   lexicographic order, so a point can only be dominated by previous
+   ones, and it's front is found by a binary search over the fronts
+   already built (a point dominated by front k is dominated by all the
+   fronts before it). The domination by a front is checked in O(1) for
+   2 objectives (O(n log n) overall), with a staircase of the 2nd and
+   3rd objectives of the front for 3 (O(log n)) and by scanning the
+   front for more.
+   =RETURNS=
+   - The number of fronts. */
+
+void
+int_crowding_distance(float *objs, int stride, int *members,
+                      int n_members, int n_objectives, float *crowding);
+/* This function defines 'crowding[members[k]]' as the crowding distance
+   of the point 'members[k]' inside it's front ('members', with
+   'n_members' points): the sum over the objectives of the normalized
+   distance between it's neighbors along that objective (INFINITY for
+   the boundary points). */
+
+/*==========================*/
+/* Out-of-the-box GA iteration. */
 void
 int_ga_one_iter(struct IntPopulation *pop,
                 float (*objective_function)(), int tournament_size,
@@ -319,14 +1435,30 @@ int_ga_one_iter(struct IntPopulation *pop,
    of the GA algorithm. This means:
    -> Apply crossover using '*cross_mode' with 'n_parents' to
       'n_childs'. Parents are defined after 'n_parents' tournaments
-      with 'tournament_size' competitors.
+      with 'tournament_size' competitors (or with the method defined
+      by 'int_set_selection').
    -> Apply mutation to the childs with '*mutate_mode' and
       'mutate_rate'.
+   -> If a surrogate is set (see 'int_set_surrogate'), only the best
+      predicted childs out of several batches are kept.
    -> If n_childs < n_population, the rest of the individuals of the
       next generation will be selected by elitism.
    -> After having a full population, evaluate it.
-   The parents, childs and future individuals used in this function are
-   the external pointers 'ext_parents', 'ext_childs', 'ext_new_individuals'.
+   -> If duplicate elimination is set (see 'int_set_dedup'), duplicated
+      childs are changed and known genomes (e.g. elites) are not
+      evaluated again.
+   -> If a local search is set (see 'int_set_local_search'), it's
+      applied within the evaluation.
+   -> If a resize schedule is set (see 'int_set_resize_schedule'),
+      apply it.
+   -> If a stagnation trigger is set (see 'int_set_stagnation'),
+      check and apply it ('mutate_mode' is used for hypermutation).
+   Childs are bred straight into 'ext_new_individuals' (crossover,
+   mutation and repair in a single pass, parents read in place) and
+   their rows are swapped into the pop. The external pointers
+   'ext_parents' and 'ext_childs' are only used if n_childs > n_parents,
+   for 'unalloc' pops, with 'locus' diversity statistics or a
+   surrogate.
    =ARGUMENTS=
    - '*pop' : pointer to alread initialized IntPopulation struct.
    - '(*objective_function)()' : pointer to the objective function (fo)'.
@@ -337,4 +1469,259 @@ int_ga_one_iter(struct IntPopulation *pop,
    - 'mutate_mode' : See 'int_mutation' function for details on accepted modes.
    - 'mutate_rate' : probability of one gene to suffer mutation. */
 
+/*==========================*/
+/* Anytime run driver. */
+void
+int_set_run_limits(struct IntPopulation *pop, int max_iter,
+                   double max_seconds, long max_evaluations,
+                   int max_stagnant_gens);
+/* This function sets the budgets of 'int_ga_run' (0 for no limit).
+   Time and evaluation budgets are never exceeded on purpose: a
+   generation is not started if it would end after them, taking the
+   last generation as estimate.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'max_iter' : Max. number of generations.
+   - 'max_seconds' : Max. wall time (evaluation of the first population
+                     included).
+   - 'max_evaluations' : Max. number of objective function calls.
+   - 'max_stagnant_gens' : Max. generations without improving the all
+                           time best (see 'pop->n_stagnant_gens'). */
+
+void
+int_set_run_target(struct IntPopulation *pop, float target_fo);
+/* This function makes 'int_ga_run' stop as soon as 'best_fo_alltime'
+   <= 'target_fo' (e.g. 0 attacks for the N queens problem). */
+
+void
+int_set_run_callback(struct IntPopulation *pop, int (*callback)(),
+                     void *data, int every);
+/* This function sets a callback, called by 'int_ga_run' every 'every'
+   generations (1 for all of them) with inputs
+   (struct IntPopulation *pop, void *data), e.g. to print or log the
+   progress. The run stops if it returns != 0. A NULL 'callback'
+   removes it. */
+
+int
+int_ga_run(struct IntPopulation *pop, float (*objective_function)(),
+           int tournament_size, char *cross_mode, int n_parents,
+           int n_childs, char *mutate_mode, float mutate_rate);
+/* The purpose of this function is to run the GA until one of the
+   limits of 'int_set_run_limits' or 'int_set_run_target' is reached,
+   the stagnation trigger of 'int_set_stagnation' in 'stop' mode sets
+   'pop->stop', the callback asks to stop or another thread calls
+   'int_stop_run'.
+   The population is evaluated first (if it's not yet) and then
+   'int_ga_one_iter' is called with the same arguments in a loop. Each
+   time the all time best improves, it's published with
+   'int_publish_best', so other threads can read it with
+   'int_read_best' at any moment (anytime algorithm). 'pop->run_generation'
+   and 'pop->run_seconds' keep the generations and time of the run.
+   Without any limit, target or callback the run only stops with
+   'int_stop_run'.
+   =ARGUMENTS=
+   Same as 'int_ga_one_iter'.
+   =RETURNS=
+   - The stop reason (RUN_MAX_ITER, RUN_MAX_TIME, RUN_MAX_EVALS,
+     RUN_TARGET, RUN_STAGNATION, RUN_CALLBACK or RUN_STOPPED), also kept
+     in 'pop->run_reason'. RUN_STAGNATION is returned both for
+     'max_stagnant_gens' and for 'pop->stop' ('stop' stagnation mode),
+     which is cleared when the run starts. */
+
+void
+int_stop_run(struct IntPopulation *pop);
+/* This function asks 'int_ga_run' to stop after the current generation
+   (RUN_STOPPED). It can be called from any thread or a signal handler.
+   A request made before the run starts stops it before the first
+   generation. */
+
+void
+int_publish_best(struct IntPopulation *pop);
+/* This function copies the all time best genome (see
+   'best_indv_alltime') of an evaluated population to the snapshot
+   read by 'int_read_best'. It's called by 'int_ga_run', hand made
+   loops can call it after each generation. Only one thread (the one
+   running the GA) may publish. */
+
+long
+int_read_best(struct IntPopulation *pop, int *arr, float *fo);
+/* This function copies the last published best genome to 'arr'
+   ('pop->length' genes, or NULL) and it's fo to '*fo' (or NULL)
+   without locks: it can be called from any thread while the GA runs
+   (a seqlock, the copy is retried if it overlaps a publication, and
+   the GA never waits for readers). The pop must not be free'd while
+   it's read.
+   =RETURNS=
+   - The generation of the run in which it was published (0 for the
+     first population), or -1 if nothing was published yet. */
+
+/*==========================*/
+/* Genome sharing (copy-on-write). */
+void
+int_set_genome_sharing(struct IntPopulation *pop, char *sharing_mode);
+/* This function makes identical individuals share one row of genes
+   (reference counted) instead of keeping a private copy each, which
+   saves memory and copies in converged populations of long genomes:
+   - After each evaluation, individuals with the same genome (hash and
+     gene by gene comparison) are pointed to the same row and the
+     duplicated rows are free'd.
+   - Childs of two parents with the same row and no mutation are stored
+     as a reference to it (no genes written, no row needed), the others
+     are bred as usual. With mutation, identical parents are only copied
+     and mutated (crossover is the identity for them).
+   - A shared row is copied the first time it's written (local search,
+     stagnation triggers, duplicate elimination, resizes).
+   Genome hashes are kept (as with 'int_set_dedup'). Rows of
+   pop->individuals may be shared: user code writing an individual in
+   place MUST call 'int_own_row' first. Between generations of
+   'int_ga_one_iter' the 'ext_new_individuals' rows of the childs are
+   not kept (NULL). 'n_cow_shared',
+   'n_cow_copies' and 'n_cow_clones' keep the statistics. Freed rows of
+   long genomes are only returned to the system if the allocator maps
+   them on their own (e.g. mallopt(M_MMAP_THRESHOLD, ...), see
+   examples/scaling).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized, with library
+              alloc'd rows on the heap (not 'unalloc' nor mapped).
+   - '*sharing_mode' : - 'none' : Private rows (default), shared rows
+                                  are copied back.
+                       - 'cow'  : Shared rows, copied on write.
+   Multi-objective populations never share rows. */
+
+int
+*int_own_row(struct IntPopulation *pop, int i);
+/* This function makes the row of individual 'i' private (copied if
+   it's shared, see 'int_set_genome_sharing') before writing it.
+   =RETURNS=
+   - The row, 'pop->individuals[i]'. */
+
+/*==========================*/
+/* Decomposable objective. */
+void
+int_set_block_objective(struct IntPopulation *pop, int block_size,
+                        float (*block_function)());
+/* This function declares the objective as a sum of independent terms
+   over blocks of 'block_size' consecutive genes (the last block may be
+   shorter). 'int_evaluate_population' keeps the score of each block of
+   each individual and only evaluates the blocks that changed:
+   - Childs bred by 'int_ga_one_iter' (fused breeding) take the scores
+     of their blocks equal to the same block of one of their parents
+     (e.g. the blocks between two crossover points without mutated or
+     repaired genes), elites keep all of them.
+   - The other engines and paths ('int_cellular_one_iter',
+     'int_crowding_one_iter', non-fused breeding, user operators)
+     evaluate all the blocks.
+   The fo is the float sum of the block scores, in block order. The
+   objective function passed to 'int_evaluate_population' is still used
+   for single individuals (local search, stagnation triggers, resizes)
+   and both must give the same fos. A batch objective (see
+   'int_set_batch_objective') is not used while blocks are set, nor
+   are blocks in the multi-objective mode. User code changing the genes
+   of an evaluated individual in place MUST call 'int_block_invalidate'.
+   'n_block_evaluations' and 'n_blocks_reused' keep the statistics.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - 'block_size' : Number of genes per block, in [1, length].
+   - '(*block_function)()' : Score of one block, with inputs
+                             (int *arr, int length, int first, int last):
+                             the block has the genes [first, last) of
+                             '*arr' (block number first / block_size)
+                             and it's score can only depend on them.
+                             NULL goes back to full evaluations. */
+
+void
+int_block_invalidate(struct IntPopulation *pop, int i);
+/* This function marks all the blocks of individual 'i' to be evaluated
+   again (see 'int_set_block_objective'), after it's genes are changed
+   in place. */
+
+/*==========================*/
+/* External process evaluator. */
+void
+int_set_process_evaluator(struct IntPopulation *pop, char *command,
+                          char *protocol, int n_processes, int batch_size,
+                          double timeout, float penalty);
+/* This function makes 'int_evaluate_population' send the individuals
+   to 'n_processes' long-lived copies of an external program (e.g. a
+   simulator) instead of calling the objective function, so a program
+   is started once instead of once per evaluation. Each process is
+   'command' run by /bin/sh, with it's stdin and stdout connected to
+   the library: it reads one individual at a time from stdin and
+   writes it's fo to stdout (flushing it), until stdin is closed.
+   - Up to 'batch_size' individuals are sent to a process before it's
+     first reply, so it never waits for the next one. The replies are
+     in the order of the requests.
+   - A process that takes longer than 'timeout' seconds for an
+     individual is killed, as is a process that exits, closes stdout or
+     writes a malformed (or NaN) reply. The individual it was
+     evaluating gets the 'penalty' fo, the other ones sent to it are
+     sent again, and the process is started again.
+   Messages of the program must go to stderr (stdout is the protocol).
+   Other single evaluations (local search, stagnation triggers,
+   resizes, cellular and crowding engines) and the batch, block and
+   multi-objective modes use the objective function, in the calling
+   process; the fork evaluator (see 'int_set_fork_evaluator') is not
+   used while the processes are set. 'n_proc_failures',
+   'n_proc_timeouts' and 'n_proc_respawns' keep the statistics. The
+   processes are stopped by 'int_free_population' (stdin is closed,
+   they are killed if they are still alive after 'timeout' seconds).
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*command' : Shell command of the program.
+   - '*protocol' : - 'text'   : An individual is a line with it's
+                                'length' genes in decimal, separated by
+                                spaces. The reply is a line with the fo
+                                (as read by strtof).
+                   - 'binary' : An individual is 'length' native ints
+                                (4 bytes each). The reply is a native
+                                float (4 bytes).
+   - 'n_processes' : Number of processes (0 stops them).
+   - 'batch_size' : Individuals in flight per process (>= 1).
+   - 'timeout' : Seconds allowed per evaluation (> 0).
+   - 'penalty' : Fo of the individuals whose evaluation failed (e.g.
+                 FLT_MAX, as fos are minimized). */
+
+/*==========================*/
+/* Surrogate pre-screening. */
+void
+int_set_surrogate(struct IntPopulation *pop, char *surrogate_mode,
+                  int factor, int archive_size, int retrain_every,
+                  int n_neighbors);
+/* This function sets a surrogate model of the objective function for
+   'int_ga_one_iter', for objectives that cost much more than a
+   prediction. The model learns from the last 'archive_size' (genome,
+   fo) pairs evaluated by 'int_evaluate_population' (skipped, penalized
+   and non finite fos are left out). Once the archive holds a
+   population worth of samples (or is full), 'int_ga_one_iter' breeds
+   'factor'
+   batches of childs (each one from it's own selection), predicts
+   their fo and keeps the 'n_childs' best predicted ones (distinct
+   ones first), so the objective function only sees those.
+   The predictions of the kept childs are compared with their fo:
+   'surr_rank_corr' (Spearman, 1 is a perfect ranking) and 'surr_mae'
+   (mean absolute error) for the last generation. 'n_surr_predictions'
+   and 'n_surr_rejected' count the candidates predicted and the ones
+   never evaluated. Childs are bred apart from their slots (as with
+   n_childs > n_parents). Not used with multi-objective pops.
+   =ARGUMENTS=
+   - '*pop' : A IntPopulation struct already initialized.
+   - '*surrogate_mode' : - 'none'   : No surrogate (default).
+                         - 'linear' : Sum of a weight per (locus, value)
+                                      plus a bias, fitted by passes of
+                                      normalized least mean squares over
+                                      the archive (length * range must
+                                      be <= SURR_MAX_WEIGHTS).
+                         - 'knn'    : Mean fo of the 'n_neighbors'
+                                      archived genomes at the smallest
+                                      Hamming distance, weighted by
+                                      1 / (1 + distance). It reads the
+                                      archive at each prediction (no
+                                      fit), O(archive_size * length).
+   - 'factor' : Candidates bred per child (>= 1, 1 only measures the
+                accuracy).
+   - 'archive_size' : Max. samples kept (>= 1).
+   - 'retrain_every' : Generations between fits of the 'linear' model
+                       (>= 1).
+   - 'n_neighbors' : For 'knn', in [1, SURR_MAX_NEIGHBORS]. */
+
 #endif /* GA_INT_H */
@@ -0,0 +1,451 @@
+/* This header defines a compile time specialized variant of the
+   'int_ga_one_iter' loop of GA_int (header only, no source file).
+
+   Where GA_int is generic at runtime ('int' genes, 'pop->length' loop
+   bounds and mode strings checked inside the operators), here the gene
+   type, the genome length, the solution boundaries and the operators are
+   fixed when the engine is instantiated, so the compiler can unroll and
+   vectorize the loops. A 200 queens genome with 'uint8_t' genes takes
+   200 bytes instead of 800.
+
+   An engine is instantiated (once per translation unit) with:
+
+   GA_INT_STATIC(NAME, GENE_T, LENGTH, MIN_VALUE, MAX_VALUE,
+                 NON_REPEATABLE, CROSS_CODE, MUTATE_CODE)
+
+   - 'NAME' : Prefix of the generated struct and functions.
+   - 'GENE_T' : Gene type (e.g. uint8_t, uint16_t, int32_t), must hold
+                every value in [MIN_VALUE, MAX_VALUE].
+   - 'LENGTH' : Genome length (compile time constant).
+   - 'MIN_VALUE', 'MAX_VALUE' : Solution boundaries.
+   - 'NON_REPEATABLE' : NO_REPEAT or REPEATABLE (see GA_int.h, SUBSET
+                        is not supported).
+   - 'CROSS_CODE' : CROSS_1KPOINT, CROSS_2KPOINTS or CROSS_UNIFORM.
+   - 'MUTATE_CODE' : MUTATE_SWAP or MUTATE_UNIFORM (REPEATABLE only).
+
+   Which generates:
+   - 'struct NAME_population'
+   - 'NAME_init_population(n_population, seed)'
+   - 'NAME_evaluate_population(pop, objective_function)'
+   - 'NAME_ga_one_iter(pop, objective_function, tournament_size,
+                       n_childs, mutate_rate)'
+   - 'NAME_free_population(pop)'
+   The objective function has the form:
+   float objective_function(const GENE_T *genes)
+   Each generation follows 'int_ga_one_iter': tournaments (with
+   replacement), fused crossover + mutation (+ repair) of each pair
+   straight into the next generation and elitism for the remaining
+   'n_population' - 'n_childs' individuals (not evaluated again). */
+
+#ifndef GA_INT_STATIC_H
+#define GA_INT_STATIC_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Same codes as GA_int.h (so both headers can be included). */
+#ifndef NO_REPEAT
+#define NO_REPEAT 1
+#define REPEATABLE 0
+#endif
+#ifndef SUBSET
+#define SUBSET 2
+#endif
+#ifndef CROSS_1KPOINT
+#define CROSS_1KPOINT 0
+#define CROSS_2KPOINTS 1
+#define CROSS_UNIFORM 2
+#define MUTATE_SWAP 0
+#define MUTATE_UNIFORM 1
+#endif
+
+/*==========================*/
+/* Random stream (splitmix64, as 'rng_next' from generals). */
+static inline uint64_t
+ga_static_rng_next(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t
+ga_static_rng_bounded(uint64_t *state, uint32_t n)
+{
+/* Random int in [0, n) (Lemire's multiply and shift). */
+    return (uint32_t) (((ga_static_rng_next(state) >> 32) * (uint64_t) n)
+                       >> 32);
+}
+
+static inline uint64_t
+ga_static_threshold(float probability)
+{
+/* 'rng_next(state) < threshold' happens with 'probability'. */
+    if (probability <= 0.0f)
+        return 0;
+    if (probability >= 1.0f)
+        return UINT64_MAX;
+    return (uint64_t) ((double) probability * 18446744073709551616.0);
+}
+
+/*==========================*/
+/* The engine template. */
+#define GA_INT_STATIC(NAME, GENE_T, LENGTH, MIN_VALUE, MAX_VALUE,         \
+                      NON_REPEATABLE, CROSS_CODE, MUTATE_CODE)            \
+                                                                          \
+enum { NAME##_range = (MAX_VALUE) - (MIN_VALUE) + 1 };                    \
+_Static_assert(NON_REPEATABLE != NO_REPEAT ||                             \
+               MUTATE_CODE != MUTATE_UNIFORM,                             \
+               "uniform mutation needs REPEATABLE solutions");            \
+_Static_assert(NON_REPEATABLE != SUBSET,                                  \
+               "SUBSET solutions are not supported");                     \
+                                                                          \
+struct NAME##_rank                                                        \
+{                                                                         \
+    float fo;                                                             \
+    int index;                                                            \
+};                                                                        \
+                                                                          \
+struct NAME##_population                                                  \
+{                                                                         \
+/* - 'individuals', 'new_individuals' : Generations k and k + 1, with     \
+     'n_population' + 1 contiguous rows (the last one is spare).          \
+   - 'ranks' : (fo, index) sorted by fo after each evaluation.            \
+   - 'repeated', 'swaps', 'marks', 'values' : breeding scratch            \
+     ('marks' are kept to 0 after use). */                                \
+    int n_population, generation;                                         \
+    GENE_T (*individuals)[LENGTH];                                        \
+    GENE_T (*new_individuals)[LENGTH];                                    \
+    float *fos, *new_fos;                                                 \
+    struct NAME##_rank *ranks;                                            \
+    float best_fo, best_fo_alltime;                                       \
+    GENE_T best_indv_alltime[LENGTH];                                     \
+    uint64_t rng_state;                                                   \
+    int repeated[2][LENGTH], swaps[2][LENGTH];                            \
+    unsigned char marks[2][(NON_REPEATABLE == NO_REPEAT) ?                \
+                           NAME##_range : 1];                             \
+    GENE_T values[NAME##_range];                                          \
+};                                                                        \
+                                                                          \
+static int                                                                \
+NAME##_compare_ranks(const void *a, const void *b)                        \
+{                                                                         \
+    const struct NAME##_rank *ra = a, *rb = b;                            \
+                                                                          \
+    if (ra->fo < rb->fo)                                                  \
+        return -1;                                                        \
+    if (ra->fo > rb->fo)                                                  \
+        return 1;                                                         \
+    return ra->index - rb->index;                                         \
+}                                                                         \
+                                                                          \
+static void                                                               \
+*NAME##_alloc_rows(int n_rows)                                            \
+{                                                                         \
+/* Cache line aligned rows (size rounded for aligned_alloc). */           \
+    size_t size = (size_t) n_rows * sizeof(GENE_T) * (LENGTH);            \
+    void *rows = aligned_alloc(64, (size + 63) / 64 * 64);                \
+                                                                          \
+    if (rows == NULL)                                                     \
+    {                                                                     \
+        fprintf(stderr, "NULL Value returned in line %d of file "         \
+                "\"%s\"!\n", __LINE__, __FILE__);                         \
+        exit(EXIT_FAILURE);                                               \
+    }                                                                     \
+    return rows;                                                          \
+}                                                                         \
+                                                                          \
+static struct NAME##_population                                           \
+*NAME##_init_population(int n_population, uint64_t seed)                  \
+{                                                                         \
+/* Returns a random population of 'n_population' individuals (a random    \
+   permutation prefix of [MIN_VALUE, MAX_VALUE] for NO_REPEAT). It must   \
+   be evaluated before 'NAME_ga_one_iter'. */                             \
+    int i, j, k;                                                          \
+    GENE_T tmp, *values;                                                  \
+    struct NAME##_population *pop;                                        \
+                                                                          \
+    pop = calloc(1, sizeof(struct NAME##_population));                    \
+    if (pop == NULL || n_population < 2 || (NON_REPEATABLE == NO_REPEAT   \
+                                            && NAME##_range < (LENGTH)))  \
+    {                                                                     \
+        fprintf(stderr, "===ARGUMENT ERROR===\n"                          \
+                "'" #NAME "_init_population' needs n_population >= 2\n"   \
+                "(and range >= LENGTH for NO_REPEAT).\n"                  \
+                "====================\n");                                \
+        exit(EXIT_FAILURE);                                               \
+    }                                                                     \
+    pop->n_population = n_population;                                     \
+    pop->rng_state = seed;                                                \
+    pop->individuals = NAME##_alloc_rows(n_population + 1);               \
+    pop->new_individuals = NAME##_alloc_rows(n_population + 1);           \
+    pop->fos = malloc(n_population * sizeof(float));                      \
+    pop->new_fos = malloc(n_population * sizeof(float));                  \
+    pop->ranks = malloc(n_population * sizeof(struct NAME##_rank));       \
+    if (pop->fos == NULL || pop->new_fos == NULL || pop->ranks == NULL)   \
+    {                                                                     \
+        fprintf(stderr, "NULL Value returned in line %d of file "         \
+                "\"%s\"!\n", __LINE__, __FILE__);                         \
+        exit(EXIT_FAILURE);                                               \
+    }                                                                     \
+    values = pop->values;                                                 \
+    for (j = 0; j < NAME##_range; j++)                                    \
+    {                                                                     \
+        values[j] = (GENE_T) ((MIN_VALUE) + j);                           \
+    }                                                                     \
+    for (i = 0; i < n_population; i++)                                    \
+    {                                                                     \
+        for (j = 0; j < (LENGTH); j++)                                    \
+        {                                                                 \
+            if (NON_REPEATABLE == NO_REPEAT)                              \
+            {                                                             \
+                /* Partial Fisher-Yates over the values. */               \
+                k = j + (int) ga_static_rng_bounded(&pop->rng_state,      \
+                                    (uint32_t) (NAME##_range - j));       \
+                tmp = values[k];                                          \
+                values[k] = values[j];                                    \
+                values[j] = tmp;                                          \
+                pop->individuals[i][j] = tmp;                             \
+            }                                                             \
+            else                                                          \
+                pop->individuals[i][j] = (GENE_T) ((MIN_VALUE) +          \
+                    (int) ga_static_rng_bounded(&pop->rng_state,          \
+                                                NAME##_range));           \
+        }                                                                 \
+    }                                                                     \
+    return pop;                                                           \
+}                                                                         \
+                                                                          \
+static void                                                               \
+NAME##_rank_population(struct NAME##_population *pop)                     \
+{                                                                         \
+/* Sorts the (fo, index) pairs and updates the best fos. */               \
+    int i;                                                                \
+                                                                          \
+    for (i = 0; i < pop->n_population; i++)                               \
+    {                                                                     \
+        pop->ranks[i].fo = pop->fos[i];                                   \
+        pop->ranks[i].index = i;                                          \
+    }                                                                     \
+    qsort(pop->ranks, pop->n_population, sizeof(struct NAME##_rank),      \
+          NAME##_compare_ranks);                                          \
+    pop->best_fo = pop->ranks[0].fo;                                      \
+    if (pop->generation == 0 || pop->best_fo < pop->best_fo_alltime)      \
+    {                                                                     \
+        pop->best_fo_alltime = pop->best_fo;                              \
+        memcpy(pop->best_indv_alltime,                                    \
+               pop->individuals[pop->ranks[0].index],                     \
+               sizeof(GENE_T) * (LENGTH));                                \
+    }                                                                     \
+}                                                                         \
+                                                                          \
+static void                                                               \
+NAME##_evaluate_population(struct NAME##_population *pop,                 \
+                           float (*objective_function)(const GENE_T *))   \
+{                                                                         \
+/* Evaluates (and ranks) the whole population. */                         \
+    int i;                                                                \
+                                                                          \
+    for (i = 0; i < pop->n_population; i++)                               \
+    {                                                                     \
+        pop->fos[i] = objective_function(pop->individuals[i]);            \
+    }                                                                     \
+    NAME##_rank_population(pop);                                          \
+}                                                                         \
+                                                                          \
+static inline int                                                         \
+NAME##_tournament(struct NAME##_population *pop, int tournament_size)     \
+{                                                                         \
+/* Index of the best of 'tournament_size' random competitors. */          \
+    int t, candidate, winner;                                             \
+                                                                          \
+    winner = (int) ga_static_rng_bounded(&pop->rng_state,                 \
+                                         (uint32_t) pop->n_population);   \
+    for (t = 1; t < tournament_size; t++)                                 \
+    {                                                                     \
+        candidate = (int) ga_static_rng_bounded(&pop->rng_state,          \
+                                        (uint32_t) pop->n_population);    \
+        if (pop->fos[candidate] <= pop->fos[winner])                      \
+            winner = candidate;                                           \
+    }                                                                     \
+    return winner;                                                        \
+}                                                                         \
+                                                                          \
+static inline void                                                        \
+NAME##_breed_pair(struct NAME##_population *pop,                          \
+                  const GENE_T *restrict parent1,                         \
+                  const GENE_T *restrict parent2,                         \
+                  GENE_T *restrict child1, GENE_T *restrict child2,       \
+                  uint64_t mutate_threshold)                              \
+{                                                                         \
+/* Fused crossover, mutation and repair of one pair (the same steps as    \
+   'int_breed_pair' from GA_int.c, with the operators fixed). */          \
+    int c, j, k, m, k1 = 0, k2 = 0, n_missing;                            \
+    int n_repeated[2] = {0, 0}, n_swaps[2] = {0, 0};                      \
+    int (*repeated)[LENGTH] = pop->repeated;                              \
+    int (*swaps)[LENGTH] = pop->swaps;                                    \
+    GENE_T value, tmp, *missing = pop->values;                            \
+    GENE_T *childs[2];                                                    \
+    uint64_t bits = 0;                                                    \
+                                                                          \
+    childs[0] = child1;                                                   \
+    childs[1] = child2;                                                   \
+    if (CROSS_CODE == CROSS_1KPOINT)                                      \
+        k2 = 1 + (int) ga_static_rng_bounded(&pop->rng_state,             \
+                                             (LENGTH) - 1);               \
+    else if (CROSS_CODE == CROSS_2KPOINTS)                                \
+    {                                                                     \
+        k1 = (int) ga_static_rng_bounded(&pop->rng_state, (LENGTH) + 1);  \
+        k2 = (int) ga_static_rng_bounded(&pop->rng_state, (LENGTH));      \
+        if (k2 >= k1)                                                     \
+            k2++;                                                         \
+        else                                                              \
+        {                                                                 \
+            m = k1;                                                       \
+            k1 = k2;                                                      \
+            k2 = m;                                                       \
+        }                                                                 \
+    }                                                                     \
+                                                                          \
+    /* Crossover: straight copies, exchanged inside [k1, k2) (or by a     \
+       random bit per gene for 'uniform'). */                             \
+    for (j = 0; j < (LENGTH); j++)                                        \
+    {                                                                     \
+        if (CROSS_CODE == CROSS_UNIFORM)                                  \
+        {                                                                 \
+            if ((j & 63) == 0)                                            \
+                bits = ga_static_rng_next(&pop->rng_state);               \
+            m = (int) ((bits >> (j & 63)) & 1);                           \
+        }                                                                 \
+        else                                                              \
+            m = (j >= k1 && j < k2);                                      \
+        child1[j] = m ? parent2[j] : parent1[j];                          \
+        child2[j] = m ? parent1[j] : parent2[j];                          \
+    }                                                                     \
+                                                                          \
+    for (c = 0; c < 2; c++)                                               \
+    {                                                                     \
+        /* Mutation draws and repeated values. */                         \
+        for (j = 0; j < (LENGTH); j++)                                    \
+        {                                                                 \
+            if (ga_static_rng_next(&pop->rng_state) < mutate_threshold)   \
+            {                                                             \
+                if (MUTATE_CODE == MUTATE_SWAP)                           \
+                    swaps[c][n_swaps[c]++] = j;                           \
+                else                                                      \
+                {                                                         \
+                    value = (GENE_T) ((MIN_VALUE) +                       \
+                        (int) ga_static_rng_bounded(&pop->rng_state,      \
+                                                    NAME##_range - 1));   \
+                    if (value >= childs[c][j])                            \
+                        value++;                                          \
+                    childs[c][j] = value;                                 \
+                }                                                         \
+            }                                                             \
+            if (NON_REPEATABLE == NO_REPEAT)                              \
+            {                                                             \
+                k = childs[c][j] - (MIN_VALUE);                           \
+                if (pop->marks[c][k])                                     \
+                    repeated[c][n_repeated[c]++] = j;                     \
+                else                                                      \
+                    pop->marks[c][k] = 1;                                 \
+            }                                                             \
+        }                                                                 \
+        if (NON_REPEATABLE == NO_REPEAT && n_repeated[c] > 0)             \
+        {                                                                 \
+            /* Repair: repeated genes get random missing values. */       \
+            n_missing = 0;                                                \
+            for (k = 0; k < NAME##_range; k++)                            \
+            {                                                             \
+                if (!pop->marks[c][k])                                    \
+                    missing[n_missing++] = (GENE_T) ((MIN_VALUE) + k);    \
+            }                                                             \
+            for (k = 0; k < n_repeated[c]; k++)                           \
+            {                                                             \
+                m = k + (int) ga_static_rng_bounded(&pop->rng_state,      \
+                                        (uint32_t) (n_missing - k));      \
+                tmp = missing[m];                                         \
+                missing[m] = missing[k];                                  \
+                childs[c][repeated[c][k]] = tmp;                          \
+            }                                                             \
+        }                                                                 \
+        if (NON_REPEATABLE == NO_REPEAT)                                  \
+            memset(pop->marks[c], 0, NAME##_range);                       \
+        for (k = 0; k < n_swaps[c]; k++)                                  \
+        {                                                                 \
+            j = swaps[c][k];                                              \
+            m = (int) ga_static_rng_bounded(&pop->rng_state,              \
+                                            (LENGTH) - 1);                \
+            if (m >= j)                                                   \
+                m++;                                                      \
+            tmp = childs[c][m];                                           \
+            childs[c][m] = childs[c][j];                                  \
+            childs[c][j] = tmp;                                           \
+        }                                                                 \
+    }                                                                     \
+}                                                                         \
+                                                                          \
+static void                                                               \
+NAME##_ga_one_iter(struct NAME##_population *pop,                         \
+                   float (*objective_function)(const GENE_T *),           \
+                   int tournament_size, int n_childs, float mutate_rate)  \
+{                                                                         \
+/* One generation (see 'int_ga_one_iter'): 'n_childs' (<= n_population)   \
+   childs from tournaments and the best 'n_population' - 'n_childs'       \
+   individuals kept by elitism. */                                        \
+    int c, e, p1, p2;                                                     \
+    int n_elites = pop->n_population - n_childs;                          \
+    uint64_t mutate_threshold = ga_static_threshold(mutate_rate);         \
+    GENE_T (*swap_rows)[LENGTH];                                          \
+    float *swap_fos;                                                      \
+                                                                          \
+    for (c = 0; c < n_childs; c += 2)                                     \
+    {                                                                     \
+        p1 = NAME##_tournament(pop, tournament_size);                     \
+        p2 = NAME##_tournament(pop, tournament_size);                     \
+        /* An odd last child has it's sibling in the spare row. */        \
+        NAME##_breed_pair(pop, pop->individuals[p1],                      \
+                          pop->individuals[p2],                           \
+                          pop->new_individuals[c],                        \
+                          pop->new_individuals[(c + 1 < n_childs) ?       \
+                                               c + 1 : pop->n_population],\
+                          mutate_threshold);                              \
+    }                                                                     \
+    for (e = 0; e < n_elites; e++)                                        \
+    {                                                                     \
+        /* Elitism (fo already known). */                                 \
+        memcpy(pop->new_individuals[n_childs + e],                        \
+               pop->individuals[pop->ranks[e].index],                     \
+               sizeof(GENE_T) * (LENGTH));                                \
+        pop->new_fos[n_childs + e] = pop->ranks[e].fo;                    \
+    }                                                                     \
+    swap_rows = pop->individuals;                                         \
+    pop->individuals = pop->new_individuals;                              \
+    pop->new_individuals = swap_rows;                                     \
+    swap_fos = pop->fos;                                                  \
+    pop->fos = pop->new_fos;                                              \
+    pop->new_fos = swap_fos;                                              \
+    for (c = 0; c < n_childs; c++)                                        \
+    {                                                                     \
+        pop->fos[c] = objective_function(pop->individuals[c]);            \
+    }                                                                     \
+    pop->generation++;                                                    \
+    NAME##_rank_population(pop);                                          \
+}                                                                         \
+                                                                          \
+static void                                                               \
+NAME##_free_population(struct NAME##_population *pop)                     \
+{                                                                         \
+    free(pop->individuals);                                               \
+    free(pop->new_individuals);                                           \
+    free(pop->fos);                                                       \
+    free(pop->new_fos);                                                   \
+    free(pop->ranks);                                                     \
+    free(pop);                                                            \
+}
+
+#endif
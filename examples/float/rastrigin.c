@@ -0,0 +1,100 @@
+#include "../../GA_float/GA_float.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+/* Rastrigin function (minimum 0 at the origin, a local minimum at each
+   integer point) in [-5.12, 5.12]^L solved with GA_float, for each pair
+   of operators below, plus the first pair with a batch objective (same
+   fos, so the same run). Prints the best fo and the time per
+   generation.
+   Usage: ./rastrigin.out [L (30 by default)] [n_generations (2000)]
+   [n_threads (1)] */
+
+#define N_POPULATION 200
+#define N_CHILDS 160
+#define TOURNAMENT_SIZE 2
+#define MUTATIONS 1.0
+
+float objective_function(float *arr, int length);
+
+void batch_objective(float *genes, int stride, int n, int length,
+                     float *fos);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int length, int n_generations, int n_threads, char *cross_mode,
+         char *mutate_mode, int batch);
+
+float objective_function(float *arr, int length)
+{
+    /* 10 L + sum(x^2 - 10 cos(2 pi x)). */
+    int j;
+    float fo = 10.0f * length;
+
+    for (j = 0; j < length; j++)
+        fo += arr[j] * arr[j] - 10.0f * cosf(6.28318531f * arr[j]);
+    return fo;
+}
+
+void batch_objective(float *genes, int stride, int n, int length,
+                     float *fos)
+{
+    /* The same function for 'n' rows of 'stride' floats. */
+    int k;
+
+    for (k = 0; k < n; k++)
+        fos[k] = objective_function(genes + (size_t) k * stride, length);
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int length, int n_generations, int n_threads, char *cross_mode,
+         char *mutate_mode, int batch)
+{
+    int k;
+    struct FloatPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = float_init_population("random", N_POPULATION, length, -5.12, 5.12);
+    float_set_n_threads(pop, n_threads);
+    if (batch)
+        float_set_batch_objective(pop, batch_objective);
+    float_evaluate_population(pop, objective_function);
+    gettimeofday(&start, NULL);
+    for (k = 0; k < n_generations; k++)
+    {
+        float_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                          cross_mode, N_CHILDS, N_CHILDS, mutate_mode,
+                          MUTATIONS / length);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-10s %-13s %-6s: best fo %10.6f, %.3f ms per generation\n",
+           cross_mode, mutate_mode, batch ? "batch" : "single",
+           pop->best_fo_alltime,
+           elapsed(start, stop) * 1000.0 / n_generations);
+    fflush(stdout);
+    float_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int length = (argc > 1) ? atoi(argv[1]) : 30;
+    int n_generations = (argc > 2) ? atoi(argv[2]) : 2000;
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+
+    printf("Rastrigin, L = %d, %d individuals, %d generations\n", length,
+           N_POPULATION, n_generations);
+    /* GA_float has no global state: the runs share the process. */
+    run(length, n_generations, n_threads, "sbx", "polynomial", 0);
+    run(length, n_generations, n_threads, "sbx", "polynomial", 1);
+    run(length, n_generations, n_threads, "blx:0.3", "gaussian:0.01", 0);
+    run(length, n_generations, n_threads, "arithmetic", "gaussian", 0);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "../../GA_int/GA_int.h"
+#include "../../GA_float/GA_float.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Operator throughput of GA_float against GA_int: the time per generated
+   gene of 'float_ga_one_iter' and 'int_ga_one_iter' (selection,
+   crossover, mutation, elitism and a trivial linear evaluation) for
+   genome lengths from L = 10^3 to L = 10^6, with a sparse (1 / L) and a
+   dense (0.1) mutation rate.
+   - int: genes in [0, 1023], 'uniform' crossover and 'uniform' mutation
+          (the usual encoding of a real parameter in GA_int).
+   - float: 'sbx' + 'polynomial', 'blx' + 'gaussian' and 'arithmetic' +
+            'gaussian'.
+   Usage: ./throughput.out [max L (1000000 by default)] */
+
+#define N_POPULATION 32
+#define N_CHILDS 24
+#define TOURNAMENT_SIZE 2
+
+float int_objective(int *arr, int length);
+
+float float_objective(float *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+int n_generations(int length);
+
+void run_int(int length, float mutate_rate);
+
+void run_float(int length, float mutate_rate, char *cross_mode,
+               char *mutate_mode);
+
+float int_objective(int *arr, int length)
+{
+    /* Linear in the genome: alternated sum of the genes. */
+    int j;
+    double fo = 0.0;
+
+    for (j = 0; j < length; j++)
+        fo += (j & 1) ? arr[j] : -arr[j];
+    return (float) fo;
+}
+
+float float_objective(float *arr, int length)
+{
+    /* The same sum for real genes. */
+    int j;
+    double fo = 0.0;
+
+    for (j = 0; j < length; j++)
+        fo += (j & 1) ? arr[j] : -arr[j];
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int n_generations(int length)
+{
+    /* About 5 * 10^7 generated genes per run. */
+    return (50000000 / ((long) length * N_CHILDS) > 5) ?
+           50000000 / ((long) length * N_CHILDS) : 5;
+}
+
+void run_int(int length, float mutate_rate)
+{
+    int k, n_gens = n_generations(length);
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, length, 0, 1023,
+                              REPEATABLE);
+    int_evaluate_population(pop, int_objective);
+    gettimeofday(&start, NULL);
+    for (k = 0; k < n_gens; k++)
+    {
+        int_ga_one_iter(pop, int_objective, TOURNAMENT_SIZE, "uniform",
+                        N_CHILDS, N_CHILDS, "uniform", mutate_rate);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%8d  %-6g %-26s %6.2f ns/gene\n", length, mutate_rate,
+           "int uniform+uniform",
+           elapsed(start, stop) * 1e9 / ((double) n_gens * N_CHILDS * length));
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+void run_float(int length, float mutate_rate, char *cross_mode,
+               char *mutate_mode)
+{
+    int k, n_gens = n_generations(length);
+    char name[64];
+    struct FloatPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = float_init_population("random", N_POPULATION, length, 0.0, 1023.0);
+    float_evaluate_population(pop, float_objective);
+    gettimeofday(&start, NULL);
+    for (k = 0; k < n_gens; k++)
+    {
+        float_ga_one_iter(pop, float_objective, TOURNAMENT_SIZE, cross_mode,
+                          N_CHILDS, N_CHILDS, mutate_mode, mutate_rate);
+    }
+    gettimeofday(&stop, NULL);
+    snprintf(name, sizeof(name), "float %s+%s", cross_mode, mutate_mode);
+    printf("%8d  %-6g %-26s %6.2f ns/gene\n", length, mutate_rate, name,
+           elapsed(start, stop) * 1e9 / ((double) n_gens * N_CHILDS * length));
+    fflush(stdout);
+    float_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int r, length, max_length = (argc > 1) ? atoi(argv[1]) : 1000000;
+    float rate;
+
+    printf("       L  rate   operators                  time\n");
+    fflush(stdout);
+    for (length = 1000; length <= max_length; length *= 10)
+    {
+        for (r = 0; r < 2; r++)
+        {
+            rate = (r == 0) ? 1.0 / length : 0.1;
+            run_int(length, rate);
+            run_float(length, rate, "sbx", "polynomial");
+            run_float(length, rate, "blx", "gaussian");
+            run_float(length, rate, "arithmetic", "gaussian");
+        }
+    }
+    return 0;
+}
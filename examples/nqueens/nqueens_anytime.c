@@ -0,0 +1,198 @@
+#include "../../GA_int/GA_int.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Anytime run driver (see 'int_ga_run') on the N queens problem: the GA
+   runs in it's own thread while the main one (e.g. a server answering
+   requests) reads the best solution found so far at fixed deadlines
+   with 'int_read_best', without stopping or locking the GA, and stops
+   it at the last deadline with 'int_stop_run'. A second run stops by
+   itself with a time budget and a target fo, and a third one when the
+   best fo doesn't improve in STAGNATION_PATIENCE generations (the
+   'stop' stagnation trigger of 'int_set_stagnation').
+   Usage: ./nqueens_anytime.out [N (200 by default)] [n_threads (1)] */
+
+#define N_POPULATION 100
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define N_DEADLINES 6
+#define STAGNATION_PATIENCE 200
+#define MAX_GENERATIONS 100000
+
+struct IntPopulation *pop;
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+int progress(struct IntPopulation *pop, void *data);
+
+void *ga_thread(void *arg);
+
+void served_run(int nqueens, int n_threads);
+
+void budgeted_run(int nqueens, int n_threads);
+
+void stagnation_run(int nqueens, int n_threads);
+
+float objective_function(int *arr, int length)
+{
+    int i, j;
+    int fo = 0;
+
+    /* Calculating attacks for positive and negative diagonals. */
+    for (i = 0; i < length; i++)
+    {
+        for (j = i + 1; j < length; j++)
+        {
+            if (arr[j] == arr[i] + j - i ||
+                arr[j] == arr[i] - j + i)
+                fo++;
+        }
+    }
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int progress(struct IntPopulation *pop, void *data)
+{
+    /* Callback: prints the best fo every 'every' generations. */
+    printf("    [callback] generation %ld: best fo %g (%s)\n",
+           pop->run_generation, pop->best_fo_alltime, (char *) data);
+    return 0;
+}
+
+void *ga_thread(void *arg)
+{
+    /* Runs the GA of nqueens.c until 'int_stop_run'. */
+    int n_parents = N_POPULATION * 8 / 10;
+
+    int_ga_run(pop, objective_function, TOURNAMENT_SIZE, "2kpoints",
+               n_parents, n_parents, "swap", MUTATE_RATE);
+    return arg;
+}
+
+void served_run(int nqueens, int n_threads)
+{
+    /* The GA runs in it's own thread, read at each deadline. */
+    int i, *best, n_reads = 0;
+    double deadlines[N_DEADLINES] = {0.01, 0.05, 0.1, 0.5, 1.0, 2.0};
+    double now;
+    long generation;
+    float fo;
+    pthread_t thread;
+    struct timeval stop, start, read_start;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    best = malloc(nqueens * sizeof(int));
+    gettimeofday(&start, NULL);
+    pthread_create(&thread, NULL, ga_thread, NULL);
+    printf("GA running in it's own thread:\n");
+    for (i = 0; i < N_DEADLINES; i++)
+    {
+        /* Busy polling until the deadline, as a reader hammering the
+           snapshot. */
+        do
+        {
+            int_read_best(pop, best, &fo);
+            n_reads++;
+            gettimeofday(&stop, NULL);
+            now = elapsed(start, stop);
+        } while (now < deadlines[i]);
+        gettimeofday(&read_start, NULL);
+        generation = int_read_best(pop, best, &fo);
+        gettimeofday(&stop, NULL);
+        if (generation < 0)
+            printf("  %6.0f ms: first population not evaluated yet\n",
+                   deadlines[i] * 1e3);
+        else
+            printf("  %6.0f ms: best fo %4g (published at generation "
+                   "%ld), read in %.1f us\n", deadlines[i] * 1e3, fo,
+                   generation, elapsed(read_start, stop) * 1e6);
+    }
+    int_stop_run(pop);
+    pthread_join(thread, NULL);
+    printf("Stopped (reason %d) after %ld generations, %.3f s, %d reads "
+           "of the snapshot\n", pop->run_reason, pop->run_generation,
+           pop->run_seconds, n_reads);
+    fflush(stdout);
+    free(best);
+    int_free_population(pop);
+}
+
+void budgeted_run(int nqueens, int n_threads)
+{
+    /* Budgeted run: 50 ms or a solution. */
+    int reason;
+    float fo;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_run_limits(pop, 0, 0.05, 0, 0);
+    int_set_run_target(pop, 0.0);
+    int_set_run_callback(pop, progress, "50 ms budget", 100);
+    reason = int_ga_run(pop, objective_function, TOURNAMENT_SIZE,
+                        "2kpoints", N_POPULATION * 8 / 10,
+                        N_POPULATION * 8 / 10, "swap", MUTATE_RATE);
+    int_read_best(pop, NULL, &fo);
+    printf("Budgeted run: reason %d (%s), best fo %g after %ld "
+           "generations, %.2f ms\n", reason,
+           reason == RUN_MAX_TIME ? "time budget" :
+           reason == RUN_TARGET ? "solution found" : "other",
+           fo, pop->run_generation, pop->run_seconds * 1e3);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+void stagnation_run(int nqueens, int n_threads)
+{
+    /* Run stopped by the stagnation trigger (MAX_GENERATIONS is only
+       a safeguard). */
+    int reason;
+    float fo;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_stagnation(pop, "stop", STAGNATION_PATIENCE, 0.0, 0.0, 0.0);
+    int_set_run_limits(pop, MAX_GENERATIONS, 0.0, 0, 0);
+    reason = int_ga_run(pop, objective_function, TOURNAMENT_SIZE,
+                        "2kpoints", N_POPULATION * 8 / 10,
+                        N_POPULATION * 8 / 10, "swap", MUTATE_RATE);
+    int_read_best(pop, NULL, &fo);
+    printf("Stagnation run: reason %d (%s), best fo %g after %ld "
+           "generations (%d without improvement), %.2f ms\n", reason,
+           reason == RUN_STAGNATION ? "stagnation" :
+           reason == RUN_MAX_ITER ? "max generations" : "other",
+           fo, pop->run_generation, pop->n_stagnant_gens,
+           pop->run_seconds * 1e3);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int nqueens = (argc > 1) ? atoi(argv[1]) : 200;
+    int n_threads = (argc > 2) ? atoi(argv[2]) : 1;
+
+    printf("N = %d, %d individuals\n", nqueens, N_POPULATION);
+    fflush(stdout);
+    served_run(nqueens, n_threads);
+    budgeted_run(nqueens, n_threads);
+    stagnation_run(nqueens, n_threads);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Cellular GA (see 'int_set_cellular') on the N queens problem: the
+   population is a SIDE x SIDE toroidal grid and each cell only mates
+   with it's neighbors, against the usual GA with global tournaments
+   over the same number of individuals.
+   Usage: ./nqueens_cellular.out [N (100 by default)] [SIDE (32)]
+   [n_threads (1)] */
+
+#define TOURNAMENT_SIZE 2
+#define MUTATE_RATE 0.01
+#define MAX_ITER 2000
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int nqueens, int side, int n_threads, char *neighborhood,
+         char *update_mode);
+
+float objective_function(int *arr, int length)
+{
+    int i, j;
+    int fo = 0;
+
+    /* Calculating attacks for positive and negative diagonals. */
+    for (i = 0; i < length; i++)
+    {
+        for (j = i + 1; j < length; j++)
+        {
+            if (arr[j] == arr[i] + j - i ||
+                arr[j] == arr[i] - j + i)
+                fo++;
+        }
+    }
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int nqueens, int side, int n_threads, char *neighborhood,
+         char *update_mode)
+{
+    /* Runs the GA until a solution is found or MAX_ITER generations,
+       with a grid ('neighborhood' != 'none') or without it (80% of
+       childs and elitism, as nqueens.c). */
+    int k = 0, n_population = side * side;
+    /* 80% of childs, rounded to an even number of parents. */
+    int n_childs = n_population * 4 / 10 * 2;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", n_population, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_diversity(pop, "sampled");
+    int_set_cellular(pop, side, neighborhood, update_mode);
+    gettimeofday(&start, NULL);
+    int_evaluate_population(pop, objective_function);
+    while (k < MAX_ITER && pop->best_fo_alltime > 0.0)
+    {
+        if (strcmp(neighborhood, "none") == 0)
+            int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                            "2kpoints", n_childs, n_childs, "swap",
+                            MUTATE_RATE);
+        else
+            int_cellular_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                                  "2kpoints", "swap", MUTATE_RATE);
+        k++;
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-10s %-5s: best fo %g after %d generations, %.3f s "
+           "(mean Hamming distance %.1f)\n", neighborhood,
+           strcmp(neighborhood, "none") == 0 ? "-" : update_mode,
+           pop->best_fo_alltime, k, elapsed(start, stop),
+           pop->diversity_hamming);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i, nqueens = (argc > 1) ? atoi(argv[1]) : 100;
+    int side = (argc > 2) ? atoi(argv[2]) : 32;
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    char *neighborhoods[5] = {"none", "vonneumann", "vonneumann",
+                              "moore", "moore"};
+    char *update_modes[5] = {"sync", "sync", "async", "sync", "async"};
+
+    printf("N = %d, %d x %d individuals, %d thread(s)\n", nqueens, side,
+           side, n_threads);
+    fflush(stdout);
+    for (i = 0; i < 5; i++)
+    {
+        run(nqueens, side, n_threads, neighborhoods[i], update_modes[i]);
+    }
+    return 0;
+}
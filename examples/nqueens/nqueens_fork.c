@@ -0,0 +1,121 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Fork evaluator pool (see 'int_set_fork_evaluator') on the N queens
+   problem, with an objective function written as a legacy evaluator:
+   it counts the queens of each diagonal in global arrays, so it's not
+   thread safe, and it may crash (abort) with a given probability per
+   evaluation, as a buggy external library would. The population lives
+   in shared memory ('shared' init_mode), the workers read the
+   individuals from it and a crashed worker is restarted, evaluating
+   it's individual again.
+   Usage: ./nqueens_fork.out [N (200 by default)] [n_generations (300)]
+   [crash rate (0.001)] */
+
+#define N_POPULATION 400
+#define N_CHILDS 320
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define MAX_N 100000
+
+/* Legacy evaluator state. */
+int diag_pos[2 * MAX_N], diag_neg[2 * MAX_N];
+double crash_rate = 0.0;
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int nqueens, int n_generations, int n_workers, double crash);
+
+float objective_function(int *arr, int length)
+{
+    /* Attacks are the pairs of queens on the same diagonal. */
+    static unsigned int crash_seed;
+    static pid_t crash_pid;
+    int i, fo = 0;
+
+    if (crash_rate > 0.0)
+    {
+        /* Each worker process has it's own crash stream. */
+        if (crash_pid != getpid())
+        {
+            crash_pid = getpid();
+            crash_seed = (unsigned int) crash_pid;
+        }
+        if (rand_r(&crash_seed) < crash_rate * RAND_MAX)
+            abort();
+    }
+    memset(diag_pos, 0, 2 * length * sizeof(int));
+    memset(diag_neg, 0, 2 * length * sizeof(int));
+    for (i = 0; i < length; i++)
+    {
+        fo += diag_pos[arr[i] + i]++;
+        fo += diag_neg[arr[i] - i + length]++;
+    }
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int nqueens, int n_generations, int n_workers, double crash)
+{
+    int k;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population(n_workers > 0 ? "shared" : "random",
+                              N_POPULATION, nqueens, 0, nqueens - 1,
+                              NO_REPEAT);
+    crash_rate = crash;
+    if (n_workers > 0)
+        int_set_fork_evaluator(pop, n_workers);
+    gettimeofday(&start, NULL);
+    int_evaluate_population(pop, objective_function);
+    for (k = 0; k < n_generations && pop->best_fo > 0; k++)
+    {
+        int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE, "2kpoints",
+                        N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-6s %7d  %6.4f  %5.0f  %8.3f  %8ld  %8ld\n",
+           n_workers > 0 ? "fork" : "serial", n_workers, crash,
+           pop->best_fo_alltime, elapsed(start, stop) * 1000.0 / (k + 1),
+           pop->n_fork_restarts, pop->n_fork_failures);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+    int nqueens = (argc > 1) ? atoi(argv[1]) : 200;
+    int n_generations = (argc > 2) ? atoi(argv[2]) : 300;
+    double crash = (argc > 3) ? atof(argv[3]) : 0.001;
+    int workers[5] = {0, 1, 2, 4, 4};
+
+    if (nqueens < 4 || nqueens > MAX_N)
+    {
+        fprintf(stderr, "N must be in [4, %d].\n", MAX_N);
+        return 1;
+    }
+    printf("N = %d, %d individuals, %d generations\n", nqueens,
+           N_POPULATION, n_generations);
+    printf("eval   workers  crash   best   ms/gen    restarts  failures\n");
+    fflush(stdout);
+    for (i = 0; i < 5; i++)
+    {
+        /* The last run crashes. */
+        run(nqueens, n_generations, workers[i], (i == 4) ? crash : 0.0);
+    }
+    return 0;
+}
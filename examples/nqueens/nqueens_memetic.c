@@ -0,0 +1,118 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <string.h>
+
+/* Memetic GA (local search stage, see 'int_set_local_search') on the
+   N queens problem, against the pure GA when 'ls_mode' is 'none'.
+   Usage: ./nqueens_memetic.out [N] [ls_mode] [writeback_mode]
+   (defaults: 200 minconflicts lamarckian). */
+
+#define N_POPULATION 100
+#define N_CHILDS 80
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define MAX_ITER 20000
+/* Local search: the best individuals and 5% of the others, with at
+   most LS_BUDGET moves per individual. */
+#define LS_TOP 2
+#define LS_FRACTION 0.05
+#define LS_BUDGET 20000
+
+float objective_function(int *arr, int length);
+
+float swap_delta(int *arr, int length, int a, int b);
+
+int gene_attacks(int *arr, int length, int gene, int skip);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+float objective_function(int *arr, int length)
+{
+    int i, j;
+    int fo = 0;
+
+    /* Calculating attacks for positive and negative diagonals. */
+    for (i = 0; i < length; i++)
+    {
+        for (j = i + 1; j < length; j++)
+        {
+            if (arr[j] == arr[i] + j - i ||
+                arr[j] == arr[i] - j + i)
+                fo++;
+        }
+    }
+    return (float) fo;
+}
+
+int gene_attacks(int *arr, int length, int gene, int skip)
+{
+    /* Attacks between the queen of row 'gene' and the others (but the
+       one of row 'skip'). */
+    int j, n = 0;
+
+    for (j = 0; j < length; j++)
+    {
+        if (j != gene && j != skip &&
+            abs(arr[j] - arr[gene]) == abs(j - gene))
+            n++;
+    }
+    return n;
+}
+
+float swap_delta(int *arr, int length, int a, int b)
+{
+    /* Fo change of swapping the queens of rows a and b in O(N): only
+       their attacks change (the attack between them is kept). */
+    int before, after, tmp;
+
+    before = gene_attacks(arr, length, a, b) + gene_attacks(arr, length, b, a);
+    tmp = arr[a];
+    arr[a] = arr[b];
+    arr[b] = tmp;
+    after = gene_attacks(arr, length, a, b) + gene_attacks(arr, length, b, a);
+    arr[b] = arr[a];
+    arr[a] = tmp;
+    return (float) (after - before);
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    int nqueens = (argc > 1) ? atoi(argv[1]) : 200;
+    char *ls_mode = (argc > 2) ? argv[2] : "minconflicts";
+    char *writeback_mode = (argc > 3) ? argv[3] : "lamarckian";
+    int k = 0;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    gettimeofday(&start, NULL);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_local_search(pop, ls_mode, writeback_mode, LS_TOP,
+                         LS_FRACTION, LS_BUDGET, swap_delta);
+    int_evaluate_population(pop, objective_function);
+    while (k < MAX_ITER && pop->best_fo_alltime > 0.0)
+    {
+        int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                        "2kpoints", N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+        k++;
+    }
+    gettimeofday(&stop, NULL);
+    printf("N = %d, ls '%s' (%s): best fo %g after %d generations, "
+           "%.3f s\n", nqueens, ls_mode, writeback_mode,
+           pop->best_fo_alltime, k, elapsed(start, stop));
+    printf("fo evaluations %ld, local search moves %ld, improved %ld\n",
+           pop->n_evaluations, pop->n_ls_evaluations, pop->n_ls_improved);
+    int_free_population(pop);
+
+    return 0;
+}
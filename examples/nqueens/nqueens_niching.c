@@ -0,0 +1,136 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Niching (see 'int_set_niching' and 'int_crowding_one_iter') on the
+   N queens problem, which has plenty of solutions: the GA of nqueens.c
+   against fitness sharing, clearing and deterministic crowding, with
+   exact and LSH searches of the close pairs. Prints the distinct
+   solutions inside the last population, the niche counts and the
+   distances computed per generation.
+   Usage: ./nqueens_niching.out [N (32 by default)] [n_population (2000)]
+   [n_threads (1)] */
+
+#define TOURNAMENT_SIZE 2
+#define MUTATE_RATE 0.01
+#define N_GENERATIONS 300
+#define RADIUS 0.1
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+int distinct_solutions(struct IntPopulation *pop);
+
+void run(int nqueens, int n_population, int n_threads, char *niche_mode,
+         char *search_mode, float niche_param);
+
+float objective_function(int *arr, int length)
+{
+    int i, j;
+    int fo = 0;
+
+    /* Calculating attacks for positive and negative diagonals. */
+    for (i = 0; i < length; i++)
+    {
+        for (j = i + 1; j < length; j++)
+        {
+            if (arr[j] == arr[i] + j - i ||
+                arr[j] == arr[i] - j + i)
+                fo++;
+        }
+    }
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int distinct_solutions(struct IntPopulation *pop)
+{
+    /* Solutions (fo == 0) of the pop not repeated before it. */
+    int i, k, n_distinct = 0;
+
+    for (i = 0; i < pop->n_population; i++)
+    {
+        if (pop->fos[i] > 0.0)
+            continue;
+        for (k = 0; k < i; k++)
+        {
+            if (pop->fos[k] == 0.0 &&
+                memcmp(pop->individuals[k], pop->individuals[i],
+                       sizeof(int) * pop->length) == 0)
+                break;
+        }
+        if (k == i)
+            n_distinct++;
+    }
+    return n_distinct;
+}
+
+void run(int nqueens, int n_population, int n_threads, char *niche_mode,
+         char *search_mode, float niche_param)
+{
+    /* N_GENERATIONS of the GA ('crowding' for deterministic crowding),
+       with 80% of childs and elitism. */
+    int k, n_childs = n_population * 4 / 10 * 2;
+    long n_distances = 0;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", n_population, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    if (strcmp(niche_mode, "crowding") == 0)
+        int_set_niching(pop, "count", search_mode, RADIUS, 1.0);
+    else
+        int_set_niching(pop, niche_mode, search_mode, RADIUS, niche_param);
+    gettimeofday(&start, NULL);
+    int_evaluate_population(pop, objective_function);
+    for (k = 0; k < N_GENERATIONS; k++)
+    {
+        if (strcmp(niche_mode, "crowding") == 0)
+            int_crowding_one_iter(pop, objective_function, "2kpoints",
+                                  "swap", MUTATE_RATE);
+        else
+            int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                            "2kpoints", n_childs, n_childs, "swap",
+                            MUTATE_RATE);
+        n_distances += pop->n_niche_distances;
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-8s %-5s: %4d distinct solutions, %4d niches, %8ld "
+           "distances/generation, %.3f s\n", niche_mode, search_mode,
+           distinct_solutions(pop), pop->n_niches,
+           n_distances / N_GENERATIONS, elapsed(start, stop));
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i, nqueens = (argc > 1) ? atoi(argv[1]) : 32;
+    int n_population = (argc > 2) ? atoi(argv[2]) : 2000;
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    char *niche_modes[7] = {"count", "count", "sharing", "sharing",
+                            "clearing", "clearing", "crowding"};
+    char *search_modes[7] = {"exact", "lsh", "exact", "lsh", "exact",
+                             "lsh", "lsh"};
+    float niche_params[7] = {1.0, 1.0, 1.0, 1.0, 4.0, 4.0, 1.0};
+
+    printf("N = %d, %d individuals, %d thread(s), radius %g\n", nqueens,
+           n_population, n_threads, RADIUS);
+    fflush(stdout);
+    for (i = 0; i < 7; i++)
+    {
+        run(nqueens, n_population, n_threads, niche_modes[i],
+            search_modes[i], niche_params[i]);
+    }
+    return 0;
+}
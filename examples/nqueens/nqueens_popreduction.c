@@ -75,6 +75,11 @@ int main()
     /* ===1st population creation, evalution and print.=== */
     pop = int_init_population(init_mode, n_population, length,
                               min_value, max_value, non_repeatable);
+    /* Shrinking by 'pop_decrease_factor' on every improvement of the fo
+       (n_parents and n_childs are scaled by int_ga_one_iter). */
+    int_set_resize_schedule(pop, "improvement", pop_decrease_factor,
+                            min_pop, n_population, 0, 0.0,
+                            RELEASE_MEMORY);
     int_evaluate_population(pop, objective_function);
     best_fo_alltime = pop->best_fo_alltime;
     print_results(results, print_mode, pop, k);
@@ -88,24 +93,11 @@ int main()
                 cross_mode, n_parents, n_childs,
                 mutate_mode, mutate_rate);
         k++;
-        /* Updating best_fo_alltime, printing and pop reduction. */
+        /* Updating best_fo_alltime and printing. */
         if (pop->best_fo_alltime < best_fo_alltime)
         {
             best_fo_alltime = pop->best_fo_alltime;
             print_results(results, print_mode, pop, k);
-            /* Madness population reduction. */
-            if (pop->n_population > min_pop)
-            {
-                pop->n_population = (int) ((
-                    (float) pop->n_population) * pop_decrease_factor);
-                if (pop->n_population < min_pop)
-                    pop->n_population = min_pop;
-                n_parents = (int) (n_parents_percentage
-                    * (float) pop->n_population);
-                if (n_parents % 2)
-                    n_parents--; /* Only even values. */
-                n_childs = n_parents;
-            }
         }
     }
     gettimeofday(&stop, NULL);
@@ -0,0 +1,131 @@
+#include "../../GA_int/GA_int.h"
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* External process evaluator (see 'int_set_process_evaluator') on the
+   N queens problem: the fos come from a separate program,
+   nqueens_sim.out (nqueens_sim.c), which pays a startup cost of 10 ms.
+   The same GA runs with:
+   - popen: the usual wrapper, one launch of the program per
+            evaluation (inside the objective function).
+   - text and binary protocols with a pool of long-lived processes,
+     one individual or a batch of them in flight per process.
+   - a faulty program that crashes, hangs and writes garbage, with a
+     timeout and a penalty fo.
+   Usage: ./nqueens_process.out [N (100 by default)] [n_generations (50)]
+   [path of nqueens_sim.out (./nqueens_sim.out)] */
+
+#define N_POPULATION 200
+#define N_CHILDS 160
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define N_PROCESSES 2
+#define TIMEOUT 0.5
+
+char *sim_path;
+char *sim_line;
+
+float popen_objective(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int nqueens, int n_generations, char *label, char *protocol,
+         int batch_size, char *faults);
+
+float popen_objective(int *arr, int length)
+{
+    /* One program launch per evaluation: the individual is echoed to
+       it's stdin. */
+    int j, n;
+    float fo = FLT_MAX;
+    FILE *sim;
+
+    n = sprintf(sim_line, "echo");
+    for (j = 0; j < length; j++)
+        n += sprintf(sim_line + n, " %d", arr[j]);
+    sprintf(sim_line + n, " | %s text %d", sim_path, length);
+    sim = popen(sim_line, "r");
+    if (sim == NULL)
+        return FLT_MAX;
+    if (fscanf(sim, "%f", &fo) != 1)
+        fo = FLT_MAX;
+    pclose(sim);
+    return fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int nqueens, int n_generations, char *label, char *protocol,
+         int batch_size, char *faults)
+{
+    int k;
+    char command[512];
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    sim_line = malloc((size_t) nqueens * 12 + strlen(sim_path) + 64);
+    gettimeofday(&start, NULL);
+    if (protocol != NULL)
+    {
+        /* Startup of the processes included. With exec, the shell is
+           replaced by the program instead of waiting for it. */
+        snprintf(command, sizeof(command), "exec %s %s %d 10 %s", sim_path,
+                 protocol, nqueens, faults);
+        int_set_process_evaluator(pop, command, protocol, N_PROCESSES,
+                                  batch_size, TIMEOUT, FLT_MAX);
+    }
+    int_evaluate_population(pop, popen_objective);
+    for (k = 0; k < n_generations && pop->best_fo > 0; k++)
+    {
+        int_ga_one_iter(pop, popen_objective, TOURNAMENT_SIZE, "2kpoints",
+                        N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-8s %-7s %5d  %5.0f  %10.3f  %8ld  %8ld  %8ld\n", label,
+           protocol != NULL ? protocol : "-", batch_size,
+           pop->best_fo_alltime,
+           elapsed(start, stop) * 1000.0 / pop->n_evaluations,
+           pop->n_proc_failures, pop->n_proc_timeouts,
+           pop->n_proc_respawns);
+    fflush(stdout);
+    int_free_population(pop);
+    free(sim_line);
+}
+
+int main(int argc, char *argv[])
+{
+    int nqueens = (argc > 1) ? atoi(argv[1]) : 100;
+    int n_generations = (argc > 2) ? atoi(argv[2]) : 50;
+
+    sim_path = (argc > 3) ? argv[3] : "./nqueens_sim.out";
+    if (access(sim_path, X_OK) != 0)
+    {
+        fprintf(stderr, "Compile nqueens_sim.c to %s first.\n", sim_path);
+        return 1;
+    }
+    printf("N = %d, %d individuals, %d generations (popen: 2), %d "
+           "processes\n", nqueens, N_POPULATION, n_generations,
+           N_PROCESSES);
+    printf("eval     proto   batch  best   ms/eval     failures  timeouts"
+           "  respawns\n");
+    fflush(stdout);
+    run(nqueens, 2, "popen", NULL, 0, "");
+    run(nqueens, n_generations, "pool", "text", 1, "");
+    run(nqueens, n_generations, "pool", "text", 8, "");
+    run(nqueens, n_generations, "pool", "binary", 1, "");
+    run(nqueens, n_generations, "pool", "binary", 8, "");
+    /* Crashes, hangs and garbage, 1 in 1000 each. */
+    run(nqueens, n_generations, "faulty", "text", 8, "0.001 0.001 0.001");
+    return 0;
+}
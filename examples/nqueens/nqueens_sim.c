@@ -0,0 +1,96 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* External N queens "simulator" for nqueens_process.c: a separate
+   program that evaluates individuals read from stdin and writes their
+   fos to stdout (the protocols of 'int_set_process_evaluator'), until
+   stdin is closed. It pays a startup cost (as a simulator loading it's
+   model) and can misbehave on purpose: crash, hang or write garbage
+   (a NaN in binary) with the given probabilities per evaluation.
+   Usage: ./nqueens_sim.out <text|binary> <N> [startup ms (10)]
+   [crash rate (0)] [hang rate (0)] [garbage rate (0)] */
+
+int read_individual(int binary, int *arr, int length);
+
+int attacks(int *arr, int length, int *diag_pos, int *diag_neg);
+
+int read_individual(int binary, int *arr, int length)
+{
+/* Returns 1 if an individual was read, 0 at the end of stdin. */
+    int j;
+
+    if (binary)
+        return fread(arr, sizeof(int), length, stdin) == (size_t) length;
+    for (j = 0; j < length; j++)
+    {
+        if (scanf("%d", arr + j) != 1)
+            return 0;
+    }
+    return 1;
+}
+
+int attacks(int *arr, int length, int *diag_pos, int *diag_neg)
+{
+    /* Pairs of queens on the same diagonal. */
+    int i, fo = 0;
+
+    memset(diag_pos, 0, 2 * length * sizeof(int));
+    memset(diag_neg, 0, 2 * length * sizeof(int));
+    for (i = 0; i < length; i++)
+    {
+        fo += diag_pos[arr[i] + i]++;
+        fo += diag_neg[arr[i] - i + length]++;
+    }
+    return fo;
+}
+
+int main(int argc, char *argv[])
+{
+    int binary, length, fo, *arr, *diag_pos, *diag_neg;
+    int startup_ms = (argc > 3) ? atoi(argv[3]) : 10;
+    double crash = (argc > 4) ? atof(argv[4]) : 0.0;
+    double hang = (argc > 5) ? atof(argv[5]) : 0.0;
+    double garbage = (argc > 6) ? atof(argv[6]) : 0.0;
+    double draw;
+    float fo_binary;
+
+    if (argc < 3 || atoi(argv[2]) < 1)
+    {
+        fprintf(stderr, "Usage: %s <text|binary> <N> [startup ms] "
+                "[crash rate] [hang rate] [garbage rate]\n", argv[0]);
+        return 1;
+    }
+    binary = (strcmp(argv[1], "binary") == 0);
+    length = atoi(argv[2]);
+    arr = malloc(length * sizeof(int));
+    diag_pos = malloc(2 * length * sizeof(int));
+    diag_neg = malloc(2 * length * sizeof(int));
+    srand(getpid());
+    usleep(startup_ms * 1000);
+    while (read_individual(binary, arr, length))
+    {
+        draw = rand() / (RAND_MAX + 1.0);
+        if (draw < crash)
+            abort();
+        if (draw < crash + hang)
+            pause();
+        fo = attacks(arr, length, diag_pos, diag_neg);
+        if (binary)
+        {
+            fo_binary = (draw < crash + hang + garbage) ? NAN : (float) fo;
+            fwrite(&fo_binary, sizeof(float), 1, stdout);
+        }
+        else if (draw < crash + hang + garbage)
+            printf("garbage\n");
+        else
+            printf("%d\n", fo);
+        fflush(stdout);
+    }
+    free(arr);
+    free(diag_pos);
+    free(diag_neg);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "../../GA_int/GA_int.h"
+#include "../../GA_int/GA_int_static.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <string.h>
+
+/* Benchmark of the compile time specialized engine (GA_int_static.h)
+   against the runtime generic one ('int_ga_one_iter') on the N queens
+   problem, with the same parameters as nqueens.c and a fixed number of
+   generations. Usage: ./nqueens_static.out [N (50 or 200)] [breed]
+   With 'breed', the objective function is replaced by a trivial one
+   (the first gene), so only the engine itself is timed. */
+
+#define N_POPULATION 100
+#define N_CHILDS 80
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define N_GENERATIONS 2000
+
+int breed_only = 0;
+
+/* Objective function for each gene type. */
+#define NQUEENS_FO(NAME, GENE_T, LENGTH)                                  \
+static float                                                              \
+NAME##_objective_function(const GENE_T *arr)                              \
+{                                                                         \
+    int i, j, fo = 0;                                                     \
+                                                                          \
+    if (breed_only)                                                       \
+        return (float) arr[0];                                            \
+    /* Calculating attacks for positive and negative diagonals. */        \
+    for (i = 0; i < (LENGTH); i++)                                        \
+    {                                                                     \
+        for (j = i + 1; j < (LENGTH); j++)                                \
+        {                                                                 \
+            if (arr[j] == arr[i] + j - i || arr[j] == arr[i] - j + i)     \
+                fo++;                                                     \
+        }                                                                 \
+    }                                                                     \
+    return (float) fo;                                                    \
+}
+
+/* One engine per (gene type, N). */
+GA_INT_STATIC(q50_u8, uint8_t, 50, 0, 49, NO_REPEAT, CROSS_2KPOINTS,
+              MUTATE_SWAP)
+NQUEENS_FO(q50_u8, uint8_t, 50)
+GA_INT_STATIC(q200_u8, uint8_t, 200, 0, 199, NO_REPEAT, CROSS_2KPOINTS,
+              MUTATE_SWAP)
+NQUEENS_FO(q200_u8, uint8_t, 200)
+GA_INT_STATIC(q200_u16, uint16_t, 200, 0, 199, NO_REPEAT, CROSS_2KPOINTS,
+              MUTATE_SWAP)
+NQUEENS_FO(q200_u16, uint16_t, 200)
+GA_INT_STATIC(q200_i32, int32_t, 200, 0, 199, NO_REPEAT, CROSS_2KPOINTS,
+              MUTATE_SWAP)
+NQUEENS_FO(q200_i32, int32_t, 200)
+
+/* Runs N_GENERATIONS of an engine, printing time per generation. */
+#define RUN_STATIC(NAME, LABEL, SEED)                                     \
+do                                                                        \
+{                                                                         \
+    struct NAME##_population *pop = NAME##_init_population(N_POPULATION,  \
+                                                           SEED);         \
+    int k;                                                                \
+                                                                          \
+    gettimeofday(&start, NULL);                                           \
+    NAME##_evaluate_population(pop, NAME##_objective_function);           \
+    for (k = 0; k < N_GENERATIONS; k++)                                   \
+    {                                                                     \
+        NAME##_ga_one_iter(pop, NAME##_objective_function,                \
+                           TOURNAMENT_SIZE, N_CHILDS, MUTATE_RATE);       \
+    }                                                                     \
+    gettimeofday(&stop, NULL);                                            \
+    printf("%-22s %10.2f us/gen   best fo %g\n", LABEL,                   \
+           elapsed(start, stop) * 1e6 / N_GENERATIONS,                    \
+           pop->best_fo_alltime);                                         \
+    NAME##_free_population(pop);                                          \
+} while (0)
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+float objective_function(int *arr, int length)
+{
+    int i, j;
+    int fo = 0;
+
+    if (breed_only)
+        return (float) arr[0];
+    /* Calculating attacks for positive and negative diagonals. */
+    for (i = 0; i < length; i++)
+    {
+        for (j = i + 1; j < length; j++)
+        {
+            if (arr[j] == arr[i] + j - i ||
+                arr[j] == arr[i] - j + i)
+                fo++;
+        }
+    }
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    int nqueens = (argc > 1) ? atoi(argv[1]) : 200;
+    breed_only = (argc > 2 && strcmp(argv[2], "breed") == 0);
+    int k;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    if (nqueens != 50 && nqueens != 200)
+    {
+        fprintf(stderr, "Only N = 50 or N = 200 are instantiated.\n");
+        return 1;
+    }
+    srand(1);
+    printf("N = %d, %d individuals, %d generations%s:\n", nqueens,
+           N_POPULATION, N_GENERATIONS,
+           breed_only ? " (engine only)" : "");
+
+    /* ===Runtime generic engine.=== */
+    gettimeofday(&start, NULL);
+    pop = int_init_population("random", N_POPULATION, nqueens, 0,
+                              nqueens - 1, NO_REPEAT);
+    int_evaluate_population(pop, objective_function);
+    for (k = 0; k < N_GENERATIONS; k++)
+    {
+        int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                        "2kpoints", N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-22s %10.2f us/gen   best fo %g\n", "GA_int (int)",
+           elapsed(start, stop) * 1e6 / N_GENERATIONS,
+           pop->best_fo_alltime);
+    int_free_population(pop);
+
+    /* ===Compile time engines.=== */
+    if (nqueens == 50)
+        RUN_STATIC(q50_u8, "GA_int_static (uint8)", 1);
+    else
+    {
+        RUN_STATIC(q200_u8, "GA_int_static (uint8)", 1);
+        RUN_STATIC(q200_u16, "GA_int_static (uint16)", 1);
+        RUN_STATIC(q200_i32, "GA_int_static (int32)", 1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "../../GA_int/GA_int.h"
+#include "../../problems/perm_problems.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Multi-objective GA (NSGA-II, see 'int_set_multi_objective') on a
+   bi-objective TSP: the same tour is measured with two random
+   instances, e.g. cost and latency of a route, as the KroAB instances.
+   Prints the Pareto archive size, it's hypervolume (with the worst
+   objectives of the initial population as reference point) and the
+   time per generation.
+   Usage: ./mo_tsp.out [n (100 by default)] [n_population (1000)]
+   [threads (1)] */
+
+#define TOURNAMENT_SIZE 2
+#define MUTATE_RATE 0.01
+#define N_GENERATIONS 500
+#define ARCHIVE_CAPACITY 200
+
+struct PermProblem *cost, *latency;
+
+void objectives(int *arr, int length, float *objs);
+
+double hypervolume(float *objs, int n, float ref0, float ref1);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void objectives(int *arr, int length, float *objs)
+{
+    /* Length of the closed tour for both instances. */
+    int i, a, b;
+    long sum0 = 0, sum1 = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        a = arr[i];
+        b = arr[(i + 1 < length) ? i + 1 : 0];
+        sum0 += cost->dist[a * length + b];
+        sum1 += latency->dist[a * length + b];
+    }
+    objs[0] = (float) sum0;
+    objs[1] = (float) sum1;
+}
+
+double hypervolume(float *objs, int n, float ref0, float ref1)
+{
+    /* Area dominated by the 'n' non dominated points ([n][2], sorted by
+       the 1st objective) up to (ref0, ref1). */
+    int i;
+    double area = 0.0, prev1 = ref1;
+
+    for (i = 0; i < n; i++)
+    {
+        if (objs[2 * i] >= ref0 || objs[2 * i + 1] >= prev1)
+            continue;
+        area += (double) (ref0 - objs[2 * i]) * (prev1 - objs[2 * i + 1]);
+        prev1 = objs[2 * i + 1];
+    }
+    return area;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = (argc > 1) ? atoi(argv[1]) : 100;
+    int n_population = (argc > 2) ? atoi(argv[2]) : 1000;
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    int i, k, n_front;
+    float ref0 = 0.0, ref1 = 0.0, *front;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    cost = tsp_random(n, 1, DIST_MATRIX);
+    latency = tsp_random(n, 2, DIST_MATRIX);
+    pop = int_init_population("random", n_population, n, 0, n - 1,
+                              NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_multi_objective(pop, 2, objectives, ARCHIVE_CAPACITY);
+    int_evaluate_population(pop, NULL);
+    for (i = 0; i < n_population; i++)
+    {
+        if (pop->mo_objs[i] > ref0)
+            ref0 = pop->mo_objs[i];
+        if (pop->mo_objs[pop->mo_stride + i] > ref1)
+            ref1 = pop->mo_objs[pop->mo_stride + i];
+    }
+
+    front = ec_malloc(2 * ARCHIVE_CAPACITY * sizeof(float),
+                      __LINE__, __FILE__);
+    gettimeofday(&start, NULL);
+    for (k = 1; k <= N_GENERATIONS; k++)
+    {
+        int_nsga2_one_iter(pop, TOURNAMENT_SIZE, "2kpoints", "swap",
+                           MUTATE_RATE);
+        if (k % 100 == 0)
+        {
+            n_front = int_pareto_front(pop, NULL, front, ARCHIVE_CAPACITY);
+            printf("generation %d: %d points in the archive, "
+                   "hypervolume %.4g, extremes (%.0f, %.0f) "
+                   "(%.0f, %.0f)\n", k, n_front,
+                   hypervolume(front, n_front, ref0, ref1), front[0],
+                   front[1], front[2 * (n_front - 1)],
+                   front[2 * (n_front - 1) + 1]);
+        }
+    }
+    gettimeofday(&stop, NULL);
+    printf("n = %d, %d individuals: %.3f ms per generation, %d fronts "
+           "in the last one\n", n, n_population,
+           elapsed(start, stop) * 1e3 / N_GENERATIONS,
+           (int) pop->sorted_fos[n_population - 1] + 1);
+
+    free(front);
+    int_free_population(pop);
+    perm_free_problem(cost);
+    perm_free_problem(latency);
+    return 0;
+}
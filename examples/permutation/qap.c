@@ -0,0 +1,72 @@
+#include "../../GA_int/GA_int.h"
+#include "../../problems/perm_problems.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Memetic GA on the QAP (see problems/perm_problems.h): assignments are
+   non-repeatable solutions in [0, n - 1], evaluated by 'qap_objective'
+   in O(n^2), and the local search stage swaps locations with the O(n)
+   'qap_swap_delta'.
+   Usage: ./qap.out [file.dat | n (50 by default)] [ls_mode] [threads]
+   ('none' as ls_mode runs the pure GA). */
+
+#define N_POPULATION 100
+#define N_CHILDS 80
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.02
+#define MAX_ITER 500
+#define LS_TOP 2
+#define LS_FRACTION 0.05
+#define LS_BUDGET 5000
+
+double elapsed(struct timeval start, struct timeval stop);
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    char *instance = (argc > 1) ? argv[1] : "50";
+    char *ls_mode = (argc > 2) ? argv[2] : "first";
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    int k, n;
+    struct PermProblem *problem;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    if (strstr(instance, ".dat") != NULL)
+        problem = qap_read_qaplib(instance);
+    else
+        problem = qap_random(atoi(instance), 1);
+    perm_set_problem(problem);
+    n = problem->n;
+
+    gettimeofday(&start, NULL);
+    pop = int_init_population("random", N_POPULATION, n, 0, n - 1,
+                              NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_local_search(pop, ls_mode, "lamarckian", LS_TOP, LS_FRACTION,
+                         LS_BUDGET, qap_swap_delta);
+    int_evaluate_population(pop, qap_objective);
+    for (k = 0; k < MAX_ITER; k++)
+    {
+        int_ga_one_iter(pop, qap_objective, TOURNAMENT_SIZE, "2kpoints",
+                        N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%s (n = %d), ls '%s': best cost %.0f after %d generations, "
+           "%.3f s\n", problem->name, n, ls_mode, pop->best_fo_alltime, k,
+           elapsed(start, stop));
+    printf("fo evaluations %ld, local search moves %ld\n",
+           pop->n_evaluations, pop->n_ls_evaluations);
+
+    int_free_population(pop);
+    perm_free_problem(problem);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "../../GA_int/GA_int.h"
+#include "../../problems/perm_problems.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Memetic GA on the symmetric TSP (see problems/perm_problems.h): tours
+   are non-repeatable solutions in [0, n - 1], evaluated by
+   'tsp_objective', and the local search stage swaps cities with the
+   O(1) 'tsp_swap_delta'. The best tour found is then improved with
+   2-opt over neighbor lists.
+   Usage: ./tsp.out [file.tsp | n (1000 by default)] [ls_mode] [threads]
+   ('none' as ls_mode runs the pure GA). */
+
+#define N_POPULATION 100
+#define N_CHILDS 80
+#define TOURNAMENT_SIZE 3
+#define MUTATE_RATE 0.01
+#define MAX_ITER 1000
+#define LS_TOP 2
+#define LS_FRACTION 0.05
+#define LS_BUDGET 20000
+#define N_NEIGHBORS 10
+
+double elapsed(struct timeval start, struct timeval stop);
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    char *instance = (argc > 1) ? argv[1] : "1000";
+    char *ls_mode = (argc > 2) ? argv[2] : "first";
+    int n_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    int k, n, *tour;
+    float fo_ga, fo_2opt;
+    struct PermProblem *problem;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    if (strstr(instance, ".tsp") != NULL)
+        problem = tsp_read_tsplib(instance, DIST_MATRIX);
+    else
+        problem = tsp_random(atoi(instance), 1, DIST_MATRIX);
+    perm_set_problem(problem);
+    n = problem->n;
+
+    gettimeofday(&start, NULL);
+    pop = int_init_population("random", N_POPULATION, n, 0, n - 1,
+                              NO_REPEAT);
+    int_set_n_threads(pop, n_threads);
+    int_set_local_search(pop, ls_mode, "lamarckian", LS_TOP, LS_FRACTION,
+                         LS_BUDGET, tsp_swap_delta);
+    int_evaluate_population(pop, tsp_objective);
+    for (k = 0; k < MAX_ITER; k++)
+    {
+        int_ga_one_iter(pop, tsp_objective, TOURNAMENT_SIZE, "2kpoints",
+                        N_CHILDS, N_CHILDS, "swap", MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    fo_ga = pop->best_fo_alltime;
+    printf("%s (n = %d), ls '%s': best tour %.0f after %d generations, "
+           "%.3f s\n", problem->name, n, ls_mode, fo_ga, k,
+           elapsed(start, stop));
+    printf("fo evaluations %ld, local search moves %ld\n",
+           pop->n_evaluations, pop->n_ls_evaluations);
+
+    /* 2-opt over neighbor lists from the best tour. */
+    gettimeofday(&start, NULL);
+    perm_build_neighbors(problem, N_NEIGHBORS);
+    tour = ec_malloc(n * sizeof(int), __LINE__, __FILE__);
+    memcpy(tour, pop->best_indv_alltime[0], n * sizeof(int));
+    fo_2opt = fo_ga + tsp_2opt(tour, n, 0);
+    gettimeofday(&stop, NULL);
+    printf("2-opt (%d neighbors): %.0f, %.3f s\n", N_NEIGHBORS, fo_2opt,
+           elapsed(start, stop));
+
+    free(tour);
+    int_free_population(pop);
+    perm_free_problem(problem);
+    return 0;
+}
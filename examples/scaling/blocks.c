@@ -0,0 +1,118 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Decomposable objective (see 'int_set_block_objective'): a sum of
+   independent subproblems of BLOCK_SIZE genes each (a weighted graph
+   coloring per block, the weight of a conflict depending on the pair
+   of genes), evaluated as a whole and by blocks, with '2kpoints' and
+   'uniform' crossovers. Prints the best fo, the time per generation
+   and the blocks evaluated per child.
+   Usage: ./blocks.out [L (20000 by default)] [n_population (100)]
+   [n_generations (200)] */
+
+#define BLOCK_SIZE 50
+#define N_COLORS 4
+#define TOURNAMENT_SIZE 2
+#define MUTATIONS 2.0
+
+float block_function(int *arr, int length, int first, int last);
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int length, int n_population, int n_generations, char *cross_mode,
+         int blocks);
+
+float block_function(int *arr, int length, int first, int last)
+{
+    /* Conflicts (same color) between the genes of [first, last). */
+    int a, b, fo = 0;
+
+    for (a = first; a < last; a++)
+    {
+        for (b = a + 1; b < last; b++)
+        {
+            if (arr[a] == arr[b])
+                fo += (a * 31 + b * 17) % 7 + 1;
+        }
+    }
+    return (float) fo;
+}
+
+float objective_function(int *arr, int length)
+{
+    /* The same sum, block by block. */
+    int first;
+    float fo = 0.0;
+
+    for (first = 0; first < length; first += BLOCK_SIZE)
+    {
+        fo += block_function(arr, length, first,
+                             (first + BLOCK_SIZE < length) ?
+                             first + BLOCK_SIZE : length);
+    }
+    return fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int length, int n_population, int n_generations, char *cross_mode,
+         int blocks)
+{
+    int k, n_childs = n_population * 4 / 10 * 2;
+    long n_initial;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", n_population, length, 0,
+                              N_COLORS - 1, REPEATABLE);
+    if (blocks)
+        int_set_block_objective(pop, BLOCK_SIZE, block_function);
+    int_evaluate_population(pop, objective_function);
+    n_initial = pop->n_block_evaluations;
+    gettimeofday(&start, NULL);
+    for (k = 0; k < n_generations; k++)
+    {
+        int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                        cross_mode, n_childs, n_childs, "uniform",
+                        MUTATIONS / length);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-8s %-6s: best fo %8g, %.4f s per generation",
+           cross_mode, blocks ? "blocks" : "full", pop->best_fo_alltime,
+           elapsed(start, stop) / n_generations);
+    if (blocks)
+        printf(", %.1f of %d blocks evaluated per child",
+               (pop->n_block_evaluations - n_initial)
+               / ((double) n_generations * n_childs), pop->n_blocks);
+    printf("\n");
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i, length = (argc > 1) ? atoi(argv[1]) : 20000;
+    int n_population = (argc > 2) ? atoi(argv[2]) : 100;
+    int n_generations = (argc > 3) ? atoi(argv[3]) : 200;
+    char *cross_modes[4] = {"2kpoints", "2kpoints", "uniform", "uniform"};
+
+    printf("L = %d (%d blocks of %d genes), %d individuals\n", length,
+           (length + BLOCK_SIZE - 1) / BLOCK_SIZE, BLOCK_SIZE,
+           n_population);
+    fflush(stdout);
+    for (i = 0; i < 4; i++)
+    {
+        run(length, n_population, n_generations, cross_modes[i], i % 2);
+    }
+    return 0;
+}
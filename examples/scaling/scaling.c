@@ -0,0 +1,102 @@
+#include "../../GA_int/GA_int.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Scaling benchmark of GA_int with the genome length, from L = 10^3 to
+   L = 10^7 genes, for permutations (non-repeatable, '2kpoints' + 'swap')
+   and binary genomes (repeatable in [0, 1], 'uniform' + 'uniform').
+   The population is small and the objective function is a trivial
+   linear one, so the times are those of the engine itself.
+   Usage: ./scaling.out [max L (10000000 by default)] */
+
+#define N_POPULATION 8
+#define N_CHILDS 6
+#define TOURNAMENT_SIZE 2
+#define MUTATE_RATE 0.001
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int length, int perm);
+
+float objective_function(int *arr, int length)
+{
+    /* Linear in the genome: alternated sum of the genes. */
+    int j;
+    double fo = 0.0;
+
+    for (j = 0; j < length; j++)
+        fo += (j & 1) ? arr[j] : -arr[j];
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int length, int perm)
+{
+    int k, n_generations = (length <= 100000) ? 50 : 5;
+    double t_init, t_gen;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    gettimeofday(&start, NULL);
+    if (perm)
+        pop = int_init_population("random", N_POPULATION, length, 0,
+                                  length - 1, NO_REPEAT);
+    else
+        pop = int_init_population("random", N_POPULATION, length, 0, 1,
+                                  REPEATABLE);
+    int_evaluate_population(pop, objective_function);
+    gettimeofday(&stop, NULL);
+    t_init = elapsed(start, stop);
+
+    gettimeofday(&start, NULL);
+    for (k = 0; k < n_generations; k++)
+    {
+        if (perm)
+            int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                            "2kpoints", N_CHILDS, N_CHILDS, "swap",
+                            MUTATE_RATE);
+        else
+            int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                            "uniform", N_CHILDS, N_CHILDS, "uniform",
+                            MUTATE_RATE);
+    }
+    gettimeofday(&stop, NULL);
+    t_gen = elapsed(start, stop) / n_generations;
+
+    printf("%-12s %10d %12.4f %12.4f %10.2f\n", perm ? "permutation"
+           : "binary", length, t_init, t_gen,
+           t_gen * 1e9 / ((double) N_CHILDS * length));
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int length, perm, max_length = (argc > 1) ? atoi(argv[1]) : 10000000;
+
+    printf("%d individuals, %d childs per generation:\n", N_POPULATION,
+           N_CHILDS);
+    printf("%-12s %10s %12s %12s %10s\n", "mode", "L", "init (s)",
+           "gen (s)", "ns/gene");
+    fflush(stdout);
+    for (perm = 1; perm >= 0; perm--)
+    {
+        for (length = 1000; length <= max_length; length *= 10)
+        {
+            run(length, perm);
+            if (length > max_length / 10)
+                break;
+        }
+    }
+    return 0;
+}
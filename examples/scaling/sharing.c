@@ -0,0 +1,116 @@
+#include "../../GA_int/GA_int.h"
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Genome sharing (see 'int_set_genome_sharing') on long binary genomes:
+   the same run with private rows and with copy-on-write rows, printing
+   the resident memory, the individuals without a row of their own and
+   the time per generation. The population starts converged (all the
+   individuals equal, as after a restart from a single solution) and
+   the mutation rate is low (MUTATIONS genes per child on average), so
+   most childs of identical parents are clones.
+   Usage: ./sharing.out [L (1000000 by default)] [n_population (64)]
+   [n_generations (40)] */
+
+#define TOURNAMENT_SIZE 4
+#define MUTATIONS 0.1
+
+float objective_function(int *arr, int length);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+double resident_mb(void);
+
+void run(int length, int n_population, int n_generations,
+         char *sharing_mode);
+
+float objective_function(int *arr, int length)
+{
+    /* Genes different from a fixed pattern. */
+    int j, fo = 0;
+
+    for (j = 0; j < length; j++)
+        fo += (arr[j] != (j % 3 == 0));
+    return (float) fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+double resident_mb(void)
+{
+    /* Resident set size (second field of /proc/self/statm, in pages). */
+    long size = 0, resident = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+
+    if (file == NULL)
+        return 0.0;
+    if (fscanf(file, "%ld %ld", &size, &resident) != 2)
+        resident = 0;
+    fclose(file);
+    return resident * (double) sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+void run(int length, int n_population, int n_generations,
+         char *sharing_mode)
+{
+    int k, n_childs = n_population * 4 / 10 * 2;
+    double peak = 0.0;
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    /* Rows are mapped on their own, so the free'd ones go back to the
+       system (glibc raises this threshold after the first free
+       otherwise). */
+    mallopt(M_MMAP_THRESHOLD, 64 * 1024);
+    srand(1);
+    pop = int_init_population("empty", n_population, length, 0, 1,
+                              REPEATABLE);
+    int_set_genome_sharing(pop, sharing_mode);
+    int_evaluate_population(pop, objective_function);
+    gettimeofday(&start, NULL);
+    for (k = 1; k <= n_generations; k++)
+    {
+        int_ga_one_iter(pop, objective_function, TOURNAMENT_SIZE,
+                        "uniform", n_childs, n_childs, "uniform",
+                        MUTATIONS / length);
+        if (resident_mb() > peak)
+            peak = resident_mb();
+        if (k % (n_generations / 4) == 0)
+            printf("%-4s generation %4d: best fo %8g, %6.1f MB resident, "
+                   "%3ld individuals sharing a row\n", sharing_mode, k,
+                   pop->best_fo_alltime, resident_mb(), pop->n_cow_shared);
+    }
+    gettimeofday(&stop, NULL);
+    printf("%-4s %.3f s per generation, peak %.1f MB, %ld clone childs, "
+           "%ld copies on write\n", sharing_mode,
+           elapsed(start, stop) / n_generations, peak, pop->n_cow_clones,
+           pop->n_cow_copies);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i, length = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int n_population = (argc > 2) ? atoi(argv[2]) : 64;
+    int n_generations = (argc > 3) ? atoi(argv[3]) : 40;
+    char *modes[2] = {"none", "cow"};
+
+    printf("L = %d, %d individuals (%.1f MB of genes)\n", length,
+           n_population, n_population * (double) length * sizeof(int)
+           / (1024.0 * 1024.0));
+    fflush(stdout);
+    for (i = 0; i < 2; i++)
+    {
+        run(length, n_population, n_generations, modes[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../../GA_int/GA_int.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+/* Surrogate pre-screening (see 'int_set_surrogate') with a budget of
+   objective function calls, as for an objective that costs seconds.
+   The objective is a chain of L genes in [0, N_VALUES - 1]: a cost per
+   (locus, value) plus an interaction cost per pair of neighbor loci
+   (a NK landscape with K = 1), both from fixed pseudo random tables.
+   The same GA runs without surrogate, with the 'linear' and 'knn'
+   surrogates (FACTOR candidates per child) and with the 'linear' one
+   only measuring it's accuracy (factor 1). Prints the best fo, the
+   accuracy of the last generation and the time per generation.
+   Usage: ./surrogate.out [L (100 by default)] [n_evaluations (8000)] */
+
+#define N_VALUES 8
+#define N_POPULATION 100
+#define N_CHILDS 80
+#define TOURNAMENT_SIZE 2
+#define MUTATIONS 1.0
+#define FACTOR 4
+#define ARCHIVE_SIZE 2000
+#define RETRAIN_EVERY 5
+#define N_NEIGHBORS 8
+
+float objective_function(int *arr, int length);
+
+float table_cost(uint64_t key);
+
+double elapsed(struct timeval start, struct timeval stop);
+
+void run(int length, long n_evaluations, char *surrogate_mode, int factor);
+
+float table_cost(uint64_t key)
+{
+    /* Fixed pseudo random cost in [0, 1). */
+    return (float) (hash_mix64(key) >> 40) / (float) (1 << 24);
+}
+
+float objective_function(int *arr, int length)
+{
+    int j;
+    float fo = 0.0;
+
+    for (j = 0; j < length; j++)
+    {
+        fo += table_cost((uint64_t) j * N_VALUES + arr[j]);
+        if (j + 1 < length)
+            fo += 0.5f * table_cost((1ULL << 32) + ((uint64_t) j * N_VALUES
+                                    + arr[j]) * N_VALUES + arr[j + 1]);
+    }
+    return fo;
+}
+
+double elapsed(struct timeval start, struct timeval stop)
+{
+    return stop.tv_sec - start.tv_sec
+           + (stop.tv_usec - start.tv_usec) / 1000000.0;
+}
+
+void run(int length, long n_evaluations, char *surrogate_mode, int factor)
+{
+    struct IntPopulation *pop;
+    struct timeval stop, start;
+
+    srand(1);
+    pop = int_init_population("random", N_POPULATION, length, 0,
+                              N_VALUES - 1, REPEATABLE);
+    int_set_surrogate(pop, surrogate_mode, factor, ARCHIVE_SIZE,
+                      RETRAIN_EVERY, N_NEIGHBORS);
+    int_set_run_limits(pop, 0, 0.0, n_evaluations, 0);
+    gettimeofday(&start, NULL);
+    int_ga_run(pop, objective_function, TOURNAMENT_SIZE, "uniform",
+               N_CHILDS, N_CHILDS, "uniform", MUTATIONS / length);
+    gettimeofday(&stop, NULL);
+    printf("%-7s %6d  %8.3f  %9ld  %7.3f  %6.3f  %7.3f\n", surrogate_mode,
+           factor, pop->best_fo_alltime, pop->n_evaluations,
+           pop->surr_rank_corr, pop->surr_mae,
+           elapsed(start, stop) * 1000.0 / pop->generation);
+    fflush(stdout);
+    int_free_population(pop);
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+    int length = (argc > 1) ? atoi(argv[1]) : 100;
+    long n_evaluations = (argc > 2) ? atol(argv[2]) : 8000;
+    char *modes[4] = {"none", "linear", "knn", "linear"};
+    int factors[4] = {1, FACTOR, FACTOR, 1};
+
+    printf("L = %d, %d individuals, %ld evaluations\n", length,
+           N_POPULATION, n_evaluations);
+    printf("model   factor  best fo   evaluations  rank    mae     "
+           "ms/gen\n");
+    fflush(stdout);
+    for (i = 0; i < 4; i++)
+    {
+        run(length, n_evaluations, modes[i], factors[i]);
+    }
+    return 0;
+}
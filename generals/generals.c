@@ -70,6 +70,56 @@ shuffle_arr(void *arr0, int length, size_t size)
     }
 }
 
+uint64_t
+hash_mix64(uint64_t x)
+{
+/* 64 bits mixing function (splitmix64 finalizer), useful
+   to build hashes and pseudo random streams. */
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t
+rng_next(uint64_t *state)
+{
+/* Fast pseudo random stream (splitmix64): returns the next 64 bits
+   value and advances '*state'. */
+    uint64_t x = (*state += 0x9E3779B97F4A7C15ULL);
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint32_t
+rng_bounded(uint64_t *state, uint32_t n)
+{
+/* Random integer in [0, n) without modulo bias (Lemire's method):
+   one multiplication, rejection only for the few biased values. */
+    uint64_t m = (uint64_t) (uint32_t) rng_next(state) * n;
+    uint32_t low = (uint32_t) m, threshold;
+
+    if (low < n)
+    {
+        threshold = -n % n;
+        while (low < threshold)
+        {
+            m = (uint64_t) (uint32_t) rng_next(state) * n;
+            low = (uint32_t) m;
+        }
+    }
+    return (uint32_t) (m >> 32);
+}
+
+double
+rng_double(uint64_t *state)
+{
+/* Random double in [0, 1) from the 53 upper bits. */
+    return (double) (rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
 int
 get_random_int()
 {
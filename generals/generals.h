@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <stdint.h>
 
 #ifndef GENERALS_H
 #define GENERALS_H
@@ -17,5 +18,20 @@ void
 void
 shuffle_arr(void *arr0, int length, size_t size);
 /* Function to 'riffle shuffle' an array. */
+uint64_t
+hash_mix64(uint64_t x);
+/* 64 bits mixing function (splitmix64 finalizer), useful
+   to build hashes and pseudo random streams. */
+uint64_t
+rng_next(uint64_t *state);
+/* Fast pseudo random stream (splitmix64): returns the next 64 bits
+   value and advances '*state'. Independent streams are just
+   different states (e.g. seeded with 'hash_mix64'). */
+uint32_t
+rng_bounded(uint64_t *state, uint32_t n);
+/* Random integer in [0, n) without modulo bias (Lemire's method). */
+double
+rng_double(uint64_t *state);
+/* Random double in [0, 1). */
 
 #endif /* GENERALS_H */
@@ -0,0 +1,756 @@
+/* This is the source file for 'perm_problems.h'.
+
+   Written by Gabriel Gil <2021> */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "perm_problems.h"
+
+/*==========================*/
+/* Problem used by the objective and delta functions. */
+struct PermProblem *glb_problem = NULL;
+
+/* Pi as defined by TSPLIB for GEO coordinates. */
+#define TSPLIB_PI 3.141592
+/* Side of the square of 'tsp_random'. */
+#define TSP_RANDOM_SIDE 100000.0
+/* TSPLIB EDGE_WEIGHT_FORMATs of EXPLICIT instances. */
+#define FORMAT_FULL_MATRIX 0
+#define FORMAT_UPPER_ROW 1
+#define FORMAT_LOWER_ROW 2
+#define FORMAT_UPPER_DIAG_ROW 3
+#define FORMAT_LOWER_DIAG_ROW 4
+
+/*==========================*/
+/* Local source functions prototypes. */
+void
+perm_file_error(char *path, char *message);
+
+struct PermProblem
+*perm_new_problem(int type, int n);
+
+int
+perm_coord_distance(struct PermProblem *problem, int i, int j);
+
+void
+tsp_fill_matrix(struct PermProblem *problem);
+
+void
+tsp_read_weights(struct PermProblem *problem, FILE *file, char *path,
+                 int format);
+
+void
+tsp_reverse(int *arr, int *pos, int n, int start, int end);
+
+int
+tsp_2opt_city(struct PermProblem *problem, int *arr, int *pos, int n,
+              int a, unsigned char *dont_look, long long *total);
+
+/*==========================*/
+/* Instances. */
+void
+perm_file_error(char *path, char *message)
+{
+/* Reports an invalid instance file and exits. */
+    fprintf(stderr, "===ARGUMENT ERROR===\n"
+           "The file '%s' %s.\n"
+           "====================\n", path, message);
+    exit(EXIT_FAILURE);
+}
+
+struct PermProblem
+*perm_new_problem(int type, int n)
+{
+/* Returns an empty problem of size 'n'. */
+    struct PermProblem *problem;
+
+    if (n < 2)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "A permutation problem must have n >= 2 (n = %d).\n"
+               "====================\n", n);
+        exit(EXIT_FAILURE);
+    }
+    problem = ec_calloc(1, sizeof(struct PermProblem), __LINE__, __FILE__);
+    problem->type = type;
+    problem->n = n;
+    problem->weight_type = WEIGHT_EXPLICIT;
+    return problem;
+}
+
+int
+perm_coord_distance(struct PermProblem *problem, int i, int j)
+{
+/* Distance between the cities 'i' and 'j' from their coordinates,
+   rounded as defined by TSPLIB. GEO coordinates are already converted
+   to radians (latitude in 'x', longitude in 'y'). */
+    double dx, dy, r, q1, q2, q3;
+    int t;
+
+    if (problem->weight_type == WEIGHT_GEO)
+    {
+        q1 = cos(problem->y[i] - problem->y[j]);
+        q2 = cos(problem->x[i] - problem->x[j]);
+        q3 = cos(problem->x[i] + problem->x[j]);
+        return (int) (6378.388 * acos(0.5 * ((1.0 + q1) * q2 -
+                                             (1.0 - q1) * q3)) + 1.0);
+    }
+    dx = problem->x[i] - problem->x[j];
+    dy = problem->y[i] - problem->y[j];
+    if (problem->weight_type == WEIGHT_ATT)
+    {
+        r = sqrt((dx * dx + dy * dy) / 10.0);
+        t = (int) (r + 0.5);
+        return (t < r) ? t + 1 : t;
+    }
+    r = sqrt(dx * dx + dy * dy);
+    if (problem->weight_type == WEIGHT_CEIL_2D)
+        return (int) ceil(r);
+    return (int) (r + 0.5);
+}
+
+void
+tsp_fill_matrix(struct PermProblem *problem)
+{
+/* Precomputes the distances of a problem with coordinates. */
+    int i, j, n = problem->n;
+
+    problem->dist = ec_malloc((size_t) n * n * sizeof(int),
+                              __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        problem->dist[(size_t) i * n + i] = 0;
+        for (j = i + 1; j < n; j++)
+        {
+            problem->dist[(size_t) i * n + j] =
+                problem->dist[(size_t) j * n + i] =
+                perm_coord_distance(problem, i, j);
+        }
+    }
+}
+
+void
+tsp_read_weights(struct PermProblem *problem, FILE *file, char *path,
+                 int format)
+{
+/* Reads the EDGE_WEIGHT_SECTION of a TSPLIB file in the given format. */
+    int i, j, first, last, w, n = problem->n;
+
+    problem->dist = ec_calloc(n * n, sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        switch (format)
+        {
+            case FORMAT_UPPER_ROW:
+                first = i + 1;
+                last = n - 1;
+                break;
+            case FORMAT_LOWER_ROW:
+                first = 0;
+                last = i - 1;
+                break;
+            case FORMAT_UPPER_DIAG_ROW:
+                first = i;
+                last = n - 1;
+                break;
+            case FORMAT_LOWER_DIAG_ROW:
+                first = 0;
+                last = i;
+                break;
+            default:
+                first = 0;
+                last = n - 1;
+        }
+        for (j = first; j <= last; j++)
+        {
+            if (fscanf(file, "%d", &w) != 1)
+                perm_file_error(path, "has an incomplete EDGE_WEIGHT_SECTION");
+            problem->dist[i * n + j] = w;
+            if (format != FORMAT_FULL_MATRIX)
+                problem->dist[j * n + i] = w;
+        }
+    }
+}
+
+struct PermProblem
+*tsp_read_tsplib(char *path, int matrix)
+{
+/* This function reads a symmetric TSP from a TSPLIB file. Accepted
+   EDGE_WEIGHT_TYPEs are EUC_2D, CEIL_2D, ATT, GEO and EXPLICIT (with
+   FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW or LOWER_DIAG_ROW
+   formats). Other files are argument errors.
+   =ARGUMENTS=
+   - '*path' : Path of the .tsp file.
+   - 'matrix' : - DIST_MATRIX     : The distances are precomputed (n^2 ints).
+                - DIST_ON_THE_FLY : The distances are computed from the
+                                    coordinates at each use (for large n).
+                EXPLICIT instances always keep their matrix. */
+    char line[1024], key[64], *value, *end;
+    char name[64] = "";
+    int i, id, n = 0, done = 0, weight_type = -1, format = -1;
+    double x, y, deg;
+    struct PermProblem *problem = NULL;
+    FILE *file;
+
+    file = fopen(path, "r");
+    if (file == NULL)
+        perm_file_error(path, "can't be opened");
+    while (!done && fgets(line, sizeof(line), file) != NULL)
+    {
+        if (sscanf(line, " %63[A-Z_0-9]", key) != 1)
+            continue;
+        /* Value after ':', without blanks around it. */
+        value = strchr(line, ':');
+        value = (value == NULL) ? "" : value + 1;
+        while (*value == ' ' || *value == '\t')
+            value++;
+        end = value + strlen(value);
+        while (end > value && (end[-1] == '\n' || end[-1] == '\r' ||
+                               end[-1] == ' ' || end[-1] == '\t'))
+            *--end = '\0';
+
+        if (!strcmp(key, "NAME"))
+            snprintf(name, sizeof(name), "%s", value);
+        else if (!strcmp(key, "TYPE") && strcmp(value, "TSP"))
+            perm_file_error(path, "is not a symmetric TSP (TYPE: TSP)");
+        else if (!strcmp(key, "DIMENSION"))
+            n = atoi(value);
+        else if (!strcmp(key, "EDGE_WEIGHT_TYPE"))
+        {
+            if (!strcmp(value, "EXPLICIT"))
+                weight_type = WEIGHT_EXPLICIT;
+            else if (!strcmp(value, "EUC_2D"))
+                weight_type = WEIGHT_EUC_2D;
+            else if (!strcmp(value, "CEIL_2D"))
+                weight_type = WEIGHT_CEIL_2D;
+            else if (!strcmp(value, "ATT"))
+                weight_type = WEIGHT_ATT;
+            else if (!strcmp(value, "GEO"))
+                weight_type = WEIGHT_GEO;
+            else
+                perm_file_error(path, "has an unsupported EDGE_WEIGHT_TYPE");
+        }
+        else if (!strcmp(key, "EDGE_WEIGHT_FORMAT"))
+        {
+            if (!strcmp(value, "FULL_MATRIX"))
+                format = FORMAT_FULL_MATRIX;
+            else if (!strcmp(value, "UPPER_ROW"))
+                format = FORMAT_UPPER_ROW;
+            else if (!strcmp(value, "LOWER_ROW"))
+                format = FORMAT_LOWER_ROW;
+            else if (!strcmp(value, "UPPER_DIAG_ROW"))
+                format = FORMAT_UPPER_DIAG_ROW;
+            else if (!strcmp(value, "LOWER_DIAG_ROW"))
+                format = FORMAT_LOWER_DIAG_ROW;
+        }
+        else if (!strcmp(key, "NODE_COORD_SECTION") ||
+                 !strcmp(key, "EDGE_WEIGHT_SECTION"))
+        {
+            if (n < 2 || weight_type < 0)
+                perm_file_error(path, "lacks DIMENSION or EDGE_WEIGHT_TYPE");
+            problem = perm_new_problem(PROBLEM_TSP, n);
+            problem->weight_type = weight_type;
+            snprintf(problem->name, sizeof(problem->name), "%s", name);
+            if (!strcmp(key, "EDGE_WEIGHT_SECTION"))
+            {
+                if (weight_type != WEIGHT_EXPLICIT || format < 0)
+                    perm_file_error(path, "has an EDGE_WEIGHT_SECTION "
+                                    "without EXPLICIT weights and a "
+                                    "supported EDGE_WEIGHT_FORMAT");
+                tsp_read_weights(problem, file, path, format);
+            }
+            else
+            {
+                if (weight_type == WEIGHT_EXPLICIT)
+                    perm_file_error(path, "has coordinates for EXPLICIT "
+                                    "weights");
+                problem->x = ec_calloc(n, sizeof(double), __LINE__, __FILE__);
+                problem->y = ec_calloc(n, sizeof(double), __LINE__, __FILE__);
+                for (i = 0; i < n; i++)
+                {
+                    if (fscanf(file, "%d %lf %lf", &id, &x, &y) != 3 ||
+                        id < 1 || id > n)
+                        perm_file_error(path, "has an invalid "
+                                        "NODE_COORD_SECTION");
+                    if (weight_type == WEIGHT_GEO)
+                    {
+                        /* DDD.MM degrees and minutes to radians. */
+                        deg = (int) x;
+                        x = TSPLIB_PI * (deg + 5.0 * (x - deg) / 3.0) / 180.0;
+                        deg = (int) y;
+                        y = TSPLIB_PI * (deg + 5.0 * (y - deg) / 3.0) / 180.0;
+                    }
+                    problem->x[id - 1] = x;
+                    problem->y[id - 1] = y;
+                }
+                if (matrix == DIST_MATRIX)
+                    tsp_fill_matrix(problem);
+            }
+            done = 1;
+        }
+        else if (!strcmp(key, "EOF"))
+            break;
+    }
+    fclose(file);
+    if (problem == NULL)
+        perm_file_error(path, "has no NODE_COORD_SECTION or "
+                        "EDGE_WEIGHT_SECTION");
+    return problem;
+}
+
+struct PermProblem
+*tsp_random(int n, uint64_t seed, int matrix)
+{
+/* This function returns a TSP with 'n' cities uniformly spread in a
+   100000 x 100000 square (EUC_2D distances). Same 'seed' (and 'n'),
+   same instance. See 'tsp_read_tsplib' for 'matrix'. */
+    int i;
+    uint64_t rng = hash_mix64(seed);
+    struct PermProblem *problem = perm_new_problem(PROBLEM_TSP, n);
+
+    snprintf(problem->name, sizeof(problem->name), "random%d", n);
+    problem->weight_type = WEIGHT_EUC_2D;
+    problem->x = ec_calloc(n, sizeof(double), __LINE__, __FILE__);
+    problem->y = ec_calloc(n, sizeof(double), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        problem->x[i] = floor(rng_double(&rng) * TSP_RANDOM_SIDE);
+        problem->y[i] = floor(rng_double(&rng) * TSP_RANDOM_SIDE);
+    }
+    if (matrix == DIST_MATRIX)
+        tsp_fill_matrix(problem);
+    return problem;
+}
+
+struct PermProblem
+*qap_read_qaplib(char *path)
+{
+/* This function reads a QAP from a QAPLIB file: n, followed by the
+   n x n matrices A and B. */
+    int i, n;
+    struct PermProblem *problem;
+    FILE *file;
+
+    file = fopen(path, "r");
+    if (file == NULL)
+        perm_file_error(path, "can't be opened");
+    if (fscanf(file, "%d", &n) != 1 || n < 2)
+        perm_file_error(path, "doesn't start with the QAP size");
+    problem = perm_new_problem(PROBLEM_QAP, n);
+    problem->flow = ec_malloc((size_t) n * n * sizeof(int),
+                              __LINE__, __FILE__);
+    problem->dist = ec_malloc((size_t) n * n * sizeof(int),
+                              __LINE__, __FILE__);
+    for (i = 0; i < 2 * n * n; i++)
+    {
+        if (fscanf(file, "%d", (i < n * n) ? &problem->flow[i]
+                   : &problem->dist[i - n * n]) != 1)
+            perm_file_error(path, "has incomplete QAP matrices");
+    }
+    fclose(file);
+    return problem;
+}
+
+struct PermProblem
+*qap_random(int n, uint64_t seed)
+{
+/* This function returns a QAP with flows and distances uniformly
+   drawn in [0, 99] (zero diagonal), as the 'taiXXa' instances. */
+    int i, j;
+    uint64_t rng = hash_mix64(seed);
+    struct PermProblem *problem = perm_new_problem(PROBLEM_QAP, n);
+
+    snprintf(problem->name, sizeof(problem->name), "random%d", n);
+    problem->flow = ec_malloc((size_t) n * n * sizeof(int),
+                              __LINE__, __FILE__);
+    problem->dist = ec_malloc((size_t) n * n * sizeof(int),
+                              __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        for (j = 0; j < n; j++)
+        {
+            problem->flow[i * n + j] = (i == j) ? 0 : rng_bounded(&rng, 100);
+            problem->dist[i * n + j] = (i == j) ? 0 : rng_bounded(&rng, 100);
+        }
+    }
+    return problem;
+}
+
+void
+perm_free_problem(struct PermProblem *problem)
+{
+/* Frees a problem and all it's arrays. */
+    if (glb_problem == problem)
+        glb_problem = NULL;
+    free(problem->dist);
+    free(problem->flow);
+    free(problem->x);
+    free(problem->y);
+    free(problem->neighbors);
+    free(problem);
+}
+
+void
+perm_build_neighbors(struct PermProblem *problem, int n_neighbors)
+{
+/* This function builds the TSP neighbor lists: the 'n_neighbors'
+   nearest cities of each city, sorted by distance (O(n^2) distances).
+   They restrict the moves tried by 'tsp_2opt' to promising ones. */
+    int i, j, k, m, d, n = problem->n;
+    int *list, *list_dist;
+
+    if (problem->type != PROBLEM_TSP || n_neighbors < 1)
+    {
+        fprintf(stderr, "===ARGUMENT ERROR===\n"
+               "Neighbor lists are built for TSPs with n_neighbors >= 1.\n"
+               "====================\n");
+        exit(EXIT_FAILURE);
+    }
+    if (n_neighbors > n - 1)
+        n_neighbors = n - 1;
+    free(problem->neighbors);
+    problem->n_neighbors = n_neighbors;
+    problem->neighbors = ec_malloc((size_t) n * n_neighbors * sizeof(int),
+                                   __LINE__, __FILE__);
+    list_dist = ec_malloc(n_neighbors * sizeof(int), __LINE__, __FILE__);
+    for (i = 0; i < n; i++)
+    {
+        /* Insertion into the sorted list of the nearest cities so far. */
+        list = problem->neighbors + (size_t) i * n_neighbors;
+        k = 0;
+        for (j = 0; j < n; j++)
+        {
+            if (j == i)
+                continue;
+            d = tsp_distance(problem, i, j);
+            if (k == n_neighbors && d >= list_dist[k - 1])
+                continue;
+            m = (k < n_neighbors) ? k++ : k - 1;
+            for (; m > 0 && list_dist[m - 1] > d; m--)
+            {
+                list_dist[m] = list_dist[m - 1];
+                list[m] = list[m - 1];
+            }
+            list_dist[m] = d;
+            list[m] = j;
+        }
+    }
+    free(list_dist);
+}
+
+void
+perm_set_problem(struct PermProblem *problem)
+{
+/* Defines the problem used by the objective, delta and local search
+   functions. It must be called before evaluating a population. */
+    glb_problem = problem;
+}
+
+/*==========================*/
+/* TSP. */
+int
+tsp_distance(struct PermProblem *problem, int i, int j)
+{
+/* Distance between the cities 'i' and 'j' (TSPLIB rounding). */
+    if (problem->dist != NULL)
+        return problem->dist[(size_t) i * problem->n + j];
+    return perm_coord_distance(problem, i, j);
+}
+
+float
+tsp_objective(int *arr, int length)
+{
+/* Length of the closed tour 'arr' (objective function for GA_int). */
+    int i;
+    long long fo = 0;
+    struct PermProblem *problem = glb_problem;
+
+    for (i = 0; i < length - 1; i++)
+        fo += tsp_distance(problem, arr[i], arr[i + 1]);
+    fo += tsp_distance(problem, arr[length - 1], arr[0]);
+    return (float) fo;
+}
+
+float
+tsp_swap_delta(int *arr, int length, int a, int b)
+{
+/* Tour length change of swapping the cities at the positions 'a' and
+   'b' of 'arr', in O(1) ('delta_function' of 'int_set_local_search'). */
+    int ca, cb, pa, na, pb, nb, tmp;
+    long long delta;
+    struct PermProblem *problem = glb_problem;
+
+    if (a == b || length < 3)
+        return 0.0;
+    if (a > b)
+    {
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+    if (a == 0 && b == length - 1)
+    {
+        /* Neighbors through the end of the tour: same as swapping
+           positions 'b' and 'b + 1'. */
+        a = length - 1;
+        b = 0;
+    }
+    ca = arr[a];
+    cb = arr[b];
+    pa = arr[(a == 0) ? length - 1 : a - 1];
+    na = arr[(a == length - 1) ? 0 : a + 1];
+    pb = arr[(b == 0) ? length - 1 : b - 1];
+    nb = arr[(b == length - 1) ? 0 : b + 1];
+    if (na == cb)
+    {
+        /* ... pa ca cb nb ... -> ... pa cb ca nb ... */
+        if (length == 3)
+            return 0.0;
+        delta = (long long) tsp_distance(problem, pa, cb)
+                + tsp_distance(problem, ca, nb)
+                - tsp_distance(problem, pa, ca)
+                - tsp_distance(problem, cb, nb);
+    }
+    else
+    {
+        delta = (long long) tsp_distance(problem, pa, cb)
+                + tsp_distance(problem, cb, na)
+                + tsp_distance(problem, pb, ca)
+                + tsp_distance(problem, ca, nb)
+                - tsp_distance(problem, pa, ca)
+                - tsp_distance(problem, ca, na)
+                - tsp_distance(problem, pb, cb)
+                - tsp_distance(problem, cb, nb);
+    }
+    return (float) delta;
+}
+
+float
+tsp_2opt_delta(int *arr, int length, int a, int b)
+{
+/* Tour length change of the 2-opt move reversing 'arr[a + 1 .. b]'
+   (a < b), in O(1). */
+    int next_b = (b == length - 1) ? 0 : b + 1;
+    struct PermProblem *problem = glb_problem;
+
+    return (float) ((long long) tsp_distance(problem, arr[a], arr[b])
+                    + tsp_distance(problem, arr[a + 1], arr[next_b])
+                    - tsp_distance(problem, arr[a], arr[a + 1])
+                    - tsp_distance(problem, arr[b], arr[next_b]));
+}
+
+void
+tsp_2opt_apply(int *arr, int length, int a, int b)
+{
+/* Applies the 2-opt move of 'tsp_2opt_delta' (reverses 'arr[a + 1 .. b]'). */
+    int tmp;
+
+    for (a++; a < b; a++, b--)
+    {
+        tmp = arr[a];
+        arr[a] = arr[b];
+        arr[b] = tmp;
+    }
+}
+
+void
+tsp_reverse(int *arr, int *pos, int n, int start, int end)
+{
+/* Reverses the cyclic segment of the tour from position 'start' to
+   'end' (both included), or the rest of the tour if it's shorter (the
+   tour is the same), updating the positions '*pos' of the cities. */
+    int k, m, i, j, tmp;
+
+    m = (end - start + n) % n + 1;
+    if (2 * m > n)
+    {
+        tmp = start;
+        start = (end + 1) % n;
+        end = (tmp - 1 + n) % n;
+        m = n - m;
+    }
+    for (k = 0; k < m / 2; k++)
+    {
+        i = (start + k) % n;
+        j = (end - k + n) % n;
+        tmp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = tmp;
+        pos[arr[i]] = i;
+        pos[arr[j]] = j;
+    }
+}
+
+int
+tsp_2opt_city(struct PermProblem *problem, int *arr, int *pos, int n,
+              int a, unsigned char *dont_look, long long *total)
+{
+/* Tries the 2-opt moves adding an edge from the city 'a' to one of it's
+   neighbors, removing the edge to it's successor or predecessor. The
+   neighbors are sorted, so the search stops at the first one farther
+   than the removed edge (no gain is possible). Applies the first
+   improving move.
+   =RETURNS=
+   - 1 if a move was applied, 0 otherwise. */
+    int k, dir, i, j, a2, c, c2, d_a, d_ac, delta;
+    int *list = problem->neighbors + (size_t) a * problem->n_neighbors;
+
+    for (dir = 0; dir < 2; dir++)
+    {
+        i = pos[a];
+        a2 = arr[dir ? (i - 1 + n) % n : (i + 1) % n];
+        d_a = tsp_distance(problem, a, a2);
+        for (k = 0; k < problem->n_neighbors; k++)
+        {
+            c = list[k];
+            d_ac = tsp_distance(problem, a, c);
+            if (d_ac >= d_a)
+                break;
+            j = pos[c];
+            c2 = arr[dir ? (j - 1 + n) % n : (j + 1) % n];
+            if (c == a2 || c2 == a)
+                continue;
+            delta = d_ac + tsp_distance(problem, a2, c2) - d_a
+                    - tsp_distance(problem, c, c2);
+            if (delta >= 0)
+                continue;
+            /* succ: ... a a2 ... c c2 ... -> ... a c ... a2 c2 ...
+               pred: ... a2 a ... c2 c ... -> ... a2 c2 ... a c ... */
+            if (dir == 0)
+                tsp_reverse(arr, pos, n, (i + 1) % n, j);
+            else
+                tsp_reverse(arr, pos, n, i, (j - 1 + n) % n);
+            dont_look[a] = dont_look[a2] = dont_look[c] = dont_look[c2] = 0;
+            *total += delta;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+float
+tsp_2opt(int *arr, int length, int max_moves)
+{
+/* This function applies 2-opt local search to the tour 'arr' until no
+   improving move is found or 'max_moves' moves are applied (<= 0: no
+   limit). With neighbor lists (see 'perm_build_neighbors') only the
+   edges to the near cities are tried, with don't look bits, and each
+   pass is O(n * n_neighbors) plus the reversals; otherwise all the
+   O(n^2) moves are tried.
+   =RETURNS=
+   - The tour length change (<= 0). */
+    int a, b, i, improved = 1, n_moves = 0;
+    int *pos;
+    float delta;
+    long long total = 0;
+    unsigned char *dont_look;
+    struct PermProblem *problem = glb_problem;
+
+    if (length < 4)
+        return 0.0;
+    if (max_moves <= 0)
+        max_moves = -1;
+    if (problem->neighbors == NULL)
+    {
+        while (improved && n_moves != max_moves)
+        {
+            improved = 0;
+            for (a = 0; a < length - 2 && n_moves != max_moves; a++)
+            {
+                for (b = a + 2; b < length && n_moves != max_moves; b++)
+                {
+                    delta = tsp_2opt_delta(arr, length, a, b);
+                    if (delta < 0.0)
+                    {
+                        tsp_2opt_apply(arr, length, a, b);
+                        total += (long long) delta;
+                        n_moves++;
+                        improved = 1;
+                    }
+                }
+            }
+        }
+        return (float) total;
+    }
+
+    pos = ec_malloc(length * sizeof(int), __LINE__, __FILE__);
+    dont_look = ec_calloc(length, sizeof(unsigned char), __LINE__, __FILE__);
+    for (i = 0; i < length; i++)
+        pos[arr[i]] = i;
+    while (improved && n_moves != max_moves)
+    {
+        improved = 0;
+        for (a = 0; a < length && n_moves != max_moves; a++)
+        {
+            if (dont_look[a])
+                continue;
+            if (tsp_2opt_city(problem, arr, pos, length, a, dont_look,
+                              &total))
+            {
+                n_moves++;
+                improved = 1;
+                a--; /* Keep improving the same city. */
+            }
+            else
+                dont_look[a] = 1;
+        }
+    }
+    free(pos);
+    free(dont_look);
+    return (float) total;
+}
+
+/*==========================*/
+/* QAP. */
+float
+qap_objective(int *arr, int length)
+{
+/* Cost of the assignment 'arr' (objective function for GA_int). */
+    int i, j;
+    int *flow_i, *dist_i;
+    long long fo = 0;
+    struct PermProblem *problem = glb_problem;
+
+    for (i = 0; i < length; i++)
+    {
+        flow_i = problem->flow + (size_t) i * length;
+        dist_i = problem->dist + (size_t) arr[i] * length;
+        for (j = 0; j < length; j++)
+            fo += (long long) flow_i[j] * dist_i[arr[j]];
+    }
+    return (float) fo;
+}
+
+float
+qap_swap_delta(int *arr, int length, int a, int b)
+{
+/* Cost change of swapping the locations of the facilities 'a' and 'b',
+   in O(n) ('delta_function' of 'int_set_local_search'). Only the terms
+   of the rows and columns 'a' and 'b' change (asymmetric matrices
+   included). */
+    int k, n = length, pa, pb, pk;
+    int *f = glb_problem->flow, *d = glb_problem->dist;
+    long long delta;
+
+    if (a == b)
+        return 0.0;
+    pa = arr[a];
+    pb = arr[b];
+    delta = (long long) f[a * n + a] * (d[pb * n + pb] - d[pa * n + pa])
+            + (long long) f[a * n + b] * (d[pb * n + pa] - d[pa * n + pb])
+            + (long long) f[b * n + a] * (d[pa * n + pb] - d[pb * n + pa])
+            + (long long) f[b * n + b] * (d[pa * n + pa] - d[pb * n + pb]);
+    for (k = 0; k < n; k++)
+    {
+        if (k == a || k == b)
+            continue;
+        pk = arr[k];
+        delta += (long long) (f[k * n + a] - f[k * n + b])
+                 * (d[pk * n + pb] - d[pk * n + pa])
+                 + (long long) (f[a * n + k] - f[b * n + k])
+                 * (d[pb * n + pk] - d[pa * n + pk]);
+    }
+    return (float) delta;
+}
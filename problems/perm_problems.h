@@ -0,0 +1,165 @@
+/* This header defines permutation problems ready to be solved with
+   GA_int (non-repeatable solutions in [0, n - 1]): the symmetric
+   travelling salesman problem (TSP) and the quadratic assignment
+   problem (QAP), read from TSPLIB/QAPLIB files or randomly generated.
+
+   The objective and delta functions have the signatures expected by
+   'int_evaluate_population' and 'int_set_local_search', so the instance
+   in use is defined once with 'perm_set_problem' (as GA_int, one
+   problem per process). They only read the instance, so they can be
+   called from several threads. Costs are summed as integers, but the
+   fo of GA_int is a float (exact up to 2^24).
+
+   There are no batch objectives ('int_set_batch_objective') for these
+   problems: each term of their cost is a lookup at a random place of
+   the distance matrix, and a loop over the individuals of a gene-major
+   block only turns those lookups into gathers, with as many loads. With
+   1024 random individuals, gene-major versions ran at 0.7 to 0.85
+   times the speed of 'tsp_objective' (1000 cities) and 'qap_objective'
+   (50 facilities), the transposition included.
+
+   TSPLIB: http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/
+   QAPLIB: https://coral.ise.lehigh.edu/data-sets/qaplib/
+
+   Written by Gabriel Gil <2021> */
+
+#ifndef PERM_PROBLEMS_H
+#define PERM_PROBLEMS_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "../generals/generals.h"
+
+/* For 'problem->type'. */
+#define PROBLEM_TSP 0
+#define PROBLEM_QAP 1
+/* For 'problem->weight_type' (TSPLIB EDGE_WEIGHT_TYPE). */
+#define WEIGHT_EXPLICIT 0
+#define WEIGHT_EUC_2D 1
+#define WEIGHT_CEIL_2D 2
+#define WEIGHT_ATT 3
+#define WEIGHT_GEO 4
+/* For the 'matrix' argument of the TSP functions. */
+#define DIST_ON_THE_FLY 0
+#define DIST_MATRIX 1
+
+/*==========================*/
+struct PermProblem
+{
+/* A permutation problem of size 'n'. A solution 'arr' is a permutation
+   of [0, n - 1]:
+   - TSP: 'arr' is the visiting order of the cities (closed tour).
+   - QAP: facility i is placed at location arr[i]. */
+    int type, n;
+    char name[64];
+    /* TSP: n x n distances ('dist[i * n + j]'), or NULL if they are
+       computed on the fly from the coordinates 'x' and 'y' ('flow' is
+       NULL).
+       QAP: n x n flows between facilities ('flow', matrix A of QAPLIB)
+       and distances between locations ('dist', matrix B), with
+       fo = sum flow[i][j] * dist[arr[i]][arr[j]]. */
+    int *dist, *flow;
+    int weight_type;
+    double *x, *y;
+    /* Neighbor lists (see 'perm_build_neighbors'): the 'n_neighbors'
+       nearest cities of city i, closest first, at
+       'neighbors[i * n_neighbors]'. */
+    int n_neighbors;
+    int *neighbors;
+};
+
+/*==========================*/
+/* Instances. */
+struct PermProblem
+*tsp_read_tsplib(char *path, int matrix);
+/* This function reads a symmetric TSP from a TSPLIB file. Accepted
+   EDGE_WEIGHT_TYPEs are EUC_2D, CEIL_2D, ATT, GEO and EXPLICIT (with
+   FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW or LOWER_DIAG_ROW
+   formats). Other files are argument errors.
+   =ARGUMENTS=
+   - '*path' : Path of the .tsp file.
+   - 'matrix' : - DIST_MATRIX     : The distances are precomputed (n^2 ints).
+                - DIST_ON_THE_FLY : The distances are computed from the
+                                    coordinates at each use (for large n).
+                EXPLICIT instances always keep their matrix. */
+
+struct PermProblem
+*tsp_random(int n, uint64_t seed, int matrix);
+/* This function returns a TSP with 'n' cities uniformly spread in a
+   100000 x 100000 square (EUC_2D distances). Same 'seed' (and 'n'),
+   same instance. See 'tsp_read_tsplib' for 'matrix'. */
+
+struct PermProblem
+*qap_read_qaplib(char *path);
+/* This function reads a QAP from a QAPLIB file: n, followed by the
+   n x n matrices A and B. */
+
+struct PermProblem
+*qap_random(int n, uint64_t seed);
+/* This function returns a QAP with flows and distances uniformly
+   drawn in [0, 99] (zero diagonal), as the 'taiXXa' instances. */
+
+void
+perm_free_problem(struct PermProblem *problem);
+/* Frees a problem and all it's arrays. */
+
+void
+perm_build_neighbors(struct PermProblem *problem, int n_neighbors);
+/* This function builds the TSP neighbor lists: the 'n_neighbors'
+   nearest cities of each city, sorted by distance (O(n^2) distances).
+   They restrict the moves tried by 'tsp_2opt' to promising ones. */
+
+void
+perm_set_problem(struct PermProblem *problem);
+/* Defines the problem used by the objective, delta and local search
+   functions below. It must be called before evaluating a population. */
+
+/*==========================*/
+/* TSP. */
+int
+tsp_distance(struct PermProblem *problem, int i, int j);
+/* Distance between the cities 'i' and 'j' (TSPLIB rounding). */
+
+float
+tsp_objective(int *arr, int length);
+/* Length of the closed tour 'arr' (objective function for GA_int). */
+
+float
+tsp_swap_delta(int *arr, int length, int a, int b);
+/* Tour length change of swapping the cities at the positions 'a' and
+   'b' of 'arr', in O(1) ('delta_function' of 'int_set_local_search'). */
+
+float
+tsp_2opt_delta(int *arr, int length, int a, int b);
+/* Tour length change of the 2-opt move reversing 'arr[a + 1 .. b]'
+   (a < b), i.e. replacing the edges (arr[a], arr[a + 1]) and
+   (arr[b], arr[b + 1]) by (arr[a], arr[b]) and (arr[a + 1], arr[b + 1]),
+   in O(1). */
+
+void
+tsp_2opt_apply(int *arr, int length, int a, int b);
+/* Applies the 2-opt move of 'tsp_2opt_delta' (reverses 'arr[a + 1 .. b]'). */
+
+float
+tsp_2opt(int *arr, int length, int max_moves);
+/* This function applies 2-opt local search to the tour 'arr' until no
+   improving move is found or 'max_moves' moves are applied (<= 0: no
+   limit). With neighbor lists (see 'perm_build_neighbors') only the
+   edges to the near cities are tried, with don't look bits, and each
+   pass is O(n * n_neighbors) plus the reversals; otherwise all the
+   O(n^2) moves are tried.
+   =RETURNS=
+   - The tour length change (<= 0). */
+
+/*==========================*/
+/* QAP. */
+float
+qap_objective(int *arr, int length);
+/* Cost of the assignment 'arr' (objective function for GA_int). */
+
+float
+qap_swap_delta(int *arr, int length, int a, int b);
+/* Cost change of swapping the locations of the facilities 'a' and 'b',
+   in O(n) ('delta_function' of 'int_set_local_search'). */
+
+#endif /* PERM_PROBLEMS_H */